@@ -46,13 +46,35 @@ target_sources(
   PUBLIC
 
   ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/Texture.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/HandlePool.hpp
   ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/Surface.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/PixelView.hpp
   ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/SDLHW2D.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/SpriteBatch.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/SdfFont.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/TextLayout.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/TileMap.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/Animation.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/UIDrawData.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/ShapeBatch.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/RenderTargetPool.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/DirtyRegion.hpp
+  ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/FrameCapture.hpp
   ${CMAKE_CURRENT_LIST_DIR}/include/swgtk/RenderingDevice.hpp
 
   PRIVATE
 
   ${CMAKE_CURRENT_LIST_DIR}/src/SDLHW2D.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/SpriteBatch.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/SdfFont.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/TextLayout.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/TileMap.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/Animation.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/UIDrawData.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/ShapeBatch.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/RenderTargetPool.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/DirtyRegion.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/src/FrameCapture.cpp
 )
 
 target_link_libraries(
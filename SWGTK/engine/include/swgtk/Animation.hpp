@@ -0,0 +1,182 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_ANIMATION_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_ANIMATION_HPP_
+
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <swgtk/SpriteBatch.hpp>
+#include <swgtk/Texture.hpp>
+
+namespace swgtk {
+
+  // The duration given to frames that don't have one, in seconds.
+  constexpr inline auto defaultFrameDuration = 0.1f;
+
+  // Shorter frames are lengthened to this, so a clip always takes time to play.
+  constexpr inline auto minFrameDuration = 0.001f;
+
+  using ClipID = uint32_t;
+  constexpr inline ClipID nullClip = 0u;
+
+  using AnimatorID = uint32_t;
+  constexpr inline AnimatorID nullAnimator = 0u;
+
+  enum class AnimationLoop : uint8_t {
+    Once,
+    Loop,
+
+    // Plays to the last frame and back, then repeats. The first and last frames aren't shown twice in a row.
+    PingPong,
+  };
+
+  struct AnimationFrame {
+    // In texels of the sheet's texture.
+    SDL_FRect source{};
+    float duration = defaultFrameDuration;
+  };
+
+  struct AnimationClip {
+    std::string name;
+
+    // In the order they play. A ping-pong clip has its way back added at the end.
+    std::vector<AnimationFrame> frames;
+
+    // When each frame ends, from the start of the clip.
+    std::vector<float> ends{};
+    AnimationLoop loop = AnimationLoop::Loop;
+    float length = 0.0f;
+
+    // The frame showing at time, which has to be inside the clip.
+    [[nodiscard]] auto FrameAt(float time) const -> size_t;
+  };
+
+  /**
+    @brief The clips cut from one texture.
+
+    LoadJson() reads the JSON that Aseprite exports, in either its hash or array layout. TexturePacker writes the
+    same "frames" layout. Each frame tag becomes a clip, with forward, reverse and ping-pong directions, and a
+    sheet without tags becomes a single looping clip named "default".
+
+    The texture isn't loaded with the sheet. Load GetImagePath() with the renderer and hand it to SetTexture().
+   */
+  class SpriteSheet {
+  public:
+    // Returns nullClip if there are no frames.
+    auto AddClip(std::string_view name, std::span<const AnimationFrame> frames, AnimationLoop loop = AnimationLoop::Loop) -> ClipID;
+
+    auto LoadJson(std::string_view json) -> bool;
+
+    // The image path in the file is taken as relative to the file.
+    auto LoadJsonFile(const std::filesystem::path& path) -> bool;
+
+    [[nodiscard]] auto FindClip(std::string_view name) const -> ClipID;
+    [[nodiscard]] auto GetClip(ClipID clip) const -> const AnimationClip*;
+    [[nodiscard]] auto GetClipCount() const -> size_t { return _clips.size(); }
+
+    void SetTexture(const Texture texture) { _texture = texture; }
+    [[nodiscard]] constexpr auto GetTexture() const -> Texture { return _texture; }
+    [[nodiscard]] auto GetImagePath() const -> const std::filesystem::path& { return _imagePath; }
+
+    void Clear();
+
+  private:
+    std::vector<AnimationClip> _clips;
+    Texture _texture;
+    std::filesystem::path _imagePath;
+  };
+
+  /**
+    @brief Plays clips from one SpriteSheet on any number of sprites.
+
+    Animators are kept as a structure of arrays, so Update() advances every clock in one loop the compiler can
+    vectorize and only looks up a new frame for the few animators whose frame ran out. AppendTo() writes every
+    sprite into a SpriteBatch, which the renderer draws with one call.
+
+    IDs are generational like HandleID, so the ID of a removed animator doesn't refer to the next one added.
+    The sheet has to outlive the animators. Clearing or reloading it renumbers its clips, so an animator whose
+    clip no longer exists holds the frame it was showing and counts as finished until it plays another clip.
+   */
+  class Animators {
+  public:
+    explicit Animators(const SpriteSheet& sheet) : _sheet(&sheet) {}
+
+    // Start a new animator playing clip from its first frame. nullAnimator if clip doesn't exist.
+    auto Add(ClipID clip, const SDL_FRect& dest, float speed = 1.0f) -> AnimatorID;
+    auto Remove(AnimatorID animator) -> bool;
+
+    // Restart an animator on another clip.
+    auto Play(AnimatorID animator, ClipID clip) -> bool;
+
+    // A scale on the animator's clock. 0 pauses it, and it can't run backwards.
+    auto SetSpeed(AnimatorID animator, float speed) -> bool;
+    auto SetDest(AnimatorID animator, const SDL_FRect& dest) -> bool;
+
+    [[nodiscard]] auto IsValid(AnimatorID animator) const -> bool;
+
+    // True once a clip that doesn't loop has shown its last frame for its full duration.
+    [[nodiscard]] auto IsFinished(AnimatorID animator) const -> bool;
+
+    // The frame within the animator's clip, and where that frame is in the texture.
+    [[nodiscard]] auto GetFrame(AnimatorID animator) const -> size_t;
+    [[nodiscard]] auto GetSource(AnimatorID animator) const -> SDL_FRect;
+
+    [[nodiscard]] auto Size() const -> size_t { return _time.size(); }
+    void Reserve(size_t animators);
+    void Clear();
+
+    // Advance every animator by seconds.
+    void Update(float seconds);
+
+    // Add a sprite for every animator, in the order they were added unless some have been removed.
+    void AppendTo(SpriteBatch& batch, const SDL_FColor& color = whiteFColor) const;
+
+  private:
+    static constexpr uint32_t slotBits = 20u;
+    static constexpr uint32_t slotMask = (1u << slotBits) - 1u;
+
+    // The dense index of animator, or Size() if it isn't valid.
+    [[nodiscard]] auto Find(AnimatorID animator) const -> size_t;
+
+    // Find the frame showing at the animator's time, wrapping or finishing its clip as needed.
+    void Advance(size_t index);
+
+    const SpriteSheet* _sheet = nullptr;
+
+    // One entry per animator.
+    std::vector<float> _time;
+    std::vector<float> _speed;
+    std::vector<float> _frameEnd;
+    std::vector<ClipID> _clip;
+    std::vector<uint32_t> _frame;
+    std::vector<SDL_FRect> _source;
+    std::vector<SDL_FRect> _dest;
+    std::vector<uint32_t> _slotOf;
+
+    // One entry per ID slot.
+    std::vector<uint32_t> _denseOf;
+    std::vector<uint32_t> _generation;
+    std::vector<uint32_t> _freeSlots;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_ANIMATION_HPP_
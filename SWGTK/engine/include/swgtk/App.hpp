@@ -15,8 +15,14 @@
 
 #include <SDL3/SDL_video.h>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <swgtk/AudioMixer.hpp>
+#include <swgtk/FrameArena.hpp>
+#include <swgtk/MemoryTracker.hpp>
 #include <swgtk/Timer.hpp>
+#include <swgtk/Tween.hpp>
 #include <swgtk/Utility.hpp>
 #include <utility>
 #include "swgtk/Input.hpp"
@@ -26,6 +32,13 @@
 #include <emscripten.h>
 #endif
 
+#ifdef SWGTK_BUILD_WITH_LUA
+#include <swgtk/LuaBytecode.hpp>
+#include <swgtk/LuaGC.hpp>
+#include <swgtk/LuaProfiler.hpp>
+#include <swgtk/LuaScheduler.hpp>
+#endif
+
 #include "swgtk/FontGroup.hpp"
 #include "swgtk/Scene.hpp"
 
@@ -48,6 +61,8 @@ namespace swgtk {
     Camera = SDL_INIT_CAMERA,
   };
 
+  inline constexpr int32_t defaultIdleTimeout = 100;
+
   /**
     @brief This class is the root manager of the SWGTK framework.
 
@@ -56,7 +71,7 @@ namespace swgtk {
    */
   class App {
   public:
-    App() = default;
+    App();
     App(const App&) = delete;
     App(App&&) noexcept = delete;
     auto operator=(const App&) -> App& = delete;
@@ -110,13 +125,18 @@ namespace swgtk {
     void EventsAndTimeStep();
 
 #ifdef __EMSCRIPTEN__
-    void GameTick() const {
+    void GameTick() {
 #else
-    [[nodiscard]] auto GameTick() const -> bool {
+    [[nodiscard]] auto GameTick() -> bool {
 #endif
 
       [[maybe_unused]] const bool result = _currentScene->Update(_gameTimer.GetSeconds());
 
+#ifdef SWGTK_BUILD_WITH_LUA
+      // Collect in the idle time before presenting, which would otherwise be spent waiting on vsync.
+      StepLuaGC();
+#endif
+
       _renderer->BufferPresent();
 #ifndef __EMSCRIPTEN__
       return result;
@@ -138,13 +158,54 @@ namespace swgtk {
 
     [[nodiscard]] auto GetDefaultFont() const -> Font { return _fonts.GetDefaultFont(); }
     void AddFont(const std::filesystem::path& path) { _fonts.AddFont(path); }
-    [[nodiscard]] auto GetFont(const std::string& path) const -> Font { return _fonts.GetFont(path); }
+    auto AddFontFromMemory(const std::string_view name, const std::span<const std::byte> data) -> bool { return _fonts.AddFontFromMemory(name, data); }
+    [[nodiscard]] auto GetFont(const std::string_view name) const -> Font { return _fonts.GetFont(name); }
+    [[nodiscard]] auto GetFont(const std::string_view name, const float size, const FontStyle style = FontStyle::Normal) -> Font { return _fonts.GetFont(name, size, style); }
     static void SetFontStyle(const Font font, const FontStyle style) { FontGroup::SetFontStyle(font, style); }
     [[nodiscard]] static auto GetFontStyle(const Font font) -> FontStyle { return FontGroup::GetFontStyle(font); }
 
     [[nodiscard]] auto GetFontHandle() -> FontGroup* { return &_fonts; }
     [[nodiscard]] auto GetInternalClock() -> Timer* { return &_gameTimer; }
 
+    // Scratch memory for the current frame. It is reset at the start of EventsAndTimeStep().
+    [[nodiscard]] auto GetFrameArena() -> FrameArena* { return &_frameArena; }
+
+    // Plays on the default device when SystemInit::Audio is passed to InitGraphics().
+    [[nodiscard]] auto GetAudio() -> AudioMixer* { return &_audio; }
+
+    // Advanced with the frame time at the end of EventsAndTimeStep(), before the scene updates.
+    [[nodiscard]] auto GetTweens() -> Tweens* { return &_tweens; }
+
+    /**
+     * @brief How long to wait for an event while the renderer is idle, e.g. with SDLHW2D dirty rendering and
+     * nothing changed. The scene still updates at least this often, so timers and clocks keep ticking, with the
+     * whole wait showing up in that frame's time step.
+     *
+     * @param milliseconds
+     */
+    void SetIdleTimeout(const int32_t milliseconds) { _idleTimeout = milliseconds; }
+    [[nodiscard]] constexpr auto GetIdleTimeout() const -> int32_t { return _idleTimeout; }
+
+#ifdef SWGTK_BUILD_WITH_LUA
+    // Schedules garbage collection for the state passed to InitLua().
+    [[nodiscard]] auto GetLuaGC() -> LuaGC* { return &_luaGC; }
+
+    // Resumes the coroutines started with swgtk.spawn() once per frame.
+    [[nodiscard]] auto GetLuaScheduler() -> LuaScheduler* { return &_luaTasks; }
+
+    // Samples script stacks while started. Off by default.
+    [[nodiscard]] auto GetLuaProfiler() -> LuaProfiler* { return &_luaProfiler; }
+
+    // Bytecode in the directory swgtk_precompile_lua() fills, see LuaCacheDirectory(). InitLua() loads swgtk.lua through it.
+    [[nodiscard]] auto GetLuaCache() -> LuaBytecodeCache*;
+
+    // Run this frame's garbage collection slice. GameTick() does this, so it is only needed for loops driven from Lua.
+    void StepLuaGC() {
+      _luaGC.Step(_gameTimer.GetElapsedMilliseconds());
+      _luaGCStepped = true;
+    }
+#endif
+
     [[nodiscard]] auto Renderer(this auto&& self) -> std::weak_ptr<RenderingDevice> { return self._renderer; }
     [[nodiscard]] constexpr auto Window(this auto&& self) -> SDL_Window* { return self._window; }
 
@@ -225,7 +286,19 @@ namespace swgtk {
     InputSystem _input;
     FontGroup _fonts;
     Timer _gameTimer;
+    FrameArena _frameArena{defaultFrameArenaSize, EngineMemoryResource()};
+    AudioMixer _audio;
+    Tweens _tweens;
+
+#ifdef SWGTK_BUILD_WITH_LUA
+    LuaGC _luaGC;
+    LuaScheduler _luaTasks;
+    LuaProfiler _luaProfiler;
+    std::optional<LuaBytecodeCache> _luaCache; // Made on first use, so finding the directory doesn't call SDL before the App is set up.
+    bool _luaGCStepped = false;
+#endif
 
+    int32_t _idleTimeout = defaultIdleTimeout;
     bool _running = true;
   };
 } // namespace swgtk
@@ -0,0 +1,230 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_AUDIOMIXER_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_AUDIOMIXER_HPP_
+
+#include <SDL3/SDL_audio.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <swgtk/SpscQueue.hpp>
+
+namespace swgtk {
+
+  constexpr inline auto defaultSampleRate = 48000;
+  constexpr inline auto defaultMaxVoices = 128uz;
+
+  // The mixer always runs in interleaved stereo float.
+  constexpr inline auto audioChannels = 2uz;
+
+  // Commands and finished voices that can be in flight between the game thread and the audio thread.
+  constexpr inline auto audioQueueCapacity = 1024uz;
+
+  // The most frames the device callback mixes in one pass.
+  constexpr inline auto audioBlockFrames = 1024uz;
+
+  class MusicStream;
+
+  using VoiceID = uint32_t;
+  constexpr inline VoiceID nullVoice = 0u;
+
+  /**
+      @brief Decoded audio, interleaved stereo floats at the sample rate of the mixer that plays it.
+
+      Sounds are shared between voices and never change once made, so the audio thread can read one while
+      the game thread starts more voices of it.
+   */
+  class Sound {
+  public:
+    Sound() = default;
+    explicit Sound(std::vector<float>&& samples) : _samples(std::move(samples)) {}
+
+    // Load a .wav file and convert it for a mixer running at sampleRate. nullptr on failure.
+    [[nodiscard]] static auto LoadWav(const std::filesystem::path& path, int sampleRate = defaultSampleRate) -> std::shared_ptr<const Sound>;
+
+    // Convert audio in any format SDL understands. nullptr on failure.
+    [[nodiscard]] static auto Convert(const SDL_AudioSpec& spec, std::span<const std::byte> data, int sampleRate = defaultSampleRate) -> std::shared_ptr<const Sound>;
+
+    [[nodiscard]] constexpr auto GetSamples() const -> std::span<const float> { return _samples; }
+    [[nodiscard]] constexpr auto GetFrameCount() const -> size_t { return _samples.size() / audioChannels; }
+
+  private:
+    std::vector<float> _samples;
+  };
+
+  struct VoiceParams {
+    float gain = 1.0f;
+
+    // -1 is all left, 1 is all right. The centre plays both channels at full gain.
+    float pan = 0.0f;
+    bool loop = false;
+  };
+
+  /**
+      @brief Mixes playing sounds into an SDL_AudioStream from SDL's audio thread.
+
+      Everything but Mix() is called from the game thread, which only sends commands through a lock-free
+      queue; the audio thread applies them at the start of its next mix. Neither side takes a lock or
+      allocates while audio is playing. Gain and balance changes, and stops, are ramped over one mix to
+      avoid clicks.
+
+      The game thread keeps each playing sound alive until the audio thread reports that its voice has
+      finished. Update() collects those reports once a frame, which the App does when audio is initialized.
+
+      Voices are mixed with the SIMD level from GetSimdLevel() at the time the mixer was made.
+   */
+  class AudioMixer {
+  public:
+    explicit AudioMixer(int sampleRate = defaultSampleRate, size_t maxVoices = defaultMaxVoices);
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer(AudioMixer&&) = delete;
+    auto operator=(const AudioMixer&) -> AudioMixer& = delete;
+    auto operator=(AudioMixer&&) -> AudioMixer& = delete;
+    ~AudioMixer() { Close(); }
+
+    // Start mixing into a playback device. The audio subsystem has to be initialized.
+    auto Open(SDL_AudioDeviceID device = SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK) -> bool;
+
+    // Stop the device and drop every voice.
+    void Close();
+
+    [[nodiscard]] constexpr auto IsOpen() const -> bool { return _stream != nullptr; }
+    [[nodiscard]] constexpr auto GetSampleRate() const -> int { return _sampleRate; }
+
+    // Load a .wav file converted for this mixer.
+    [[nodiscard]] auto LoadSound(const std::filesystem::path& path) const -> std::shared_ptr<const Sound> { return Sound::LoadWav(path, _sampleRate); }
+
+    // Open a .wav or .ogg file to stream at this mixer's sample rate. nullptr on failure.
+    [[nodiscard]] auto OpenMusic(const std::filesystem::path& path, bool loop = false) const -> std::shared_ptr<MusicStream>;
+
+    /**
+     * @brief Start a voice playing sound.
+     *
+     * @return The voice, or nullVoice if every voice is in use or the command queue is full.
+     */
+    auto Play(std::shared_ptr<const Sound> sound, VoiceParams params = {}) -> VoiceID;
+
+    /**
+     * @brief Start a voice playing an open music stream. VoiceParams::loop is ignored; streams loop in the decoder.
+     *
+     * @return The voice, or nullVoice if the stream is closed, at another sample rate, already playing,
+     * or every voice is in use.
+     */
+    auto Play(std::shared_ptr<MusicStream> stream, VoiceParams params = {}) -> VoiceID;
+
+    // These return false if the voice has already finished or the command queue is full.
+    auto Stop(VoiceID voice) -> bool;
+    auto SetGain(VoiceID voice, float gain) -> bool;
+    auto SetPan(VoiceID voice, float pan) -> bool;
+
+    auto StopAll() -> bool;
+    auto SetMasterGain(float gain) -> bool;
+
+    // True until Update() has seen the voice finish.
+    [[nodiscard]] auto IsPlaying(const VoiceID voice) const -> bool { return _playing.contains(voice); }
+    [[nodiscard]] auto GetPlayingCount() const -> size_t { return _playing.size(); }
+
+    // Release the sounds and streams of voices the audio thread has finished with.
+    void Update();
+
+    /**
+     * @brief Mix the next frames into out, interleaved stereo.
+     *
+     * The device's callback calls this on the audio thread. Call it yourself only while the mixer is not open,
+     * to render audio without a device, and only from one thread at a time.
+     */
+    void Mix(std::span<float> out);
+
+  private:
+    enum class CommandType : uint8_t {
+      Play,
+      Stop,
+      SetGain,
+      SetPan,
+      StopAll,
+      SetMasterGain,
+    };
+
+    struct Command {
+      CommandType type = CommandType::Play;
+      bool loop = false;
+      VoiceID voice = nullVoice;
+      const Sound* sound = nullptr;
+      MusicStream* stream = nullptr;
+      float gain = 1.0f;
+      float pan = 0.0f;
+    };
+
+    // Only touched by the audio thread.
+    struct Voice {
+      VoiceID id = nullVoice;
+
+      // A voice plays either a sound or a stream.
+      const Sound* sound = nullptr;
+      MusicStream* stream = nullptr;
+      size_t frame = 0;
+      bool loop = false;
+
+      float gain = 1.0f;
+      float pan = 0.0f;
+
+      // The channel gains mixed last, ramped toward gain and pan over the next mix when they change.
+      float left = 1.0f;
+      float right = 1.0f;
+
+      bool stopping = false;
+      bool done = false;
+    };
+
+    // What the game thread keeps alive for a playing voice.
+    struct VoiceSource {
+      std::shared_ptr<const Sound> sound = nullptr;
+      std::shared_ptr<MusicStream> stream = nullptr;
+    };
+
+    static void SDLCALL StreamCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount);
+
+    auto Start(const Command& command, VoiceSource&& source) -> VoiceID;
+    auto Send(const Command& command) -> bool;
+    void ApplyCommands();
+    void MixVoice(Voice& voice, std::span<float> out);
+    [[nodiscard]] auto FindVoice(VoiceID voice) -> Voice*;
+
+    int _sampleRate = defaultSampleRate;
+    size_t _maxVoices = defaultMaxVoices;
+    SDL_AudioStream* _stream = nullptr;
+
+    // Game thread.
+    VoiceID _nextVoice = nullVoice;
+    std::unordered_map<VoiceID, VoiceSource> _playing;
+
+    SpscQueue<Command, audioQueueCapacity> _commands;
+    SpscQueue<VoiceID, audioQueueCapacity> _finished;
+
+    // Audio thread.
+    std::vector<Voice> _voices;
+    std::vector<float> _block;
+    std::vector<float> _streamBlock;
+    float _masterGain = 1.0f;
+    void (*_mixRow)(float* out, const float* in, size_t count, float left, float right) = nullptr;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_AUDIOMIXER_HPP_
@@ -0,0 +1,55 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_DIRTYREGION_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_DIRTYREGION_HPP_
+
+#include <SDL3/SDL_rect.h>
+#include <cstddef>
+
+namespace swgtk {
+
+  /**
+    @brief The part of the screen that changed since it was last redrawn, kept as the union of every rect marked.
+
+    One rect keeps the redraw to a single clip rect and a single pass over the scene. Changes far apart, like a
+    blinking cursor in one corner and a clock in the other, redraw everything between them.
+   */
+  class DirtyRegion {
+  public:
+    // Rects with no area are ignored.
+    void Add(const SDL_Rect& rect);
+    void AddAll() { _all = true; }
+
+    void Clear() {
+      _bounds = SDL_Rect{};
+      _count = 0uz;
+      _all = false;
+    }
+
+    [[nodiscard]] constexpr auto IsEmpty() const -> bool { return !_all && _count == 0uz; }
+
+    // Rects marked since the last Clear(), to see how much a frame changed.
+    [[nodiscard]] constexpr auto GetCount() const -> size_t { return _count; }
+
+    // The region inside output. Empty if nothing marked touches it.
+    [[nodiscard]] auto GetBounds(const SDL_Rect& output) const -> SDL_Rect;
+
+  private:
+    SDL_Rect _bounds{};
+    size_t _count = 0;
+    bool _all = false;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_DIRTYREGION_HPP_
@@ -13,12 +13,18 @@
 #ifndef SWGTK_ENGINE_INCLUDE_SWGTK_TTFFONT_HPP_
 #define SWGTK_ENGINE_INCLUDE_SWGTK_TTFFONT_HPP_
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
-#include <map>
+#include <functional>
+#include <list>
 #include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "SDL3_ttf/SDL_ttf.h"
 
@@ -55,22 +61,52 @@ namespace swgtk {
     TTF_Font* ptr = nullptr;
   };
 
+  // How many sized copies of fonts FontGroup keeps open before closing the least recently used one.
+  constexpr inline auto defaultFontVariantLimit = 32uz;
+
   /**
       @brief This is the primary container class for SDL_ttf fonts.
+
+      Every font added is kept open at the default size. GetFont() with a size and style returns a
+      separate copy of the font for that combination, created on first use. Mixing sizes this way
+      keeps each copy's glyph cache warm, where resizing one shared font with SetFontSize() throws
+      the cache away on every change.
+
+      The copies are capped by SetVariantLimit() and the least recently used one is closed first, so
+      a Font returned for a size is only valid until that many other sizes have been asked for. Look
+      it up again each frame rather than holding on to it, and don't change its style.
    */
   class FontGroup {
   public:
+    FontGroup() = default;
+    FontGroup(const FontGroup&) = delete;
+    FontGroup(FontGroup&&) = delete;
+    auto operator=(const FontGroup&) -> FontGroup& = delete;
+    auto operator=(FontGroup&&) -> FontGroup& = delete;
+    ~FontGroup() = default;
+
+    // Opens the default font from the copy compiled into the library, replacing it if it is already open.
     auto LoadDefaultFont() -> bool;
 
-    // Load font from a .ttf file.
+    // Load font from a .ttf file. It is named after the file without its extension.
     auto AddFont(const std::filesystem::path& filename) -> bool;
 
+    /**
+     * @brief Load a font from a .ttf image in memory under name.
+     *
+     * SDL_ttf reads glyphs from the data as they are needed, so it has to outlive the font. Pass the
+     * data in a vector instead to have the group keep it until ClearFonts().
+     */
+    auto AddFontFromMemory(std::string_view name, std::span<const std::byte> data) -> bool;
+    auto AddFontFromMemory(std::string_view name, std::vector<std::byte>&& data) -> bool;
+
+    // The default font's .ttf file as it was compiled in.
+    [[nodiscard]] static auto GetDefaultFontData() -> std::span<const std::byte>;
+
     // Used internally, do not call.
-    void ClearFonts() const;
+    void ClearFonts();
 
-    [[nodiscard]] auto GetDefaultFont() const -> Font {
-      return _ttfFonts.at(SWGTK_DEFAULT_FONT_ID);
-    }
+    [[nodiscard]] auto GetDefaultFont() const -> Font { return GetFont(SWGTK_DEFAULT_FONT_ID); }
 
     static void SetFontStyle(const Font font, const FontStyle style) {
       TTF_SetFontStyle(font.ptr, std::to_underlying(style));
@@ -78,32 +114,81 @@ namespace swgtk {
 
     [[nodiscard]] static auto GetFontStyle(const Font font) -> FontStyle { return FontStyle{TTF_GetFontStyle(font.ptr)}; }
 
-    [[nodiscard]] auto SetFontSize(const std::string& name, const float size) const -> bool {
-      if (_ttfFonts.contains(name)) {
-        return TTF_SetFontSize(_ttfFonts.at(name).ptr, size);
+    // Resizes the shared font. Prefer GetFont() with a size when more than one size is drawn per frame.
+    [[nodiscard]] auto SetFontSize(const std::string_view name, const float size) const -> bool {
+      if (const auto face = _faces.find(name); face != _faces.end()) {
+        return TTF_SetFontSize(face->second, size);
       }
 
       return false;
     }
 
     void SetAllFontSizes(const float size) const {
-      for (const auto [ptr]: _ttfFonts | std::views::values) {
+      for (auto* ptr: _faces | std::views::values) {
         TTF_SetFontSize(ptr, size);
       }
     }
 
     constexpr void SetDefaultFontSize(const float size) { _defaultFontSize = size; }
 
-    [[nodiscard]] auto GetFont(const std::string& name) const -> Font {
-      if (_ttfFonts.contains(name)) {
-        return _ttfFonts.at(name);
+    [[nodiscard]] auto GetFont(const std::string_view name) const -> Font {
+      if (const auto face = _faces.find(name); face != _faces.end()) {
+        return Font{.ptr = face->second};
       }
 
       return Font{};
     }
 
+    // The named font at a size and style, opened the first time the combination is asked for.
+    [[nodiscard]] auto GetFont(std::string_view name, float size, FontStyle style = FontStyle::Normal) -> Font;
+
+    // Closes the least recently used copies until no more than limit are open. A limit of 0 is treated as 1.
+    void SetVariantLimit(size_t limit);
+
+    [[nodiscard]] constexpr auto GetVariantLimit() const -> size_t { return _variantLimit; }
+    [[nodiscard]] auto GetVariantCount() const -> size_t { return _variants.size(); }
+
   private:
-    std::map<std::string, Font> _ttfFonts;
+    struct StringHash {
+      using is_transparent = void;
+
+      [[nodiscard]] auto operator()(const std::string_view value) const noexcept -> size_t { return std::hash<std::string_view>{}(value); }
+    };
+
+    // The name views point into the keys of _faces, which stay put until ClearFonts().
+    struct VariantKey {
+      std::string_view name;
+      float size = 0.0f;
+      FontStyle style = FontStyle::Normal;
+
+      [[nodiscard]] auto operator==(const VariantKey&) const -> bool = default;
+    };
+
+    struct VariantHash {
+      [[nodiscard]] auto operator()(const VariantKey& key) const noexcept -> size_t {
+        const auto hash = (std::hash<std::string_view>{}(key.name) * 31uz) + std::hash<float>{}(key.size);
+        return (hash * 31uz) + std::to_underlying(key.style);
+      }
+    };
+
+    struct Variant {
+      VariantKey key;
+      TTF_Font* ptr = nullptr;
+    };
+
+    void EvictVariants(size_t limit);
+    void DropVariants(std::string_view name);
+
+    std::unordered_map<std::string, TTF_Font*, StringHash, std::equal_to<>> _faces;
+
+    // Font data handed over to AddFontFromMemory(). Moving a vector keeps its buffer where it is.
+    std::vector<std::vector<std::byte>> _fontData;
+
+    // Most recently used at the front.
+    std::list<Variant> _variants;
+    std::unordered_map<VariantKey, std::list<Variant>::iterator, VariantHash> _variantLookup;
+    size_t _variantLimit = defaultFontVariantLimit;
+
     float _defaultFontSize = defaultFontSize;
   };
 } // namespace swgtk
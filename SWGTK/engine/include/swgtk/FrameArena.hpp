@@ -0,0 +1,109 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_FRAMEARENA_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_FRAMEARENA_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace swgtk {
+
+  constexpr inline size_t defaultFrameArenaSize = 64uz * 1024uz;
+
+  /**
+   * @brief A linear allocator for data that only lives until the end of the current frame.
+   *
+   * Allocations bump a pointer through a block of memory and are never freed individually. Reset() rewinds
+   * the arena, and if the previous frames needed more than one block they are merged into a single block
+   * big enough for the high-water mark, so a steady-state frame does not touch the upstream allocator.
+   *
+   * FrameArena is a std::pmr::memory_resource, so it can back pmr containers directly:
+   *
+   *    std::pmr::string text{app->GetFrameArena()};
+   *
+   * It is not thread-safe. Each worker thread should own its own arena.
+   */
+  class FrameArena : public std::pmr::memory_resource {
+  public:
+    explicit FrameArena(size_t initialSize = defaultFrameArenaSize, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+    FrameArena(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) noexcept = delete;
+    auto operator=(const FrameArena&) -> FrameArena& = delete;
+    auto operator=(FrameArena&&) noexcept -> FrameArena& = delete;
+    ~FrameArena() override;
+
+    /**
+     * @brief Allocate a value-initialized array of objects that lives until the next Reset().
+     *
+     * Destructors are never run, so only trivially destructible types are allowed.
+     *
+     * @return The new objects, or an empty span if count is zero.
+     */
+    template<typename T>
+      requires std::is_trivially_destructible_v<T>
+    [[nodiscard]] auto Allocate(const size_t count) -> std::span<T> {
+      if (count == 0uz || count > (static_cast<size_t>(-1) / sizeof(T))) {
+        return {};
+      }
+
+      auto* memory = static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+      std::uninitialized_value_construct_n(memory, count);
+
+      return std::span<T>{memory, count};
+    }
+
+    // Rewind the arena. Everything allocated since the last reset becomes invalid.
+    void Reset();
+
+    // Bytes handed out since the last reset, including alignment padding.
+    [[nodiscard]] constexpr auto GetUsedBytes() const -> size_t { return _usedBytes; }
+
+    // The most bytes used in any single frame since the arena was created.
+    [[nodiscard]] constexpr auto GetHighWaterMark() const -> size_t { return _highWaterMark; }
+
+    // Total size of the blocks currently owned by the arena.
+    [[nodiscard]] auto GetCapacity() const -> size_t;
+
+    // Number of times the arena had to ask the upstream resource for a new block.
+    [[nodiscard]] constexpr auto GetBlockAllocations() const -> size_t { return _blockAllocations; }
+
+  protected:
+    auto do_allocate(size_t bytes, size_t alignment) -> void* override;
+    void do_deallocate([[maybe_unused]] void* ptr, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment) override {}
+    [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override { return this == &other; }
+
+  private:
+    struct Block {
+      std::byte* data = nullptr;
+      size_t size = 0uz;
+    };
+
+    void AddBlock(size_t minimumSize);
+    void ReleaseBlocks();
+
+    std::pmr::memory_resource* _upstream = nullptr;
+    std::vector<Block> _blocks;
+    size_t _currentBlock = 0uz;
+    size_t _offset = 0uz;
+    size_t _usedBytes = 0uz;
+    size_t _highWaterMark = 0uz;
+    size_t _blockAllocations = 0uz;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_FRAMEARENA_HPP_
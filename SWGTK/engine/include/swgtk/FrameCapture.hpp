@@ -0,0 +1,140 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_FRAMECAPTURE_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_FRAMECAPTURE_HPP_
+
+#include <SDL3/SDL_surface.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace swgtk {
+
+  enum class CaptureFormat : uint8_t {
+    Png, // One numbered .png per frame, in a directory.
+    Y4m, // Uncompressed 4:2:0 YUV4MPEG2 video in one file, which ffmpeg and most players read.
+  };
+
+  constexpr inline auto defaultCaptureQueueDepth = 4uz;
+
+  struct FrameCaptureStats {
+    uint64_t captured = 0u; // Frames read back and queued.
+    uint64_t written = 0u;  // Frames the worker wrote to disk, screenshots included.
+    uint64_t dropped = 0u;  // Frames due while the queue was full, so never read back.
+    uint64_t failed = 0u;   // Frames the worker couldn't write.
+  };
+
+  /**
+      @brief Records presented frames, and takes screenshots, with the encoding and disk writes on a worker thread.
+
+      The renderer asks IsFrameDue() once per presented frame and, if it is, reads the frame back and passes it
+      to Submit(). Reading back still waits for the GPU, so recording every Nth frame keeps the cost to those
+      frames. A frame due while the queue is full is dropped before it's read back and counted in the stats;
+      the queue never grows past its depth, so a slow disk can't eat memory.
+
+      The worker converts into buffers it keeps between frames. Recording to Y4M takes the frame size from
+      the first frame; frames of another size after that fail, since the format can't change size.
+   */
+  class FrameCapture {
+  public:
+    FrameCapture() = default;
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture(FrameCapture&&) = delete;
+    auto operator=(const FrameCapture&) -> FrameCapture& = delete;
+    auto operator=(FrameCapture&&) -> FrameCapture& = delete;
+    ~FrameCapture();
+
+    /**
+     * @brief Start recording, stopping any recording already running first.
+     *
+     * @param path The directory for Png frames, created if needed, or the file for Y4m.
+     * @param format
+     * @param every Record one frame in every this many presented.
+     * @param fps The frame rate written in a Y4m header.
+     * @return false if the file or directory couldn't be created.
+     */
+    auto Start(const std::filesystem::path& path, CaptureFormat format, uint32_t every = 1u, int fps = 60) -> bool;
+
+    // Stop recording. Waits for queued frames and screenshots to be written.
+    void Stop();
+
+    // Write the next presented frame to a .png, whether recording or not.
+    void Screenshot(const std::filesystem::path& path);
+
+    // How many frames may wait for the worker. At least one.
+    void SetQueueDepth(size_t frames);
+
+    [[nodiscard]] auto IsRecording() const -> bool;
+    [[nodiscard]] auto GetStats() const -> FrameCaptureStats;
+
+    // For the renderer. Call once per presented frame; true if this one should be read back and submitted.
+    [[nodiscard]] auto IsFrameDue() -> bool;
+
+    // For the renderer. Takes ownership of the frame read back after IsFrameDue() returned true.
+    void Submit(SDL_Surface* frame);
+
+  private:
+    struct Job {
+      SDL_Surface* frame = nullptr;
+      std::filesystem::path path;
+      bool video = false;
+    };
+
+    void Work(const std::stop_token& stop);
+    void WaitUntilDrained(std::unique_lock<std::mutex>& lock);
+
+    // Worker only.
+    auto WritePng(SDL_Surface* frame, const std::filesystem::path& path) -> bool;
+    auto WriteVideoFrame(SDL_Surface* frame) -> bool;
+    auto ConvertToRgba(SDL_Surface* frame) -> bool;
+
+    mutable std::mutex _mutex;
+    std::condition_variable_any _wake;
+    std::condition_variable _drained;
+    std::deque<Job> _jobs;
+    std::deque<std::filesystem::path> _screenshots;
+    FrameCaptureStats _stats{};
+    size_t _queueDepth = defaultCaptureQueueDepth;
+    bool _busy = false;
+
+    // Main thread only, apart from the Y4M stream, which the worker owns while recording.
+    std::filesystem::path _path;
+    CaptureFormat _format = CaptureFormat::Png;
+    uint32_t _every = 1u;
+    uint64_t _frame = 0u;
+    bool _recording = false;
+    bool _recordDue = false;
+    bool _screenshotDue = false;
+
+    // Worker only. Reused from frame to frame.
+    std::ofstream _video;
+    int _fps = 60;
+    int _videoWidth = 0;
+    int _videoHeight = 0;
+    SDL_Surface* _rgba = nullptr;
+    std::vector<uint8_t> _planes;
+
+    // Last, so it stops before anything it uses is destroyed.
+    std::jthread _worker;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_FRAMECAPTURE_HPP_
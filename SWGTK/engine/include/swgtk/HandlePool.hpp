@@ -0,0 +1,287 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_HANDLEPOOL_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_HANDLEPOOL_HPP_
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <swgtk/Utility.hpp>
+
+namespace swgtk {
+
+  /**
+   * @brief A 32-bit generational handle.
+   *
+   * The low bits index a slot in a HandlePool and the high bits store the slot's generation, so a handle
+   * to a destroyed resource stays invalid even after its slot is reused. Zero is never handed out and
+   * acts as the null handle.
+   */
+  using HandleID = uint32_t;
+
+  inline constexpr HandleID nullHandle = 0u;
+
+  /**
+   * @brief Owns a set of resources and hands out generational handles to them.
+   *
+   * Resource pointers are kept in a dense array so iterating or clearing the pool touches contiguous
+   * memory. Destruction is explicit: either immediately with Destroy() or at a safe point later with
+   * DestroyDeferred() followed by FlushDeferred().
+   *
+   * The pool is not thread-safe, like the rest of the engine it expects to be used from the main thread.
+   *
+   * @tparam Resource The type being managed, typically an opaque SDL type.
+   * @tparam Deleter A function called with the resource pointer when it is destroyed.
+   */
+  template<typename Resource, auto Deleter>
+    requires std::invocable<decltype(Deleter), Resource*>
+  class HandlePool {
+  public:
+    static constexpr uint32_t indexBits = 20u;
+    static constexpr uint32_t indexMask = (1u << indexBits) - 1u;
+    static constexpr uint32_t maxGeneration = std::numeric_limits<HandleID>::max() >> indexBits;
+    static constexpr size_t maxResources = indexMask + 1u;
+
+    HandlePool() = default;
+    HandlePool(const HandlePool&) = delete;
+    HandlePool(HandlePool&&) noexcept = default;
+    auto operator=(const HandlePool&) -> HandlePool& = delete;
+    auto operator=(HandlePool&& other) noexcept -> HandlePool& {
+      if (this != &other) {
+        Clear();
+
+        _dense = std::move(other._dense);
+        _denseToSlot = std::move(other._denseToSlot);
+        _slots = std::move(other._slots);
+        _freeSlots = std::move(other._freeSlots);
+        _pending = std::move(other._pending);
+      }
+
+      return *this;
+    }
+    ~HandlePool() { Clear(); }
+
+    /**
+     * @brief Take ownership of a resource.
+     *
+     * @return A handle to the resource, or nullHandle if the resource is null or the pool is full.
+     */
+    [[nodiscard]] auto Insert(Resource* resource) -> HandleID {
+      if (resource == nullptr) {
+        return nullHandle;
+      }
+
+      uint32_t index{};
+
+      if (!_freeSlots.empty()) {
+        index = _freeSlots.back();
+        _freeSlots.pop_back();
+      } else if (_slots.size() < maxResources) {
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+      } else {
+        DEBUG_PRINT("Handle pool is full, {} resources are already alive.\n", _dense.size())
+        Deleter(resource);
+        return nullHandle;
+      }
+
+      auto& slot = _slots[index];
+      slot.dense = static_cast<uint32_t>(_dense.size());
+
+      _dense.push_back(resource);
+      _denseToSlot.push_back(index);
+
+      return MakeID(index, slot.generation);
+    }
+
+    [[nodiscard]] auto Get(const HandleID id) const -> Resource* {
+      if (const auto* slot = Find(id); slot != nullptr) {
+        return _dense[slot->dense];
+      }
+
+      return nullptr;
+    }
+
+    [[nodiscard]] auto IsValid(const HandleID id) const -> bool { return Find(id) != nullptr; }
+
+    // Destroy the resource now. Returns false if the handle was already stale.
+    auto Destroy(const HandleID id) -> bool {
+      const auto* slot = Find(id);
+
+      if (slot == nullptr) {
+        return false;
+      }
+
+      const auto denseIndex = slot->dense;
+      const auto lastIndex = static_cast<uint32_t>(_dense.size() - 1u);
+
+      Deleter(_dense[denseIndex]);
+
+      if (denseIndex != lastIndex) {
+        _dense[denseIndex] = _dense[lastIndex];
+        _denseToSlot[denseIndex] = _denseToSlot[lastIndex];
+        _slots[_denseToSlot[denseIndex]].dense = denseIndex;
+      }
+
+      _dense.pop_back();
+      _denseToSlot.pop_back();
+      Release(IndexOf(id));
+
+      return true;
+    }
+
+    // Queue the resource for destruction at the next call to FlushDeferred().
+    void DestroyDeferred(const HandleID id) {
+      if (IsValid(id)) {
+        _pending.push_back(id);
+      }
+    }
+
+    void FlushDeferred() {
+      for (const auto id: _pending) {
+        Destroy(id);
+      }
+
+      _pending.clear();
+    }
+
+    // Destroy every resource the predicate accepts. Returns how many were destroyed.
+    template<std::predicate<Resource*> Predicate>
+    auto DestroyIf(Predicate predicate) -> size_t {
+      size_t count = 0;
+
+      // Walk backwards so the resource Destroy() swaps into place has already been visited.
+      for (auto i = _dense.size(); i-- > 0u;) {
+        if (predicate(_dense[i])) {
+          const auto index = _denseToSlot[i];
+
+          Destroy(MakeID(index, _slots[index].generation));
+          ++count;
+        }
+      }
+
+      return count;
+    }
+
+    // Destroy every resource in the pool. All outstanding handles become invalid.
+    void Clear() {
+      for (auto* resource: _dense) {
+        Deleter(resource);
+      }
+
+      for (const auto index: _denseToSlot) {
+        Release(index);
+      }
+
+      _dense.clear();
+      _denseToSlot.clear();
+      _pending.clear();
+    }
+
+    [[nodiscard]] constexpr auto Size() const -> size_t { return _dense.size(); }
+    [[nodiscard]] constexpr auto PendingCount() const -> size_t { return _pending.size(); }
+    [[nodiscard]] constexpr auto Resources() const -> std::span<Resource* const> { return _dense; }
+
+  private:
+    static constexpr uint32_t deadSlot = std::numeric_limits<uint32_t>::max();
+
+    struct Slot {
+      uint32_t dense = deadSlot;
+      uint32_t generation = 1u;
+    };
+
+    [[nodiscard]] static constexpr auto MakeID(const uint32_t index, const uint32_t generation) -> HandleID { return (generation << indexBits) | index; }
+    [[nodiscard]] static constexpr auto IndexOf(const HandleID id) -> uint32_t { return id & indexMask; }
+    [[nodiscard]] static constexpr auto GenerationOf(const HandleID id) -> uint32_t { return id >> indexBits; }
+
+    [[nodiscard]] auto Find(const HandleID id) const -> const Slot* {
+      const auto index = IndexOf(id);
+
+      if (id == nullHandle || index >= _slots.size()) {
+        return nullptr;
+      }
+
+      const auto& slot = _slots[index];
+      return (slot.dense != deadSlot && slot.generation == GenerationOf(id)) ? &slot : nullptr;
+    }
+
+    // A slot whose generation is used up is retired rather than wrapped, so an old handle can never match again.
+    void Release(const uint32_t index) {
+      auto& slot = _slots[index];
+
+      slot.dense = deadSlot;
+
+      if (slot.generation == maxGeneration) {
+        return;
+      }
+
+      ++slot.generation;
+      _freeSlots.push_back(index);
+    }
+
+    std::vector<Resource*> _dense;
+    std::vector<uint32_t> _denseToSlot;
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _freeSlots;
+    std::vector<HandleID> _pending;
+  };
+
+  /**
+   * @brief Owns the resource behind a handle and destroys it when it goes out of scope.
+   *
+   * Handles themselves never own anything. UniqueHandle is for code that wants the resource tied to a
+   * scope or an object instead, and for Lua, where the garbage collector destroys it. It is still a
+   * Handle, so it can be passed wherever one is expected; the copies made that way don't keep the
+   * resource alive.
+   *
+   * @tparam Handle A handle type with a Destroy() member, such as Texture or Surface.
+   */
+  template<typename Handle>
+  class UniqueHandle : public Handle {
+  public:
+    constexpr UniqueHandle() = default;
+    explicit UniqueHandle(const Handle handle) :
+        Handle(handle) {}
+
+    UniqueHandle(const UniqueHandle&) = delete;
+    UniqueHandle(UniqueHandle&& other) noexcept :
+        Handle(other.Release()) {}
+    auto operator=(const UniqueHandle&) -> UniqueHandle& = delete;
+    auto operator=(UniqueHandle&& other) noexcept -> UniqueHandle& {
+      if (this != &other) {
+        Reset(other.Release());
+      }
+
+      return *this;
+    }
+
+    ~UniqueHandle() { Handle::Destroy(); }
+
+    // Give up ownership without destroying the resource.
+    [[nodiscard]] auto Release() -> Handle { return std::exchange(static_cast<Handle&>(*this), Handle{}); }
+
+    // Destroy the resource now, and own another one instead.
+    void Reset(const Handle handle = Handle{}) {
+      Handle::Destroy();
+      static_cast<Handle&>(*this) = handle;
+    }
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_HANDLEPOOL_HPP_
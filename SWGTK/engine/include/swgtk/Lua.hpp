@@ -1,12 +1,22 @@
 #ifndef SWGTK_INCLUDE_SWGTK_LUA_HPP
 #define SWGTK_INCLUDE_SWGTK_LUA_HPP
 
+#include <filesystem>
 #include <sol/sol.hpp>
 #include <swgtk/Utility.hpp>
 
 namespace swgtk {
   class App;
   void InitLua(App* app, sol::state& lua, LuaPrivledges priv = LuaPrivledges::None);
+
+  /**
+   * @brief Where to keep the Lua bytecode cache, found at runtime so a build can be moved or installed.
+   *
+   * The SWGTK_LUA_CACHE_DIR environment variable overrides it. Otherwise it's the luac directory next to the
+   * executable, where swgtk_precompile_lua() or an installer puts it. The directory is never created at runtime,
+   * so without one scripts simply load from source. Empty if the executable's directory can't be found.
+   */
+  [[nodiscard]] auto LuaCacheDirectory() -> std::filesystem::path;
 } // namespace swgtk
 
 #endif // SWGTK_INCLUDE_SWGTK_LUA_HPP
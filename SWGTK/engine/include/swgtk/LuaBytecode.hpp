@@ -0,0 +1,106 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_LUABYTECODE_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_LUABYTECODE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <sol/sol.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace swgtk {
+
+  struct LuaCacheStats {
+    size_t hits = 0uz;     // Scripts loaded from bytecode.
+    size_t misses = 0uz;   // Scripts compiled from source because no entry existed.
+    size_t rejected = 0uz; // Entries that existed but were stale, corrupt or built by a different Lua. They are deleted.
+    size_t writes = 0uz;   // Entries written back to the cache directory.
+  };
+
+  /**
+   * @brief Caches compiled Lua chunks on disk so scripts do not have to be parsed on every launch.
+   *
+   * Entries are named after a hash of the script's source text, so an edited script never matches an
+   * old entry and moving a script does not invalidate it. Each entry records the Lua version and the
+   * source hash, and lua_load() checks the bytecode header itself, so anything that does not match is
+   * deleted and the script is compiled from source instead.
+   *
+   * The build step (swgtk_precompile_lua() in CMake) creates and fills the directory ahead of time. Any
+   * script it missed is compiled on first load and written back, unless write-back is disabled. Loading
+   * never creates the directory, and an empty path disables the cache.
+   *
+   * Lua does not verify bytecode. Only point the cache at a directory the game controls.
+   */
+  class LuaBytecodeCache {
+  public:
+    static constexpr uint32_t formatVersion = 1u;
+
+    explicit LuaBytecodeCache(std::filesystem::path directory, bool writeBack = true);
+
+    /**
+     * @brief Load a script as a function without running it, using the cached bytecode when it is valid.
+     *
+     * @return The same result lua.load_file() would produce.
+     */
+    [[nodiscard]] auto Load(sol::state& lua, const std::filesystem::path& script) -> sol::load_result;
+
+    // Load and run a script. Errors are reported through DEBUG_PRINT.
+    auto RunFile(sol::state& lua, const std::filesystem::path& script) -> bool;
+
+    // Compile a script and store it without running it. Used by the build step.
+    auto Precompile(lua_State* state, const std::filesystem::path& script) -> bool;
+
+    [[nodiscard]] auto EntryPath(uint64_t sourceHash) const -> std::filesystem::path;
+    [[nodiscard]] constexpr auto GetDirectory() const -> const std::filesystem::path& { return _directory; }
+    [[nodiscard]] constexpr auto GetStats() const -> const LuaCacheStats& { return _stats; }
+
+    // 64-bit FNV-1a of the source text.
+    [[nodiscard]] static constexpr auto HashSource(const std::string_view source) -> uint64_t {
+      constexpr auto offsetBasis = 14695981039346656037ull;
+      constexpr auto prime = 1099511628211ull;
+
+      auto hash = offsetBasis;
+
+      for (const auto c: source) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= prime;
+      }
+
+      return hash;
+    }
+
+  private:
+    [[nodiscard]] auto ReadEntry(uint64_t sourceHash) const -> std::optional<std::vector<char>>;
+    auto WriteEntry(uint64_t sourceHash, const std::vector<char>& bytecode) -> bool;
+
+    std::filesystem::path _directory;
+    LuaCacheStats _stats;
+    bool _writeBack = true;
+  };
+
+  /**
+   * @brief Compile Lua source text to bytecode with lua_dump().
+   *
+   * Debug information is kept so error messages still carry the chunk name and line numbers.
+   *
+   * @return The bytecode, or nothing if the source does not compile.
+   */
+  [[nodiscard]] auto CompileLuaBytecode(lua_State* state, std::string_view source, const std::string& chunkName) -> std::optional<std::vector<char>>;
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_LUABYTECODE_HPP_
@@ -0,0 +1,39 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_LUACLOSEGUARD_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_LUACLOSEGUARD_HPP_
+
+extern "C" {
+struct lua_State;
+}
+
+namespace swgtk {
+
+  /**
+   * @brief Lets an engine object that holds a lua_State* find out when Lua closes that state.
+   *
+   * Install() stores a userdata with a __gc metamethod in the registry under a key. Lua finalizes it in
+   * lua_close(), which calls the callback with the owner. Remove() disarms the guard, so an owner that
+   * is destroyed first is never called back.
+   */
+  class LuaCloseGuard {
+  public:
+    using Callback = void (*)(void* owner);
+
+    static void Install(lua_State* state, const char* key, Callback callback, void* owner);
+    static void Remove(lua_State* state, const char* key, const void* owner);
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_LUACLOSEGUARD_HPP_
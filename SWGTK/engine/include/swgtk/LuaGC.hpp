@@ -0,0 +1,123 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_LUAGC_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_LUAGC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+struct lua_State;
+}
+
+namespace swgtk {
+
+  enum class LuaGCMode : uint8_t {
+    Incremental,
+    Generational,
+  };
+
+  struct LuaGCStats {
+    double lastMilliseconds = 0.0; // Time spent collecting during the last Step().
+    double maxMilliseconds = 0.0;  // The longest single Step() so far.
+    size_t lastSteps = 0uz;        // lua_gc(LUA_GCSTEP) calls made during the last Step().
+    size_t heapBytes = 0uz;        // Heap size after the last Step().
+    size_t peakHeapBytes = 0uz;
+    size_t cycles = 0uz;           // Completed collection cycles.
+    size_t catchUpFrames = 0uz;    // Frames where the heap grew past the pause threshold and the maximum step time was used.
+  };
+
+  /**
+   * @brief Runs Lua's garbage collector in bounded slices at a time the engine chooses.
+   *
+   * The first Step() stops Lua's automatic collector, so allocations never trigger a collection in the middle
+   * of a script. Step() is then called once per frame, after the scene has updated and before the frame is
+   * presented, and performs small lua_gc(LUA_GCSTEP) increments until the frame's idle time runs out.
+   *
+   * Until then, and again after HandBack(), Lua collects automatically in the chosen mode. Scripts run before
+   * the frame loop starts, or after it ends, and states nothing steps (tools, tests) are still collected, so
+   * objects that release resources in __gc, like PixelBuffer, still do.
+   *
+   * Every frame gets at least the minimum step time, even when it has no idle time, so the collector keeps up
+   * with scripts that allocate steadily. If the heap still grows past the pause threshold (twice the size left
+   * by the last cycle, like Lua's default pause of 200%) the maximum step time is used instead.
+   *
+   * Generational mode is supported, but each step there is a whole minor collection, so the time limit is
+   * only checked between steps.
+   *
+   * Attach() leaves a guard in the Lua registry, so closing the state before this object is destroyed is safe.
+   */
+  class LuaGC {
+  public:
+    static constexpr double defaultFrameBudget = 1000.0 / 60.0;
+    static constexpr double defaultMinStep = 0.1;
+    static constexpr double defaultMaxStep = 2.0;
+
+    LuaGC() = default;
+    explicit LuaGC(lua_State* state, LuaGCMode mode = LuaGCMode::Incremental) { Attach(state, mode); }
+    LuaGC(const LuaGC&) = delete;
+    LuaGC(LuaGC&&) noexcept = delete;
+    auto operator=(const LuaGC&) -> LuaGC& = delete;
+    auto operator=(LuaGC&&) noexcept -> LuaGC& = delete;
+    ~LuaGC() { Detach(); }
+
+    // Schedule collection for a state from the first Step() on. Any previously attached state gets its automatic collector back.
+    void Attach(lua_State* state, LuaGCMode mode = LuaGCMode::Incremental);
+
+    // Give collection back to Lua.
+    void Detach();
+
+    // Let Lua collect automatically again until the next Step(). Call it when the frame loop stops stepping.
+    void HandBack();
+
+    // Forget the attached state without touching it. Called automatically when Lua closes the state.
+    constexpr void Release() {
+      _state = nullptr;
+      _stepping = false;
+    }
+
+    /**
+     * @brief Collect garbage in the idle time left in this frame.
+     *
+     * @param frameElapsed Milliseconds already spent on this frame, usually Timer::GetElapsedMilliseconds().
+     */
+    void Step(double frameElapsed);
+
+    // The frame length to fit collection into, in milliseconds.
+    constexpr void SetFrameBudget(const double milliseconds) { _frameBudget = milliseconds; }
+    constexpr void SetStepLimits(const double minMilliseconds, const double maxMilliseconds) {
+      _minStep = minMilliseconds;
+      _maxStep = maxMilliseconds;
+    }
+
+    [[nodiscard]] constexpr auto IsAttached() const -> bool { return _state != nullptr; }
+    // True between the first Step() and HandBack(), while the engine schedules collection instead of Lua.
+    [[nodiscard]] constexpr auto IsStepping() const -> bool { return _stepping; }
+    [[nodiscard]] constexpr auto GetStats() const -> const LuaGCStats& { return _stats; }
+    [[nodiscard]] auto GetHeapBytes() const -> size_t;
+
+  private:
+    lua_State* _state = nullptr;
+    LuaGCStats _stats;
+    LuaGCMode _mode = LuaGCMode::Incremental;
+    double _frameBudget = defaultFrameBudget;
+    double _minStep = defaultMinStep;
+    double _maxStep = defaultMaxStep;
+    size_t _heapAfterCycle = 0uz;
+    bool _cycleDone = false;
+    bool _stepping = false;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_LUAGC_HPP_
@@ -0,0 +1,155 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_LUAPROFILER_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_LUAPROFILER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+struct lua_State;
+struct lua_Debug;
+}
+
+namespace swgtk {
+
+  struct LuaFunctionProfile {
+    std::string name;               // "name (source:line)", the same label used in folded stacks.
+    size_t selfSamples = 0uz;       // Samples taken while this function was running.
+    size_t totalSamples = 0uz;      // Samples taken while this function was anywhere on the stack.
+    double selfMilliseconds = 0.0;  // Estimated from the time between samples.
+    double totalMilliseconds = 0.0;
+  };
+
+  /**
+   * @brief Samples running Lua code with a count hook and builds a call tree from the samples.
+   *
+   * While started, Lua calls the hook every N VM instructions. The hook walks the current stack and adds
+   * one sample to each frame of the call tree, so hot functions collect samples in proportion to the
+   * instructions they run. Each sample is also weighted by the time since the previous one, capped so that
+   * time spent outside Lua (rendering, waiting on vsync) is not charged to the next function that runs.
+   * Calls into C (drawing, for example) are a single instruction, so their cost only shows up in the time.
+   *
+   * Stopped, the hook is removed completely and profiling costs nothing.
+   *
+   * Lua hooks belong to a thread. Coroutines inherit the hook when they are created, so tasks spawned
+   * before Start() are not sampled until they are spawned again. Ones spawned while profiling keep the hook
+   * after Stop() and take it off the next time it runs.
+   */
+  class LuaProfiler {
+  public:
+    static constexpr int defaultInterval = 1000;
+    static constexpr double defaultMaxSampleGap = 1.0;
+
+    LuaProfiler() = default;
+    LuaProfiler(const LuaProfiler&) = delete;
+    LuaProfiler(LuaProfiler&&) noexcept = delete;
+    auto operator=(const LuaProfiler&) -> LuaProfiler& = delete;
+    auto operator=(LuaProfiler&&) noexcept -> LuaProfiler& = delete;
+    ~LuaProfiler() { Stop(); }
+
+    /**
+     * @brief Install the sampling hook. Samples are added to any already collected.
+     *
+     * Only one profiler can sample at a time. Starting another one stops this one.
+     *
+     * @param interval VM instructions between samples.
+     */
+    void Start(lua_State* state, int interval = defaultInterval);
+
+    // Remove the hook. The collected samples are kept.
+    void Stop();
+
+    // Forget the attached state without touching it. Called automatically when Lua closes the state.
+    void Release();
+
+    // Drop every sample.
+    void Reset();
+
+    // The longest gap between samples, in milliseconds, that is charged to a sample.
+    constexpr void SetMaxSampleGap(const double milliseconds) { _maxSampleGap = milliseconds; }
+
+    [[nodiscard]] constexpr auto IsRunning() const -> bool { return _state != nullptr; }
+    [[nodiscard]] constexpr auto GetSampleCount() const -> size_t { return _samples; }
+
+    // Every sampled function, sorted by self time.
+    [[nodiscard]] auto GetFunctionProfiles() const -> std::vector<LuaFunctionProfile>;
+
+    /**
+     * @brief The call tree in the folded format read by flamegraph.pl, inferno and speedscope.
+     *
+     * One line per distinct stack, outermost frame first: "main (game.lua:1);update (game.lua:10) 42".
+     *
+     * @param useTime Weight the stacks in microseconds instead of sample counts.
+     */
+    [[nodiscard]] auto GetFoldedStacks(bool useTime = false) const -> std::string;
+    auto WriteFoldedStacks(const std::filesystem::path& path, bool useTime = false) const -> bool;
+
+  private:
+    struct Node {
+      uint32_t function = 0u;
+      uint32_t parent = 0u;
+      uint32_t firstChild = 0u;
+      uint32_t nextSibling = 0u;
+      size_t selfSamples = 0uz;
+      size_t totalSamples = 0uz;
+      double selfMilliseconds = 0.0;
+      double totalMilliseconds = 0.0;
+    };
+
+    struct Function {
+      std::string name;
+      size_t selfSamples = 0uz;
+      size_t totalSamples = 0uz;
+      double selfMilliseconds = 0.0;
+      double totalMilliseconds = 0.0;
+      size_t lastSample = 0uz; // Stops recursive calls counting twice towards totalSamples.
+    };
+
+    struct StringHash {
+      using is_transparent = void;
+
+      [[nodiscard]] auto operator()(const std::string_view value) const noexcept -> size_t { return std::hash<std::string_view>{}(value); }
+    };
+
+    static void Hook(lua_State* state, lua_Debug* debug);
+
+    // True for the profiled state and for coroutines created from it.
+    [[nodiscard]] auto IsProfiling(lua_State* state) const -> bool;
+
+    void Sample(lua_State* state);
+    [[nodiscard]] auto FunctionID(lua_State* state, lua_Debug& debug) -> uint32_t;
+    [[nodiscard]] auto ChildNode(uint32_t parent, uint32_t function) -> uint32_t;
+
+    lua_State* _state = nullptr;
+    std::chrono::steady_clock::time_point _lastSample;
+    double _maxSampleGap = defaultMaxSampleGap;
+    size_t _samples = 0uz;
+
+    std::vector<Node> _nodes{Node{}}; // Index 0 is the root, above the outermost frame.
+    std::vector<Function> _functions;
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> _functionIDs; // Keyed by "source:line".
+    std::vector<uint32_t> _stack; // Reused by every sample, innermost frame first.
+    std::string _key;             // Reused by every lookup.
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_LUAPROFILER_HPP_
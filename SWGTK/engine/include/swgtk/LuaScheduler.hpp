@@ -0,0 +1,159 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_LUASCHEDULER_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_LUASCHEDULER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <swgtk/Timer.hpp>
+#include <vector>
+
+extern "C" {
+struct lua_State;
+}
+
+namespace swgtk {
+
+  using LuaTaskID = uint32_t;
+  inline constexpr LuaTaskID nullLuaTask = 0u;
+
+  struct LuaSchedulerStats {
+    double lastMilliseconds = 0.0; // Time spent resuming tasks during the last Update().
+    size_t lastResumed = 0uz;      // Tasks resumed during the last Update().
+    size_t lastDeferred = 0uz;     // Tasks that were not checked because the budget ran out.
+    size_t running = 0uz;          // Tasks that have not finished yet.
+    size_t failed = 0uz;           // Tasks that stopped with an error since the scheduler was attached.
+  };
+
+  /**
+   * @brief Runs Lua functions as coroutines and resumes them once per frame within a time budget.
+   *
+   * Attach() adds these functions to the swgtk table:
+   *
+   *    swgtk.spawn(fn, ...)     Start fn(...) as a task. Returns its id.
+   *    swgtk.cancel(id)         Stop a task. It is not resumed again.
+   *    swgtk.is_running(id)     True until the task returns, fails or is cancelled.
+   *    swgtk.wait_frames(n)     Suspend the calling task for n frames (default 1).
+   *    swgtk.wait_seconds(s)    Suspend the calling task until s seconds of frame time have passed.
+   *    swgtk.wait_until(pred)   Suspend the calling task until pred() returns true. pred is checked once per frame.
+   *    swgtk.wait_budget()      Suspend until next frame only if this frame's budget is spent, otherwise return at once.
+   *
+   * The App calls Update() at the end of EventsAndTimeStep(), once input and frame time are current. Tasks are
+   * resumed round-robin, starting after the last task that got a turn, until the budget is used up. The budget
+   * cannot interrupt a task, so long jobs should call wait_budget() every so often.
+   *
+   * A plain coroutine.yield() inside a task waits for one frame.
+   */
+  class LuaScheduler {
+  public:
+    static constexpr double defaultBudget = 2.0;
+
+    LuaScheduler() = default;
+    LuaScheduler(const LuaScheduler&) = delete;
+    LuaScheduler(LuaScheduler&&) noexcept = delete;
+    auto operator=(const LuaScheduler&) -> LuaScheduler& = delete;
+    auto operator=(LuaScheduler&&) noexcept -> LuaScheduler& = delete;
+    ~LuaScheduler() { Detach(); }
+
+    // Register the task functions with a state. Any previously attached state loses its tasks.
+    void Attach(lua_State* state);
+
+    // Cancel every task and let go of the state.
+    void Detach();
+
+    // Forget the attached state without touching it. Called automatically when Lua closes the state.
+    void Release();
+
+    /**
+     * @brief Spawn the function that sits below nargs arguments on top of the attached state's stack.
+     *
+     * The function and its arguments are popped.
+     *
+     * @return The new task, or nullLuaTask if nothing is attached or the value is not a function.
+     */
+    auto Spawn(int nargs = 0) -> LuaTaskID { return SpawnFrom(_state, nargs); }
+
+    // Same as Spawn(), but the function and arguments are on the stack of a thread belonging to the attached state.
+    auto SpawnFrom(lua_State* from, int nargs) -> LuaTaskID;
+
+    // Spawn anything that can push itself onto a Lua stack, such as a sol::function.
+    auto Spawn(const auto& function) -> LuaTaskID {
+      if (_state == nullptr) {
+        return nullLuaTask;
+      }
+
+      function.push(_state);
+      return Spawn(0);
+    }
+
+    auto Cancel(LuaTaskID id) -> bool;
+
+    /**
+     * @brief Advance every wait and resume the tasks that are ready.
+     *
+     * Does nothing when called from inside a task, since the tasks already running can't be resumed again.
+     *
+     * @param deltaSeconds Frame time used by wait_seconds().
+     */
+    void Update(double deltaSeconds);
+
+    // Milliseconds of task time allowed per Update().
+    constexpr void SetBudget(const double milliseconds) { _budget = milliseconds; }
+
+    [[nodiscard]] auto IsRunning(LuaTaskID id) const -> bool;
+    [[nodiscard]] constexpr auto IsAttached() const -> bool { return _state != nullptr; }
+    [[nodiscard]] constexpr auto GetStats() const -> const LuaSchedulerStats& { return _stats; }
+
+    // True while Update() is running and the budget has been used up. Backs swgtk.wait_budget().
+    [[nodiscard]] auto IsOverBudget() const -> bool;
+
+  private:
+    enum class Wait : uint8_t {
+      None,
+      Frames,
+      Seconds,
+      Until,
+    };
+
+    static constexpr int noRef = -2; // LUA_NOREF
+
+    struct Task {
+      lua_State* thread = nullptr;
+      int threadRef = noRef;
+      int predicateRef = noRef;
+      int startArgs = 0;
+      LuaTaskID id = nullLuaTask;
+      Wait wait = Wait::None;
+      int64_t frames = 0;
+      double seconds = 0.0;
+      bool finished = false;
+    };
+
+    [[nodiscard]] auto IsReady(Task& task) -> bool;
+    void Resume(size_t index);
+    void ReadWait(Task& task, int yielded);
+    void RemoveFinished();
+
+    lua_State* _state = nullptr;
+    std::vector<Task> _tasks;
+    LuaSchedulerStats _stats;
+    Timer _updateTimer;
+    double _budget = defaultBudget;
+    size_t _cursor = 0uz;
+    LuaTaskID _nextID = 1u;
+    bool _updating = false;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_LUASCHEDULER_HPP_
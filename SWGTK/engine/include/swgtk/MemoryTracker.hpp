@@ -0,0 +1,99 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_MEMORYTRACKER_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_MEMORYTRACKER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace swgtk {
+
+  // The subsystem an allocation is charged to.
+  enum class MemoryTag : uint8_t {
+    Engine,
+    SDL,
+    Lua,
+    Count,
+  };
+
+  struct MemoryStats {
+    size_t allocations = 0uz;       // Allocations made during the last completed frame.
+    size_t bytesAllocated = 0uz;    // Bytes requested during the last completed frame.
+    size_t residentBytes = 0uz;     // Bytes currently allocated.
+    size_t peakResidentBytes = 0uz; // The most bytes that were ever allocated at once.
+  };
+
+  /**
+   * @brief Counts allocations made by SWGTK, SDL (including SDL_image and SDL_ttf) and Lua, tagged by subsystem.
+   *
+   * The counters are always available, but the engine only routes its allocators through them when built with
+   * SWGTK_MEMORY_TRACKING. In that case the App installs the SDL allocator when it's constructed, InitLua() installs the
+   * Lua allocator, and the frame arena draws its blocks from EngineMemoryResource().
+   *
+   * FreeType allocates through its own memory interface, so glyph caches are not counted.
+   *
+   * Counters are atomic because SDL allocates from its audio and worker threads.
+   */
+  class MemoryTracker {
+  public:
+    static void RecordAllocation(MemoryTag tag, size_t bytes);
+    static void RecordFree(MemoryTag tag, size_t bytes);
+
+    // Latch the counters for the frame that just ended. Called by the App at the start of every frame.
+    static void NewFrame();
+
+    [[nodiscard]] static auto GetFrameStats(MemoryTag tag) -> MemoryStats;
+
+    // The sum of every tag. The peak is the sum of the per-tag peaks, which can overestimate the true peak.
+    [[nodiscard]] static auto GetTotalFrameStats() -> MemoryStats;
+
+    /**
+     * @brief Route SDL_malloc and friends through the tracker.
+     *
+     * Blocks are still allocated by the functions SDL was using before, and the tracker keeps their
+     * sizes on the side, so it is safe to install after SDL has allocated; anything allocated earlier
+     * is freed normally but not counted. The App does it in its constructor, so create the App before
+     * calling SDL yourself to have everything counted.
+     */
+    static auto InstallSDLAllocator() -> bool;
+
+    // A lua_Alloc compatible allocator. It uses realloc/free like Lua's default one, so it can be installed on a running
+    // state; the heap the state already had is not counted.
+    static auto LuaAllocator(void* userData, void* ptr, size_t oldSize, size_t newSize) -> void*;
+  };
+
+  /**
+   * @brief A memory_resource that forwards to another resource and charges everything to a MemoryTag.
+   */
+  class TrackedResource : public std::pmr::memory_resource {
+  public:
+    explicit TrackedResource(const MemoryTag tag, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) :
+        _upstream(upstream), _tag(tag) {}
+
+  protected:
+    auto do_allocate(size_t bytes, size_t alignment) -> void* override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override { return this == &other; }
+
+  private:
+    std::pmr::memory_resource* _upstream = nullptr;
+    MemoryTag _tag = MemoryTag::Engine;
+  };
+
+  // The resource engine systems should allocate long-lived buffers from. Tracked when SWGTK_MEMORY_TRACKING is on.
+  [[nodiscard]] auto EngineMemoryResource() -> std::pmr::memory_resource*;
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_MEMORYTRACKER_HPP_
@@ -0,0 +1,117 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_MUSICSTREAM_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_MUSICSTREAM_HPP_
+
+#include <SDL3/SDL_audio.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include <swgtk/AudioMixer.hpp>
+#include <swgtk/SpscQueue.hpp>
+
+namespace swgtk {
+
+  // How much decoded audio a stream keeps ready ahead of playback.
+  constexpr inline auto defaultMusicPrefetch = std::chrono::milliseconds{500};
+
+  // How many frames the worker decodes at a time.
+  constexpr inline auto musicChunkFrames = 4096uz;
+
+  class MusicDecoder;
+
+  /**
+      @brief Music decoded a chunk at a time on a worker thread, for tracks too long to hold as a Sound.
+
+      Open() decodes the start of the track, then a worker thread keeps a ring buffer of converted samples
+      full to the prefetch depth while the mixer reads from the other end. Memory use depends only on the
+      prefetch depth and the chunk size, never on the length of the track.
+
+      Plays .wav (8, 16 and 32-bit PCM or 32-bit float) and, when built with SWGTK_OGG_VORBIS, .ogg files.
+      A stream can only be played by one voice at a time. Looping is done by the decoder, so pass it to
+      Open() rather than in the voice's VoiceParams.
+
+      If the mixer reads faster than the worker decodes, the missing samples play as silence and are
+      counted by GetUnderrunCount().
+   */
+  class MusicStream {
+  public:
+    explicit MusicStream(int sampleRate = defaultSampleRate, std::chrono::milliseconds prefetch = defaultMusicPrefetch);
+    MusicStream(const MusicStream&) = delete;
+    MusicStream(MusicStream&&) = delete;
+    auto operator=(const MusicStream&) -> MusicStream& = delete;
+    auto operator=(MusicStream&&) -> MusicStream& = delete;
+    ~MusicStream();
+
+    // Open a track and start prefetching it. Any track already open is closed first.
+    auto Open(const std::filesystem::path& path, bool loop = false) -> bool;
+
+    // Stop the worker and close the track. Not while a voice is playing the stream.
+    void Close();
+
+    [[nodiscard]] auto IsOpen() const -> bool { return _decoder != nullptr; }
+    [[nodiscard]] constexpr auto GetSampleRate() const -> int { return _sampleRate; }
+
+    /**
+     * @brief Take the next decoded samples, interleaved stereo. Called by the mixer on the audio thread.
+     *
+     * @return How many samples were written to out. Short only at the end of the track or on an underrun.
+     */
+    auto Read(std::span<float> out) -> size_t;
+
+    // True once the whole track has been decoded and read.
+    [[nodiscard]] auto IsFinished() const -> bool { return _ended.load(std::memory_order_acquire) && _buffer.Size() == 0uz; }
+
+    // Reads that came up short before the end of the track.
+    [[nodiscard]] auto GetUnderrunCount() const -> uint64_t { return _underruns.load(std::memory_order_relaxed); }
+    [[nodiscard]] auto GetBufferedFrames() const -> size_t { return _buffer.Size() / audioChannels; }
+    [[nodiscard]] auto GetCapacityFrames() const -> size_t { return _buffer.GetCapacity() / audioChannels; }
+
+  private:
+    // Decode and convert until frames are buffered, the buffer is full or the track has ended.
+    void Fill(size_t frames);
+    void Prefetch(const std::stop_token& stop);
+
+    int _sampleRate = defaultSampleRate;
+    bool _loop = false;
+    std::chrono::milliseconds _pollInterval{};
+
+    // Owned by whichever thread is filling: Open() until the worker starts, then the worker.
+    std::unique_ptr<MusicDecoder> _decoder;
+    SDL_AudioStream* _converter = nullptr;
+    std::vector<std::byte> _encoded;
+    std::vector<float> _converted;
+    bool _flushed = false;
+
+    SpscRingBuffer<float> _buffer;
+    std::atomic<bool> _ended = false;
+    std::atomic<uint64_t> _underruns = 0u;
+
+    std::mutex _wakeMutex;
+    std::condition_variable_any _wake;
+    std::jthread _worker;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_MUSICSTREAM_HPP_
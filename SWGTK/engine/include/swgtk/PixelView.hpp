@@ -0,0 +1,147 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_PIXELVIEW_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_PIXELVIEW_HPP_
+
+#include <SDL3/SDL_pixels.h>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace swgtk {
+
+  // Pixel layouts for the byte-ordered formats. The member order matches the order of the bytes in memory.
+  struct PixelRGBA32 {
+    static constexpr SDL_PixelFormat format = SDL_PIXELFORMAT_RGBA32;
+    uint8_t r = 0u, g = 0u, b = 0u, a = 0u;
+
+    [[nodiscard]] constexpr auto operator==(const PixelRGBA32&) const -> bool = default;
+  };
+
+  struct PixelBGRA32 {
+    static constexpr SDL_PixelFormat format = SDL_PIXELFORMAT_BGRA32;
+    uint8_t b = 0u, g = 0u, r = 0u, a = 0u;
+
+    [[nodiscard]] constexpr auto operator==(const PixelBGRA32&) const -> bool = default;
+  };
+
+  struct PixelRGB24 {
+    static constexpr SDL_PixelFormat format = SDL_PIXELFORMAT_RGB24;
+    uint8_t r = 0u, g = 0u, b = 0u;
+
+    [[nodiscard]] constexpr auto operator==(const PixelRGB24&) const -> bool = default;
+  };
+
+  static_assert(sizeof(PixelRGBA32) == 4uz && sizeof(PixelBGRA32) == 4uz && sizeof(PixelRGB24) == 3uz);
+
+  // A pixel type that names the exact SDL format it describes.
+  template <typename T>
+  concept FormatPixel = requires { { T::format } -> std::convertible_to<SDL_PixelFormat>; };
+
+  // Pixel types a view can be made of: the layouts above, or a plain integer the size of one pixel.
+  template <typename T>
+  concept PixelType = FormatPixel<std::remove_const_t<T>> || std::is_integral_v<std::remove_const_t<T>>;
+
+  /**
+   * @brief A typed, non-owning window over a 2D pixel buffer, in the spirit of a 2D std::mdspan.
+   *
+   * Rows may be padded, so the view keeps the pitch in bytes and every row access steps by it. Indexing is
+   * view[x, y], matching SDL's coordinate order. Nothing is bounds checked.
+   *
+   * Views are made by SurfaceLock::View(), which checks that T matches the surface's format.
+   */
+  template <PixelType T>
+  class PixelView {
+  public:
+    using Byte = std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>;
+
+    constexpr PixelView() = default;
+    constexpr PixelView(Byte* pixels, const int width, const int height, const int pitch) :
+        _pixels(pixels), _width(width), _height(height), _pitch(pitch) {}
+
+    [[nodiscard]] constexpr auto Width() const -> int { return _width; }
+    [[nodiscard]] constexpr auto Height() const -> int { return _height; }
+    [[nodiscard]] constexpr auto Pitch() const -> int { return _pitch; }
+    [[nodiscard]] constexpr auto Empty() const -> bool { return _pixels == nullptr; }
+
+    // True when the rows have no padding, so the whole image can be treated as one span.
+    [[nodiscard]] constexpr auto IsContiguous() const -> bool { return static_cast<size_t>(_pitch) == sizeof(T) * static_cast<size_t>(_width); }
+
+    [[nodiscard]] auto Row(const int y) const -> std::span<T> {
+      return std::span<T>{reinterpret_cast<T*>(_pixels + (static_cast<ptrdiff_t>(y) * _pitch)), static_cast<size_t>(_width)}; // NOLINT(*-reinterpret-cast, *-pointer-arithmetic)
+    }
+
+    [[nodiscard]] auto operator[](const int x, const int y) const -> T& { return Row(y)[static_cast<size_t>(x)]; }
+
+    // Every pixel in one span. Only valid when IsContiguous().
+    [[nodiscard]] auto Pixels() const -> std::span<T> {
+      return std::span<T>{reinterpret_cast<T*>(_pixels), static_cast<size_t>(_width) * static_cast<size_t>(_height)}; // NOLINT(*-reinterpret-cast)
+    }
+
+    // The raw bytes, padding included.
+    [[nodiscard]] auto Bytes() const -> std::span<Byte> { return std::span<Byte>{_pixels, static_cast<size_t>(_pitch) * static_cast<size_t>(_height)}; }
+
+    // Call fn(x, y, pixel) for every pixel, row by row.
+    void ForEach(auto&& fn) const {
+      for (auto y = 0; y < _height; ++y) {
+        auto x = 0;
+
+        for (auto& pixel: Row(y)) {
+          fn(x++, y, pixel);
+        }
+      }
+    }
+
+    void Fill(const std::remove_const_t<T>& value) const
+      requires(!std::is_const_v<T>)
+    {
+      for (auto y = 0; y < _height; ++y) {
+        std::ranges::fill(Row(y), value);
+      }
+    }
+
+  private:
+    Byte* _pixels = nullptr;
+    int _width = 0;
+    int _height = 0;
+    int _pitch = 0;
+  };
+
+  /**
+   * @brief Convert a whole block of pixels from one format to another in a single pass.
+   *
+   * This wraps SDL_ConvertPixels(), which runs SDL's blitters over the entire block instead of mapping each
+   * pixel through a float color.
+   */
+  inline auto ConvertPixels(const int width, const int height, const SDL_PixelFormat sourceFormat, const void* source, const int sourcePitch,
+                            const SDL_PixelFormat destFormat, void* dest, const int destPitch) -> bool {
+    return SDL_ConvertPixels(width, height, sourceFormat, source, sourcePitch, destFormat, dest, destPitch);
+  }
+
+  template <PixelType Source, PixelType Dest>
+    requires FormatPixel<std::remove_const_t<Source>> && FormatPixel<Dest>
+  auto ConvertPixels(const PixelView<Source>& source, const PixelView<Dest>& dest) -> bool {
+    if (source.Width() != dest.Width() || source.Height() != dest.Height()) {
+      return false;
+    }
+
+    return ConvertPixels(source.Width(), source.Height(), std::remove_const_t<Source>::format, source.Bytes().data(), source.Pitch(),
+                         Dest::format, dest.Bytes().data(), dest.Pitch());
+  }
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_PIXELVIEW_HPP_
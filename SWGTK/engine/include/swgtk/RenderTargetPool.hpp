@@ -0,0 +1,137 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_RENDERTARGETPOOL_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_RENDERTARGETPOOL_HPP_
+
+#include <SDL3/SDL_blendmode.h>
+#include <SDL3/SDL_pixels.h>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <swgtk/Texture.hpp>
+
+namespace swgtk {
+
+  // Targets that match a key can stand in for each other.
+  struct RenderTargetKey {
+    int width = 0;
+    int height = 0;
+    SDL_PixelFormat format = SDL_PIXELFORMAT_RGBA32;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+
+    [[nodiscard]] constexpr auto operator==(const RenderTargetKey& other) const -> bool = default;
+  };
+
+  struct RenderTargetPoolStats {
+    size_t pooled = 0;   // Targets the pool owns, handed out or not.
+    size_t inUse = 0;    // Targets handed out this frame.
+    size_t created = 0;  // Acquires that had to create a target.
+    size_t reused = 0;   // Acquires served from the pool.
+    size_t released = 0; // Targets destroyed after going unused.
+
+    // Share of acquires served without creating a texture.
+    [[nodiscard]] constexpr auto ReuseRate() const -> double {
+      const auto acquires = created + reused;
+      return acquires == 0uz ? 0.0 : static_cast<double>(reused) / static_cast<double>(acquires);
+    }
+  };
+
+  /**
+    @brief Keeps render targets alive between frames, so passes that need a temporary target don't create and
+    destroy one every frame.
+
+    Acquire() hands out a free target with the same key, or creates one. Every target handed out goes back to
+    the pool at EndFrame(), which SDLHW2D calls when the frame is presented, so a transient target must not be
+    held on to past the frame it was acquired in. Release() gives one back early, for passes that ping-pong
+    between targets. A target's contents are whatever the last user left in it; clear it before drawing.
+
+    Targets that go unused for longer than the idle limit are destroyed, so a one-off size doesn't hold on to
+    VRAM for the rest of the run.
+   */
+  class RenderTargetPool {
+  public:
+    static constexpr uint32_t defaultIdleFrames = 120u;
+
+    RenderTargetPool() = default;
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool(RenderTargetPool&&) noexcept = default;
+    auto operator=(const RenderTargetPool&) -> RenderTargetPool& = delete;
+    auto operator=(RenderTargetPool&&) noexcept -> RenderTargetPool& = default;
+    ~RenderTargetPool() { Clear(); }
+
+    /**
+     * @brief Hand out a free target matching key, or call create(key) to make one. create() returns a Texture.
+     *
+     * @return The target, or an invalid Texture if create() failed. Failures aren't pooled.
+     */
+    template<std::invocable<const RenderTargetKey&> Create>
+    [[nodiscard]] auto Acquire(const RenderTargetKey& key, Create&& create) -> Texture {
+      for (auto& entry: _entries) {
+        if (!entry.inUse && entry.key == key) {
+          entry.inUse = true;
+          entry.lastUsed = _frame;
+          ++_stats.reused;
+          ++_stats.inUse;
+          return entry.texture;
+        }
+      }
+
+      const Texture texture = create(key);
+
+      if (!texture.IsValid()) {
+        return Texture{};
+      }
+
+      _entries.push_back(Entry{.key = key, .texture = texture, .lastUsed = _frame, .inUse = true});
+      ++_stats.created;
+      ++_stats.inUse;
+      ++_stats.pooled;
+      return texture;
+    }
+
+    // Give a target back before the frame ends. Returns false if it isn't one this pool handed out.
+    auto Release(Texture target) -> bool;
+
+    // Reclaim every target handed out this frame and destroy the ones idle for too long.
+    void EndFrame();
+
+    void SetIdleFrames(const uint32_t frames) { _idleFrames = frames; }
+    [[nodiscard]] constexpr auto GetIdleFrames() const -> uint32_t { return _idleFrames; }
+
+    [[nodiscard]] constexpr auto GetStats() const -> const RenderTargetPoolStats& { return _stats; }
+
+    // Zero the created, reused and released counts, to measure from a known point.
+    void ResetStats();
+
+    // Destroy every target, including ones handed out this frame.
+    void Clear();
+
+  private:
+    struct Entry {
+      RenderTargetKey key{};
+      Texture texture{};
+      uint64_t lastUsed = 0;
+      bool inUse = false;
+    };
+
+    std::vector<Entry> _entries;
+    RenderTargetPoolStats _stats{};
+    uint64_t _frame = 0;
+    uint32_t _idleFrames = defaultIdleFrames;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_RENDERTARGETPOOL_HPP_
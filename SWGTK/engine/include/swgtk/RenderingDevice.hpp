@@ -97,6 +97,15 @@ namespace swgtk {
 
     [[nodiscard]] virtual auto GetVSync() const -> VSync = 0;
 
+    /**
+     * @brief True when the last BufferPresent() had nothing new to show and didn't present. While this holds,
+     * App waits for events instead of running frames nobody would see.
+     */
+    [[nodiscard]] virtual auto IsIdle() const -> bool { return false; }
+
+    // Present the last frame again at the next BufferPresent(), e.g. after the window was uncovered.
+    virtual void RequestPresent() {}
+
 #ifdef SWGTK_BUILD_WITH_LUA
     virtual void InitLua(sol::state*) = 0;
 #endif
@@ -18,8 +18,17 @@
 #include <SDL3/SDL_pixels.h>
 #include <SDL3/SDL_rect.h>
 #include <sol/sol.hpp>
+#include <swgtk/DirtyRegion.hpp>
+#include <swgtk/FrameCapture.hpp>
+#include <swgtk/RenderTargetPool.hpp>
 #include <swgtk/RenderingDevice.hpp>
+#include <swgtk/SdfFont.hpp>
+#include <swgtk/ShapeBatch.hpp>
+#include <swgtk/SpriteBatch.hpp>
 #include <swgtk/Surface.hpp>
+#include <swgtk/TextLayout.hpp>
+#include <swgtk/TileMap.hpp>
+#include <swgtk/UIDrawData.hpp>
 #include "SDL3/SDL_blendmode.h"
 #include "SDL3/SDL_render.h"
 #include "SDL3_ttf/SDL_ttf.h"
@@ -39,7 +48,7 @@ namespace swgtk {
    */
   class SDLHW2D : public RenderingDevice, public std::enable_shared_from_this<SDLHW2D> {
   public:
-    constexpr SDLHW2D() = default;
+    SDLHW2D() = default;
     SDLHW2D(const SDLHW2D&) = delete;
     SDLHW2D(SDLHW2D&&) noexcept = delete;
     auto operator=(const SDLHW2D&) -> SDLHW2D& = delete;
@@ -57,6 +66,16 @@ namespace swgtk {
     [[nodiscard]] auto PrepareDevice(const std::any& window_ptr) -> bool override;
     void DestroyDevice() override;
 
+    /**
+     * @brief Render into a surface with SDL's software renderer instead of a window, so no display is needed.
+     *
+     * Meant for tests and offline rendering. BufferPresent() leaves the finished frame in target, which has to
+     * outlive the device.
+     *
+     * @param target
+     */
+    [[nodiscard]] auto PrepareHeadless(SDL_Surface* target) -> bool;
+
     /**
      * @brief SDL3 has several vsync options that you can set. This function wraps that functionality.
      *
@@ -72,6 +91,39 @@ namespace swgtk {
 
     [[nodiscard]] auto GetRef() -> std::weak_ptr<RenderingDevice> override { return shared_from_this(); }
 
+    /**
+     * @brief Only redraw the parts of the window that changed, for tools and other mostly static UIs.
+     *
+     * The frame is kept in a back-buffer texture the size of the render output. Each frame the scene marks what
+     * changed with MarkDirty() and calls BeginRedraw(), which clips drawing to the union of the marked rects and
+     * returns false if there's nothing to draw. BufferPresent() then skips frames with nothing new, and App sleeps
+     * until the next event while the renderer is idle. The back buffer is drawn at one unit per output pixel.
+     *
+     * @param enabled
+     */
+    void SetDirtyRendering(bool enabled);
+    [[nodiscard]] constexpr auto IsDirtyRendering() const -> bool { return _dirtyRendering; }
+
+    void MarkDirty(const SDL_Rect& rect) { _dirty.Add(rect); }
+    void MarkAllDirty() { _dirty.AddAll(); }
+
+    /**
+     * @brief Start drawing this frame's changes. Fills the dirty area with color and clips drawing to it.
+     *
+     * Use this instead of BufferClear() with dirty rendering, because SDL_RenderClear() ignores the clip rect.
+     * Without dirty rendering it clears the whole output and always returns true, so a scene can call it either way.
+     *
+     * @param color
+     * @return false if nothing was marked dirty since the last redraw, and nothing needs drawing.
+     */
+    [[nodiscard]] auto BeginRedraw(const SDL_FColor& color = SDL_FColor{.r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f}) -> bool;
+
+    // The area BeginRedraw() last cleared. Drawing that misses it can be skipped.
+    [[nodiscard]] constexpr auto GetRedrawRect() const -> SDL_Rect { return _redrawRect; }
+
+    [[nodiscard]] constexpr auto IsIdle() const -> bool override { return _idle; }
+    void RequestPresent() override { _presentRequested = true; }
+
     void SetDrawColor(const float r, const float g, const float b, const float a = defaultAlphaFloat) const { SDL_SetRenderDrawColorFloat(_render, r, g, b, a); }
     void SetDrawColor(const SDL_FColor& color = SDL_FColor{.r = 0.0f, .g = 0.0f, .b = 0.0f, .a = defaultAlphaFloat}) const {
       SDL_SetRenderDrawColorFloat(_render, color.r, color.g, color.b, color.a);
@@ -106,6 +158,21 @@ namespace swgtk {
                            const SDL_Color& color = SDL_Color{
                                .r = defaultAlphaInt, .g = defaultAlphaInt, .b = defaultAlphaInt, .a = defaultAlphaInt}) const;
 
+    /**
+     * @brief Draw text from a signed distance field font at any size. Text at a new size is resampled on the CPU
+     *        the first time it is drawn, after that it costs one SDL_RenderGeometry() call.
+     *
+     * @param font
+     * @param text UTF-8, with '\n' starting a new line.
+     * @param pos Top-left of the first line.
+     * @param size Font size in pixels.
+     * @param color
+     */
+    void DrawSdfText(SdfFont& font, std::string_view text, SDL_FPoint pos, float size, const SDL_FColor& color = whiteFColor);
+
+    // Draw the lines of a TextLayout that fall inside the render output, with the text's top-left at pos.
+    void DrawTextLayout(const TextLayout& layout, SDL_FPoint pos, const SDL_FColor& color = whiteFColor);
+
     /*
       Combines SDL_ttf's API with SDL_Textures to preload text renderables as Textures. These can be rotated and tinted as needed.
     */
@@ -150,15 +217,70 @@ namespace swgtk {
      * @param vertices
      * @param indices
      */
-    void DrawGeometry(Texture texture, const std::span<SDL_Vertex> vertices, const std::span<int> indices) const {
+    void DrawGeometry(Texture texture, const std::span<const SDL_Vertex> vertices, const std::span<const int> indices) const {
       SDL_RenderGeometry(_render, *texture, vertices.data(), static_cast<int>(std::ssize(vertices)),
                          indices.data(), static_cast<int>(std::ssize(indices)));
     }
 
+    /**
+     * @brief Draw the contents of a VertexBuffer in one call. If the buffer has no indices, every three
+     *        vertices form a triangle.
+     *
+     * @param texture
+     * @param buffer
+     */
+    void DrawGeometry(Texture texture, const VertexBuffer& buffer) const;
+
+    // Draw every sprite in the batch with a single SDL_RenderGeometry() call.
+    void DrawSpriteBatch(const SpriteBatch& batch) const;
+
+    // Draw every shape in the batch with a single SDL_RenderGeometry() call, alpha blended.
+    void DrawShapes(const ShapeBatch& shapes) const;
+
+    /**
+     * @brief Draw a frame of immediate-mode UI, one SDL_RenderGeometry() call per batch.
+     *
+     * Each batch's clip rect is set with SDL_SetRenderClipRect(), and the clip rect from before is put back after.
+     *
+     * @param data
+     */
+    void DrawUI(const UIDrawData& data) const;
+
+    /**
+     * @brief Draw the part of a tile map inside view, with the view's top-left corner at pos.
+     *
+     * Chunks of a cached map that changed, or have no texture yet, are rendered into their textures first.
+     *
+     * @param map
+     * @param view The visible area in map pixels, usually the camera.
+     * @param pos Where the top-left of view lands in the render output.
+     */
+    void DrawTileMap(TileMap& map, const SDL_FRect& view, SDL_FPoint pos = SDL_FPoint{});
+
     [[nodiscard]] auto LoadTextureImg(const std::filesystem::path& img, SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND) const -> Texture;
     [[nodiscard]] auto CreateRenderableTexture(int width, int height, SDL_PixelFormat format = SDL_PIXELFORMAT_RGBA32, SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND) const -> Texture;
     [[nodiscard]] auto CreateTextureFromSurface(const Surface& surface) const -> Texture;
 
+    /**
+     * @brief Borrow a render target for the rest of this frame. Targets are pooled by size, format and blend mode,
+     *        and all of them go back to the pool in BufferPresent(), so a pass that needs a temporary target every
+     *        frame stops creating textures after its first frame.
+     *
+     * The target's contents are left over from its last use. Don't keep it, or draw it, past this frame.
+     *
+     * @return The target, or an invalid Texture if one couldn't be created.
+     */
+    [[nodiscard]] auto AcquireTarget(int width, int height, SDL_PixelFormat format = SDL_PIXELFORMAT_RGBA32,
+                                     SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND) -> Texture;
+
+    // Give a borrowed target back before the frame ends, so a later pass this frame can use it.
+    auto ReleaseTarget(const Texture target) -> bool { return _targets.Release(target); }
+
+    [[nodiscard]] constexpr auto GetTargetPool() -> RenderTargetPool& { return _targets; }
+
+    // Records or screenshots the frames BufferPresent() presents, or while dirty rendering idles, the unchanged back buffer.
+    [[nodiscard]] constexpr auto GetCapture() -> FrameCapture& { return _capture; }
+
     [[nodiscard]] auto GetDrawColor() const -> SDL_FColor {
       SDL_FColor res{};
       SDL_GetRenderDrawColorFloat(_render, &res.r, &res.g, &res.b, &res.a);
@@ -166,7 +288,8 @@ namespace swgtk {
       return res;
     }
 
-    auto SetDrawTarget(Texture texture) const -> bool { return SDL_SetRenderTarget(_render, *texture); }
+    // An invalid Texture targets the output again, which is the back buffer with dirty rendering.
+    auto SetDrawTarget(Texture texture) const -> bool { return SDL_SetRenderTarget(_render, texture == Texture{} ? *_backBuffer : *texture); }
 
     [[nodiscard]] static auto Create() noexcept { return std::make_shared<SDLHW2D>(); }
 
@@ -175,8 +298,28 @@ namespace swgtk {
 #endif
 
   private:
+    // Brings the texture of an SDF bucket up to date with its coverage surface.
+    auto UploadSdfBucket(SdfBucket& bucket) const -> bool;
+
+    // Brings the texture of a tile map chunk up to date with its tiles.
+    auto RenderTileChunk(TileMap& map, int x, int y) -> bool;
+
+    // Makes sure the back buffer matches the output size. A new one has to be drawn in full.
+    auto PrepareBackBuffer() -> bool;
+
     SDL_Renderer* _render = nullptr;
     TTF_Font* _currentFont = nullptr;
+    VertexBuffer _textVertices;
+    SpriteBatch _tileBatch;
+    RenderTargetPool _targets;
+    FrameCapture _capture;
+    DirtyRegion _dirty;
+    Texture _backBuffer;
+    SDL_Rect _redrawRect{};
+    bool _dirtyRendering = false;
+    bool _redrawn = false;
+    bool _presentRequested = false;
+    bool _idle = false;
   };
 } // namespace swgtk
 
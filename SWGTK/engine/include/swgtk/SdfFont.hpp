@@ -0,0 +1,157 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_SDFFONT_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_SDFFONT_HPP_
+
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <cstdint>
+#include <list>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <swgtk/SpriteBatch.hpp>
+#include <swgtk/Surface.hpp>
+#include <swgtk/Texture.hpp>
+#include "SDL3_ttf/SDL_ttf.h"
+
+namespace swgtk {
+
+  // FreeType's default spread: how far, in pixels at the base size, the field reaches past each outline.
+  constexpr inline auto sdfSpread = 8.0f;
+  constexpr inline auto defaultSdfBaseSize = 48.0f;
+  constexpr inline auto defaultSdfBucketLimit = 8uz;
+  constexpr inline auto sdfAtlasWidth = 512;
+
+  struct SdfGlyph {
+    // Where the distance field sits in the atlas. Empty for glyphs with nothing to draw, like spaces.
+    SDL_Rect atlas{};
+
+    // From the pen position and the top of the line to the top-left of the field, at the base size.
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    float advance = 0.0f;
+  };
+
+  /**
+   * @brief The atlas resampled for one text size, white with the glyph coverage in the alpha channel.
+   *
+   * The coverage surface is filled on the CPU as glyphs are added. The renderer uploads it to texture
+   * whenever version moves past uploadedVersion, see SDLHW2D::DrawSdfText().
+   */
+  struct SdfBucket {
+    float size = 0.0f;
+    float scale = 0.0f;
+    Surface coverage;
+    Texture texture;
+    uint64_t version = 0;
+    uint64_t uploadedVersion = 0;
+    size_t glyphs = 0;
+  };
+
+  /**
+    @brief Scalable text from a single signed distance field atlas.
+
+    Glyphs are rendered once at the base size with SDL_ttf's SDF mode, which has FreeType build the distance
+    field from the glyph outlines, and packed into one 8-bit atlas. Any size can be drawn from it.
+
+    SDLHW2D has no shaders to turn distances into edges on the GPU, so each size in use gets a bucket: the
+    atlas resampled on the CPU into plain coverage at that size. Sizes are rounded to a bucket (whole pixels,
+    then steps of 4 above 32) and the quads are scaled the rest of the way. Buckets are capped by
+    SetBucketLimit() and the least recently used one is dropped first.
+   */
+  class SdfFont {
+  public:
+    SdfFont() = default;
+    SdfFont(const SdfFont&) = delete;
+    SdfFont(SdfFont&&) = delete;
+    auto operator=(const SdfFont&) -> SdfFont& = delete;
+    auto operator=(SdfFont&&) -> SdfFont& = delete;
+    ~SdfFont() { Release(); }
+
+    // Copies font with SDF rendering on and sized to baseSize. The font passed in is left alone.
+    auto Load(TTF_Font* font, float baseSize = defaultSdfBaseSize) -> bool;
+
+    // Close the font and destroy the atlas and every bucket.
+    void Release();
+
+    [[nodiscard]] constexpr auto IsLoaded() const -> bool { return _font != nullptr; }
+    [[nodiscard]] constexpr auto GetBaseSize() const -> float { return _baseSize; }
+
+    // Render every glyph in the UTF-8 text that isn't in the atlas yet. Returns how many were added.
+    auto AddGlyphs(std::string_view text) -> size_t;
+
+    // The glyph for a codepoint, rendered into the atlas on first use. nullptr if the font has no such glyph.
+    [[nodiscard]] auto GetGlyph(uint32_t codepoint) -> const SdfGlyph*;
+
+    // The size a bucket is kept at for text drawn at size.
+    [[nodiscard]] auto BucketSize(float size) const -> float;
+
+    // The bucket for size, with any glyphs added since it was last used resampled into it.
+    [[nodiscard]] auto GetBucket(float size) -> SdfBucket*;
+
+    /**
+     * @brief Append a textured quad per glyph of text, laid out from pos (the top-left of the first line).
+     *
+     * @return The bucket whose texture the quads are mapped to, or nullptr if nothing could be laid out.
+     */
+    auto AppendQuads(std::string_view text, SDL_FPoint pos, float size, SDL_FColor color, VertexBuffer& out) -> SdfBucket*;
+
+    // Append the quad for one glyph with its pen position at pen. bucket has to be up to date with the glyph.
+    void AppendGlyph(const SdfGlyph& glyph, SDL_FPoint pen, float size, SDL_FColor color, const SdfBucket& bucket, VertexBuffer& out) const;
+
+    // Distance between baselines, and the kerning between two codepoints, at the base size.
+    [[nodiscard]] constexpr auto GetLineSkip() const -> float { return _lineSkip; }
+    [[nodiscard]] auto GetKerning(uint32_t previous, uint32_t codepoint) const -> float;
+
+    // The width of the longest line and the height of all lines of text at size.
+    [[nodiscard]] auto MeasureText(std::string_view text, float size) -> SDL_FPoint;
+
+    void SetBucketLimit(size_t limit);
+    [[nodiscard]] constexpr auto GetBucketLimit() const -> size_t { return _bucketLimit; }
+    [[nodiscard]] auto GetBucketCount() const -> size_t { return _buckets.size(); }
+
+    // The raw distance field, sdfAtlasWidth texels per row. 128 is the outline, higher is inside.
+    [[nodiscard]] constexpr auto GetDistances() const -> std::span<const uint8_t> { return _distances; }
+    [[nodiscard]] constexpr auto GetAtlasHeight() const -> int { return _atlasHeight; }
+
+  private:
+    auto Rasterize(uint32_t codepoint) -> const SdfGlyph*;
+    auto Pack(int width, int height) -> SDL_Point;
+    void Refresh(SdfBucket& bucket) const;
+    void EvictBuckets(size_t limit);
+
+    TTF_Font* _font = nullptr;
+    float _baseSize = defaultSdfBaseSize;
+    float _ascent = 0.0f;
+    float _lineSkip = 0.0f;
+
+    std::vector<uint8_t> _distances;
+    int _atlasHeight = 0;
+    SDL_Point _shelf{};
+    int _shelfHeight = 0;
+
+    // Glyphs never move once added, so _order can keep pointers to them.
+    std::unordered_map<uint32_t, SdfGlyph> _glyphs;
+    std::vector<const SdfGlyph*> _order;
+
+    // Most recently used at the front.
+    std::list<SdfBucket> _buckets;
+    size_t _bucketLimit = defaultSdfBucketLimit;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_SDFFONT_HPP_
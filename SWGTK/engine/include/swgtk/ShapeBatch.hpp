@@ -0,0 +1,80 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_SHAPEBATCH_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_SHAPEBATCH_HPP_
+
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <cstddef>
+#include <span>
+
+#include <swgtk/SpriteBatch.hpp>
+
+namespace swgtk {
+
+  /**
+   * @brief Tessellates lines, rectangles, circles and convex polygons into one untextured VertexBuffer, so a
+   * frame of debug drawing or vector UI costs a single SDLHW2D::DrawShapes() call.
+   *
+   * Outlines of rectangles and circles are drawn inside their edge, like SDL_RenderRect(). Polygon outlines are
+   * centered on the edges, with mitered corners. Circles get as many segments as their radius needs to stay
+   * within the tolerance of a true circle, so small circles stay cheap and large ones stay round.
+   */
+  class ShapeBatch {
+  public:
+    // Furthest a circle's edge may stray from the true circle, in pixels.
+    static constexpr float defaultTolerance = 0.25f;
+    static constexpr int minCircleSegments = 8;
+    static constexpr int maxCircleSegments = 256;
+
+    void AddLine(SDL_FPoint from, SDL_FPoint to, float thickness = 1.0f, const SDL_FColor& color = whiteFColor);
+
+    /**
+     * @brief Add a line between each pair of points.
+     *
+     * @return The number of lines added. A point left without a partner is ignored.
+     */
+    auto AddLines(std::span<const SDL_FPoint> points, float thickness = 1.0f, const SDL_FColor& color = whiteFColor) -> size_t;
+
+    void AddRect(const SDL_FRect& rect, float thickness = 1.0f, const SDL_FColor& color = whiteFColor);
+    void AddFilledRect(const SDL_FRect& rect, const SDL_FColor& color = whiteFColor);
+
+    void AddCircle(SDL_FPoint center, float radius, float thickness = 1.0f, const SDL_FColor& color = whiteFColor);
+    void AddFilledCircle(SDL_FPoint center, float radius, const SDL_FColor& color = whiteFColor);
+
+    // Both return false, and add nothing, for fewer than three points. Points of a filled polygon must be convex.
+    auto AddPolygon(std::span<const SDL_FPoint> points, float thickness = 1.0f, const SDL_FColor& color = whiteFColor) -> bool;
+    auto AddFilledPolygon(std::span<const SDL_FPoint> points, const SDL_FColor& color = whiteFColor) -> bool;
+
+    // Scale this with the renderer's scale, so circles keep the same quality on screen.
+    void SetTolerance(float pixels);
+    [[nodiscard]] constexpr auto GetTolerance() const -> float { return _tolerance; }
+
+    [[nodiscard]] static auto CircleSegments(float radius, float tolerance = defaultTolerance) -> int;
+
+    void Reserve(const size_t vertices, const size_t indices) { _buffer.Reserve(vertices, indices); }
+    void Clear() { _buffer.Clear(); }
+
+    [[nodiscard]] constexpr auto Buffer() const -> const VertexBuffer& { return _buffer; }
+
+  private:
+    // Joins the corners of a closed band whose vertices were pushed from base as outer, inner pairs.
+    void PushRingIndices(int base, int corners);
+
+    VertexBuffer _buffer;
+    float _tolerance = defaultTolerance;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_SHAPEBATCH_HPP_
@@ -0,0 +1,144 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_SPRITEBATCH_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_SPRITEBATCH_HPP_
+
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <swgtk/Texture.hpp>
+
+namespace swgtk {
+
+  inline constexpr auto whiteFColor = SDL_FColor{.r = 1.0f, .g = 1.0f, .b = 1.0f, .a = 1.0f};
+
+  /**
+   * @brief A packed list of vertices and indices that can be filled once and drawn with a single
+   * SDLHW2D::DrawGeometry() call.
+   *
+   * This exists mainly for Lua, where building a table of Vertex2D userdata is far slower than pushing
+   * plain numbers into a buffer that already lives on the C++ side.
+   */
+  class VertexBuffer {
+  public:
+    // Number of floats per vertex when using AddFlat(): x, y, r, g, b, a, u, v
+    static constexpr size_t flatStride = 8uz;
+
+    void Push(const SDL_Vertex& vertex) { _vertices.push_back(vertex); }
+    void PushIndex(const int index) { _indices.push_back(index); }
+
+    /**
+     * @brief Append vertices from a flat array of floats laid out as x, y, r, g, b, a, u, v.
+     *
+     * @return The number of vertices added. Trailing values that do not form a full vertex are ignored.
+     */
+    auto AddFlat(std::span<const float> values) -> size_t;
+
+    void Reserve(const size_t vertices, const size_t indices) {
+      _vertices.reserve(vertices);
+      _indices.reserve(indices);
+    }
+
+    /**
+     * @brief Make room for this many more vertices and indices before appending them.
+     *
+     * Capacity at least doubles when it has to grow, so appending in many small steps stays linear
+     * where calling Reserve() with the new total each time would copy the buffer on every call.
+     */
+    void Grow(const size_t vertices, const size_t indices) {
+      GrowVector(_vertices, vertices);
+      GrowVector(_indices, indices);
+    }
+
+    void Clear() {
+      _vertices.clear();
+      _indices.clear();
+    }
+
+    [[nodiscard]] constexpr auto Vertices() const -> std::span<const SDL_Vertex> { return _vertices; }
+    [[nodiscard]] constexpr auto Indices() const -> std::span<const int> { return _indices; }
+    [[nodiscard]] constexpr auto Size() const -> size_t { return _vertices.size(); }
+
+  private:
+    template<typename T>
+    static void GrowVector(std::vector<T>& vector, const size_t more) {
+      if (const auto needed = vector.size() + more; needed > vector.capacity()) {
+        vector.reserve(std::max(needed, vector.capacity() * 2uz));
+      }
+    }
+
+    std::vector<SDL_Vertex> _vertices;
+    std::vector<int> _indices;
+  };
+
+  /**
+   * @brief Collects many textured quads that share one Texture and draws them with one SDL_RenderGeometry() call.
+   *
+   * Source rectangles are in texel coordinates, like SDLHW2D::DrawTexture(). An empty source rectangle uses
+   * the whole texture. Rotations are in degrees around the center of the destination rectangle.
+   */
+  class SpriteBatch {
+  public:
+    // Number of floats per sprite when using AddFlat(): src x, y, w, h, dest x, y, w, h
+    static constexpr size_t flatStride = 8uz;
+
+    SpriteBatch() = default;
+    explicit SpriteBatch(const Texture texture, const size_t reserve = 0uz) {
+      SetTexture(texture);
+      Reserve(reserve);
+    }
+
+    void SetTexture(Texture texture);
+    [[nodiscard]] constexpr auto GetTexture() const -> Texture { return _texture; }
+
+    void Add(const SDL_FRect& src, const SDL_FRect& dest, const SDL_FColor& color = whiteFColor);
+    void Add(const SDL_FRect& src, const SDL_FRect& dest, double angle, const SDL_FColor& color = whiteFColor);
+
+    /**
+     * @brief Append sprites from a flat array of floats laid out as src x, y, w, h, dest x, y, w, h.
+     *
+     * @return The number of sprites added. Trailing values that do not form a full sprite are ignored.
+     */
+    auto AddFlat(std::span<const float> values, const SDL_FColor& color = whiteFColor) -> size_t;
+
+    void Reserve(size_t sprites);
+
+    // Make room for this many more sprites, growing geometrically like VertexBuffer::Grow().
+    void Grow(size_t sprites);
+
+    void Clear() { _buffer.Clear(); }
+
+    [[nodiscard]] constexpr auto Size() const -> size_t { return _buffer.Size() / verticesPerSprite; }
+    [[nodiscard]] constexpr auto Buffer() const -> const VertexBuffer& { return _buffer; }
+
+  private:
+    static constexpr size_t verticesPerSprite = 4uz;
+    static constexpr size_t indicesPerSprite = 6uz;
+
+    void PushQuad(const SDL_FRect& src, const std::array<SDL_FPoint, verticesPerSprite>& corners, const SDL_FColor& color);
+
+    Texture _texture;
+    VertexBuffer _buffer;
+    float _texWidth = 1.0f;
+    float _texHeight = 1.0f;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_SPRITEBATCH_HPP_
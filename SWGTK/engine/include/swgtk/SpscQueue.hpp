@@ -0,0 +1,168 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_SPSCQUEUE_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_SPSCQUEUE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace swgtk {
+
+  // Kept apart so the producer and consumer don't share a cache line. 64 bytes covers the targets we build for;
+  // std::hardware_destructive_interference_size changes with compiler flags, which GCC warns about in headers.
+  constexpr inline auto cacheLineSize = 64uz;
+
+  /**
+    @brief A fixed size, lock-free queue between exactly one producer thread and one consumer thread.
+
+    TryPush() may only be called from the producer and TryPop() only from the consumer. Neither blocks,
+    allocates or takes a lock, so the consumer can be a real-time thread such as SDL's audio callback.
+
+    Each side keeps a cached copy of the other side's index and only reads the shared one when the cache
+    says the queue is full (or empty), so the two threads rarely touch each other's cache line.
+   */
+  template<typename T, size_t Capacity>
+    requires(std::has_single_bit(Capacity) && std::is_trivially_copyable_v<T>)
+  class SpscQueue {
+  public:
+    // Returns false, and drops value, if the queue is full.
+    auto TryPush(const T& value) -> bool {
+      const auto head = _head.load(std::memory_order_relaxed);
+
+      if (head - _cachedTail == Capacity) {
+        _cachedTail = _tail.load(std::memory_order_acquire);
+
+        if (head - _cachedTail == Capacity) {
+          return false;
+        }
+      }
+
+      _items[head & mask] = value;
+      _head.store(head + 1uz, std::memory_order_release);
+
+      return true;
+    }
+
+    [[nodiscard]] auto TryPop() -> std::optional<T> {
+      const auto tail = _tail.load(std::memory_order_relaxed);
+
+      if (tail == _cachedHead) {
+        _cachedHead = _head.load(std::memory_order_acquire);
+
+        if (tail == _cachedHead) {
+          return std::nullopt;
+        }
+      }
+
+      const T value = _items[tail & mask];
+      _tail.store(tail + 1uz, std::memory_order_release);
+
+      return value;
+    }
+
+    // Only exact while neither side is running; otherwise a snapshot that may already be stale.
+    [[nodiscard]] auto Size() const -> size_t {
+      // The tail never passes the head, so reading it first can't give a negative size.
+      const auto tail = _tail.load(std::memory_order_acquire);
+      return _head.load(std::memory_order_acquire) - tail;
+    }
+
+    [[nodiscard]] auto IsEmpty() const -> bool { return Size() == 0uz; }
+    [[nodiscard]] static constexpr auto GetCapacity() -> size_t { return Capacity; }
+
+  private:
+    static constexpr auto mask = Capacity - 1uz;
+
+    // Written by the producer.
+    alignas(cacheLineSize) std::atomic<size_t> _head = 0uz;
+    size_t _cachedTail = 0uz;
+
+    // Written by the consumer.
+    alignas(cacheLineSize) std::atomic<size_t> _tail = 0uz;
+    size_t _cachedHead = 0uz;
+
+    alignas(cacheLineSize) std::array<T, Capacity> _items{};
+  };
+
+  /**
+    @brief A lock-free ring of values between one producer thread and one consumer thread, moved in bulk.
+
+    Like SpscQueue, but sized at run time (rounded up to a power of two) and written and read a span at a
+    time, for streams of samples. The buffer is allocated once, in the constructor.
+   */
+  template<typename T>
+    requires std::is_trivially_copyable_v<T>
+  class SpscRingBuffer {
+  public:
+    explicit SpscRingBuffer(const size_t capacity) : _items(std::bit_ceil(std::max(capacity, 1uz))), _mask(_items.size() - 1uz) {}
+
+    // Producer only. Copies as much of values as there is room for and returns how many that was.
+    auto Write(const std::span<const T> values) -> size_t {
+      const auto head = _head.load(std::memory_order_relaxed);
+      const auto count = std::min(values.size(), _items.size() - (head - _tail.load(std::memory_order_acquire)));
+      const auto start = head & _mask;
+      const auto first = std::min(count, _items.size() - start);
+
+      std::ranges::copy(values.first(first), _items.begin() + static_cast<std::ptrdiff_t>(start));
+      std::ranges::copy(values.subspan(first, count - first), _items.begin());
+
+      _head.store(head + count, std::memory_order_release);
+      return count;
+    }
+
+    // Consumer only. Fills as much of out as there are values for and returns how many that was.
+    auto Read(const std::span<T> out) -> size_t {
+      const auto tail = _tail.load(std::memory_order_relaxed);
+      const auto count = std::min(out.size(), _head.load(std::memory_order_acquire) - tail);
+      const auto start = tail & _mask;
+      const auto first = std::min(count, _items.size() - start);
+      const auto items = std::span<const T>{_items};
+
+      std::ranges::copy(items.subspan(start, first), out.begin());
+      std::ranges::copy(items.first(count - first), out.begin() + static_cast<std::ptrdiff_t>(first));
+
+      _tail.store(tail + count, std::memory_order_release);
+      return count;
+    }
+
+    // Empty the buffer. Only while neither side is running.
+    void Clear() {
+      _head.store(0uz, std::memory_order_relaxed);
+      _tail.store(0uz, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto Size() const -> size_t {
+      const auto tail = _tail.load(std::memory_order_acquire);
+      return _head.load(std::memory_order_acquire) - tail;
+    }
+
+    [[nodiscard]] auto GetFreeSpace() const -> size_t { return _items.size() - Size(); }
+    [[nodiscard]] auto GetCapacity() const -> size_t { return _items.size(); }
+
+  private:
+    alignas(cacheLineSize) std::atomic<size_t> _head = 0uz;
+    alignas(cacheLineSize) std::atomic<size_t> _tail = 0uz;
+
+    std::vector<T> _items;
+    size_t _mask = 0uz;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_SPSCQUEUE_HPP_
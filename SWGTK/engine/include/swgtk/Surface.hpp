@@ -15,65 +15,326 @@
 
 #include <SDL3/SDL_pixels.h>
 #include <SDL3/SDL_surface.h>
-#include <memory>
+#include <bit>
+#include <cstring>
 #include <span>
+#include <string>
+#include <string_view>
+#include <utility>
 
+#include <swgtk/HandlePool.hpp>
+#include <swgtk/PixelView.hpp>
 #include <swgtk/Utility.hpp>
 
 namespace swgtk {
+  using SurfacePool = HandlePool<SDL_Surface, SDL_DestroySurface>;
+
+  // The process-wide registry that owns every SDL_Surface wrapped by a Surface handle.
+  [[nodiscard]] inline auto SurfaceRegistry() -> SurfacePool& {
+    static SurfacePool pool;
+    return pool;
+  }
+
+  class SurfaceLock;
 
   /**
-      @brief A reference-counted RAII wrapper for the SDL_Surface type.
+      @brief A trivially copyable handle to a SDL_Surface.
 
-      Unlike Texture, Surface provides a number of constructors that cover the majority of use cases.
+      Unlike Texture, Surface provides a number of constructors that cover the majority of use cases. Every constructor
+      registers a new SDL_Surface with the SurfaceRegistry(); copies of a Surface refer to the same pixels.
+
+      Surfaces are destroyed explicitly with Destroy() or DestroyDeferred(). Deferred surfaces are released at the start
+      of the next frame, and the App releases any surface still alive when it shuts down. A UniqueSurface destroys its
+      surface when it goes out of scope instead. Destroying a locked surface is always deferred.
    */
   class Surface {
-    static void DestroySurface(SDL_Surface* surface) { SDL_DestroySurface(surface); }
     static constexpr uint8_t whiteColorValue = 255u;
 
   public:
     constexpr Surface() = default;
     explicit Surface(SDL_Surface* surface) :
-        _surface(SDL_DuplicateSurface(surface), Surface::DestroySurface) {}
+        _id(SurfaceRegistry().Insert(SDL_DuplicateSurface(surface))) {}
 
     Surface(const int width, const int height, const SDL_PixelFormat format = SDL_PIXELFORMAT_RGBA32) :
-        _surface(SDL_CreateSurface(width, height, format), Surface::DestroySurface) {
-      if (!_surface) {
+        _id(SurfaceRegistry().Insert(SDL_CreateSurface(width, height, format))) {
+      if (_id == nullHandle) {
         DEBUG_PRINT("Failed to create surface: {}\n", SDL_GetError())
       }
     }
 
     Surface(const int width, const int height, const SDL_PixelFormat format, void* pixels, const int pitch) :
-        _surface(SDL_CreateSurfaceFrom(width, height, format, pixels, pitch), Surface::DestroySurface) {
-      if (!_surface) {
+        _id(SurfaceRegistry().Insert(SDL_CreateSurfaceFrom(width, height, format, pixels, pitch))) {
+      if (_id == nullHandle) {
         DEBUG_PRINT("Failed to create surface: {}\n", SDL_GetError())
       }
     }
 
-    [[nodiscard]] auto operator*() const -> SDL_Surface* { return _surface.get(); }
+    [[nodiscard]] auto operator*() const -> SDL_Surface* { return SurfaceRegistry().Get(_id); }
+    [[nodiscard]] constexpr auto GetID() const -> HandleID { return _id; }
+    [[nodiscard]] auto IsValid() const -> bool { return SurfaceRegistry().IsValid(_id); }
+    [[nodiscard]] constexpr auto operator==(const Surface& other) const -> bool = default;
 
-    void Clear(const SDL_FColor& color = SDL_FColor{.r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f}) const { SDL_ClearSurface(_surface.get(), color.r, color.g, color.b, color.a); }
+    // A locked surface is only queued, so the SurfaceLock on it keeps working until the end of the frame.
+    void Destroy() const {
+      if (IsLocked()) {
+        DestroyDeferred();
+      } else {
+        SurfaceRegistry().Destroy(_id);
+      }
+    }
+
+    void DestroyDeferred() const { SurfaceRegistry().DestroyDeferred(_id); }
+
+    [[nodiscard]] auto IsLocked() const -> bool {
+      const auto* surface = **this;
+      return surface != nullptr && (surface->flags & SDL_SURFACE_LOCKED) != 0u;
+    }
+
+    // Lock the pixels for direct access. Much faster than ReadPixel() and DrawPixel() for more than a few pixels.
+    [[nodiscard]] auto Lock() const -> SurfaceLock;
+
+    // A new surface with the same pixels in another format, converted in one pass.
+    [[nodiscard]] auto Convert(const SDL_PixelFormat format) const -> Surface { return Adopt(SDL_ConvertSurface(**this, format)); }
+
+    void Clear(const SDL_FColor& color = SDL_FColor{.r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f}) const { SDL_ClearSurface(**this, color.r, color.g, color.b, color.a); }
 
     [[nodiscard]] auto ReadPixel(const int x, const int y) const -> SDL_FColor {
       float r{}, g{}, b{}, a{};
-      SDL_ReadSurfacePixelFloat(_surface.get(), x, y, &r, &g, &b, &a);
+      SDL_ReadSurfacePixelFloat(**this, x, y, &r, &g, &b, &a);
       return SDL_FColor{.r = r, .g = g, .b = b, .a = a};
     }
 
-    void DrawPixel(const int x, const int y, const SDL_FColor& color = SDL_FColor{.r = 1.0f, .g = 1.0f, .b = 1.0f, .a = 1.0f}) const { SDL_WriteSurfacePixelFloat(_surface.get(), x, y, color.r, color.g, color.b, color.a); }
+    void DrawPixel(const int x, const int y, const SDL_FColor& color = SDL_FColor{.r = 1.0f, .g = 1.0f, .b = 1.0f, .a = 1.0f}) const { SDL_WriteSurfacePixelFloat(**this, x, y, color.r, color.g, color.b, color.a); }
 
     void FillRect(const SDL_Rect& rect, const SDL_Color& color = SDL_Color{.r = whiteColorValue, .g = whiteColorValue, .b = whiteColorValue, .a = whiteColorValue}) const {
-      SDL_FillSurfaceRect(_surface.get(), &rect, SDL_MapSurfaceRGBA(_surface.get(), color.r, color.g, color.b, color.a));
+      auto* surface = **this;
+      SDL_FillSurfaceRect(surface, &rect, SDL_MapSurfaceRGBA(surface, color.r, color.g, color.b, color.a));
     }
 
     void FillRects(const std::span<SDL_Rect> rects, const SDL_Color& color = SDL_Color{.r = whiteColorValue, .g = whiteColorValue, .b = whiteColorValue, .a = whiteColorValue}) const {
-      SDL_FillSurfaceRects(_surface.get(), rects.data(), static_cast<int>(std::ssize(rects)),
-                           SDL_MapSurfaceRGBA(_surface.get(), color.r, color.g, color.b, color.a));
+      auto* surface = **this;
+      SDL_FillSurfaceRects(surface, rects.data(), static_cast<int>(std::ssize(rects)),
+                           SDL_MapSurfaceRGBA(surface, color.r, color.g, color.b, color.a));
+    }
+
+  private:
+    // Register a surface SDL has just created for us, without duplicating it.
+    [[nodiscard]] static auto Adopt(SDL_Surface* surface) -> Surface {
+      Surface result;
+      result._id = SurfaceRegistry().Insert(surface);
+
+      if (result._id == nullHandle) {
+        DEBUG_PRINT("Failed to create surface: {}\n", SDL_GetError())
+      }
+
+      return result;
+    }
+
+    HandleID _id = nullHandle;
+  };
+
+  // A Surface destroyed when it goes out of scope. Surfaces made from Lua are these, so the garbage collector frees them.
+  using UniqueSurface = UniqueHandle<Surface>;
+
+  /**
+      @brief Keeps a surface locked and gives direct access to its pixels.
+
+      Pixels can be reached through a typed PixelView, or one at a time as raw values in the surface's own
+      format. MapRGBA() converts a color to that raw value once, so a loop only writes integers.
+
+      The lock is released when this object is destroyed or Unlock() is called. It holds the Surface handle
+      rather than the SDL_Surface, so if the surface is destroyed anyway the lock reads as unlocked and stops
+      touching it. Views taken from it are plain pointers and must not outlive the surface.
+   */
+  class SurfaceLock {
+  public:
+    constexpr SurfaceLock() = default;
+    explicit SurfaceLock(const Surface surface) {
+      if (auto* locked = *surface; locked != nullptr && SDL_LockSurface(locked)) {
+        _surface = surface;
+      } else {
+        DEBUG_PRINT("Failed to lock surface: {}\n", SDL_GetError())
+      }
+    }
+
+    SurfaceLock(const SurfaceLock&) = delete;
+    SurfaceLock(SurfaceLock&& other) noexcept : _surface(std::exchange(other._surface, Surface{})) {}
+    auto operator=(const SurfaceLock&) -> SurfaceLock& = delete;
+    auto operator=(SurfaceLock&& other) noexcept -> SurfaceLock& {
+      if (this != &other) {
+        Unlock();
+        _surface = std::exchange(other._surface, Surface{});
+      }
+
+      return *this;
+    }
+
+    ~SurfaceLock() { Unlock(); }
+
+    void Unlock() {
+      if (auto* surface = *_surface; surface != nullptr) {
+        SDL_UnlockSurface(surface);
+      }
+
+      _surface = Surface{};
+    }
+
+    [[nodiscard]] auto IsLocked() const -> bool { return _surface.IsValid(); }
+
+    [[nodiscard]] auto Width() const -> int {
+      const auto* surface = *_surface;
+      return (surface != nullptr) ? surface->w : 0;
+    }
+
+    [[nodiscard]] auto Height() const -> int {
+      const auto* surface = *_surface;
+      return (surface != nullptr) ? surface->h : 0;
+    }
+
+    [[nodiscard]] auto Pitch() const -> int {
+      const auto* surface = *_surface;
+      return (surface != nullptr) ? surface->pitch : 0;
+    }
+
+    [[nodiscard]] auto Format() const -> SDL_PixelFormat {
+      const auto* surface = *_surface;
+      return (surface != nullptr) ? surface->format : SDL_PIXELFORMAT_UNKNOWN;
+    }
+
+    [[nodiscard]] auto BytesPerPixel() const -> int { return SDL_BYTESPERPIXEL(Format()); }
+
+    /**
+        @brief A typed view of the pixels.
+
+        T must be one of the Pixel* layouts for exactly this format, or an integer as wide as one pixel
+        (uint32_t for the packed 32-bit formats, for example).
+
+        @return An empty view if the surface is not locked or T does not fit the format.
+     */
+    template <PixelType T>
+    [[nodiscard]] auto View() const -> PixelView<T> {
+      auto* surface = *_surface;
+
+      if (surface == nullptr) {
+        return PixelView<T>{};
+      }
+
+      if constexpr (FormatPixel<std::remove_const_t<T>>) {
+        if (std::remove_const_t<T>::format != surface->format) {
+          DEBUG_PRINT("Pixel type does not match surface format {}\n", SDL_GetPixelFormatName(surface->format))
+          return PixelView<T>{};
+        }
+      } else if (sizeof(T) != static_cast<size_t>(SDL_BYTESPERPIXEL(surface->format))) {
+        DEBUG_PRINT("Pixel type is not the size of a {} pixel\n", SDL_GetPixelFormatName(surface->format))
+        return PixelView<T>{};
+      }
+
+      return PixelView<T>{static_cast<std::byte*>(surface->pixels), surface->w, surface->h, surface->pitch};
+    }
+
+    // Convert a color to a raw pixel value in this surface's format, or 0 if it is no longer locked.
+    [[nodiscard]] auto MapRGBA(const uint8_t r, const uint8_t g, const uint8_t b, const uint8_t a) const -> uint32_t {
+      auto* surface = *_surface;
+      return (surface != nullptr) ? SDL_MapSurfaceRGBA(surface, r, g, b, a) : 0u;
+    }
+
+    // Split a raw pixel value in this surface's format into a color.
+    [[nodiscard]] auto GetRGBA(const uint32_t pixel) const -> SDL_Color {
+      SDL_Color color{};
+
+      if (auto* surface = *_surface; surface != nullptr) {
+        SDL_GetRGBA(pixel, SDL_GetPixelFormatDetails(surface->format), SDL_GetSurfacePalette(surface), &color.r, &color.g, &color.b, &color.a);
+      }
+
+      return color;
+    }
+
+    [[nodiscard]] auto Contains(const int x, const int y) const -> bool { return x >= 0 && y >= 0 && x < Width() && y < Height(); }
+
+    // Read one pixel as a raw value, or 0 if the surface is no longer locked. The coordinates are not checked.
+    [[nodiscard]] auto ReadRaw(const int x, const int y) const -> uint32_t {
+      const auto* surface = *_surface;
+      uint32_t pixel = 0u;
+
+      if (surface == nullptr) {
+        return pixel;
+      }
+
+      const auto bytes = static_cast<size_t>(SDL_BYTESPERPIXEL(surface->format));
+      std::memcpy(&pixel, PixelAddress(surface, x, y), bytes);
+
+      if constexpr (std::endian::native == std::endian::big) {
+        pixel >>= (sizeof(pixel) - bytes) * 8uz;
+      }
+
+      return pixel;
+    }
+
+    // Write one raw pixel value, unless the surface is no longer locked. The coordinates are not checked.
+    void WriteRaw(const int x, const int y, uint32_t pixel) const {
+      const auto* surface = *_surface;
+
+      if (surface == nullptr) {
+        return;
+      }
+
+      const auto bytes = static_cast<size_t>(SDL_BYTESPERPIXEL(surface->format));
+
+      if constexpr (std::endian::native == std::endian::big) {
+        pixel <<= (sizeof(pixel) - bytes) * 8uz;
+      }
+
+      std::memcpy(PixelAddress(surface, x, y), &pixel, bytes);
+    }
+
+    // Copy the pixels out, row after row without padding.
+    [[nodiscard]] auto ReadBytes() const -> std::string {
+      const auto* surface = *_surface;
+
+      if (surface == nullptr) {
+        return std::string{};
+      }
+
+      const auto rowBytes = static_cast<size_t>(surface->w) * static_cast<size_t>(SDL_BYTESPERPIXEL(surface->format));
+      auto bytes = std::string(rowBytes * static_cast<size_t>(surface->h), '\0');
+
+      for (auto y = 0; y < surface->h; ++y) {
+        std::memcpy(bytes.data() + (rowBytes * static_cast<size_t>(y)), PixelAddress(surface, 0, y), rowBytes); // NOLINT(*-pointer-arithmetic)
+      }
+
+      return bytes;
+    }
+
+    // Copy pixels in, laid out like ReadBytes(). Returns false if the size does not match.
+    auto WriteBytes(const std::string_view bytes) const -> bool {
+      const auto* surface = *_surface;
+
+      if (surface == nullptr) {
+        return false;
+      }
+
+      const auto rowBytes = static_cast<size_t>(surface->w) * static_cast<size_t>(SDL_BYTESPERPIXEL(surface->format));
+
+      if (bytes.size() != rowBytes * static_cast<size_t>(surface->h)) {
+        return false;
+      }
+
+      for (auto y = 0; y < surface->h; ++y) {
+        std::memcpy(PixelAddress(surface, 0, y), bytes.data() + (rowBytes * static_cast<size_t>(y)), rowBytes); // NOLINT(*-pointer-arithmetic)
+      }
+
+      return true;
     }
 
   private:
-    std::shared_ptr<SDL_Surface> _surface;
+    [[nodiscard]] static auto PixelAddress(const SDL_Surface* surface, const int x, const int y) -> std::byte* {
+      return static_cast<std::byte*>(surface->pixels) + (static_cast<ptrdiff_t>(y) * surface->pitch) + (static_cast<ptrdiff_t>(x) * SDL_BYTESPERPIXEL(surface->format)); // NOLINT(*-pointer-arithmetic)
+    }
+
+    Surface _surface;
   };
+
+  inline auto Surface::Lock() const -> SurfaceLock { return SurfaceLock{*this}; }
 } // namespace swgtk
 
 #endif // SWGTK_ENGINE_INCLUDE_SWGTK_SURFACE_HPP_
@@ -0,0 +1,75 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_SURFACEOPS_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_SURFACEOPS_HPP_
+
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <cstdint>
+#include <swgtk/Surface.hpp>
+
+/*
+  Software raster kernels for CPU-side compositing.
+
+  Every kernel works on 32-bit surfaces that keep alpha in the top byte of the pixel value (Ashift == 24):
+  RGBA32, BGRA32, ARGB32, ABGR32, ARGB8888 and ABGR8888. Blits need both surfaces in the same format. Anything
+  else is refused with false; Surface::Convert() first.
+
+  The per-pixel kernels have SSE2 and AVX2 versions chosen at run time, with a scalar version everywhere else.
+  All versions round the same way, so they produce identical pixels.
+*/
+namespace swgtk {
+
+  enum class SimdLevel : uint8_t {
+    Scalar,
+    SSE2,
+    AVX2,
+  };
+
+  enum class ScaleFilter : uint8_t {
+    Nearest,
+    Bilinear,
+  };
+
+  // The instruction set the kernels use. Detected on first use.
+  [[nodiscard]] auto GetSimdLevel() -> SimdLevel;
+
+  // Use a lower instruction set than the one detected, for testing and benchmarks. Returns the level now in use.
+  auto SetSimdLevel(SimdLevel level) -> SimdLevel;
+
+  /**
+   * @brief Draw source over dest with straight (non-premultiplied) alpha, like SDL_BLENDMODE_BLEND.
+   *
+   * @param sourceRect The part of the source to draw, or nullptr for all of it.
+   * @param x, y Where the top-left corner lands in dest. The blit is clipped to both surfaces.
+   */
+  auto BlitBlend(const Surface& source, const SDL_Rect* sourceRect, const Surface& dest, int x, int y) -> bool;
+
+  // Copy every source pixel whose color (ignoring alpha) is not the key.
+  auto BlitColorKey(const Surface& source, const SDL_Rect* sourceRect, const Surface& dest, int x, int y, SDL_Color key) -> bool;
+
+  // Copy source into destRect (nullptr for all of dest), resampling to fit. Pixels are copied, not blended.
+  auto BlitScaled(const Surface& source, const SDL_Rect* sourceRect, const Surface& dest, const SDL_Rect* destRect, ScaleFilter filter = ScaleFilter::Bilinear) -> bool;
+
+  // Multiply the color channels by alpha, for premultiplied blending and filtering without dark fringes.
+  auto Premultiply(const Surface& surface) -> bool;
+
+  // Undo Premultiply(). Precision lost in dark, transparent pixels is not recovered. Scalar only.
+  auto Unpremultiply(const Surface& surface) -> bool;
+
+  // Multiply every channel, alpha included, by a color.
+  auto Tint(const Surface& surface, SDL_Color color) -> bool;
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_SURFACEOPS_HPP_
@@ -0,0 +1,148 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_TEXTLAYOUT_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_TEXTLAYOUT_HPP_
+
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_rect.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <swgtk/SdfFont.hpp>
+#include <swgtk/SpriteBatch.hpp>
+
+namespace swgtk {
+
+  constexpr inline auto defaultTextLayoutSize = 16.0f;
+
+  // One laid out line. offset and length are bytes of the layout's text, y and width are in pixels.
+  struct TextLine {
+    size_t offset = 0;
+    size_t length = 0;
+    float y = 0.0f;
+    float width = 0.0f;
+  };
+
+  /**
+    @brief Word wrapped text for an SdfFont that is kept laid out between edits.
+
+    The text is stored as paragraphs (split on '\n'), each with its glyph positions and line breaks. An edit
+    only reshapes the paragraphs it touches, and appending to the last paragraph only re-wraps its last line,
+    so a growing log costs time in proportion to what is added rather than to everything already there.
+    Drawing emits quads for the visible lines only.
+
+    Offsets are in bytes of the UTF-8 text and should fall on codepoint boundaries, like the ones HitTest()
+    returns. The layout points into the font's glyphs, so keep the font loaded for as long as the layout.
+   */
+  class TextLayout {
+  public:
+    TextLayout() = default;
+    explicit TextLayout(SdfFont* font, const float size = defaultTextLayoutSize, const float wrapWidth = 0.0f) :
+        _font(font), _size(size), _wrapWidth(wrapWidth) {}
+
+    // Changing the font, size or wrap width lays out all of the text again.
+    void SetFont(SdfFont* font, float size);
+    void SetWrapWidth(float width);
+
+    [[nodiscard]] constexpr auto GetSize() const -> float { return _size; }
+    [[nodiscard]] constexpr auto GetWrapWidth() const -> float { return _wrapWidth; }
+
+    void SetText(std::string_view text);
+    void Append(std::string_view text);
+    void Insert(size_t offset, std::string_view text);
+    void Erase(size_t offset, size_t count);
+    void Clear() { SetText({}); }
+
+    // Copies the text out of its paragraphs.
+    [[nodiscard]] auto GetText() const -> std::string;
+    [[nodiscard]] constexpr auto GetTextLength() const -> size_t { return _length; }
+
+    [[nodiscard]] auto GetLineCount() const -> size_t;
+    [[nodiscard]] auto GetLine(size_t index) const -> TextLine;
+    [[nodiscard]] auto GetLineHeight() const -> float;
+
+    // The width of the longest line and the height of every line. Walks all the lines.
+    [[nodiscard]] auto Measure() const -> SDL_FPoint;
+
+    // The offset of the caret position nearest to point, which is relative to the top-left of the text.
+    [[nodiscard]] auto HitTest(SDL_FPoint point) const -> size_t;
+
+    // Where a caret before the byte at offset goes, one pixel wide and a line high.
+    [[nodiscard]] auto GetCaretRect(size_t offset) const -> SDL_FRect;
+
+    /**
+     * @brief Append a quad per glyph on the lines that overlap [top, bottom), with the text's top-left at pos.
+     *        top and bottom are relative to the text, so pass the scroll position and the view height.
+     *
+     * @return The bucket whose texture the quads are mapped to, or nullptr if there was nothing to lay out.
+     */
+    auto AppendQuads(SDL_FPoint pos, SDL_FColor color, VertexBuffer& out, float top = 0.0f,
+                     float bottom = std::numeric_limits<float>::max()) const -> SdfBucket*;
+
+  private:
+    struct LayoutGlyph {
+      const SdfGlyph* glyph = nullptr;
+      uint32_t codepoint = 0;
+      size_t byte = 0;
+      float x = 0.0f;
+      float advance = 0.0f;
+    };
+
+    // Glyphs [first, last) of the paragraph. Trailing spaces hang past width.
+    struct LayoutLine {
+      size_t first = 0;
+      size_t last = 0;
+      float width = 0.0f;
+    };
+
+    struct Paragraph {
+      std::string text;
+      std::vector<LayoutGlyph> glyphs;
+
+      // An empty paragraph is still one empty line.
+      std::vector<LayoutLine> lines = std::vector<LayoutLine>(1uz);
+
+      // Where the paragraph starts in the whole text, kept by UpdateStarts().
+      size_t byte = 0;
+      size_t line = 0;
+    };
+
+    // Shape the text from byte on, after the glyphs already there.
+    void Shape(Paragraph& paragraph, size_t byte) const;
+
+    // Break the paragraph into lines again, keeping the first fromLine lines.
+    void Wrap(Paragraph& paragraph, size_t fromLine) const;
+
+    void Relayout(Paragraph& paragraph) const;
+    void UpdateStarts(size_t from);
+
+    // The paragraph holding offset and the offset inside it.
+    [[nodiscard]] auto Locate(size_t offset) const -> std::pair<size_t, size_t>;
+    [[nodiscard]] auto FindLine(size_t line) const -> std::pair<size_t, size_t>;
+    [[nodiscard]] auto LineStartX(const Paragraph& paragraph, const LayoutLine& line) const -> float;
+
+    SdfFont* _font = nullptr;
+    float _size = defaultTextLayoutSize;
+    float _wrapWidth = 0.0f;
+
+    std::vector<Paragraph> _paragraphs = std::vector<Paragraph>(1uz);
+    size_t _length = 0;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_TEXTLAYOUT_HPP_
@@ -15,48 +15,70 @@
 
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_surface.h>
-#include <memory>
 #include <utility>
 
+#include <swgtk/HandlePool.hpp>
+
 namespace swgtk {
+  using TexturePool = HandlePool<SDL_Texture, SDL_DestroyTexture>;
+
+  // The process-wide registry that owns every SDL_Texture wrapped by a Texture handle.
+  [[nodiscard]] inline auto TextureRegistry() -> TexturePool& {
+    static TexturePool pool;
+    return pool;
+  }
+
   /**
-    @brief A simple, reference-counted, RAII container class for SDL_Texture.
+    @brief A trivially copyable handle to a SDL_Texture.
+
+    When creating a SDL_Texture, you are responsible for calling the appropriate SDL function for your use case. The
+    Texture constructor hands ownership of the SDL_Texture to the TextureRegistry(). Copying a Texture only copies the
+    handle, so it is cheap to pass by value and to move in and out of Lua.
 
-    When creating a SDL_Texture, you are responsible for calling the appropriate SDL function for your use case. However,
-    the Texture class will reference count your SDL_Texture and clean it up for you when all references are destroyed.
+    Textures are destroyed explicitly with Destroy(), or with DestroyDeferred() when the texture may still be referenced
+    by draw calls queued this frame. Deferred textures are released by the renderer when the frame is presented. Any
+    texture still alive is released when the rendering device is destroyed. To tie a texture to a scope or an object
+    instead, hold it in a UniqueTexture. Get() returns the raw SDL_Texture, which is only valid while the handle is.
   */
   class Texture {
-    static void DestroyTexture(SDL_Texture* texture) { SDL_DestroyTexture(texture); }
-
   public:
-    Texture() = default;
+    constexpr Texture() = default;
     explicit Texture(SDL_Texture* texture) :
-        _texture(std::shared_ptr<SDL_Texture>{texture, Texture::DestroyTexture}) {}
+        _id(TextureRegistry().Insert(texture)) {}
+
+    [[nodiscard]] auto operator*() const -> SDL_Texture* { return TextureRegistry().Get(_id); }
+    [[nodiscard]] auto Get() const -> SDL_Texture* { return TextureRegistry().Get(_id); }
+    [[nodiscard]] constexpr auto GetID() const -> HandleID { return _id; }
+    [[nodiscard]] auto IsValid() const -> bool { return TextureRegistry().IsValid(_id); }
+    [[nodiscard]] constexpr auto operator==(const Texture& other) const -> bool = default;
 
-    [[nodiscard]] auto operator*(this auto&& self) { return self._texture.get(); }
-    [[nodiscard]] auto Get(this auto&& self) { return self._texture; }
+    void Destroy() const { TextureRegistry().Destroy(_id); }
+    void DestroyDeferred() const { TextureRegistry().DestroyDeferred(_id); }
 
-    void SetBlendMode(const SDL_BlendMode mode) const { SDL_SetTextureBlendMode(_texture.get(), mode); }
+    void SetBlendMode(const SDL_BlendMode mode) const { SDL_SetTextureBlendMode(Get(), mode); }
 
     void SetTint(const SDL_FColor& color) const {
-      SDL_SetTextureColorModFloat(_texture.get(), color.r, color.g, color.b);
-      SDL_SetTextureAlphaModFloat(_texture.get(), color.a);
+      auto* texture = Get();
+
+      SDL_SetTextureColorModFloat(texture, color.r, color.g, color.b);
+      SDL_SetTextureAlphaModFloat(texture, color.a);
     }
 
-    void SetScaleMode(const SDL_ScaleMode mode) const { SDL_SetTextureScaleMode(_texture.get(), mode); }
+    void SetScaleMode(const SDL_ScaleMode mode) const { SDL_SetTextureScaleMode(Get(), mode); }
 
     [[nodiscard]] auto GetBlendMode() const -> SDL_BlendMode {
       SDL_BlendMode blend{};
 
-      SDL_GetTextureBlendMode(_texture.get(), &blend);
+      SDL_GetTextureBlendMode(Get(), &blend);
       return blend;
     }
 
     [[nodiscard]] auto GetTint() const -> SDL_FColor {
       SDL_FColor color{};
+      auto* texture = Get();
 
-      SDL_GetTextureColorModFloat(_texture.get(), &color.r, &color.g, &color.b);
-      SDL_GetTextureAlphaModFloat(_texture.get(), &color.a);
+      SDL_GetTextureColorModFloat(texture, &color.r, &color.g, &color.b);
+      SDL_GetTextureAlphaModFloat(texture, &color.a);
 
       return color;
     }
@@ -64,7 +86,7 @@ namespace swgtk {
     [[nodiscard]] auto GetScaleMode() const -> SDL_ScaleMode {
       SDL_ScaleMode mode{};
 
-      SDL_GetTextureScaleMode(_texture.get(), &mode);
+      SDL_GetTextureScaleMode(Get(), &mode);
 
       return mode;
     }
@@ -72,12 +94,15 @@ namespace swgtk {
     [[nodiscard]] auto GetSize() const -> std::pair<float, float> {
       float w{}, y{};
 
-      SDL_GetTextureSize(_texture.get(), &w, &y);
+      SDL_GetTextureSize(Get(), &w, &y);
       return std::make_pair(w, y);
     }
 
   private:
-    std::shared_ptr<SDL_Texture> _texture;
+    HandleID _id = nullHandle;
   };
+
+  // A Texture destroyed when it goes out of scope. Textures made for Lua are these, so the garbage collector frees them.
+  using UniqueTexture = UniqueHandle<Texture>;
 } // namespace swgtk
 #endif // SWGTK_ENGINE_INCLUDE_SWGTK_TEXTURE_HPP_
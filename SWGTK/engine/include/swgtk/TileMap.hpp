@@ -0,0 +1,172 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_TILEMAP_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_TILEMAP_HPP_
+
+#include <SDL3/SDL_rect.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <swgtk/SpriteBatch.hpp>
+#include <swgtk/Texture.hpp>
+
+namespace swgtk {
+
+  // Tiles along each side of a chunk.
+  constexpr inline auto tileChunkSize = 32;
+  constexpr inline auto tilesPerChunk = static_cast<size_t>(tileChunkSize * tileChunkSize);
+
+  // How many chunk textures a cached map keeps before dropping the ones drawn longest ago.
+  constexpr inline auto defaultTileChunkBudget = 64uz;
+
+  // Tiles are numbered from 1, left to right then top to bottom across the tileset. 0 is an empty cell.
+  using TileID = uint16_t;
+  constexpr inline TileID emptyTile = 0u;
+
+  struct TileSet {
+    Texture texture{};
+    int tileWidth = 0;
+    int tileHeight = 0;
+    int columns = 1;
+
+    // Where a tile sits in the texture, in texels.
+    [[nodiscard]] constexpr auto GetSource(const TileID tile) const -> SDL_FRect {
+      const auto index = static_cast<int>(tile) - 1;
+
+      return SDL_FRect{
+          .x = static_cast<float>((index % columns) * tileWidth),
+          .y = static_cast<float>((index / columns) * tileHeight),
+          .w = static_cast<float>(tileWidth),
+          .h = static_cast<float>(tileHeight),
+      };
+    }
+  };
+
+  /**
+   * @brief A square of tiles and, for cached maps, the texture they were last rendered into.
+   *
+   * Setting a tile moves version past renderedVersion, and the renderer draws the chunk's tiles into its
+   * texture again the next time it is on screen. See SDLHW2D::DrawTileMap().
+   */
+  struct TileChunk {
+    std::array<TileID, tilesPerChunk> tiles{};
+    size_t filled = 0;
+
+    Texture texture;
+    uint64_t version = 0;
+    uint64_t renderedVersion = 0;
+    uint64_t lastDrawn = 0;
+
+    // Counted against the map's chunk budget.
+    bool cached = false;
+  };
+
+  /**
+    @brief A grid of tiles from one TileSet, stored and drawn in chunks of tileChunkSize by tileChunkSize.
+
+    A cached map is for layers that rarely change. Each chunk on screen is rendered once into its own
+    render-target texture and drawn from then on with one texture copy, and only again after one of its
+    tiles changes. Chunk textures are capped by SetChunkBudget(), and the ones drawn longest ago are
+    dropped first, so a map of millions of tiles costs only what is on screen.
+
+    An uncached map draws its visible tiles with one SpriteBatch each frame, for layers that change often.
+
+    Either way, only chunks that overlap the view are touched, and chunks without tiles are skipped.
+   */
+  class TileMap {
+  public:
+    TileMap(int width, int height, const TileSet& tileset, bool cached = true);
+    TileMap(const TileMap&) = delete;
+    TileMap(TileMap&&) = delete;
+    auto operator=(const TileMap&) -> TileMap& = delete;
+    auto operator=(TileMap&&) -> TileMap& = delete;
+    ~TileMap() { Release(); }
+
+    // Returns false if the cell is outside the map.
+    auto Set(int x, int y, TileID tile) -> bool;
+    [[nodiscard]] auto Get(int x, int y) const -> TileID;
+
+    // Set every cell of area that is inside the map.
+    void Fill(const SDL_Rect& area, TileID tile);
+
+    // Replace the whole map from tiles in rows, top to bottom. Returns false if the count doesn't match.
+    auto Load(std::span<const TileID> tiles) -> bool;
+
+    [[nodiscard]] constexpr auto GetWidth() const -> int { return _width; }
+    [[nodiscard]] constexpr auto GetHeight() const -> int { return _height; }
+    [[nodiscard]] constexpr auto GetTileSet() const -> const TileSet& { return _tileset; }
+    [[nodiscard]] constexpr auto IsCached() const -> bool { return _cached; }
+
+    // The map's size in pixels.
+    [[nodiscard]] auto GetPixelSize() const -> SDL_FPoint;
+
+    // A chunk's size in pixels, which is also the size of its texture.
+    [[nodiscard]] constexpr auto GetChunkPixelWidth() const -> int { return tileChunkSize * _tileset.tileWidth; }
+    [[nodiscard]] constexpr auto GetChunkPixelHeight() const -> int { return tileChunkSize * _tileset.tileHeight; }
+
+    [[nodiscard]] constexpr auto GetChunkColumns() const -> int { return _chunkColumns; }
+    [[nodiscard]] constexpr auto GetChunkRows() const -> int { return _chunkRows; }
+
+    // Chunks are stored in rows, so chunk (x, y) is at y * GetChunkColumns() + x.
+    [[nodiscard]] auto GetChunk(int x, int y) -> TileChunk& { return _chunks[ChunkIndex(x, y)]; }
+    [[nodiscard]] auto GetChunk(int x, int y) const -> const TileChunk& { return _chunks[ChunkIndex(x, y)]; }
+
+    // The chunks, as columns and rows, that overlap view. view is in map pixels.
+    [[nodiscard]] auto GetChunksInView(const SDL_FRect& view) const -> SDL_Rect;
+
+    // Append a quad for every tile in chunk (x, y), with the chunk's top-left corner at origin.
+    void AppendChunk(int x, int y, SDL_FPoint origin, SpriteBatch& out) const;
+
+    // Start a draw of the map. Chunks drawn after this are kept over ones that weren't.
+    auto BeginDraw() -> uint64_t { return ++_drawCount; }
+
+    // Record that chunk (x, y) was drawn from its texture in the current draw.
+    void MarkDrawn(int x, int y);
+
+    // Destroy the textures of the least recently drawn chunks until no more than the budget are left.
+    auto EvictChunks() -> size_t;
+
+    void SetChunkBudget(size_t chunks) { _chunkBudget = chunks; }
+    [[nodiscard]] constexpr auto GetChunkBudget() const -> size_t { return _chunkBudget; }
+    [[nodiscard]] constexpr auto GetCachedChunkCount() const -> size_t { return _cachedChunks.size(); }
+
+    // Render every cached chunk again, for when the renderer has lost the contents of its render targets.
+    void Invalidate();
+
+    // Destroy every chunk texture. The tiles are kept.
+    void Release();
+
+  private:
+    [[nodiscard]] constexpr auto ChunkIndex(const int x, const int y) const -> size_t { return static_cast<size_t>((y * _chunkColumns) + x); }
+
+    int _width = 0;
+    int _height = 0;
+    int _chunkColumns = 0;
+    int _chunkRows = 0;
+    TileSet _tileset;
+    bool _cached = true;
+
+    std::vector<TileChunk> _chunks;
+
+    // Indices of the chunks that have a texture.
+    std::vector<size_t> _cachedChunks;
+    size_t _chunkBudget = defaultTileChunkBudget;
+    uint64_t _drawCount = 0;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_TILEMAP_HPP_
@@ -41,6 +41,9 @@ namespace swgtk {
     // Get a microsecond accurate representation of the time between the last updates.
     [[nodiscard]] constexpr auto GetMicroseconds() const { return _timeDifference.count(); }
 
+    // Get the time passed since the last update in milliseconds, without updating.
+    [[nodiscard]] auto GetElapsedMilliseconds() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _lastFrameTime).count(); }
+
   private:
     using timePoint = std::chrono::time_point<std::chrono::steady_clock>;
 
@@ -0,0 +1,178 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_TWEEN_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_TWEEN_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace swgtk {
+
+  using TweenID = uint32_t;
+  constexpr inline TweenID nullTween = 0u;
+
+  enum class Ease : uint8_t {
+    Linear,
+    QuadIn,
+    QuadOut,
+    QuadInOut,
+    CubicIn,
+    CubicOut,
+    CubicInOut,
+    SineIn,
+    SineOut,
+    SineInOut,
+
+    // Pulls back a little before setting off, or runs a little past the end before settling.
+    BackIn,
+    BackOut,
+    ElasticOut,
+    BounceOut,
+    Count,
+  };
+
+  // The eased value of t, which runs from 0 to 1.
+  [[nodiscard]] auto EaseValue(Ease ease, float t) -> float;
+
+  // Ease every value in place. This is the loop the tweens use, with the easing chosen once for the whole span.
+  void EaseValues(Ease ease, std::span<float> values);
+
+  /**
+    @brief Moves floats from one value to another over time.
+
+    Running tweens are kept in one pool per easing, each a structure of arrays, so Update() eases a whole pool
+    with one function in loops the compiler can vectorize, then writes every result to its target.
+
+    A tween starts on the first Update() after its delay has passed, and takes the target's value then as
+    its start unless it was given one. Then() queues a tween to start when another finishes, which is how
+    sequences are built. Time left over when a tween finishes goes to the ones after it, so sequences don't
+    drift with the frame rate.
+
+    Storage is reused between tweens, and Reserve() makes room up front, so starting a tween doesn't allocate.
+
+    Targets are written through raw pointers and have to outlive their tweens. Cancel() a target's tweens
+    before it goes away. Two tweens on one target both write it, and the one updated last wins.
+   */
+  class Tweens {
+  public:
+    Tweens() = default;
+    Tweens(const Tweens&) = delete;
+    Tweens(Tweens&&) = delete;
+    auto operator=(const Tweens&) -> Tweens& = delete;
+    auto operator=(Tweens&&) -> Tweens& = delete;
+    ~Tweens() = default;
+
+    // Tween target from its value when the tween starts to to, over seconds.
+    auto To(float& target, float to, float seconds, Ease ease = Ease::Linear, float delay = 0.0f) -> TweenID;
+    auto FromTo(float& target, float from, float to, float seconds, Ease ease = Ease::Linear, float delay = 0.0f) -> TweenID;
+
+    // Like To(), but waits for after to finish first. The delay counts from then. nullTween if after isn't active.
+    auto Then(TweenID after, float& target, float to, float seconds, Ease ease = Ease::Linear, float delay = 0.0f) -> TweenID;
+
+    // Stop a tween where it is, along with everything queued after it.
+    auto Cancel(TweenID tween) -> bool;
+
+    // True from when a tween is made until it finishes or is cancelled.
+    [[nodiscard]] auto IsActive(TweenID tween) const -> bool;
+
+    // Tweens that are running, waiting out a delay or queued after another.
+    [[nodiscard]] constexpr auto Size() const -> size_t { return _active; }
+    [[nodiscard]] auto GetRunningCount() const -> size_t;
+
+    // Make room for tweens at once in the shared lists and in the pool of every easing.
+    void Reserve(size_t tweens);
+    void Clear();
+
+    // Advance every tween by seconds. The App does this once a frame with the frame time.
+    void Update(float seconds);
+
+  private:
+    static constexpr uint32_t slotBits = 20u;
+    static constexpr uint32_t slotMask = (1u << slotBits) - 1u;
+    static constexpr uint32_t noSlot = slotMask;
+
+    enum class State : uint8_t { Free, Queued, Waiting, Running };
+
+    // What a tween needs before it starts, and how to find it after.
+    struct Slot {
+      float* target = nullptr;
+      float from = 0.0f;
+      float to = 0.0f;
+      float duration = 0.0f;
+      float delay = 0.0f;
+      uint32_t generation = 1u;
+
+      // Where the tween is in the waiting list or its pool.
+      uint32_t dense = 0u;
+
+      // The tween this one is queued after, the first tween queued after this one, and the next tween queued
+      // after the same one as this.
+      uint32_t leader = noSlot;
+      uint32_t firstFollower = noSlot;
+      uint32_t nextFollower = noSlot;
+      Ease ease = Ease::Linear;
+      State state = State::Free;
+      bool hasFrom = false;
+    };
+
+    // The running tweens of one easing.
+    struct Pool {
+      std::vector<float> elapsed;
+      std::vector<float> duration;
+      std::vector<float> from;
+      std::vector<float> to;
+      std::vector<float> value;
+      std::vector<float*> target;
+      std::vector<uint32_t> slotOf;
+
+      [[nodiscard]] auto Size() const -> size_t { return slotOf.size(); }
+    };
+
+    auto Make(float& target, float from, bool hasFrom, float to, float seconds, Ease ease, float delay) -> uint32_t;
+    [[nodiscard]] auto Find(TweenID tween) const -> uint32_t;
+    [[nodiscard]] auto MakeID(uint32_t slot) const -> TweenID { return (_slots[slot].generation << slotBits) | slot; }
+
+    void Wait(uint32_t slot, float seconds);
+    void Start(uint32_t slot, float elapsed);
+
+    // Start a follower whose leader finished overshoot seconds ago, or wait out what is left of its delay.
+    void Follow(uint32_t slot, float overshoot);
+
+    // Take a tween out of the waiting list or its pool.
+    void Unlink(uint32_t slot);
+
+    // Take a queued tween out of its leader's followers.
+    void Detach(uint32_t slot);
+    void Free(uint32_t slot);
+
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _freeSlots;
+    size_t _active = 0;
+
+    std::vector<uint32_t> _waitSlots;
+    std::vector<float> _waitLeft;
+
+    std::array<Pool, static_cast<size_t>(Ease::Count)> _pools;
+
+    // Scratch lists for Update() and Cancel(), kept to reuse their memory. Finished tweens carry their overshoot.
+    std::vector<uint32_t> _finished;
+    std::vector<float> _overshoot;
+    std::vector<uint32_t> _cancelled;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_TWEEN_HPP_
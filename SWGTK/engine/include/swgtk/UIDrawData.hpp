@@ -0,0 +1,102 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_ENGINE_INCLUDE_SWGTK_UIDRAWDATA_HPP_
+#define SWGTK_ENGINE_INCLUDE_SWGTK_UIDRAWDATA_HPP_
+
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <swgtk/Texture.hpp>
+
+namespace swgtk {
+
+  // Laid out like Dear ImGui's ImDrawVert, so a draw list's vertex buffer can be passed as it is.
+  struct UIVertex {
+    SDL_FPoint position{};
+    SDL_FPoint uv{};
+
+    // RGBA with red in the lowest byte, like IM_COL32().
+    uint32_t color = 0u;
+  };
+
+  // Corners, not a size, like the ClipRect of an ImDrawCmd.
+  struct UIClipRect {
+    float x1 = 0.0f;
+    float y1 = 0.0f;
+    float x2 = 0.0f;
+    float y2 = 0.0f;
+  };
+
+  // The parts of an ImDrawCmd the renderer needs. Copy each field across; use Texture handles as ImTextureID.
+  struct UIDrawCommand {
+    UIClipRect clip{};
+    Texture texture{};
+    uint32_t vertexOffset = 0u;
+    uint32_t indexOffset = 0u;
+    uint32_t elementCount = 0u;
+  };
+
+  // Indices drawn with one texture and clip rect, in one SDL_RenderGeometry() call.
+  struct UIBatch {
+    Texture texture{};
+    SDL_Rect clip{};
+    size_t firstIndex = 0;
+    size_t indexCount = 0;
+  };
+
+  /**
+    @brief One frame of immediate-mode UI, converted for SDLHW2D::DrawUI().
+
+    Each draw list added is converted once into one vertex buffer and one index buffer shared by the whole
+    frame. Commands are turned into batches as they come, and a command with the same texture and clip rect as
+    the batch before it extends that batch, so a frame usually costs a few draw calls however many commands
+    the UI produced. Commands with an empty clip rect are dropped.
+
+    Clear() starts the next frame and keeps the memory, so a UI of steady size stops allocating after its
+    first frames.
+
+    Positions and clip rects are used as they are. For Dear ImGui that means DisplayPos at (0, 0); set the
+    renderer's scale for a FramebufferScale other than 1. User callbacks aren't supported.
+   */
+  class UIDrawData {
+  public:
+    void Clear();
+
+    // Add a draw list. Returns false, and adds nothing, if a command reaches past the indices or vertices it was given.
+    auto AddList(std::span<const UIVertex> vertices, std::span<const uint16_t> indices, std::span<const UIDrawCommand> commands) -> bool;
+    auto AddList(std::span<const UIVertex> vertices, std::span<const uint32_t> indices, std::span<const UIDrawCommand> commands) -> bool;
+
+    [[nodiscard]] auto Vertices() const -> std::span<const SDL_Vertex> { return _vertices; }
+    [[nodiscard]] auto Indices() const -> std::span<const int> { return _indices; }
+    [[nodiscard]] auto Batches() const -> std::span<const UIBatch> { return _batches; }
+
+    // Commands taken this frame, to compare with the batch count.
+    [[nodiscard]] constexpr auto GetCommandCount() const -> size_t { return _commandCount; }
+
+  private:
+    template<typename Index>
+    auto Add(std::span<const UIVertex> vertices, std::span<const Index> indices, std::span<const UIDrawCommand> commands) -> bool;
+
+    std::vector<SDL_Vertex> _vertices;
+    std::vector<int> _indices;
+    std::vector<UIBatch> _batches;
+    size_t _commandCount = 0;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_ENGINE_INCLUDE_SWGTK_UIDRAWDATA_HPP_
@@ -0,0 +1,658 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/Animation.hpp>
+#include <swgtk/Utility.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
+
+namespace {
+  using namespace swgtk;
+
+  /*
+    Just enough JSON for sprite sheets. Objects keep their members in file order, which the hash layout
+    relies on for frame order.
+  */
+  struct JsonValue {
+    enum class Type : uint8_t { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+
+    // Array elements, or object members with their names in keys.
+    std::vector<JsonValue> items;
+    std::vector<std::string> keys;
+
+    [[nodiscard]] auto Find(const std::string_view key) const -> const JsonValue* {
+      if (type != Type::Object) {
+        return nullptr;
+      }
+
+      const auto found = std::ranges::find(keys, key);
+      return found != keys.end() ? &items[static_cast<size_t>(std::distance(keys.begin(), found))] : nullptr;
+    }
+
+    [[nodiscard]] auto NumberOr(const std::string_view key, const double fallback) const -> double {
+      const auto* value = Find(key);
+      return value != nullptr && value->type == Type::Number ? value->number : fallback;
+    }
+
+    [[nodiscard]] auto StringOr(const std::string_view key, const std::string_view fallback) const -> std::string_view {
+      const auto* value = Find(key);
+      return value != nullptr && value->type == Type::String ? std::string_view{value->string} : fallback;
+    }
+  };
+
+  class JsonParser {
+    // Deep enough for any sheet, shallow enough that hostile input can't exhaust the stack.
+    static constexpr auto maxDepth = 64;
+
+  public:
+    explicit JsonParser(const std::string_view text) : _text(text) {}
+
+    [[nodiscard]] auto Parse() -> std::optional<JsonValue> {
+      JsonValue value;
+
+      if (!ParseValue(value, 0)) {
+        DEBUG_PRINT("Invalid JSON near offset {}\n", _pos)
+        return std::nullopt;
+      }
+
+      SkipSpace();
+      return _pos == _text.size() ? std::optional{std::move(value)} : std::nullopt;
+    }
+
+  private:
+    void SkipSpace() {
+      while (_pos < _text.size() && (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\n' || _text[_pos] == '\r')) {
+        ++_pos;
+      }
+    }
+
+    auto Consume(const char c) -> bool {
+      SkipSpace();
+
+      if (_pos < _text.size() && _text[_pos] == c) {
+        ++_pos;
+        return true;
+      }
+
+      return false;
+    }
+
+    auto ConsumeWord(const std::string_view word) -> bool {
+      if (_text.substr(_pos).starts_with(word)) {
+        _pos += word.size();
+        return true;
+      }
+
+      return false;
+    }
+
+    auto ParseValue(JsonValue& value, const int depth) -> bool {
+      SkipSpace();
+
+      if (_pos >= _text.size() || depth > maxDepth) {
+        return false;
+      }
+
+      switch (_text[_pos]) {
+        case '{':
+          value.type = JsonValue::Type::Object;
+          return ParseObject(value, depth);
+        case '[':
+          value.type = JsonValue::Type::Array;
+          return ParseArray(value, depth);
+        case '"':
+          value.type = JsonValue::Type::String;
+          return ParseString(value.string);
+        case 't':
+          value.type = JsonValue::Type::Bool;
+          value.boolean = true;
+          return ConsumeWord("true");
+        case 'f':
+          value.type = JsonValue::Type::Bool;
+          return ConsumeWord("false");
+        case 'n':
+          return ConsumeWord("null");
+        default:
+          value.type = JsonValue::Type::Number;
+          return ParseNumber(value.number);
+      }
+    }
+
+    auto ParseObject(JsonValue& value, const int depth) -> bool {
+      ++_pos;
+
+      if (Consume('}')) {
+        return true;
+      }
+
+      do {
+        SkipSpace();
+
+        if (auto& key = value.keys.emplace_back(); !ParseString(key) || !Consume(':')) {
+          return false;
+        }
+
+        if (!ParseValue(value.items.emplace_back(), depth + 1)) {
+          return false;
+        }
+      } while (Consume(','));
+
+      return Consume('}');
+    }
+
+    auto ParseArray(JsonValue& value, const int depth) -> bool {
+      ++_pos;
+
+      if (Consume(']')) {
+        return true;
+      }
+
+      do {
+        if (!ParseValue(value.items.emplace_back(), depth + 1)) {
+          return false;
+        }
+      } while (Consume(','));
+
+      return Consume(']');
+    }
+
+    auto ParseNumber(double& number) -> bool {
+      const auto* first = _text.data() + _pos;
+      const auto* last = _text.data() + _text.size();
+
+      // from_chars doesn't take the leading '+' JSON also forbids, but it does take "inf" and "nan", which JSON doesn't.
+      if (*first != '-' && (*first < '0' || *first > '9')) {
+        return false;
+      }
+
+      const auto [end, error] = std::from_chars(first, last, number);
+
+      if (error != std::errc{}) {
+        return false;
+      }
+
+      _pos += static_cast<size_t>(end - first);
+      return true;
+    }
+
+    auto ParseHex(uint32_t& code) -> bool {
+      if (_pos + 4uz > _text.size()) {
+        return false;
+      }
+
+      const auto* first = _text.data() + _pos;
+      const auto [end, error] = std::from_chars(first, first + 4, code, 16);
+
+      _pos += 4uz;
+      return error == std::errc{} && end == first + 4;
+    }
+
+    auto ParseString(std::string& out) -> bool {
+      if (_pos >= _text.size() || _text[_pos] != '"') {
+        return false;
+      }
+
+      ++_pos;
+
+      while (_pos < _text.size()) {
+        const auto c = _text[_pos++];
+
+        if (c == '"') {
+          return true;
+        }
+
+        if (c != '\\') {
+          out.push_back(c);
+          continue;
+        }
+
+        if (_pos >= _text.size()) {
+          return false;
+        }
+
+        switch (const auto escaped = _text[_pos++]) {
+          case 'b': out.push_back('\b'); break;
+          case 'f': out.push_back('\f'); break;
+          case 'n': out.push_back('\n'); break;
+          case 'r': out.push_back('\r'); break;
+          case 't': out.push_back('\t'); break;
+          case 'u': {
+            uint32_t code = 0u;
+
+            if (!ParseHex(code)) {
+              return false;
+            }
+
+            // A high surrogate followed by a low one makes a single codepoint past the BMP.
+            if (code >= 0xD800u && code < 0xDC00u && ConsumeWord("\\u")) {
+              uint32_t low = 0u;
+
+              if (!ParseHex(low) || low < 0xDC00u || low >= 0xE000u) {
+                return false;
+              }
+
+              code = 0x10000u + ((code - 0xD800u) << 10u) + (low - 0xDC00u);
+            }
+
+            AppendUtf8(out, code);
+            break;
+          }
+          default: out.push_back(escaped); break;
+        }
+      }
+
+      return false;
+    }
+
+    static void AppendUtf8(std::string& out, const uint32_t code) {
+      if (code < 0x80u) {
+        out.push_back(static_cast<char>(code));
+      } else if (code < 0x800u) {
+        out.push_back(static_cast<char>(0xC0u | (code >> 6u)));
+        out.push_back(static_cast<char>(0x80u | (code & 0x3Fu)));
+      } else if (code < 0x10000u) {
+        out.push_back(static_cast<char>(0xE0u | (code >> 12u)));
+        out.push_back(static_cast<char>(0x80u | ((code >> 6u) & 0x3Fu)));
+        out.push_back(static_cast<char>(0x80u | (code & 0x3Fu)));
+      } else {
+        out.push_back(static_cast<char>(0xF0u | (code >> 18u)));
+        out.push_back(static_cast<char>(0x80u | ((code >> 12u) & 0x3Fu)));
+        out.push_back(static_cast<char>(0x80u | ((code >> 6u) & 0x3Fu)));
+        out.push_back(static_cast<char>(0x80u | (code & 0x3Fu)));
+      }
+    }
+
+    std::string_view _text;
+    size_t _pos = 0;
+  };
+
+  // A frame entry from either layout. Durations are in milliseconds in the file.
+  [[nodiscard]] auto ReadFrame(const JsonValue& entry) -> std::optional<AnimationFrame> {
+    const auto* rect = entry.Find("frame");
+
+    if (rect == nullptr || rect->type != JsonValue::Type::Object) {
+      return std::nullopt;
+    }
+
+    return AnimationFrame{
+        .source = SDL_FRect{
+            .x = static_cast<float>(rect->NumberOr("x", 0.0)),
+            .y = static_cast<float>(rect->NumberOr("y", 0.0)),
+            .w = static_cast<float>(rect->NumberOr("w", 0.0)),
+            .h = static_cast<float>(rect->NumberOr("h", 0.0)),
+        },
+        .duration = static_cast<float>(entry.NumberOr("duration", static_cast<double>(defaultFrameDuration) * 1000.0) / 1000.0),
+    };
+  }
+
+  [[nodiscard]] auto ReadFrames(const JsonValue& frames) -> std::optional<std::vector<AnimationFrame>> {
+    std::vector<AnimationFrame> result;
+
+    // The hash layout keys frames by name and the array layout lists them, but the entries are the same.
+    if (frames.type != JsonValue::Type::Object && frames.type != JsonValue::Type::Array) {
+      return std::nullopt;
+    }
+
+    for (const auto& entry: frames.items) {
+      const auto frame = ReadFrame(entry);
+
+      if (!frame) {
+        return std::nullopt;
+      }
+
+      result.push_back(*frame);
+    }
+
+    return result;
+  }
+} // namespace
+
+namespace swgtk {
+
+  auto AnimationClip::FrameAt(const float time) const -> size_t {
+    const auto found = std::ranges::upper_bound(ends, time);
+    return std::min(static_cast<size_t>(std::distance(ends.begin(), found)), frames.size() - 1uz);
+  }
+
+  auto SpriteSheet::AddClip(const std::string_view name, const std::span<const AnimationFrame> frames, const AnimationLoop loop) -> ClipID {
+    if (frames.empty()) {
+      return nullClip;
+    }
+
+    auto& clip = _clips.emplace_back(AnimationClip{.name = std::string{name}, .frames = {frames.begin(), frames.end()}, .loop = loop});
+
+    // Unrolled here so playback never needs to know which way a clip is going.
+    if (loop == AnimationLoop::PingPong && frames.size() > 2uz) {
+      clip.frames.insert(clip.frames.end(), std::next(frames.rbegin()), std::prev(frames.rend()));
+    }
+
+    for (auto& frame: clip.frames) {
+      frame.duration = std::max(frame.duration, minFrameDuration);
+      clip.length += frame.duration;
+      clip.ends.push_back(clip.length);
+    }
+
+    return static_cast<ClipID>(_clips.size());
+  }
+
+  auto SpriteSheet::LoadJson(const std::string_view json) -> bool {
+    const auto document = JsonParser{json}.Parse();
+
+    if (!document) {
+      return false;
+    }
+
+    const auto* framesValue = document->Find("frames");
+    const auto frames = framesValue != nullptr ? ReadFrames(*framesValue) : std::nullopt;
+
+    if (!frames || frames->empty()) {
+      DEBUG_PRINT("Sprite sheet has no usable \"{}\" entry.\n", "frames")
+      return false;
+    }
+
+    Clear();
+
+    const auto* meta = document->Find("meta");
+    const auto* tags = meta != nullptr ? meta->Find("frameTags") : nullptr;
+
+    if (meta != nullptr) {
+      _imagePath = meta->StringOr("image", "");
+    }
+
+    if (tags == nullptr || tags->type != JsonValue::Type::Array || tags->items.empty()) {
+      AddClip("default", *frames);
+      return true;
+    }
+
+    for (const auto& tag: tags->items) {
+      const auto last = static_cast<double>(frames->size() - 1uz);
+      const auto from = static_cast<size_t>(std::clamp(tag.NumberOr("from", 0.0), 0.0, last));
+      const auto to = static_cast<size_t>(std::clamp(tag.NumberOr("to", last), static_cast<double>(from), last));
+      const auto direction = tag.StringOr("direction", "forward");
+
+      std::vector<AnimationFrame> clipFrames{frames->begin() + static_cast<std::ptrdiff_t>(from), frames->begin() + static_cast<std::ptrdiff_t>(to) + 1};
+
+      if (direction == "reverse" || direction == "pingpong_reverse") {
+        std::ranges::reverse(clipFrames);
+      }
+
+      // Aseprite writes "repeat" only for tags that stop; a count other than one still loops here.
+      const auto repeat = tag.StringOr("repeat", "");
+      const auto loop = repeat == "1"                 ? AnimationLoop::Once
+                        : direction.starts_with("pingpong") ? AnimationLoop::PingPong
+                                                            : AnimationLoop::Loop;
+
+      AddClip(tag.StringOr("name", ""), clipFrames, loop);
+    }
+
+    return true;
+  }
+
+  auto SpriteSheet::LoadJsonFile(const std::filesystem::path& path) -> bool {
+    std::ifstream file{path, std::ios::binary};
+
+    if (!file) {
+      DEBUG_PRINT("Could not open sprite sheet {}\n", path.string())
+      return false;
+    }
+
+    const std::string json{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+    if (!LoadJson(json)) {
+      return false;
+    }
+
+    if (!_imagePath.empty()) {
+      _imagePath = path.parent_path() / _imagePath;
+    }
+
+    return true;
+  }
+
+  auto SpriteSheet::FindClip(const std::string_view name) const -> ClipID {
+    const auto found = std::ranges::find(_clips, name, &AnimationClip::name);
+    return found != _clips.end() ? static_cast<ClipID>(std::distance(_clips.begin(), found) + 1) : nullClip;
+  }
+
+  auto SpriteSheet::GetClip(const ClipID clip) const -> const AnimationClip* {
+    return clip != nullClip && clip <= _clips.size() ? &_clips[clip - 1u] : nullptr;
+  }
+
+  void SpriteSheet::Clear() {
+    _clips.clear();
+    _imagePath.clear();
+  }
+
+  auto Animators::Add(const ClipID clip, const SDL_FRect& dest, const float speed) -> AnimatorID {
+    const auto* playing = _sheet->GetClip(clip);
+
+    if (playing == nullptr) {
+      return nullAnimator;
+    }
+
+    uint32_t slot{};
+
+    if (!_freeSlots.empty()) {
+      slot = _freeSlots.back();
+      _freeSlots.pop_back();
+    } else if (_denseOf.size() < slotMask) {
+      slot = static_cast<uint32_t>(_denseOf.size());
+      _denseOf.push_back(0u);
+      _generation.push_back(1u);
+    } else {
+      DEBUG_PRINT("Animators are full at {}\n", Size())
+      return nullAnimator;
+    }
+
+    _denseOf[slot] = static_cast<uint32_t>(Size());
+    _slotOf.push_back(slot);
+
+    _time.push_back(0.0f);
+    _speed.push_back(std::max(speed, 0.0f));
+    _frameEnd.push_back(playing->ends.front());
+    _clip.push_back(clip);
+    _frame.push_back(0u);
+    _source.push_back(playing->frames.front().source);
+    _dest.push_back(dest);
+
+    return (_generation[slot] << slotBits) | slot;
+  }
+
+  auto Animators::Remove(const AnimatorID animator) -> bool {
+    const auto index = Find(animator);
+
+    if (index == Size()) {
+      return false;
+    }
+
+    const auto slot = _slotOf[index];
+
+    // Swap the last animator into the gap, so the arrays stay packed for Update().
+    const auto swapOut = [index](auto& values) {
+      values[index] = values.back();
+      values.pop_back();
+    };
+
+    swapOut(_time);
+    swapOut(_speed);
+    swapOut(_frameEnd);
+    swapOut(_clip);
+    swapOut(_frame);
+    swapOut(_source);
+    swapOut(_dest);
+    swapOut(_slotOf);
+
+    if (index < Size()) {
+      _denseOf[_slotOf[index]] = static_cast<uint32_t>(index);
+    }
+
+    // A slot whose generation is used up is retired rather than risk an old ID matching again.
+    if (++_generation[slot] <= (std::numeric_limits<AnimatorID>::max() >> slotBits)) {
+      _freeSlots.push_back(slot);
+    }
+
+    return true;
+  }
+
+  auto Animators::Play(const AnimatorID animator, const ClipID clip) -> bool {
+    const auto index = Find(animator);
+    const auto* playing = _sheet->GetClip(clip);
+
+    if (index == Size() || playing == nullptr) {
+      return false;
+    }
+
+    _clip[index] = clip;
+    _time[index] = 0.0f;
+    _frame[index] = 0u;
+    _frameEnd[index] = playing->ends.front();
+    _source[index] = playing->frames.front().source;
+
+    return true;
+  }
+
+  auto Animators::SetSpeed(const AnimatorID animator, const float speed) -> bool {
+    if (const auto index = Find(animator); index != Size()) {
+      _speed[index] = std::max(speed, 0.0f);
+      return true;
+    }
+
+    return false;
+  }
+
+  auto Animators::SetDest(const AnimatorID animator, const SDL_FRect& dest) -> bool {
+    if (const auto index = Find(animator); index != Size()) {
+      _dest[index] = dest;
+      return true;
+    }
+
+    return false;
+  }
+
+  auto Animators::IsValid(const AnimatorID animator) const -> bool { return Find(animator) != Size(); }
+
+  auto Animators::IsFinished(const AnimatorID animator) const -> bool {
+    const auto index = Find(animator);
+
+    if (index == Size()) {
+      return false;
+    }
+
+    // A clip that has gone from the sheet has nothing left to play.
+    const auto* clip = _sheet->GetClip(_clip[index]);
+    return clip == nullptr || (clip->loop == AnimationLoop::Once && _time[index] >= clip->length);
+  }
+
+  auto Animators::GetFrame(const AnimatorID animator) const -> size_t {
+    const auto index = Find(animator);
+    return index != Size() ? _frame[index] : 0uz;
+  }
+
+  auto Animators::GetSource(const AnimatorID animator) const -> SDL_FRect {
+    const auto index = Find(animator);
+    return index != Size() ? _source[index] : SDL_FRect{};
+  }
+
+  void Animators::Reserve(const size_t animators) {
+    _time.reserve(animators);
+    _speed.reserve(animators);
+    _frameEnd.reserve(animators);
+    _clip.reserve(animators);
+    _frame.reserve(animators);
+    _source.reserve(animators);
+    _dest.reserve(animators);
+    _slotOf.reserve(animators);
+  }
+
+  void Animators::Clear() {
+    while (!_slotOf.empty()) {
+      Remove((_generation[_slotOf.back()] << slotBits) | _slotOf.back());
+    }
+  }
+
+  void Animators::Update(const float seconds) {
+    const auto count = Size();
+    auto* time = _time.data();
+    const auto* speed = _speed.data();
+
+    // No branches or lookups, so this vectorizes.
+    for (auto i = 0uz; i < count; ++i) {
+      time[i] += seconds * speed[i];
+    }
+
+    // Frames last several updates, so only a few animators get past this test each time.
+    for (auto i = 0uz; i < count; ++i) {
+      if (time[i] >= _frameEnd[i]) {
+        Advance(i);
+      }
+    }
+  }
+
+  void Animators::AppendTo(SpriteBatch& batch, const SDL_FColor& color) const {
+    batch.Grow(Size());
+
+    for (auto i = 0uz; i < Size(); ++i) {
+      batch.Add(_source[i], _dest[i], color);
+    }
+  }
+
+  auto Animators::Find(const AnimatorID animator) const -> size_t {
+    const auto slot = animator & slotMask;
+
+    if (slot >= _denseOf.size() || _generation[slot] != (animator >> slotBits)) {
+      return Size();
+    }
+
+    return _denseOf[slot];
+  }
+
+  void Animators::Advance(const size_t index) {
+    const auto* clip = _sheet->GetClip(_clip[index]);
+
+    // The sheet was cleared or reloaded with fewer clips. Hold the frame showing until the animator plays another clip.
+    if (clip == nullptr) {
+      _frameEnd[index] = std::numeric_limits<float>::infinity();
+      return;
+    }
+
+    if (_time[index] >= clip->length) {
+      if (clip->loop == AnimationLoop::Once) {
+        // Hold the last frame. Its end can't be reached again, so Update() leaves it alone from now on.
+        _time[index] = clip->length;
+        _frame[index] = static_cast<uint32_t>(clip->frames.size() - 1uz);
+        _frameEnd[index] = std::numeric_limits<float>::infinity();
+        _source[index] = clip->frames.back().source;
+        return;
+      }
+
+      _time[index] = std::fmod(_time[index], clip->length);
+    }
+
+    const auto frame = clip->FrameAt(_time[index]);
+
+    _frame[index] = static_cast<uint32_t>(frame);
+    _frameEnd[index] = clip->ends[frame];
+    _source[index] = clip->frames[frame].source;
+  }
+
+} // namespace swgtk
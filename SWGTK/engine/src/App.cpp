@@ -11,6 +11,7 @@
     SOFTWARE.
 */
 #include <swgtk/App.hpp>
+#include <swgtk/Surface.hpp>
 #include <swgtk/Utility.hpp>
 
 #include <SDL3/SDL_error.h>
@@ -23,19 +24,30 @@
 
 
 namespace swgtk {
+  App::App() {
+#ifdef SWGTK_TRACK_MEMORY
+    // Before the App or the game calls into SDL, so every SDL allocation is counted.
+    MemoryTracker::InstallSDLAllocator();
+#endif
+  }
+
   App::~App() {
+    // A scene can own music streams, whose converters have to be destroyed before SDL quits.
+    _currentScene.reset();
+    _audio.Close();
     _fonts.ClearFonts();
     if ((SDL_WasInit(SDL_INIT_VIDEO) & SDL_INIT_VIDEO) == SDL_INIT_VIDEO) {
       _renderer.reset();
       SDL_DestroyWindow(_window);
     }
 
+    SurfaceRegistry().Clear();
+
     TTF_Quit();
     SDL_Quit();
   }
 
   auto App::InitGraphics(const char* appName, const int width, const int height, std::shared_ptr<RenderingDevice>&& renderPtr, const SystemInit flags) -> bool {
-
     if (SDL_Init(std::to_underlying(flags)) && TTF_Init()) {
 
       // false positive
@@ -54,10 +66,35 @@ namespace swgtk {
   void App::EventsAndTimeStep() {
     SDL_Event e;
 
+#ifdef SWGTK_TRACK_MEMORY
+    MemoryTracker::NewFrame();
+#endif
+
+    _frameArena.Reset();
+    SurfaceRegistry().FlushDeferred();
+    _audio.Update();
+
+#ifdef SWGTK_BUILD_WITH_LUA
+    // Loops driven from Lua never reach GameTick(), but the collector still needs its minimum slice every frame.
+    if (!_luaGCStepped) {
+      StepLuaGC();
+    }
+
+    _luaGCStepped = false;
+#endif
+
     ResetScroll();
     ResetMouseEvents();
     ResetKeyEvent();
 
+#ifndef __EMSCRIPTEN__
+    // Nothing new was shown last frame, so sleep until something happens instead of spinning. The event stays
+    // queued for the loop below.
+    if (_renderer->IsIdle()) {
+      SDL_WaitEventTimeout(nullptr, _idleTimeout);
+    }
+#endif
+
     while (SDL_PollEvent(&e)) {
       switch (e.type) {
         case SDL_EVENT_MOUSE_BUTTON_UP:
@@ -79,6 +116,12 @@ namespace swgtk {
           break;
         }
 
+        case SDL_EVENT_WINDOW_EXPOSED: {
+          // A renderer that skips presenting still has to repaint a window that was covered.
+          _renderer->RequestPresent();
+          break;
+        }
+
         case SDL_EVENT_QUIT: {
           CloseApp();
           break;
@@ -96,11 +139,23 @@ namespace swgtk {
     UpdateMouseState();
 
     _gameTimer.UpdateTime();
+    _tweens.Update(_gameTimer.GetSeconds());
+
+#ifdef SWGTK_BUILD_WITH_LUA
+    // Tasks run after input and frame time are current, before the scene updates.
+    _luaTasks.Update(_gameTimer.GetSeconds());
+#endif
   }
 
   auto App::InitializeGame() -> bool {
     if (_renderer->PrepareDevice(_window) && _fonts.LoadDefaultFont()) {
       _renderer->SetFont(_fonts.GetDefaultFont().ptr);
+
+      // A missing audio device shouldn't stop the game, it just plays silently.
+      if ((SDL_WasInit(SDL_INIT_AUDIO) & SDL_INIT_AUDIO) == SDL_INIT_AUDIO && !_audio.Open()) {
+        DEBUG_PRINT("Audio is disabled. - {}\n", SDL_GetError())
+      }
+
       return true;
     }
 
@@ -125,6 +180,11 @@ namespace swgtk {
       gameOk = GameTick();
     }
 
+#ifdef SWGTK_BUILD_WITH_LUA
+    // Nothing steps the collector once the loop is over.
+    _luaGC.HandBack();
+#endif
+
 #endif // __EMSCRIPTEN__
   }
 
@@ -0,0 +1,478 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/AudioMixer.hpp>
+#include <swgtk/MusicStream.hpp>
+#include <swgtk/SurfaceOps.hpp>
+#include <swgtk/Utility.hpp>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SWGTK_AUDIO_MIXER_X86 1
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SWGTK_TARGET_SSE2 __attribute__((target("sse2")))
+#define SWGTK_TARGET_AVX __attribute__((target("avx")))
+#else
+#define SWGTK_TARGET_SSE2
+#define SWGTK_TARGET_AVX
+#endif
+#endif
+
+// NOLINTBEGIN(*-pointer-arithmetic, *-reinterpret-cast, *-magic-numbers)
+
+namespace {
+  using namespace swgtk;
+
+  // The gains for a voice's left and right channels. Panning turns one side down and leaves the other alone.
+  [[nodiscard]] auto ChannelGains(const float gain, const float pan) -> std::pair<float, float> {
+    const auto balance = std::clamp(pan, -1.0f, 1.0f);
+    return {gain * std::min(1.0f, 1.0f - balance), gain * std::min(1.0f, 1.0f + balance)};
+  }
+
+  // Every row kernel adds count interleaved stereo samples of in, scaled by left and right, to out.
+  namespace scalar {
+    void MixRow(float* out, const float* in, const size_t count, const float left, const float right) {
+      for (auto i = 0uz; i + 1uz < count; i += 2uz) {
+        out[i] += in[i] * left;
+        out[i + 1uz] += in[i + 1uz] * right;
+      }
+    }
+  } // namespace scalar
+
+#ifdef SWGTK_AUDIO_MIXER_X86
+  namespace sse2 {
+    // Two frames a register.
+    SWGTK_TARGET_SSE2 void MixRow(float* out, const float* in, const size_t count, const float left, const float right) {
+      const auto gains = _mm_setr_ps(left, right, left, right);
+      auto i = 0uz;
+
+      for (; i + 4uz <= count; i += 4uz) {
+        const auto mixed = _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), gains));
+        _mm_storeu_ps(out + i, mixed);
+      }
+
+      scalar::MixRow(out + i, in + i, count - i, left, right);
+    }
+  } // namespace sse2
+
+  namespace avx {
+    // Four frames a register.
+    SWGTK_TARGET_AVX void MixRow(float* out, const float* in, const size_t count, const float left, const float right) {
+      const auto gains = _mm256_setr_ps(left, right, left, right, left, right, left, right);
+      auto i = 0uz;
+
+      for (; i + 8uz <= count; i += 8uz) {
+        const auto mixed = _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(_mm256_loadu_ps(in + i), gains));
+        _mm256_storeu_ps(out + i, mixed);
+      }
+
+      // Finishing with the scalar loop rather than the SSE2 kernel avoids mixing AVX and legacy SSE encodings.
+      scalar::MixRow(out + i, in + i, count - i, left, right);
+    }
+  } // namespace avx
+#endif // SWGTK_AUDIO_MIXER_X86
+
+  [[nodiscard]] auto MixRowFor([[maybe_unused]] const SimdLevel level) -> void (*)(float*, const float*, size_t, float, float) {
+#ifdef SWGTK_AUDIO_MIXER_X86
+    if (level == SimdLevel::AVX2) {
+      return &avx::MixRow;
+    }
+
+    if (level == SimdLevel::SSE2) {
+      return &sse2::MixRow;
+    }
+#endif
+
+    return &scalar::MixRow;
+  }
+} // namespace
+
+namespace swgtk {
+
+  auto Sound::LoadWav(const std::filesystem::path& path, const int sampleRate) -> std::shared_ptr<const Sound> {
+    const auto fileString = path.string();
+
+    SDL_AudioSpec spec{};
+    Uint8* data = nullptr;
+    Uint32 length = 0u;
+
+    if (!SDL_LoadWAV(fileString.c_str(), &spec, &data, &length)) {
+      DEBUG_PRINT2("Error loading sound {}: {}\n", fileString, SDL_GetError())
+      return nullptr;
+    }
+
+    auto sound = Convert(spec, std::as_bytes(std::span{data, length}), sampleRate);
+    SDL_free(data);
+
+    return sound;
+  }
+
+  auto Sound::Convert(const SDL_AudioSpec& spec, const std::span<const std::byte> data, const int sampleRate) -> std::shared_ptr<const Sound> {
+    const SDL_AudioSpec mixSpec{.format = SDL_AUDIO_F32, .channels = static_cast<int>(audioChannels), .freq = sampleRate};
+
+    Uint8* converted = nullptr;
+    int length = 0;
+
+    if (!SDL_ConvertAudioSamples(&spec, reinterpret_cast<const Uint8*>(data.data()), static_cast<int>(data.size()), &mixSpec, &converted, &length)) {
+      DEBUG_PRINT("Error converting sound: {}\n", SDL_GetError())
+      return nullptr;
+    }
+
+    std::vector<float> samples(static_cast<size_t>(length) / sizeof(float));
+    std::memcpy(samples.data(), converted, samples.size() * sizeof(float));
+    SDL_free(converted);
+
+    return std::make_shared<const Sound>(std::move(samples));
+  }
+
+  AudioMixer::AudioMixer(const int sampleRate, const size_t maxVoices) :
+      _sampleRate(sampleRate), _maxVoices(std::max(maxVoices, 1uz)), _mixRow(MixRowFor(GetSimdLevel())) {
+    // Everything the audio thread needs is allocated up front. The game thread never lets more than
+    // _maxVoices voices be alive, so _voices never grows.
+    _voices.reserve(_maxVoices);
+    _block.resize(audioBlockFrames * audioChannels);
+    _streamBlock.resize(audioBlockFrames * audioChannels);
+  }
+
+  auto AudioMixer::Open(const SDL_AudioDeviceID device) -> bool {
+    if (_stream != nullptr) {
+      return true;
+    }
+
+    const SDL_AudioSpec spec{.format = SDL_AUDIO_F32, .channels = static_cast<int>(audioChannels), .freq = _sampleRate};
+
+    if (_stream = SDL_OpenAudioDeviceStream(device, &spec, &AudioMixer::StreamCallback, this); _stream == nullptr) {
+      DEBUG_PRINT("Error opening audio device: {}\n", SDL_GetError())
+      return false;
+    }
+
+    if (!SDL_ResumeAudioStreamDevice(_stream)) {
+      DEBUG_PRINT("Error starting audio device: {}\n", SDL_GetError())
+      Close();
+      return false;
+    }
+
+    return true;
+  }
+
+  void AudioMixer::Close() {
+    // SDL doesn't return until the callback has finished, so after this the audio thread is gone.
+    if (_stream != nullptr) {
+      SDL_DestroyAudioStream(_stream);
+      _stream = nullptr;
+    }
+
+    // With no audio thread left, this one can empty both queues.
+    while (_commands.TryPop()) {
+    }
+
+    while (_finished.TryPop()) {
+    }
+
+    _voices.clear();
+    _playing.clear();
+  }
+
+  auto AudioMixer::OpenMusic(const std::filesystem::path& path, const bool loop) const -> std::shared_ptr<MusicStream> {
+    auto stream = std::make_shared<MusicStream>(_sampleRate);
+    return stream->Open(path, loop) ? stream : nullptr;
+  }
+
+  auto AudioMixer::Play(std::shared_ptr<const Sound> sound, const VoiceParams params) -> VoiceID {
+    if (sound == nullptr) {
+      return nullVoice;
+    }
+
+    const auto command = Command{
+        .type = CommandType::Play,
+        .loop = params.loop,
+        .sound = sound.get(),
+        .gain = params.gain,
+        .pan = params.pan,
+    };
+
+    return Start(command, VoiceSource{.sound = std::move(sound)});
+  }
+
+  auto AudioMixer::Play(std::shared_ptr<MusicStream> stream, const VoiceParams params) -> VoiceID {
+    if (stream == nullptr || !stream->IsOpen()) {
+      return nullVoice;
+    }
+
+    if (stream->GetSampleRate() != _sampleRate) {
+      DEBUG_PRINT2("Music stream runs at {} Hz, the mixer at {} Hz.\n", stream->GetSampleRate(), _sampleRate)
+      return nullVoice;
+    }
+
+    // The stream has one read position, so two voices would each play every other block.
+    if (std::ranges::any_of(_playing, [&stream](const auto& playing) { return playing.second.stream == stream; })) {
+      return nullVoice;
+    }
+
+    const auto command = Command{
+        .type = CommandType::Play,
+        .stream = stream.get(),
+        .gain = params.gain,
+        .pan = params.pan,
+    };
+
+    return Start(command, VoiceSource{.stream = std::move(stream)});
+  }
+
+  auto AudioMixer::Start(const Command& command, VoiceSource&& source) -> VoiceID {
+    if (_playing.size() >= _maxVoices) {
+      return nullVoice;
+    }
+
+    if (++_nextVoice == nullVoice) {
+      ++_nextVoice;
+    }
+
+    auto started = command;
+    started.voice = _nextVoice;
+
+    if (!Send(started)) {
+      return nullVoice;
+    }
+
+    _playing.emplace(_nextVoice, std::move(source));
+    return _nextVoice;
+  }
+
+  auto AudioMixer::Stop(const VoiceID voice) -> bool {
+    return IsPlaying(voice) && Send(Command{.type = CommandType::Stop, .voice = voice});
+  }
+
+  auto AudioMixer::SetGain(const VoiceID voice, const float gain) -> bool {
+    return IsPlaying(voice) && Send(Command{.type = CommandType::SetGain, .voice = voice, .gain = gain});
+  }
+
+  auto AudioMixer::SetPan(const VoiceID voice, const float pan) -> bool {
+    return IsPlaying(voice) && Send(Command{.type = CommandType::SetPan, .voice = voice, .pan = pan});
+  }
+
+  auto AudioMixer::StopAll() -> bool { return Send(Command{.type = CommandType::StopAll}); }
+
+  auto AudioMixer::SetMasterGain(const float gain) -> bool { return Send(Command{.type = CommandType::SetMasterGain, .gain = gain}); }
+
+  void AudioMixer::Update() {
+    while (const auto voice = _finished.TryPop()) {
+      _playing.erase(*voice);
+    }
+  }
+
+  auto AudioMixer::Send(const Command& command) -> bool {
+    if (!_commands.TryPush(command)) {
+      DEBUG_PRINT("Audio command queue is full, {} commands waiting.\n", _commands.Size())
+      return false;
+    }
+
+    return true;
+  }
+
+  void AudioMixer::Mix(const std::span<float> out) {
+    ApplyCommands();
+
+    std::ranges::fill(out, 0.0f);
+
+    for (auto& voice: _voices) {
+      if (!voice.done) {
+        MixVoice(voice, out);
+      }
+    }
+
+    for (auto& sample: out) {
+      sample = std::clamp(sample * _masterGain, -1.0f, 1.0f);
+    }
+
+    // A finished voice whose report doesn't fit in the queue waits for the next mix.
+    for (auto i = 0uz; i < _voices.size();) {
+      if (_voices[i].done && _finished.TryPush(_voices[i].id)) {
+        _voices[i] = _voices.back();
+        _voices.pop_back();
+      } else {
+        ++i;
+      }
+    }
+  }
+
+  void AudioMixer::ApplyCommands() {
+    while (const auto command = _commands.TryPop()) {
+      switch (command->type) {
+        case CommandType::Play: {
+          const auto [left, right] = ChannelGains(command->gain, command->pan);
+
+          if (_voices.size() < _maxVoices) {
+            _voices.push_back(Voice{
+                .id = command->voice,
+                .sound = command->sound,
+                .stream = command->stream,
+                .loop = command->loop,
+                .gain = command->gain,
+                .pan = command->pan,
+                .left = left,
+                .right = right,
+            });
+          }
+
+          break;
+        }
+
+        case CommandType::Stop: {
+          if (auto* voice = FindVoice(command->voice); voice != nullptr) {
+            voice->stopping = true;
+          }
+
+          break;
+        }
+
+        case CommandType::SetGain: {
+          if (auto* voice = FindVoice(command->voice); voice != nullptr) {
+            voice->gain = command->gain;
+          }
+
+          break;
+        }
+
+        case CommandType::SetPan: {
+          if (auto* voice = FindVoice(command->voice); voice != nullptr) {
+            voice->pan = command->pan;
+          }
+
+          break;
+        }
+
+        case CommandType::StopAll: {
+          for (auto& voice: _voices) {
+            voice.stopping = true;
+          }
+
+          break;
+        }
+
+        case CommandType::SetMasterGain: {
+          _masterGain = command->gain;
+          break;
+        }
+      }
+    }
+  }
+
+  void AudioMixer::MixVoice(Voice& voice, const std::span<float> out) {
+    const auto frames = out.size() / audioChannels;
+
+    // Stopping fades out over this mix instead of cutting the wave off mid-cycle.
+    const auto gains = voice.stopping ? std::pair{0.0f, 0.0f} : ChannelGains(voice.gain, voice.pan);
+    const auto left = gains.first;
+    const auto right = gains.second;
+    const auto ramp = left != voice.left || right != voice.right;
+
+    // Adds count frames of in to out from frame written on. A ramp runs across the whole mix.
+    const auto mixFrames = [&](const float* in, const size_t written, const size_t count) {
+      auto* dest = out.data() + (written * audioChannels);
+
+      if (ramp) {
+        const auto step = 1.0f / static_cast<float>(frames);
+
+        for (auto i = 0uz; i < count; ++i) {
+          const auto t = static_cast<float>(written + i + 1uz) * step;
+          dest[(i * 2uz)] += in[(i * 2uz)] * (voice.left + ((left - voice.left) * t));
+          dest[(i * 2uz) + 1uz] += in[(i * 2uz) + 1uz] * (voice.right + ((right - voice.right) * t));
+        }
+      } else {
+        _mixRow(dest, in, count * audioChannels, left, right);
+      }
+    };
+
+    if (voice.stream != nullptr) {
+      for (auto written = 0uz; written < frames;) {
+        const auto wanted = std::min(frames - written, audioBlockFrames);
+        const auto count = voice.stream->Read(std::span{_streamBlock}.first(wanted * audioChannels)) / audioChannels;
+
+        mixFrames(_streamBlock.data(), written, count);
+        written += count;
+
+        // Past the end of the track or an underrun, the rest of this mix is silence.
+        if (count < wanted) {
+          break;
+        }
+      }
+
+      voice.left = left;
+      voice.right = right;
+      voice.done = voice.stopping || voice.stream->IsFinished();
+      return;
+    }
+
+    const auto samples = voice.sound->GetSamples();
+    const auto soundFrames = voice.sound->GetFrameCount();
+
+    auto written = 0uz;
+
+    while (written < frames) {
+      if (voice.frame >= soundFrames) {
+        if (!voice.loop || soundFrames == 0uz) {
+          voice.done = true;
+          break;
+        }
+
+        voice.frame = 0uz;
+      }
+
+      const auto count = std::min(frames - written, soundFrames - voice.frame);
+      mixFrames(samples.data() + (voice.frame * audioChannels), written, count);
+
+      voice.frame += count;
+      written += count;
+    }
+
+    voice.left = left;
+    voice.right = right;
+
+    if (voice.stopping || (!voice.loop && voice.frame >= soundFrames)) {
+      voice.done = true;
+    }
+  }
+
+  auto AudioMixer::FindVoice(const VoiceID voice) -> Voice* {
+    const auto found = std::ranges::find(_voices, voice, &Voice::id);
+    return found != _voices.end() ? &*found : nullptr;
+  }
+
+  void SDLCALL AudioMixer::StreamCallback(void* userdata, SDL_AudioStream* stream, const int additionalAmount, [[maybe_unused]] const int totalAmount) {
+    auto* mixer = static_cast<AudioMixer*>(userdata);
+
+    constexpr auto frameBytes = sizeof(float) * audioChannels;
+    auto frames = (static_cast<size_t>(additionalAmount) + frameBytes - 1uz) / frameBytes;
+
+    while (frames > 0uz) {
+      const auto count = std::min(frames, audioBlockFrames);
+      const auto block = std::span{mixer->_block}.first(count * audioChannels);
+
+      mixer->Mix(block);
+      SDL_PutAudioStreamData(stream, block.data(), static_cast<int>(block.size_bytes()));
+
+      frames -= count;
+    }
+  }
+
+} // namespace swgtk
+
+// NOLINTEND(*-pointer-arithmetic, *-reinterpret-cast, *-magic-numbers)
@@ -0,0 +1,58 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/DirtyRegion.hpp>
+
+#include <algorithm>
+
+namespace swgtk {
+
+  void DirtyRegion::Add(const SDL_Rect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) {
+      return;
+    }
+
+    if (_count++ == 0uz) {
+      _bounds = rect;
+      return;
+    }
+
+    const auto left = std::min(_bounds.x, rect.x);
+    const auto top = std::min(_bounds.y, rect.y);
+    const auto right = std::max(_bounds.x + _bounds.w, rect.x + rect.w);
+    const auto bottom = std::max(_bounds.y + _bounds.h, rect.y + rect.h);
+
+    _bounds = SDL_Rect{.x = left, .y = top, .w = right - left, .h = bottom - top};
+  }
+
+  auto DirtyRegion::GetBounds(const SDL_Rect& output) const -> SDL_Rect {
+    if (_all) {
+      return output;
+    }
+
+    if (_count == 0uz) {
+      return SDL_Rect{};
+    }
+
+    const auto left = std::max(_bounds.x, output.x);
+    const auto top = std::max(_bounds.y, output.y);
+    const auto right = std::min(_bounds.x + _bounds.w, output.x + output.w);
+    const auto bottom = std::min(_bounds.y + _bounds.h, output.y + output.h);
+
+    if (right <= left || bottom <= top) {
+      return SDL_Rect{};
+    }
+
+    return SDL_Rect{.x = left, .y = top, .w = right - left, .h = bottom - top};
+  }
+
+} // namespace swgtk
@@ -11,33 +11,69 @@
     SOFTWARE.
 */
 #include "swgtk/FontGroup.hpp"
+#include <SDL3/SDL_iostream.h>
+#include <algorithm>
 #include <string>
 #include <swgtk/Utility.hpp>
 #include <utility>
 
+namespace swgtk::embedded {
+  // Generated by swgtk_embed_file() in SWGTK/CMakeLists.txt.
+  extern const unsigned char defaultFontData[]; // NOLINT(*-avoid-c-arrays)
+  extern const size_t defaultFontDataSize;
+} // namespace swgtk::embedded
+
 namespace swgtk {
 
-  auto FontGroup::LoadDefaultFont() -> bool {
-    if (const auto filePath = std::filesystem::path{SWGTK_DEFAULT_FONT_FILE}; std::filesystem::exists(filePath)) {
-      const auto fileString = filePath.string();
+  namespace {
+    [[nodiscard]] auto OpenFontFromMemory(const std::span<const std::byte> data, const float size) -> TTF_Font* {
+      SDL_IOStream* stream = SDL_IOFromConstMem(data.data(), data.size());
 
-      if (TTF_Font* ttf = TTF_OpenFont(fileString.c_str(), _defaultFontSize); ttf == nullptr) {
-        DEBUG_PRINT2("Error opening font file {}: {}\n", fileString, SDL_GetError());
-      } else {
-        _ttfFonts.insert_or_assign(SWGTK_DEFAULT_FONT_ID, Font{.ptr = ttf});
-        return true;
+      if (stream == nullptr) {
+        DEBUG_PRINT("Error reading font from memory: {}\n", SDL_GetError())
+        return nullptr;
+      }
+
+      // The stream is closed along with the font, or straight away if opening fails.
+      TTF_Font* ttf = TTF_OpenFontIO(stream, true, size);
+
+      if (ttf == nullptr) {
+        DEBUG_PRINT("Error opening font from memory: {}\n", SDL_GetError())
       }
+
+      return ttf;
     }
+  } // namespace
 
-    return false;
+  auto FontGroup::GetDefaultFontData() -> std::span<const std::byte> {
+    return std::as_bytes(std::span{embedded::defaultFontData, embedded::defaultFontDataSize});
+  }
+
+  auto FontGroup::LoadDefaultFont() -> bool {
+    TTF_Font* ttf = OpenFontFromMemory(GetDefaultFontData(), _defaultFontSize);
+
+    if (ttf == nullptr) {
+      return false;
+    }
+
+    if (const auto face = _faces.find(SWGTK_DEFAULT_FONT_ID); face != _faces.end()) {
+      DropVariants(face->first);
+      TTF_CloseFont(std::exchange(face->second, ttf));
+    } else {
+      _faces.emplace(SWGTK_DEFAULT_FONT_ID, ttf);
+    }
+
+    return true;
   }
 
   auto FontGroup::AddFont(const std::filesystem::path& filename) -> bool {
-    if (const auto fileString = filename.string(); !_ttfFonts.contains(fileString)) {
+    if (auto name = filename.stem().string(); !_faces.contains(name)) {
+      const auto fileString = filename.string();
+
       if (TTF_Font* ttf = TTF_OpenFont(fileString.c_str(), _defaultFontSize); ttf == nullptr) {
         DEBUG_PRINT2("Error opening font file {}: {}\n", fileString, SDL_GetError());
       } else {
-        _ttfFonts.insert_or_assign(filename.stem().string(), Font{.ptr = ttf});
+        _faces.emplace(std::move(name), ttf);
         return true;
       }
     }
@@ -45,10 +81,104 @@ namespace swgtk {
     return false;
   }
 
-  void FontGroup::ClearFonts() const {
-    for (const auto [ptr]: _ttfFonts | std::views::values) {
+  auto FontGroup::AddFontFromMemory(const std::string_view name, const std::span<const std::byte> data) -> bool {
+    if (_faces.contains(name)) {
+      return false;
+    }
+
+    if (TTF_Font* ttf = OpenFontFromMemory(data, _defaultFontSize); ttf != nullptr) {
+      _faces.emplace(std::string{name}, ttf);
+      return true;
+    }
+
+    return false;
+  }
+
+  auto FontGroup::AddFontFromMemory(const std::string_view name, std::vector<std::byte>&& data) -> bool {
+    if (!AddFontFromMemory(name, std::span<const std::byte>{data})) {
+      return false;
+    }
+
+    _fontData.push_back(std::move(data));
+    return true;
+  }
+
+  void FontGroup::ClearFonts() {
+    // Copies go first, they were made from the faces and their keys point at the face names.
+    EvictVariants(0uz);
+
+    for (auto* ptr: _faces | std::views::values) {
       TTF_CloseFont(ptr);
     }
+
+    _faces.clear();
+    _fontData.clear();
+  }
+
+  auto FontGroup::GetFont(const std::string_view name, const float size, const FontStyle style) -> Font {
+    const auto face = _faces.find(name);
+
+    if (face == _faces.end()) {
+      return Font{};
+    }
+
+    const auto key = VariantKey{.name = face->first, .size = size, .style = style};
+
+    if (const auto found = _variantLookup.find(key); found != _variantLookup.end()) {
+      _variants.splice(_variants.begin(), _variants, found->second);
+      return Font{.ptr = found->second->ptr};
+    }
+
+    TTF_Font* copy = TTF_CopyFont(face->second);
+
+    if (copy == nullptr) {
+      DEBUG_PRINT2("Error copying font {}: {}\n", face->first, SDL_GetError());
+      return Font{};
+    }
+
+    if (!TTF_SetFontSize(copy, size)) {
+      DEBUG_PRINT2("Error sizing font {}: {}\n", face->first, SDL_GetError());
+      TTF_CloseFont(copy);
+      return Font{};
+    }
+
+    if (style != FontStyle::None) {
+      TTF_SetFontStyle(copy, std::to_underlying(style));
+    }
+
+    EvictVariants(_variantLimit - 1uz);
+
+    _variants.push_front(Variant{.key = key, .ptr = copy});
+    _variantLookup.emplace(key, _variants.begin());
+
+    return Font{.ptr = copy};
+  }
+
+  void FontGroup::SetVariantLimit(const size_t limit) {
+    _variantLimit = std::max(limit, 1uz);
+    EvictVariants(_variantLimit);
+  }
+
+  void FontGroup::EvictVariants(const size_t limit) {
+    while (_variants.size() > limit) {
+      const auto& oldest = _variants.back();
+
+      _variantLookup.erase(oldest.key);
+      TTF_CloseFont(oldest.ptr);
+      _variants.pop_back();
+    }
+  }
+
+  void FontGroup::DropVariants(const std::string_view name) {
+    for (auto variant = _variants.begin(); variant != _variants.end();) {
+      if (variant->key.name == name) {
+        _variantLookup.erase(variant->key);
+        TTF_CloseFont(variant->ptr);
+        variant = _variants.erase(variant);
+      } else {
+        ++variant;
+      }
+    }
   }
 
 } // namespace swgtk
@@ -0,0 +1,99 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/FrameArena.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+
+namespace {
+  constexpr auto blockAlignment = alignof(std::max_align_t);
+}
+
+namespace swgtk {
+
+  FrameArena::FrameArena(const size_t initialSize, std::pmr::memory_resource* upstream) :
+      _upstream(upstream) {
+    if (initialSize > 0uz) {
+      AddBlock(initialSize);
+    }
+  }
+
+  FrameArena::~FrameArena() {
+    ReleaseBlocks();
+  }
+
+  auto FrameArena::GetCapacity() const -> size_t {
+    return std::accumulate(_blocks.begin(), _blocks.end(), 0uz, [](const size_t total, const Block& block) { return total + block.size; });
+  }
+
+  void FrameArena::Reset() {
+    _highWaterMark = std::max(_highWaterMark, _usedBytes);
+
+    // Last frame spilled into extra blocks. Replace them with one block that fits the whole frame.
+    if (_blocks.size() > 1uz) {
+      ReleaseBlocks();
+      AddBlock(std::bit_ceil(_highWaterMark));
+    }
+
+    _currentBlock = 0uz;
+    _offset = 0uz;
+    _usedBytes = 0uz;
+  }
+
+  auto FrameArena::do_allocate(const size_t bytes, const size_t alignment) -> void* {
+    while (_currentBlock < _blocks.size()) {
+      const auto& block = _blocks[_currentBlock];
+      const auto base = reinterpret_cast<uintptr_t>(block.data); // NOLINT(*-reinterpret-cast)
+      const auto aligned = (base + _offset + (alignment - 1uz)) & ~(alignment - 1uz);
+      const auto end = aligned + bytes;
+
+      if (end <= base + block.size) {
+        _usedBytes += end - (base + _offset);
+        _offset = end - base;
+
+        return block.data + (aligned - base); // NOLINT(*-pointer-arithmetic)
+      }
+
+      // The rest of this block is wasted for the frame, move on to the next one.
+      _usedBytes += block.size - _offset;
+      ++_currentBlock;
+      _offset = 0uz;
+    }
+
+    const auto lastSize = _blocks.empty() ? defaultFrameArenaSize : _blocks.back().size;
+    AddBlock(std::max(lastSize * 2uz, bytes + alignment));
+    _currentBlock = _blocks.size() - 1uz;
+
+    return do_allocate(bytes, alignment);
+  }
+
+  void FrameArena::AddBlock(const size_t minimumSize) {
+    _blocks.push_back(Block{
+        .data = static_cast<std::byte*>(_upstream->allocate(minimumSize, blockAlignment)),
+        .size = minimumSize,
+    });
+
+    ++_blockAllocations;
+  }
+
+  void FrameArena::ReleaseBlocks() {
+    for (const auto& [data, size]: _blocks) {
+      _upstream->deallocate(data, size, blockAlignment);
+    }
+
+    _blocks.clear();
+  }
+
+} // namespace swgtk
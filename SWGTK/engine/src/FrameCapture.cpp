@@ -0,0 +1,323 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/FrameCapture.hpp>
+#include <swgtk/Utility.hpp>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <format>
+#include <span>
+#include <system_error>
+
+namespace {
+
+  struct Rgb {
+    int r = 0;
+    int g = 0;
+    int b = 0;
+  };
+
+  [[nodiscard]] constexpr auto Clamp8(const int value) -> uint8_t { return static_cast<uint8_t>(std::clamp(value, 0, 255)); }
+
+  // Full range BT.601 in 16.16 fixed point, the matrix Y4M's C420jpeg means.
+  [[nodiscard]] constexpr auto Luma(const Rgb& c) -> uint8_t { return Clamp8((19595 * c.r + 38470 * c.g + 7471 * c.b + 32768) >> 16); }
+  [[nodiscard]] constexpr auto ChromaBlue(const Rgb& c) -> uint8_t { return Clamp8(((-11059 * c.r - 21709 * c.g + 32768 * c.b + 32768) >> 16) + 128); }
+  [[nodiscard]] constexpr auto ChromaRed(const Rgb& c) -> uint8_t { return Clamp8(((32768 * c.r - 27439 * c.g - 5329 * c.b + 32768) >> 16) + 128); }
+
+  [[nodiscard]] auto PixelAt(const SDL_Surface* rgba, const int x, const int y) -> Rgb {
+    const auto* row = static_cast<const uint8_t*>(rgba->pixels) + static_cast<ptrdiff_t>(y) * rgba->pitch;
+    const auto* pixel = row + static_cast<ptrdiff_t>(x) * 4;
+
+    return Rgb{.r = pixel[0], .g = pixel[1], .b = pixel[2]};
+  }
+
+  // Planar Y, then U and V at half resolution, each chroma sample the average of the 2x2 block it covers.
+  void ToI420(const SDL_Surface* rgba, std::span<uint8_t> planes) {
+    const auto width = rgba->w;
+    const auto height = rgba->h;
+    const auto chromaWidth = (width + 1) / 2;
+    const auto chromaHeight = (height + 1) / 2;
+
+    auto luma = planes.begin();
+    auto blue = planes.begin() + static_cast<ptrdiff_t>(width) * height;
+    auto red = blue + static_cast<ptrdiff_t>(chromaWidth) * chromaHeight;
+
+    for (auto y = 0; y < height; ++y) {
+      for (auto x = 0; x < width; ++x) {
+        *luma++ = Luma(PixelAt(rgba, x, y));
+      }
+    }
+
+    for (auto cy = 0; cy < chromaHeight; ++cy) {
+      for (auto cx = 0; cx < chromaWidth; ++cx) {
+        Rgb sum{};
+        auto samples = 0;
+
+        for (auto y = cy * 2; y < std::min(cy * 2 + 2, height); ++y) {
+          for (auto x = cx * 2; x < std::min(cx * 2 + 2, width); ++x) {
+            const auto c = PixelAt(rgba, x, y);
+            sum.r += c.r;
+            sum.g += c.g;
+            sum.b += c.b;
+            ++samples;
+          }
+        }
+
+        const auto average = Rgb{.r = sum.r / samples, .g = sum.g / samples, .b = sum.b / samples};
+        *blue++ = ChromaBlue(average);
+        *red++ = ChromaRed(average);
+      }
+    }
+  }
+
+} // namespace
+
+namespace swgtk {
+
+  FrameCapture::~FrameCapture() {
+    Stop();
+
+    if (_worker.joinable()) {
+      _worker.request_stop();
+      _worker.join();
+    }
+
+    SDL_DestroySurface(_rgba);
+  }
+
+  auto FrameCapture::Start(const std::filesystem::path& path, const CaptureFormat format, const uint32_t every, const int fps) -> bool {
+    Stop();
+
+    if (format == CaptureFormat::Png) {
+      std::error_code error;
+      std::filesystem::create_directories(path, error);
+
+      if (error) {
+        DEBUG_PRINT2("Error creating capture directory {}: {}\n", path.string(), error.message())
+        return false;
+      }
+    } else {
+      // Nothing is queued after Stop(), so the worker isn't touching the stream.
+      _video.open(path, std::ios::binary | std::ios::trunc);
+
+      if (!_video) {
+        DEBUG_PRINT("Error opening capture file {}\n", path.string())
+        return false;
+      }
+
+      _fps = std::max(fps, 1);
+      _videoWidth = 0;
+      _videoHeight = 0;
+    }
+
+    if (!_worker.joinable()) {
+      _worker = std::jthread{[this](const std::stop_token& stop) { Work(stop); }};
+    }
+
+    std::scoped_lock lock{_mutex};
+    _path = path;
+    _format = format;
+    _every = std::max(every, 1u);
+    _frame = 0u;
+    _recording = true;
+    return true;
+  }
+
+  void FrameCapture::Stop() {
+    std::unique_lock lock{_mutex};
+    _recording = false;
+    WaitUntilDrained(lock);
+
+    if (_video.is_open()) {
+      _video.close();
+    }
+  }
+
+  void FrameCapture::Screenshot(const std::filesystem::path& path) {
+    if (!_worker.joinable()) {
+      _worker = std::jthread{[this](const std::stop_token& stop) { Work(stop); }};
+    }
+
+    std::scoped_lock lock{_mutex};
+    _screenshots.push_back(path);
+  }
+
+  void FrameCapture::SetQueueDepth(const size_t frames) {
+    std::scoped_lock lock{_mutex};
+    _queueDepth = std::max(frames, 1uz);
+  }
+
+  auto FrameCapture::IsRecording() const -> bool {
+    std::scoped_lock lock{_mutex};
+    return _recording;
+  }
+
+  auto FrameCapture::GetStats() const -> FrameCaptureStats {
+    std::scoped_lock lock{_mutex};
+    return _stats;
+  }
+
+  auto FrameCapture::IsFrameDue() -> bool {
+    std::scoped_lock lock{_mutex};
+
+    const auto record = _recording && _frame++ % _every == 0u;
+    const auto screenshot = !_screenshots.empty();
+
+    if (!record && !screenshot) {
+      return false;
+    }
+
+    // A screenshot waiting for room is just taken a frame later.
+    if (_jobs.size() + (_busy ? 1uz : 0uz) >= _queueDepth) {
+      if (record) {
+        ++_stats.dropped;
+      }
+
+      return false;
+    }
+
+    _recordDue = record;
+    _screenshotDue = screenshot;
+    return true;
+  }
+
+  void FrameCapture::Submit(SDL_Surface* frame) {
+    {
+      std::scoped_lock lock{_mutex};
+
+      if (frame == nullptr) {
+        DEBUG_PRINT("Error reading back frame: {}\n", SDL_GetError())
+        // A screenshot stays pending and is tried again on the next frame.
+        _stats.failed += _recordDue ? 1u : 0u;
+        _recordDue = false;
+        _screenshotDue = false;
+        return;
+      }
+
+      if (!_recordDue && !_screenshotDue) {
+        SDL_DestroySurface(frame);
+        return;
+      }
+
+      if (_screenshotDue) {
+        auto* shot = _recordDue ? SDL_DuplicateSurface(frame) : frame;
+
+        if (shot != nullptr) {
+          _jobs.push_back(Job{.frame = shot, .path = std::move(_screenshots.front()), .video = false});
+        } else {
+          ++_stats.failed;
+        }
+
+        _screenshots.pop_front();
+      }
+
+      if (_recordDue) {
+        const auto video = _format == CaptureFormat::Y4m;
+        auto path = video ? std::filesystem::path{} : _path / std::format("frame_{:06}.png", _stats.captured);
+
+        _jobs.push_back(Job{.frame = frame, .path = std::move(path), .video = video});
+        ++_stats.captured;
+      }
+
+      _recordDue = false;
+      _screenshotDue = false;
+    }
+
+    _wake.notify_one();
+  }
+
+  void FrameCapture::WaitUntilDrained(std::unique_lock<std::mutex>& lock) {
+    _drained.wait(lock, [this] { return _jobs.empty() && !_busy; });
+  }
+
+  void FrameCapture::Work(const std::stop_token& stop) {
+    std::unique_lock lock{_mutex};
+
+    // Jobs still queued when asked to stop are written first, the wait only gives up once there are none.
+    while (_wake.wait(lock, stop, [this] { return !_jobs.empty(); })) {
+      auto job = std::move(_jobs.front());
+      _jobs.pop_front();
+      _busy = true;
+      lock.unlock();
+
+      const auto written = job.video ? WriteVideoFrame(job.frame) : WritePng(job.frame, job.path);
+      SDL_DestroySurface(job.frame);
+
+      lock.lock();
+      _busy = false;
+
+      if (written) {
+        ++_stats.written;
+      } else {
+        ++_stats.failed;
+      }
+
+      _drained.notify_all();
+    }
+  }
+
+  auto FrameCapture::WritePng(SDL_Surface* frame, const std::filesystem::path& path) -> bool {
+    if (!IMG_SavePNG(frame, path.string().c_str())) {
+      DEBUG_PRINT2("Error writing {}: {}\n", path.string(), SDL_GetError())
+      return false;
+    }
+
+    return true;
+  }
+
+  auto FrameCapture::ConvertToRgba(SDL_Surface* frame) -> bool {
+    if (_rgba == nullptr || _rgba->w != frame->w || _rgba->h != frame->h) {
+      SDL_DestroySurface(_rgba);
+      _rgba = SDL_CreateSurface(frame->w, frame->h, SDL_PIXELFORMAT_RGBA32);
+
+      if (_rgba == nullptr) {
+        DEBUG_PRINT("Error creating capture surface: {}\n", SDL_GetError())
+        return false;
+      }
+    }
+
+    if (!SDL_ConvertPixels(frame->w, frame->h, frame->format, frame->pixels, frame->pitch, _rgba->format, _rgba->pixels, _rgba->pitch)) {
+      DEBUG_PRINT("Error converting captured frame: {}\n", SDL_GetError())
+      return false;
+    }
+
+    return true;
+  }
+
+  auto FrameCapture::WriteVideoFrame(SDL_Surface* frame) -> bool {
+    if (_videoWidth == 0) {
+      _videoWidth = frame->w;
+      _videoHeight = frame->h;
+      _video << std::format("YUV4MPEG2 W{} H{} F{}:1 Ip A1:1 C420jpeg\n", _videoWidth, _videoHeight, _fps);
+    }
+
+    if (frame->w != _videoWidth || frame->h != _videoHeight) {
+      DEBUG_PRINT2("Captured frame is {}x{}, the video's size can't change.\n", frame->w, frame->h)
+      return false;
+    }
+
+    if (!ConvertToRgba(frame)) {
+      return false;
+    }
+
+    const auto chroma = static_cast<size_t>((_videoWidth + 1) / 2) * static_cast<size_t>((_videoHeight + 1) / 2);
+    _planes.resize(static_cast<size_t>(_videoWidth) * static_cast<size_t>(_videoHeight) + chroma * 2uz);
+    ToI420(_rgba, _planes);
+
+    _video << "FRAME\n";
+    _video.write(reinterpret_cast<const char*>(_planes.data()), static_cast<std::streamsize>(_planes.size()));
+    return static_cast<bool>(_video);
+  }
+
+} // namespace swgtk
@@ -1,20 +1,69 @@
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <swgtk/App.hpp>
 #include <swgtk/FontGroup.hpp>
 #include <swgtk/Input.hpp>
 #include <swgtk/Lua.hpp>
+#include <swgtk/LuaBytecode.hpp>
+#include <swgtk/LuaGC.hpp>
+#include <swgtk/LuaProfiler.hpp>
+#include <swgtk/LuaScheduler.hpp>
+#include <swgtk/MemoryTracker.hpp>
 #include <swgtk/Surface.hpp>
 #include <swgtk/Timer.hpp>
+#include <span>
+#include <tuple>
+#include <vector>
 
 namespace {
   void InitLuaFonts(swgtk::FontGroup* fonts, sol::state& lua);
 }
 
 namespace swgtk {
+  auto LuaCacheDirectory() -> std::filesystem::path {
+#ifdef SWGTK_LUA_CACHE_DIR
+    constexpr auto cacheName = SWGTK_LUA_CACHE_DIR;
+#else
+    constexpr auto cacheName = "luac";
+#endif
+
+    if (const auto* overridden = SDL_getenv("SWGTK_LUA_CACHE_DIR"); overridden != nullptr && *overridden != '\0') {
+      return std::filesystem::path{overridden};
+    }
+
+    if (const auto* base = SDL_GetBasePath(); base != nullptr) {
+      return std::filesystem::path{base} / cacheName;
+    }
+
+    DEBUG_PRINT("No directory for the Lua cache, scripts will load from source: {}\n", SDL_GetError())
+    return std::filesystem::path{};
+  }
+
+  auto App::GetLuaCache() -> LuaBytecodeCache* {
+    if (!_luaCache) {
+      _luaCache.emplace(LuaCacheDirectory());
+    }
+
+    return &*_luaCache;
+  }
+
   void InitLua(App* app, sol::state& lua, const LuaPrivledges priv) {
+#ifdef SWGTK_TRACK_MEMORY
+    // Lua's default allocator also uses realloc/free, so the existing heap can be handed over as-is. It isn't counted,
+    // the tracker only sees allocations made from here on.
+    lua_setallocf(lua.lua_state(), &MemoryTracker::LuaAllocator, nullptr);
+#endif
 
-    lua.open_libraries(sol::lib::base, sol::lib::string, sol::lib::math, sol::lib::package);
+    lua.open_libraries(sol::lib::base, sol::lib::string, sol::lib::math, sol::lib::package, sol::lib::coroutine);
 
+#ifdef SWGTK_LUA_CACHE_DIR
+    app->GetLuaCache()->RunFile(lua, SWGTK_TABLE_LUA_FILE);
+#else
     lua.safe_script_file(SWGTK_TABLE_LUA_FILE);
+#endif
 
     auto SWGTK = lua["swgtk"];
 
@@ -325,12 +374,79 @@ namespace swgtk {
 
     App_Type["CloseApp"] = &App::CloseApp;
 
+    App_Type["SetIdleTimeout"] = &App::SetIdleTimeout;
+
     App_Type["GetWindowSize"] = &App::GetWindowSize;
 
-    SWGTK["Surface"] = lua.new_usertype<Surface>("Surface",
-                                                 sol::constructors<Surface(), Surface(SDL_Surface*), Surface(const Surface&),
-                                                                   Surface(const int, const int, const SDL_PixelFormat),
-                                                                   Surface(const int, const int, const SDL_PixelFormat, void*, const int)>());
+    // The engine schedules garbage collection once the frame loop steps it. See LuaGC.
+    app->GetLuaGC()->Attach(lua.lua_state());
+
+    SWGTK["GCStats"] = lua.new_usertype<LuaGCStats>("GCStats", sol::no_constructor,
+                                                    "lastMilliseconds", sol::readonly(&LuaGCStats::lastMilliseconds),
+                                                    "maxMilliseconds", sol::readonly(&LuaGCStats::maxMilliseconds),
+                                                    "lastSteps", sol::readonly(&LuaGCStats::lastSteps),
+                                                    "heapBytes", sol::readonly(&LuaGCStats::heapBytes),
+                                                    "peakHeapBytes", sol::readonly(&LuaGCStats::peakHeapBytes),
+                                                    "cycles", sol::readonly(&LuaGCStats::cycles),
+                                                    "catchUpFrames", sol::readonly(&LuaGCStats::catchUpFrames));
+
+    App_Type["StepGC"] = &App::StepLuaGC;
+
+    App_Type["GetGCStats"] = [app] { return app->GetLuaGC()->GetStats(); };
+
+    // Adds swgtk.spawn() and the wait functions. See LuaScheduler.
+    app->GetLuaScheduler()->Attach(lua.lua_state());
+
+    SWGTK["TaskStats"] = lua.new_usertype<LuaSchedulerStats>("TaskStats", sol::no_constructor,
+                                                             "lastMilliseconds", sol::readonly(&LuaSchedulerStats::lastMilliseconds),
+                                                             "lastResumed", sol::readonly(&LuaSchedulerStats::lastResumed),
+                                                             "lastDeferred", sol::readonly(&LuaSchedulerStats::lastDeferred),
+                                                             "running", sol::readonly(&LuaSchedulerStats::running),
+                                                             "failed", sol::readonly(&LuaSchedulerStats::failed));
+
+    App_Type["SetTaskBudget"] = [](App& self, const double milliseconds) { self.GetLuaScheduler()->SetBudget(milliseconds); };
+
+    App_Type["GetTaskStats"] = [app] { return app->GetLuaScheduler()->GetStats(); };
+
+    SWGTK["FunctionProfile"] = lua.new_usertype<LuaFunctionProfile>("FunctionProfile", sol::no_constructor,
+                                                                    "name", sol::readonly(&LuaFunctionProfile::name),
+                                                                    "selfSamples", sol::readonly(&LuaFunctionProfile::selfSamples),
+                                                                    "totalSamples", sol::readonly(&LuaFunctionProfile::totalSamples),
+                                                                    "selfMilliseconds", sol::readonly(&LuaFunctionProfile::selfMilliseconds),
+                                                                    "totalMilliseconds", sol::readonly(&LuaFunctionProfile::totalMilliseconds));
+
+    App_Type["StartProfiler"] = [state = lua.lua_state()](App& self, const sol::optional<int> interval) {
+      self.GetLuaProfiler()->Start(state, interval.value_or(LuaProfiler::defaultInterval));
+    };
+
+    App_Type["StopProfiler"] = [app] { app->GetLuaProfiler()->Stop(); };
+
+    App_Type["IsProfiling"] = [app] { return app->GetLuaProfiler()->IsRunning(); };
+
+    App_Type["ResetProfile"] = [app] { app->GetLuaProfiler()->Reset(); };
+
+    App_Type["GetProfile"] = [app] { return sol::as_table(app->GetLuaProfiler()->GetFunctionProfiles()); };
+
+    App_Type["SaveProfile"] = [](App& self, const std::string& path, const sol::optional<bool> useTime) {
+      return self.GetLuaProfiler()->WriteFoldedStacks(path, useTime.value_or(false));
+    };
+
+    // Surfaces Lua creates are UniqueSurfaces, destroyed when collected. Copying one only copies the handle.
+    SWGTK["Surface"] = lua.new_usertype<Surface>(
+        "Surface", sol::factories([] { return Surface{}; }, [](const Surface& other) { return Surface{other}; },
+                                  [](SDL_Surface* surface) { return UniqueSurface{Surface{surface}}; },
+                                  [](const int width, const int height, const SDL_PixelFormat format) { return UniqueSurface{Surface{width, height, format}}; },
+                                  [](const int width, const int height, const SDL_PixelFormat format, void* pixels, const int pitch) {
+                                    return UniqueSurface{Surface{width, height, format, pixels, pitch}};
+                                  }));
+
+    SWGTK["UniqueSurface"] = lua.new_usertype<UniqueSurface>("UniqueSurface", sol::no_constructor, sol::base_classes, sol::bases<Surface>());
+
+    SWGTK["Surface"]["Destroy"] = &Surface::Destroy;
+
+    SWGTK["Surface"]["DestroyDeferred"] = &Surface::DestroyDeferred;
+
+    SWGTK["Surface"]["IsValid"] = &Surface::IsValid;
 
     SWGTK["Surface"]["Clear"] = &Surface::Clear;
 
@@ -341,6 +457,79 @@ namespace swgtk {
     SWGTK["Surface"]["FillRect"] = &Surface::FillRect;
 
     SWGTK["Surface"]["FillRects"] = &Surface::FillRects;
+
+    SWGTK["Surface"]["Convert"] = [](const Surface& self, const SDL_PixelFormat format) { return UniqueSurface{self.Convert(format)}; };
+
+    // The PixelBuffer keeps the surface it locked referenced, so the collector can't destroy it underneath the lock.
+    SWGTK["Surface"]["Lock"] = sol::policies(&Surface::Lock, sol::self_dependency());
+
+    // Raw access to a locked surface. Pixels are integers in the surface's format; Map() makes one from a color.
+    auto PixelBuffer_Type = lua.new_usertype<SurfaceLock>("PixelBuffer", sol::no_constructor);
+    SWGTK["PixelBuffer"] = PixelBuffer_Type;
+
+    PixelBuffer_Type["Unlock"] = &SurfaceLock::Unlock;
+    PixelBuffer_Type["IsLocked"] = &SurfaceLock::IsLocked;
+    PixelBuffer_Type["Width"] = &SurfaceLock::Width;
+    PixelBuffer_Type["Height"] = &SurfaceLock::Height;
+    PixelBuffer_Type["Format"] = &SurfaceLock::Format;
+    PixelBuffer_Type["BytesPerPixel"] = &SurfaceLock::BytesPerPixel;
+
+    // Components are 0 to 255. Out of range gives nil rather than a pixel of some other color.
+    PixelBuffer_Type["Map"] = [](const SurfaceLock& self, const lua_Integer r, const lua_Integer g, const lua_Integer b,
+                                 const sol::optional<lua_Integer> a) -> sol::optional<uint32_t> {
+      constexpr auto maxComponent = static_cast<lua_Integer>(std::numeric_limits<uint8_t>::max());
+      const auto alpha = a.value_or(maxComponent);
+
+      if (std::ranges::any_of(std::array{r, g, b, alpha}, [](const lua_Integer c) { return c < 0 || c > maxComponent; })) {
+        DEBUG_PRINT("{}\n", "PixelBuffer:Map() color components must be from 0 to 255.")
+        return sol::nullopt;
+      }
+
+      return self.MapRGBA(static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b), static_cast<uint8_t>(alpha));
+    };
+
+    PixelBuffer_Type["Unmap"] = [](const SurfaceLock& self, const uint32_t pixel) {
+      const auto color = self.GetRGBA(pixel);
+      return std::make_tuple(color.r, color.g, color.b, color.a);
+    };
+
+    PixelBuffer_Type["Get"] = [](const SurfaceLock& self, const int x, const int y) -> uint32_t {
+      return (self.IsLocked() && self.Contains(x, y)) ? self.ReadRaw(x, y) : 0u;
+    };
+
+    PixelBuffer_Type["Set"] = [](const SurfaceLock& self, const int x, const int y, const uint32_t pixel) {
+      if (self.IsLocked() && self.Contains(x, y)) {
+        self.WriteRaw(x, y, pixel);
+      }
+    };
+
+    PixelBuffer_Type["Fill"] = [](const SurfaceLock& self, const uint32_t pixel) {
+      for (auto y = 0; y < self.Height(); ++y) {
+        for (auto x = 0; x < self.Width(); ++x) {
+          self.WriteRaw(x, y, pixel);
+        }
+      }
+    };
+
+    // A whole row at once, as an array of raw pixels. Missing entries are left alone.
+    PixelBuffer_Type["SetRow"] = [](const SurfaceLock& self, const int y, const sol::table& pixels) {
+      if (!self.IsLocked() || y < 0 || y >= self.Height()) {
+        return;
+      }
+
+      const auto count = std::min(static_cast<int>(pixels.size()), self.Width());
+
+      for (auto x = 0; x < count; ++x) {
+        if (const auto pixel = pixels.get<sol::optional<uint32_t>>(x + 1)) {
+          self.WriteRaw(x, y, *pixel);
+        }
+      }
+    };
+
+    // The raw bytes of every row, without padding, as a Lua string. Pairs with string.pack/unpack.
+    PixelBuffer_Type["Read"] = [](const SurfaceLock& self) { return self.IsLocked() ? self.ReadBytes() : std::string{}; };
+
+    PixelBuffer_Type["Write"] = [](const SurfaceLock& self, const std::string_view bytes) { return self.IsLocked() && self.WriteBytes(bytes); };
   }
 } // namespace swgtk
 
@@ -375,13 +564,26 @@ namespace {
 
     FontGroup_Type["AddFont"] = [](FontGroup& self, const std::filesystem::path& filename) { self.AddFont(filename); };
 
-    FontGroup_Type["GetFont"] = [](const FontGroup& self, const std::string& name) { return self.GetFont(name); };
+    // Lua strings are collected whenever, so the group keeps its own copy of the data.
+    FontGroup_Type["AddFontFromMemory"] = [](FontGroup& self, const std::string& name, const std::string_view data) {
+      const auto bytes = std::as_bytes(std::span{data});
+      return self.AddFontFromMemory(name, std::vector<std::byte>{bytes.begin(), bytes.end()});
+    };
+
+    FontGroup_Type["GetFont"] = sol::overload(
+        [](const FontGroup& self, const std::string& name) { return self.GetFont(name); },
+        [](FontGroup& self, const std::string& name, const float size) { return self.GetFont(name, size); },
+        [](FontGroup& self, const std::string& name, const float size, const FontStyle style) { return self.GetFont(name, size, style); });
+
+    FontGroup_Type["SetVariantLimit"] = [](FontGroup& self, const size_t limit) { self.SetVariantLimit(limit); };
+
+    FontGroup_Type["GetVariantCount"] = [](const FontGroup& self) { return self.GetVariantCount(); };
 
     FontGroup_Type["SetFontStyle"] = [](const Font font, const FontStyle style) { FontGroup::SetFontStyle(font, style); };
 
     FontGroup_Type["GetFontStyle"] = [](const Font font) { return FontGroup::GetFontStyle(font); };
 
-    FontGroup_Type["ClearFonts"] = [](const FontGroup& self) { self.ClearFonts(); };
+    FontGroup_Type["ClearFonts"] = [](FontGroup& self) { self.ClearFonts(); };
   }
 
 } // namespace
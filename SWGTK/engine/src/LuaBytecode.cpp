@@ -0,0 +1,242 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/LuaBytecode.hpp>
+
+#include <array>
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <swgtk/Utility.hpp>
+#include <system_error>
+#include <utility>
+
+namespace {
+  using namespace swgtk;
+
+  constexpr auto entryMagic = std::array{'S', 'W', 'L', 'B'};
+
+  struct EntryHeader {
+    std::array<char, 4uz> magic = entryMagic;
+    uint32_t format = LuaBytecodeCache::formatVersion;
+    uint32_t luaVersion = LUA_VERSION_NUM;
+    uint32_t reserved = 0u;
+    uint64_t sourceHash = 0u;
+    uint64_t byteCount = 0u;
+  };
+
+  [[nodiscard]] auto ReadFile(const std::filesystem::path& path) -> std::optional<std::string> {
+    auto file = std::ifstream{path, std::ios::binary};
+
+    if (!file) {
+      return std::nullopt;
+    }
+
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  }
+
+  [[nodiscard]] auto ChunkName(const std::filesystem::path& script) -> std::string {
+    // A leading '@' tells Lua the chunk came from a file, so error messages show the path.
+    return "@" + script.generic_string();
+  }
+
+  auto DumpWriter([[maybe_unused]] lua_State* state, const void* data, const size_t size, void* userData) -> int {
+    auto* bytes = static_cast<std::vector<char>*>(userData);
+    const auto* first = static_cast<const char*>(data);
+
+    bytes->insert(bytes->end(), first, first + size); // NOLINT(*-pointer-arithmetic)
+    return 0;
+  }
+} // namespace
+
+namespace swgtk {
+
+  LuaBytecodeCache::LuaBytecodeCache(std::filesystem::path directory, const bool writeBack) :
+      _directory(std::move(directory)), _writeBack(writeBack) {}
+
+  auto LuaBytecodeCache::Load(sol::state& lua, const std::filesystem::path& script) -> sol::load_result {
+    const auto source = ReadFile(script);
+
+    if (!source || _directory.empty()) {
+      // Let Lua report the missing file the same way it would without the cache.
+      return lua.load_file(script.string());
+    }
+
+    const auto hash = HashSource(*source);
+    const auto chunkName = ChunkName(script);
+
+    if (const auto bytecode = ReadEntry(hash); !bytecode) {
+      ++_stats.misses;
+    } else {
+      // An empty entry failed the header check. Otherwise lua_load() validates the bytecode header itself.
+      if (!bytecode->empty()) {
+        if (auto chunk = lua.load_buffer(bytecode->data(), bytecode->size(), chunkName, sol::load_mode::binary); chunk.valid()) {
+          ++_stats.hits;
+          return chunk;
+        }
+      }
+
+      // Drop it so it isn't read and rejected again on every launch; write-back replaces it below.
+      std::error_code error;
+      std::filesystem::remove(EntryPath(hash), error);
+
+      ++_stats.rejected;
+    }
+
+    auto chunk = lua.load_buffer(source->data(), source->size(), chunkName, sol::load_mode::text);
+
+    if (chunk.valid() && _writeBack) {
+      std::vector<char> bytecode;
+
+      lua_pushvalue(lua.lua_state(), chunk.stack_index());
+
+      if (lua_dump(lua.lua_state(), &DumpWriter, &bytecode, 0) == 0) {
+        WriteEntry(hash, bytecode);
+      }
+
+      lua_pop(lua.lua_state(), 1);
+    }
+
+    return chunk;
+  }
+
+  auto LuaBytecodeCache::RunFile(sol::state& lua, const std::filesystem::path& script) -> bool {
+    auto chunk = Load(lua, script);
+
+    if (!chunk.valid()) {
+      [[maybe_unused]] const sol::error error = chunk;
+      DEBUG_PRINT("Failed to load Lua script: {}\n", error.what())
+      return false;
+    }
+
+    const sol::protected_function function = chunk;
+
+    if (const auto result = function(); !result.valid()) {
+      [[maybe_unused]] const sol::error error = result;
+      DEBUG_PRINT("Lua script failed: {}\n", error.what())
+      return false;
+    }
+
+    return true;
+  }
+
+  auto LuaBytecodeCache::Precompile(lua_State* state, const std::filesystem::path& script) -> bool {
+    const auto source = ReadFile(script);
+
+    if (!source) {
+      DEBUG_PRINT("Could not read Lua script {}\n", script.string())
+      return false;
+    }
+
+    const auto bytecode = CompileLuaBytecode(state, *source, ChunkName(script));
+
+    if (!bytecode) {
+      return false;
+    }
+
+    // Only the build step creates the directory. At runtime its absence means there is no cache to write back to.
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+
+    return WriteEntry(HashSource(*source), *bytecode);
+  }
+
+  auto LuaBytecodeCache::EntryPath(const uint64_t sourceHash) const -> std::filesystem::path {
+    return _directory / std::format("{:016x}.luac", sourceHash);
+  }
+
+  auto LuaBytecodeCache::ReadEntry(const uint64_t sourceHash) const -> std::optional<std::vector<char>> {
+    const auto path = EntryPath(sourceHash);
+    auto file = std::ifstream{path, std::ios::binary};
+
+    if (!file) {
+      return std::nullopt;
+    }
+
+    EntryHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header)); // NOLINT(*-reinterpret-cast)
+
+    std::error_code error;
+    const auto fileSize = std::filesystem::file_size(path, error);
+
+    if (!file || error || header.magic != entryMagic || header.format != formatVersion || header.luaVersion != LUA_VERSION_NUM ||
+        header.sourceHash != sourceHash || header.byteCount != fileSize - sizeof(header)) {
+      return std::vector<char>{};
+    }
+
+    auto bytecode = std::vector<char>(header.byteCount);
+    file.read(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+
+    if (!file) {
+      return std::vector<char>{};
+    }
+
+    return bytecode;
+  }
+
+  auto LuaBytecodeCache::WriteEntry(const uint64_t sourceHash, const std::vector<char>& bytecode) -> bool {
+    std::error_code error;
+    const auto path = EntryPath(sourceHash);
+    auto temp = path;
+    temp += ".tmp";
+
+    // Write to a temporary file first so a crash or a second process never leaves a half-written entry behind.
+    {
+      auto file = std::ofstream{temp, std::ios::binary | std::ios::trunc};
+
+      if (!file) {
+        return false;
+      }
+
+      const auto header = EntryHeader{.sourceHash = sourceHash, .byteCount = bytecode.size()};
+
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header)); // NOLINT(*-reinterpret-cast)
+      file.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+
+      if (!file) {
+        std::filesystem::remove(temp, error);
+        return false;
+      }
+    }
+
+    std::filesystem::rename(temp, path, error);
+
+    if (error) {
+      std::filesystem::remove(temp, error);
+      return false;
+    }
+
+    ++_stats.writes;
+    return true;
+  }
+
+  auto CompileLuaBytecode(lua_State* state, const std::string_view source, const std::string& chunkName) -> std::optional<std::vector<char>> {
+    if (luaL_loadbufferx(state, source.data(), source.size(), chunkName.c_str(), "t") != LUA_OK) {
+      DEBUG_PRINT("Failed to compile Lua script: {}\n", lua_tostring(state, -1))
+      lua_pop(state, 1);
+      return std::nullopt;
+    }
+
+    std::vector<char> bytecode;
+    const auto status = lua_dump(state, &DumpWriter, &bytecode, 0);
+
+    lua_pop(state, 1);
+
+    if (status != 0) {
+      return std::nullopt;
+    }
+
+    return bytecode;
+  }
+
+} // namespace swgtk
@@ -0,0 +1,59 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/LuaCloseGuard.hpp>
+
+extern "C" {
+#include <lua.h>
+}
+
+namespace {
+  struct Guard {
+    swgtk::LuaCloseGuard::Callback callback = nullptr;
+    void* owner = nullptr;
+  };
+
+  auto OnClose(lua_State* state) -> int {
+    if (auto* guard = static_cast<Guard*>(lua_touserdata(state, 1)); guard != nullptr && guard->owner != nullptr) {
+      guard->callback(guard->owner);
+    }
+
+    return 0;
+  }
+} // namespace
+
+namespace swgtk {
+
+  void LuaCloseGuard::Install(lua_State* state, const char* key, const Callback callback, void* owner) {
+    auto* guard = static_cast<Guard*>(lua_newuserdatauv(state, sizeof(Guard), 0));
+    *guard = Guard{.callback = callback, .owner = owner};
+
+    lua_createtable(state, 0, 1);
+    lua_pushcfunction(state, &OnClose);
+    lua_setfield(state, -2, "__gc");
+    lua_setmetatable(state, -2);
+    lua_setfield(state, LUA_REGISTRYINDEX, key);
+  }
+
+  void LuaCloseGuard::Remove(lua_State* state, const char* key, const void* owner) {
+    lua_getfield(state, LUA_REGISTRYINDEX, key);
+
+    if (auto* guard = static_cast<Guard*>(lua_touserdata(state, -1)); guard != nullptr && guard->owner == owner) {
+      guard->owner = nullptr;
+      lua_pushnil(state);
+      lua_setfield(state, LUA_REGISTRYINDEX, key);
+    }
+
+    lua_pop(state, 1);
+  }
+
+} // namespace swgtk
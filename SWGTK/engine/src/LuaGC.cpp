@@ -0,0 +1,141 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/LuaGC.hpp>
+
+#include <algorithm>
+#include <swgtk/LuaCloseGuard.hpp>
+#include <swgtk/Timer.hpp>
+
+extern "C" {
+#include <lua.h>
+}
+
+namespace {
+  constexpr auto pauseFactor = 2uz;
+  constexpr auto guardKey = "swgtk.LuaGC";
+} // namespace
+
+namespace swgtk {
+
+  void LuaGC::Attach(lua_State* state, const LuaGCMode mode) {
+    Detach();
+
+    _state = state;
+    _mode = mode;
+    _stats = LuaGCStats{};
+    _cycleDone = false;
+    _stepping = false;
+
+    if (_state == nullptr) {
+      return;
+    }
+
+    // Zeroes keep Lua's default tuning parameters for the chosen mode. The automatic collector runs in it until Step().
+    if (_mode == LuaGCMode::Generational) {
+      lua_gc(_state, LUA_GCGEN, 0, 0);
+    } else {
+      lua_gc(_state, LUA_GCINC, 0, 0, 0);
+    }
+
+    lua_gc(_state, LUA_GCRESTART);
+
+    LuaCloseGuard::Install(_state, guardKey, [](void* owner) { static_cast<LuaGC*>(owner)->Release(); }, this);
+  }
+
+  void LuaGC::Detach() {
+    if (_state == nullptr) {
+      return;
+    }
+
+    LuaCloseGuard::Remove(_state, guardKey, this);
+    HandBack();
+    _state = nullptr;
+  }
+
+  void LuaGC::HandBack() {
+    if (_state != nullptr && _stepping) {
+      lua_gc(_state, LUA_GCRESTART);
+    }
+
+    _stepping = false;
+  }
+
+  void LuaGC::Step(const double frameElapsed) {
+    if (_state == nullptr) {
+      return;
+    }
+
+    if (!_stepping) {
+      lua_gc(_state, LUA_GCSTOP);
+      _stepping = true;
+      _cycleDone = false;
+      _heapAfterCycle = GetHeapBytes();
+    }
+
+    const auto heap = GetHeapBytes();
+    const auto threshold = _heapAfterCycle * pauseFactor;
+
+    const auto startingCycle = _cycleDone;
+
+    _stats.lastMilliseconds = 0.0;
+    _stats.lastSteps = 0uz;
+
+    // Like Lua's own pause, do not start the next cycle until the heap has grown enough to be worth collecting.
+    if (startingCycle && heap < threshold) {
+      _stats.heapBytes = heap;
+      return;
+    }
+
+    _cycleDone = false;
+
+    auto allowed = std::clamp(_frameBudget - frameElapsed, _minStep, _maxStep);
+
+    // The heap doubled in the middle of a cycle, so the collector is falling behind the scripts.
+    if (!startingCycle && heap >= threshold) {
+      allowed = _maxStep;
+      ++_stats.catchUpFrames;
+    }
+
+    Timer timer;
+
+    do {
+      ++_stats.lastSteps;
+
+      // A zero sized step performs one basic increment. It returns 1 when the step finished a cycle.
+      const auto finished = lua_gc(_state, LUA_GCSTEP, 0) != 0;
+
+      // A generational step is a complete minor collection, so treat every one as the end of a cycle.
+      if (finished || _mode == LuaGCMode::Generational) {
+        ++_stats.cycles;
+        _cycleDone = true;
+        _heapAfterCycle = GetHeapBytes();
+        break;
+      }
+    } while (timer.GetElapsedMilliseconds() < allowed);
+
+    _stats.lastMilliseconds = timer.GetElapsedMilliseconds();
+    _stats.maxMilliseconds = std::max(_stats.maxMilliseconds, _stats.lastMilliseconds);
+    _stats.heapBytes = GetHeapBytes();
+    _stats.peakHeapBytes = std::max(_stats.peakHeapBytes, _stats.heapBytes);
+  }
+
+  auto LuaGC::GetHeapBytes() const -> size_t {
+    if (_state == nullptr) {
+      return 0uz;
+    }
+
+    constexpr auto kilobyte = 1024uz;
+    return (static_cast<size_t>(lua_gc(_state, LUA_GCCOUNT)) * kilobyte) + static_cast<size_t>(lua_gc(_state, LUA_GCCOUNTB));
+  }
+
+} // namespace swgtk
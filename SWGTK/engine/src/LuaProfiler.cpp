@@ -0,0 +1,260 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/LuaProfiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <string_view>
+#include <swgtk/LuaCloseGuard.hpp>
+
+extern "C" {
+#include <lua.h>
+}
+
+namespace {
+  constexpr auto guardKey = "swgtk.LuaProfiler";
+
+  // Lua hooks are plain functions, so the profiler that installed the hook is kept here.
+  swgtk::LuaProfiler* activeProfiler = nullptr;
+
+  [[nodiscard]] auto FrameLabel(const lua_Debug& debug) -> std::string {
+    if (std::string_view{debug.what} == "main") {
+      return std::format("main ({})", debug.short_src);
+    }
+
+    const auto* name = (debug.name != nullptr) ? debug.name : "?";
+
+    if (std::string_view{debug.what} == "C") {
+      return std::format("{} ([C])", name);
+    }
+
+    return std::format("{} ({}:{})", name, debug.short_src, debug.linedefined);
+  }
+} // namespace
+
+namespace swgtk {
+
+  void LuaProfiler::Start(lua_State* state, const int interval) {
+    Stop();
+
+    if (activeProfiler != nullptr) {
+      activeProfiler->Stop();
+    }
+
+    if (state == nullptr) {
+      return;
+    }
+
+    _state = state;
+    _lastSample = std::chrono::steady_clock::now();
+    activeProfiler = this;
+
+    lua_sethook(_state, &LuaProfiler::Hook, LUA_MASKCOUNT, std::max(interval, 1));
+    LuaCloseGuard::Install(_state, guardKey, [](void* owner) { static_cast<LuaProfiler*>(owner)->Release(); }, this);
+  }
+
+  void LuaProfiler::Stop() {
+    if (_state == nullptr) {
+      return;
+    }
+
+    lua_sethook(_state, nullptr, 0, 0);
+    LuaCloseGuard::Remove(_state, guardKey, this);
+    Release();
+  }
+
+  void LuaProfiler::Release() {
+    _state = nullptr;
+
+    if (activeProfiler == this) {
+      activeProfiler = nullptr;
+    }
+  }
+
+  void LuaProfiler::Reset() {
+    _nodes.assign(1uz, Node{});
+    _functions.clear();
+    _functionIDs.clear();
+    _samples = 0uz;
+  }
+
+  void LuaProfiler::Hook(lua_State* state, [[maybe_unused]] lua_Debug* debug) {
+    // Coroutines created while profiling keep the hook after Stop(), and may belong to another state than the
+    // one now profiled. Those take their hook off instead of sampling into whichever profiler is active.
+    if (activeProfiler == nullptr || !activeProfiler->IsProfiling(state)) {
+      lua_sethook(state, nullptr, 0, 0);
+      return;
+    }
+
+    activeProfiler->Sample(state);
+  }
+
+  auto LuaProfiler::IsProfiling(lua_State* state) const -> bool {
+    if (state == _state) {
+      return true;
+    }
+
+    lua_rawgeti(state, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+    const auto* main = lua_tothread(state, -1);
+    lua_pop(state, 1);
+
+    return main != nullptr && main == _state;
+  }
+
+  void LuaProfiler::Sample(lua_State* state) {
+    const auto now = std::chrono::steady_clock::now();
+    const auto gap = std::chrono::duration<double, std::milli>(now - _lastSample).count();
+    const auto milliseconds = std::min(gap, _maxSampleGap);
+
+    _lastSample = now;
+
+    _stack.clear();
+    lua_Debug debug{};
+
+    for (auto level = 0; lua_getstack(state, level, &debug) != 0; ++level) {
+      _stack.push_back(FunctionID(state, debug));
+    }
+
+    if (_stack.empty()) {
+      return;
+    }
+
+    ++_samples;
+    auto node = 0u;
+
+    for (auto frame = _stack.rbegin(); frame != _stack.rend(); ++frame) {
+      node = ChildNode(node, *frame);
+      _nodes[node].totalSamples += 1uz;
+      _nodes[node].totalMilliseconds += milliseconds;
+
+      if (auto& function = _functions[*frame]; function.lastSample != _samples) {
+        function.lastSample = _samples;
+        function.totalSamples += 1uz;
+        function.totalMilliseconds += milliseconds;
+      }
+    }
+
+    _nodes[node].selfSamples += 1uz;
+    _nodes[node].selfMilliseconds += milliseconds;
+
+    auto& running = _functions[_stack.front()];
+    running.selfSamples += 1uz;
+    running.selfMilliseconds += milliseconds;
+  }
+
+  auto LuaProfiler::FunctionID(lua_State* state, lua_Debug& debug) -> uint32_t {
+    // A Lua function is identified by where it's defined, which stays the same for every closure made from it
+    // and can't be taken over by another function once it's collected. C functions all share one source, so
+    // they go by name instead. Only new functions pay for building a label.
+    lua_getinfo(state, "Sn", &debug);
+
+    if (std::string_view{debug.what} == "C") {
+      _key = "[C] ";
+      _key += (debug.name != nullptr) ? debug.name : "?";
+    } else {
+      _key = debug.source;
+      _key += ':';
+      _key += std::to_string(debug.linedefined);
+    }
+
+    if (const auto found = _functionIDs.find(std::string_view{_key}); found != _functionIDs.end()) {
+      return found->second;
+    }
+
+    const auto id = static_cast<uint32_t>(_functions.size());
+    _functions.push_back(Function{.name = FrameLabel(debug)});
+    _functionIDs.emplace(_key, id);
+
+    return id;
+  }
+
+  auto LuaProfiler::ChildNode(const uint32_t parent, const uint32_t function) -> uint32_t {
+    for (auto child = _nodes[parent].firstChild; child != 0u; child = _nodes[child].nextSibling) {
+      if (_nodes[child].function == function) {
+        return child;
+      }
+    }
+
+    const auto child = static_cast<uint32_t>(_nodes.size());
+    _nodes.push_back(Node{.function = function, .parent = parent, .nextSibling = _nodes[parent].firstChild});
+    _nodes[parent].firstChild = child;
+
+    return child;
+  }
+
+  auto LuaProfiler::GetFunctionProfiles() const -> std::vector<LuaFunctionProfile> {
+    std::vector<LuaFunctionProfile> profiles;
+    profiles.reserve(_functions.size());
+
+    for (const auto& function: _functions) {
+      profiles.push_back(LuaFunctionProfile{
+          .name = function.name,
+          .selfSamples = function.selfSamples,
+          .totalSamples = function.totalSamples,
+          .selfMilliseconds = function.selfMilliseconds,
+          .totalMilliseconds = function.totalMilliseconds,
+      });
+    }
+
+    std::ranges::sort(profiles, [](const LuaFunctionProfile& a, const LuaFunctionProfile& b) {
+      return (a.selfMilliseconds != b.selfMilliseconds) ? a.selfMilliseconds > b.selfMilliseconds : a.selfSamples > b.selfSamples;
+    });
+
+    return profiles;
+  }
+
+  auto LuaProfiler::GetFoldedStacks(const bool useTime) const -> std::string {
+    constexpr auto microsecondsPerMillisecond = 1000.0;
+
+    std::string folded;
+    std::vector<uint32_t> path;
+
+    for (auto node = 1uz; node < _nodes.size(); ++node) {
+      const auto weight = useTime ? static_cast<size_t>(std::llround(_nodes[node].selfMilliseconds * microsecondsPerMillisecond))
+                                  : _nodes[node].selfSamples;
+
+      if (weight == 0uz) {
+        continue;
+      }
+
+      path.clear();
+
+      for (auto frame = static_cast<uint32_t>(node); frame != 0u; frame = _nodes[frame].parent) {
+        path.push_back(_nodes[frame].function);
+      }
+
+      for (auto frame = path.rbegin(); frame != path.rend(); ++frame) {
+        folded += _functions[*frame].name;
+        folded += (frame + 1 != path.rend()) ? ';' : ' ';
+      }
+
+      folded += std::format("{}\n", weight);
+    }
+
+    return folded;
+  }
+
+  auto LuaProfiler::WriteFoldedStacks(const std::filesystem::path& path, const bool useTime) const -> bool {
+    auto file = std::ofstream{path, std::ios::trunc};
+
+    if (!file) {
+      return false;
+    }
+
+    file << GetFoldedStacks(useTime);
+    return static_cast<bool>(file);
+  }
+
+} // namespace swgtk
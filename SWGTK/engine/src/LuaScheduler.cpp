@@ -0,0 +1,414 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/LuaScheduler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <swgtk/LuaCloseGuard.hpp>
+#include <swgtk/Utility.hpp>
+#include <utility>
+
+extern "C" {
+#include <lauxlib.h>
+#include <lua.h>
+}
+
+namespace {
+  using namespace swgtk;
+
+  constexpr auto guardKey = "swgtk.LuaScheduler";
+  constexpr auto boxKey = "swgtk.LuaScheduler.box";
+
+  // The first value every wait function yields, so a plain coroutine.yield(...) is never mistaken for a wait.
+  constexpr auto waitMarker = 0;
+
+  enum WaitCode : lua_Integer {
+    FramesCode = 1,
+    SecondsCode,
+    UntilCode,
+  };
+
+  /*
+    The task functions reach the scheduler through a userdata box rather than a raw pointer, so Detach()
+    can clear it and a script that kept a reference to swgtk.spawn gets an error instead of a dangling pointer.
+  */
+  auto Self(lua_State* state) -> LuaScheduler* {
+    auto* scheduler = *static_cast<LuaScheduler**>(lua_touserdata(state, lua_upvalueindex(1)));
+
+    if (scheduler == nullptr) {
+      luaL_error(state, "the task scheduler is no longer attached");
+    }
+
+    return scheduler;
+  }
+
+  auto YieldWait(lua_State* state, const WaitCode code) -> int {
+    // The argument (if any) is already at index 1. Put the marker and code in front of it.
+    lua_settop(state, 1);
+    lua_pushlightuserdata(state, const_cast<int*>(&waitMarker)); // NOLINT(*-const-cast)
+    lua_pushinteger(state, code);
+    lua_rotate(state, 1, 2);
+
+    return lua_yield(state, 3);
+  }
+
+  auto LuaSpawn(lua_State* state) -> int {
+    luaL_checktype(state, 1, LUA_TFUNCTION);
+
+    const auto id = Self(state)->SpawnFrom(state, lua_gettop(state) - 1);
+    lua_pushinteger(state, id);
+
+    return 1;
+  }
+
+  auto LuaCancel(lua_State* state) -> int {
+    const auto id = static_cast<LuaTaskID>(luaL_checkinteger(state, 1));
+    lua_pushboolean(state, static_cast<int>(Self(state)->Cancel(id)));
+
+    return 1;
+  }
+
+  auto LuaIsRunning(lua_State* state) -> int {
+    const auto id = static_cast<LuaTaskID>(luaL_checkinteger(state, 1));
+    lua_pushboolean(state, static_cast<int>(Self(state)->IsRunning(id)));
+
+    return 1;
+  }
+
+  auto LuaWaitFrames(lua_State* state) -> int {
+    const auto frames = luaL_optinteger(state, 1, 1);
+    lua_settop(state, 0);
+    lua_pushinteger(state, frames);
+
+    return YieldWait(state, FramesCode);
+  }
+
+  auto LuaWaitSeconds(lua_State* state) -> int {
+    luaL_checknumber(state, 1);
+    return YieldWait(state, SecondsCode);
+  }
+
+  auto LuaWaitUntil(lua_State* state) -> int {
+    luaL_checktype(state, 1, LUA_TFUNCTION);
+    return YieldWait(state, UntilCode);
+  }
+
+  auto LuaWaitBudget(lua_State* state) -> int {
+    if (!Self(state)->IsOverBudget()) {
+      return 0;
+    }
+
+    lua_settop(state, 0);
+    lua_pushinteger(state, 1);
+
+    return YieldWait(state, FramesCode);
+  }
+
+  struct TaskFunction {
+    const char* name;
+    lua_CFunction function;
+  };
+
+  constexpr auto taskFunctions = std::array{
+      TaskFunction{.name = "spawn", .function = &LuaSpawn},
+      TaskFunction{.name = "cancel", .function = &LuaCancel},
+      TaskFunction{.name = "is_running", .function = &LuaIsRunning},
+      TaskFunction{.name = "wait_frames", .function = &LuaWaitFrames},
+      TaskFunction{.name = "wait_seconds", .function = &LuaWaitSeconds},
+      TaskFunction{.name = "wait_until", .function = &LuaWaitUntil},
+      TaskFunction{.name = "wait_budget", .function = &LuaWaitBudget},
+  };
+} // namespace
+
+namespace swgtk {
+
+  void LuaScheduler::Attach(lua_State* state) {
+    Detach();
+
+    _state = state;
+    _stats = LuaSchedulerStats{};
+
+    if (_state == nullptr) {
+      return;
+    }
+
+    auto** box = static_cast<LuaScheduler**>(lua_newuserdatauv(_state, sizeof(LuaScheduler*), 0));
+    *box = this;
+
+    lua_pushvalue(_state, -1);
+    lua_setfield(_state, LUA_REGISTRYINDEX, boxKey);
+
+    if (lua_getglobal(_state, "swgtk") != LUA_TTABLE) {
+      lua_pop(_state, 1);
+      lua_newtable(_state);
+      lua_pushvalue(_state, -1);
+      lua_setglobal(_state, "swgtk");
+    }
+
+    for (const auto& [name, function]: taskFunctions) {
+      lua_pushvalue(_state, -2);
+      lua_pushcclosure(_state, function, 1);
+      lua_setfield(_state, -2, name);
+    }
+
+    lua_pop(_state, 2);
+
+    LuaCloseGuard::Install(_state, guardKey, [](void* owner) { static_cast<LuaScheduler*>(owner)->Release(); }, this);
+  }
+
+  void LuaScheduler::Detach() {
+    if (_state == nullptr) {
+      return;
+    }
+
+    for (auto& task: _tasks) {
+      task.finished = true;
+    }
+
+    RemoveFinished();
+
+    if (lua_getfield(_state, LUA_REGISTRYINDEX, boxKey) == LUA_TUSERDATA) {
+      *static_cast<LuaScheduler**>(lua_touserdata(_state, -1)) = nullptr;
+    }
+
+    lua_pop(_state, 1);
+    lua_pushnil(_state);
+    lua_setfield(_state, LUA_REGISTRYINDEX, boxKey);
+
+    LuaCloseGuard::Remove(_state, guardKey, this);
+    _state = nullptr;
+  }
+
+  void LuaScheduler::Release() {
+    // The state is being closed and takes every thread with it.
+    _tasks.clear();
+    _stats.running = 0uz;
+    _cursor = 0uz;
+    _state = nullptr;
+  }
+
+  auto LuaScheduler::SpawnFrom(lua_State* from, const int nargs) -> LuaTaskID {
+    if (_state == nullptr || from == nullptr) {
+      return nullLuaTask;
+    }
+
+    if (lua_type(from, -(nargs + 1)) != LUA_TFUNCTION) {
+      lua_pop(from, nargs + 1);
+      return nullLuaTask;
+    }
+
+    auto* thread = lua_newthread(from);
+    const auto threadRef = luaL_ref(from, LUA_REGISTRYINDEX);
+
+    lua_xmove(from, thread, nargs + 1);
+
+    _tasks.push_back(Task{
+        .thread = thread,
+        .threadRef = threadRef,
+        .startArgs = nargs,
+        .id = _nextID++,
+    });
+
+    ++_stats.running;
+    return _tasks.back().id;
+  }
+
+  auto LuaScheduler::Cancel(const LuaTaskID id) -> bool {
+    const auto task = std::ranges::find_if(_tasks, [id](const Task& t) { return t.id == id && !t.finished; });
+
+    if (task == _tasks.end()) {
+      return false;
+    }
+
+    task->finished = true;
+
+    // A task cancelled during Update() may be the one running, so cleanup waits until the update is over.
+    if (!_updating) {
+      RemoveFinished();
+    }
+
+    return true;
+  }
+
+  auto LuaScheduler::IsRunning(const LuaTaskID id) const -> bool {
+    return std::ranges::any_of(_tasks, [id](const Task& t) { return t.id == id && !t.finished; });
+  }
+
+  auto LuaScheduler::IsOverBudget() const -> bool {
+    return _updating && _updateTimer.GetElapsedMilliseconds() >= _budget;
+  }
+
+  void LuaScheduler::Update(const double deltaSeconds) {
+    // A task driving the frame loop itself, e.g. through EventsAndTimeStep(), would resume tasks that are already running.
+    if (_updating) {
+      DEBUG_PRINT("{}\n", "LuaScheduler::Update() called from inside a task, skipped.")
+      return;
+    }
+
+    _stats.lastMilliseconds = 0.0;
+    _stats.lastResumed = 0uz;
+    _stats.lastDeferred = 0uz;
+
+    if (_state == nullptr || _tasks.empty()) {
+      return;
+    }
+
+    _updateTimer.UpdateTime();
+    _updating = true;
+
+    for (auto& task: _tasks) {
+      if (task.wait == Wait::Frames) {
+        --task.frames;
+      } else if (task.wait == Wait::Seconds) {
+        task.seconds -= deltaSeconds;
+      }
+    }
+
+    // Tasks spawned while this loop runs are appended and get their first turn next frame.
+    const auto count = _tasks.size();
+    auto visited = 0uz;
+
+    // The first task always gets its turn, so a spent budget cannot starve every task forever.
+    for (; visited < count && (visited == 0uz || !IsOverBudget()); ++visited) {
+      const auto index = (_cursor + visited) % count;
+
+      if (!_tasks[index].finished && IsReady(_tasks[index])) {
+        Resume(index);
+      }
+    }
+
+    _stats.lastDeferred = count - visited;
+    _cursor = (_cursor + visited) % count;
+    _updating = false;
+
+    RemoveFinished();
+
+    if (_cursor >= _tasks.size()) {
+      _cursor = 0uz;
+    }
+
+    _stats.lastMilliseconds = _updateTimer.GetElapsedMilliseconds();
+  }
+
+  auto LuaScheduler::IsReady(Task& task) -> bool {
+    switch (task.wait) {
+      case Wait::None:
+        return true;
+      case Wait::Frames:
+        return task.frames <= 0;
+      case Wait::Seconds:
+        return task.seconds <= 0.0;
+      case Wait::Until:
+        break;
+    }
+
+    lua_rawgeti(_state, LUA_REGISTRYINDEX, task.predicateRef);
+
+    if (lua_pcall(_state, 0, 1, 0) != LUA_OK) {
+      DEBUG_PRINT("Lua task wait_until() failed: {}\n", lua_tostring(_state, -1))
+      lua_pop(_state, 1);
+
+      ++_stats.failed;
+      task.finished = true;
+      return false;
+    }
+
+    const auto ready = lua_toboolean(_state, -1) != 0;
+    lua_pop(_state, 1);
+
+    return ready;
+  }
+
+  void LuaScheduler::Resume(const size_t index) {
+    auto* thread = _tasks[index].thread;
+    const auto nargs = std::exchange(_tasks[index].startArgs, 0);
+    auto yielded = 0;
+
+    const auto status = lua_resume(thread, _state, nargs, &yielded);
+
+    // The task may have spawned others, so look it up again in case the vector moved.
+    auto& task = _tasks[index];
+    ++_stats.lastResumed;
+
+    if (status == LUA_YIELD) {
+      if (!task.finished) {
+        ReadWait(task, yielded);
+      }
+
+      lua_pop(thread, yielded);
+      return;
+    }
+
+    if (status != LUA_OK) {
+      DEBUG_PRINT("Lua task failed: {}\n", lua_tostring(thread, -1))
+      ++_stats.failed;
+    }
+
+    task.finished = true;
+  }
+
+  void LuaScheduler::ReadWait(Task& task, const int yielded) {
+    if (task.predicateRef != noRef) {
+      luaL_unref(_state, LUA_REGISTRYINDEX, task.predicateRef);
+      task.predicateRef = noRef;
+    }
+
+    // Anything that is not one of our waits, including a bare coroutine.yield(), waits for one frame.
+    task.wait = Wait::Frames;
+    task.frames = 1;
+
+    if (yielded < 2 || lua_touserdata(task.thread, -yielded) != &waitMarker) {
+      return;
+    }
+
+    const auto argIndex = -yielded + 2;
+
+    switch (lua_tointeger(task.thread, -yielded + 1)) {
+      case FramesCode:
+        task.frames = (yielded > 2) ? lua_tointeger(task.thread, argIndex) : 1;
+        break;
+      case SecondsCode:
+        task.wait = Wait::Seconds;
+        task.seconds = lua_tonumber(task.thread, argIndex);
+        break;
+      case UntilCode:
+        task.wait = Wait::Until;
+        lua_pushvalue(task.thread, argIndex);
+        task.predicateRef = luaL_ref(task.thread, LUA_REGISTRYINDEX);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void LuaScheduler::RemoveFinished() {
+    const auto removed = std::ranges::remove_if(_tasks, [this](Task& task) {
+      if (!task.finished) {
+        return false;
+      }
+
+      // Suspended or failed threads may still hold to-be-closed variables.
+      if (lua_status(task.thread) != LUA_OK) {
+        lua_closethread(task.thread, _state);
+      }
+
+      luaL_unref(_state, LUA_REGISTRYINDEX, task.predicateRef);
+      luaL_unref(_state, LUA_REGISTRYINDEX, task.threadRef);
+      return true;
+    });
+
+    _stats.running -= static_cast<size_t>(std::ranges::distance(removed));
+    _tasks.erase(removed.begin(), removed.end());
+  }
+
+} // namespace swgtk
@@ -0,0 +1,249 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/MemoryTracker.hpp>
+
+#include <SDL3/SDL_stdinc.h>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+  using namespace swgtk;
+
+  struct TagCounters {
+    std::atomic<size_t> frameAllocations{};
+    std::atomic<size_t> frameBytes{};
+    std::atomic<size_t> resident{};
+    std::atomic<size_t> peak{};
+
+    // Values latched by NewFrame().
+    std::atomic<size_t> lastFrameAllocations{};
+    std::atomic<size_t> lastFrameBytes{};
+  };
+
+  constexpr auto tagCount = std::to_underlying(MemoryTag::Count);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+  std::array<TagCounters, tagCount> counters{};
+
+  [[nodiscard]] auto CountersFor(const MemoryTag tag) -> TagCounters& { return counters.at(std::to_underlying(tag)); }
+
+  /*
+    SDL's free() and realloc() do not pass the block size, so the size of every block allocated through the tracker is
+    kept here. SDL may have allocated before the tracker was installed; those blocks are not in the table and are handed
+    back to the allocator they came from without being counted.
+  */
+  // NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+  SDL_malloc_func originalMalloc = nullptr;
+  SDL_calloc_func originalCalloc = nullptr;
+  SDL_realloc_func originalRealloc = nullptr;
+  SDL_free_func originalFree = nullptr;
+
+  std::mutex blocksMutex;
+  std::unordered_map<void*, size_t> blockSizes;
+  // NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+  auto TrackBlock(void* ptr, const size_t size) -> void* {
+    if (ptr == nullptr) {
+      return nullptr;
+    }
+
+    {
+      const std::scoped_lock lock{blocksMutex};
+      blockSizes.insert_or_assign(ptr, size);
+    }
+
+    MemoryTracker::RecordAllocation(MemoryTag::SDL, size);
+    return ptr;
+  }
+
+  auto SDLMalloc(const size_t size) -> void* { return TrackBlock(originalMalloc(size), size); }
+
+  auto SDLCalloc(const size_t count, const size_t size) -> void* { return TrackBlock(originalCalloc(count, size), count * size); }
+
+  auto SDLRealloc(void* ptr, const size_t size) -> void* {
+    if (ptr == nullptr) {
+      return SDLMalloc(size);
+    }
+
+    size_t oldSize = 0uz;
+    void* newPtr = nullptr;
+
+    {
+      // Held across the realloc so another thread can't be handed the old address before its entry is gone.
+      const std::scoped_lock lock{blocksMutex};
+
+      newPtr = originalRealloc(ptr, size);
+
+      if (newPtr == nullptr) {
+        return nullptr;
+      }
+
+      if (const auto it = blockSizes.find(ptr); it != blockSizes.end()) {
+        oldSize = it->second;
+        blockSizes.erase(it);
+      }
+
+      blockSizes.insert_or_assign(newPtr, size);
+    }
+
+    MemoryTracker::RecordFree(MemoryTag::SDL, oldSize);
+    MemoryTracker::RecordAllocation(MemoryTag::SDL, size);
+
+    return newPtr;
+  }
+
+  void SDLFree(void* ptr) {
+    if (ptr == nullptr) {
+      return;
+    }
+
+    size_t size = 0uz;
+
+    {
+      const std::scoped_lock lock{blocksMutex};
+
+      if (const auto it = blockSizes.find(ptr); it != blockSizes.end()) {
+        size = it->second;
+        blockSizes.erase(it);
+      }
+    }
+
+    MemoryTracker::RecordFree(MemoryTag::SDL, size);
+    originalFree(ptr);
+  }
+} // namespace
+
+namespace swgtk {
+
+  void MemoryTracker::RecordAllocation(const MemoryTag tag, const size_t bytes) {
+    auto& tagCounters = CountersFor(tag);
+
+    tagCounters.frameAllocations.fetch_add(1uz, std::memory_order_relaxed);
+    tagCounters.frameBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    const auto resident = tagCounters.resident.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    auto peak = tagCounters.peak.load(std::memory_order_relaxed);
+
+    while (resident > peak && !tagCounters.peak.compare_exchange_weak(peak, resident, std::memory_order_relaxed)) {
+    }
+  }
+
+  void MemoryTracker::RecordFree(const MemoryTag tag, const size_t bytes) {
+    auto& resident = CountersFor(tag).resident;
+    auto current = resident.load(std::memory_order_relaxed);
+
+    // Blocks allocated before the tracker was installed can be freed through it, so never wrap below zero.
+    while (!resident.compare_exchange_weak(current, (current > bytes) ? current - bytes : 0uz, std::memory_order_relaxed)) {
+    }
+  }
+
+  void MemoryTracker::NewFrame() {
+    for (auto& tagCounters: counters) {
+      tagCounters.lastFrameAllocations.store(tagCounters.frameAllocations.exchange(0uz, std::memory_order_relaxed), std::memory_order_relaxed);
+      tagCounters.lastFrameBytes.store(tagCounters.frameBytes.exchange(0uz, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+  }
+
+  auto MemoryTracker::GetFrameStats(const MemoryTag tag) -> MemoryStats {
+    const auto& tagCounters = CountersFor(tag);
+
+    return MemoryStats{
+        .allocations = tagCounters.lastFrameAllocations.load(std::memory_order_relaxed),
+        .bytesAllocated = tagCounters.lastFrameBytes.load(std::memory_order_relaxed),
+        .residentBytes = tagCounters.resident.load(std::memory_order_relaxed),
+        .peakResidentBytes = tagCounters.peak.load(std::memory_order_relaxed),
+    };
+  }
+
+  auto MemoryTracker::GetTotalFrameStats() -> MemoryStats {
+    MemoryStats total{};
+
+    for (auto tag = 0u; tag < tagCount; ++tag) {
+      const auto stats = GetFrameStats(MemoryTag{static_cast<uint8_t>(tag)});
+
+      total.allocations += stats.allocations;
+      total.bytesAllocated += stats.bytesAllocated;
+      total.residentBytes += stats.residentBytes;
+      total.peakResidentBytes += stats.peakResidentBytes;
+    }
+
+    return total;
+  }
+
+  auto MemoryTracker::InstallSDLAllocator() -> bool {
+    SDL_malloc_func currentMalloc = nullptr;
+    SDL_calloc_func currentCalloc = nullptr;
+    SDL_realloc_func currentRealloc = nullptr;
+    SDL_free_func currentFree = nullptr;
+
+    SDL_GetMemoryFunctions(&currentMalloc, &currentCalloc, &currentRealloc, &currentFree);
+
+    if (currentMalloc == &SDLMalloc) {
+      return true;
+    }
+
+    // Every block is still allocated by whatever SDL was using, so blocks from before this call can be freed either way.
+    originalMalloc = currentMalloc;
+    originalCalloc = currentCalloc;
+    originalRealloc = currentRealloc;
+    originalFree = currentFree;
+
+    return SDL_SetMemoryFunctions(SDLMalloc, SDLCalloc, SDLRealloc, SDLFree);
+  }
+
+  auto MemoryTracker::LuaAllocator([[maybe_unused]] void* userData, void* ptr, const size_t oldSize, const size_t newSize) -> void* {
+    // When ptr is null, oldSize encodes the type of object being created rather than a size.
+    const auto freedSize = (ptr != nullptr) ? oldSize : 0uz;
+
+    if (newSize == 0uz) {
+      std::free(ptr); // NOLINT(*-no-malloc, *-owning-memory)
+      RecordFree(MemoryTag::Lua, freedSize);
+      return nullptr;
+    }
+
+    auto* block = std::realloc(ptr, newSize); // NOLINT(*-no-malloc, *-owning-memory)
+
+    if (block != nullptr) {
+      RecordFree(MemoryTag::Lua, freedSize);
+      RecordAllocation(MemoryTag::Lua, newSize);
+    }
+
+    return block;
+  }
+
+  auto TrackedResource::do_allocate(const size_t bytes, const size_t alignment) -> void* {
+    auto* ptr = _upstream->allocate(bytes, alignment);
+    MemoryTracker::RecordAllocation(_tag, bytes);
+
+    return ptr;
+  }
+
+  void TrackedResource::do_deallocate(void* ptr, const size_t bytes, const size_t alignment) {
+    _upstream->deallocate(ptr, bytes, alignment);
+    MemoryTracker::RecordFree(_tag, bytes);
+  }
+
+  auto EngineMemoryResource() -> std::pmr::memory_resource* {
+#ifdef SWGTK_TRACK_MEMORY
+    static TrackedResource resource{MemoryTag::Engine};
+    return &resource;
+#else
+    return std::pmr::get_default_resource();
+#endif
+  }
+
+} // namespace swgtk
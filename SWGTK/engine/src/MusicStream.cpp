@@ -0,0 +1,392 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/MusicStream.hpp>
+#include <swgtk/Utility.hpp>
+
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_iostream.h>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+
+#ifdef SWGTK_BUILD_WITH_VORBIS
+#define STB_VORBIS_HEADER_ONLY
+#include <stb_vorbis.c>
+#endif
+
+namespace swgtk {
+
+  // Produces a track's samples in the track's own format. Used by one thread at a time.
+  class MusicDecoder {
+  public:
+    MusicDecoder() = default;
+    MusicDecoder(const MusicDecoder&) = delete;
+    MusicDecoder(MusicDecoder&&) = delete;
+    auto operator=(const MusicDecoder&) -> MusicDecoder& = delete;
+    auto operator=(MusicDecoder&&) -> MusicDecoder& = delete;
+    virtual ~MusicDecoder() = default;
+
+    [[nodiscard]] virtual auto GetSpec() const -> SDL_AudioSpec = 0;
+
+    // Decode as many whole frames as fit in out. Returns the bytes written, 0 at the end of the track.
+    virtual auto Decode(std::span<std::byte> out) -> size_t = 0;
+
+    virtual auto Rewind() -> bool = 0;
+  };
+
+} // namespace swgtk
+
+namespace {
+  using namespace swgtk;
+
+  using ChunkTag = std::array<char, 4>;
+
+  [[nodiscard]] constexpr auto TagName(const ChunkTag& tag) -> std::string_view { return std::string_view{tag.data(), tag.size()}; }
+
+  /*
+    Reads the samples of a RIFF .wave file straight from disk. SDL_LoadWAV() would load the whole file, so
+    the header is walked here instead, up to the start of the data chunk.
+  */
+  class WavDecoder final : public MusicDecoder {
+    static constexpr uint16_t formatPcm = 1u;
+    static constexpr uint16_t formatFloat = 3u;
+    static constexpr uint16_t formatExtensible = 0xFFFEu;
+    static constexpr uint32_t extensibleFormatSize = 40u;
+
+  public:
+    explicit WavDecoder(SDL_IOStream* stream) : _stream(stream) {}
+    WavDecoder(const WavDecoder&) = delete;
+    WavDecoder(WavDecoder&&) = delete;
+    auto operator=(const WavDecoder&) -> WavDecoder& = delete;
+    auto operator=(WavDecoder&&) -> WavDecoder& = delete;
+    ~WavDecoder() override { SDL_CloseIO(_stream); }
+
+    auto ReadHeader() -> bool {
+      ChunkTag riff{};
+      ChunkTag wave{};
+      Uint32 riffSize = 0u;
+
+      if (!ReadTag(riff) || !SDL_ReadU32LE(_stream, &riffSize) || !ReadTag(wave) || TagName(riff) != "RIFF" || TagName(wave) != "WAVE") {
+        return false;
+      }
+
+      auto haveFormat = false;
+
+      while (true) {
+        ChunkTag tag{};
+        Uint32 size = 0u;
+
+        if (!ReadTag(tag) || !SDL_ReadU32LE(_stream, &size)) {
+          return false;
+        }
+
+        // Chunks are padded to an even size.
+        const auto next = SDL_TellIO(_stream) + static_cast<Sint64>(size) + static_cast<Sint64>(size & 1u);
+
+        if (TagName(tag) == "fmt ") {
+          if (haveFormat = ReadFormat(size); !haveFormat) {
+            return false;
+          }
+        } else if (TagName(tag) == "data") {
+          _dataStart = SDL_TellIO(_stream);
+          _dataSize = size;
+          return haveFormat;
+        }
+
+        if (SDL_SeekIO(_stream, next, SDL_IO_SEEK_SET) < 0) {
+          return false;
+        }
+      }
+    }
+
+    [[nodiscard]] auto GetSpec() const -> SDL_AudioSpec override { return _spec; }
+
+    auto Decode(const std::span<std::byte> out) -> size_t override {
+      const auto wanted = std::min<uint64_t>(out.size() - (out.size() % _blockAlign), _dataSize - _consumed);
+      const auto read = SDL_ReadIO(_stream, out.data(), static_cast<size_t>(wanted));
+
+      // A short read, or data that stops part way through a frame, would leave the converter out of step with
+      // the channels. Only whole frames are returned, and a partial one is read again next time.
+      const auto whole = read - (read % _blockAlign);
+
+      if (whole < read && SDL_SeekIO(_stream, -static_cast<Sint64>(read - whole), SDL_IO_SEEK_CUR) < 0) {
+        return 0uz;
+      }
+
+      _consumed += whole;
+      return whole;
+    }
+
+    auto Rewind() -> bool override {
+      _consumed = 0u;
+      return SDL_SeekIO(_stream, _dataStart, SDL_IO_SEEK_SET) >= 0;
+    }
+
+  private:
+    auto ReadTag(ChunkTag& tag) -> bool { return SDL_ReadIO(_stream, tag.data(), tag.size()) == tag.size(); }
+
+    auto ReadFormat(const Uint32 size) -> bool {
+      Uint16 format = 0u;
+      Uint16 channels = 0u;
+      Uint32 rate = 0u;
+      Uint32 byteRate = 0u;
+      Uint16 bits = 0u;
+
+      if (!SDL_ReadU16LE(_stream, &format) || !SDL_ReadU16LE(_stream, &channels) || !SDL_ReadU32LE(_stream, &rate) ||
+          !SDL_ReadU32LE(_stream, &byteRate) || !SDL_ReadU16LE(_stream, &_blockAlign) || !SDL_ReadU16LE(_stream, &bits)) {
+        return false;
+      }
+
+      // Extensible files keep the real format in the first two bytes of a GUID after the extra fields.
+      if (format == formatExtensible && size >= extensibleFormatSize) {
+        Uint16 extraSize = 0u;
+        Uint16 validBits = 0u;
+        Uint32 channelMask = 0u;
+
+        if (!SDL_ReadU16LE(_stream, &extraSize) || !SDL_ReadU16LE(_stream, &validBits) || !SDL_ReadU32LE(_stream, &channelMask) ||
+            !SDL_ReadU16LE(_stream, &format)) {
+          return false;
+        }
+      }
+
+      _spec = SDL_AudioSpec{.format = SDL_AUDIO_UNKNOWN, .channels = static_cast<int>(channels), .freq = static_cast<int>(rate)};
+
+      if (format == formatPcm && bits == 8u) {
+        _spec.format = SDL_AUDIO_U8;
+      } else if (format == formatPcm && bits == 16u) {
+        _spec.format = SDL_AUDIO_S16LE;
+      } else if (format == formatPcm && bits == 32u) {
+        _spec.format = SDL_AUDIO_S32LE;
+      } else if (format == formatFloat && bits == 32u) {
+        _spec.format = SDL_AUDIO_F32LE;
+      } else {
+        DEBUG_PRINT2("Unsupported .wav sample format {} with {} bits.\n", format, bits)
+        return false;
+      }
+
+      return channels > 0u && rate > 0u && _blockAlign > 0u;
+    }
+
+    SDL_IOStream* _stream = nullptr;
+    SDL_AudioSpec _spec{};
+    Uint16 _blockAlign = 0u;
+    Sint64 _dataStart = 0;
+    uint64_t _dataSize = 0u;
+    uint64_t _consumed = 0u;
+  };
+
+#ifdef SWGTK_BUILD_WITH_VORBIS
+  // stb_vorbis reads the file a page at a time, so only the current page is in memory.
+  class VorbisDecoder final : public MusicDecoder {
+  public:
+    explicit VorbisDecoder(stb_vorbis* vorbis) : _vorbis(vorbis), _info(stb_vorbis_get_info(vorbis)) {}
+    VorbisDecoder(const VorbisDecoder&) = delete;
+    VorbisDecoder(VorbisDecoder&&) = delete;
+    auto operator=(const VorbisDecoder&) -> VorbisDecoder& = delete;
+    auto operator=(VorbisDecoder&&) -> VorbisDecoder& = delete;
+    ~VorbisDecoder() override { stb_vorbis_close(_vorbis); }
+
+    [[nodiscard]] auto GetSpec() const -> SDL_AudioSpec override {
+      return SDL_AudioSpec{.format = SDL_AUDIO_F32, .channels = _info.channels, .freq = static_cast<int>(_info.sample_rate)};
+    }
+
+    auto Decode(const std::span<std::byte> out) -> size_t override {
+      const auto channels = static_cast<size_t>(_info.channels);
+      const auto floats = (out.size() / sizeof(float)) - ((out.size() / sizeof(float)) % channels);
+
+      // The encoded buffer comes from operator new, so it is aligned for floats.
+      const auto frames = stb_vorbis_get_samples_float_interleaved(_vorbis, _info.channels, reinterpret_cast<float*>(out.data()), static_cast<int>(floats)); // NOLINT(*-reinterpret-cast)
+
+      return static_cast<size_t>(frames) * channels * sizeof(float);
+    }
+
+    auto Rewind() -> bool override { return stb_vorbis_seek_start(_vorbis) != 0; }
+
+  private:
+    stb_vorbis* _vorbis = nullptr;
+    stb_vorbis_info _info{};
+  };
+#endif
+
+  // Pick a decoder from the first bytes of the file rather than its extension.
+  [[nodiscard]] auto OpenDecoder(const std::filesystem::path& path) -> std::unique_ptr<MusicDecoder> {
+    const auto fileString = path.string();
+    SDL_IOStream* stream = SDL_IOFromFile(fileString.c_str(), "rb");
+
+    if (stream == nullptr) {
+      DEBUG_PRINT2("Error opening music file {}: {}\n", fileString, SDL_GetError())
+      return nullptr;
+    }
+
+    ChunkTag magic{};
+
+    if (SDL_ReadIO(stream, magic.data(), magic.size()) != magic.size() || SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET) < 0) {
+      DEBUG_PRINT2("Error reading music file {}: {}\n", fileString, SDL_GetError())
+      SDL_CloseIO(stream);
+      return nullptr;
+    }
+
+    if (TagName(magic) == "RIFF") {
+      if (auto wav = std::make_unique<WavDecoder>(stream); wav->ReadHeader()) {
+        return wav;
+      }
+
+      DEBUG_PRINT("Unsupported .wav file {}\n", fileString)
+      return nullptr;
+    }
+
+    SDL_CloseIO(stream);
+
+#ifdef SWGTK_BUILD_WITH_VORBIS
+    if (TagName(magic) == "OggS") {
+      auto error = 0;
+
+      if (stb_vorbis* vorbis = stb_vorbis_open_filename(fileString.c_str(), &error, nullptr); vorbis != nullptr) {
+        return std::make_unique<VorbisDecoder>(vorbis);
+      }
+
+      DEBUG_PRINT2("Error decoding {}: stb_vorbis error {}\n", fileString, error)
+      return nullptr;
+    }
+#endif
+
+    DEBUG_PRINT("Unsupported music file {}\n", fileString)
+    return nullptr;
+  }
+} // namespace
+
+namespace swgtk {
+
+  MusicStream::MusicStream(const int sampleRate, const std::chrono::milliseconds prefetch) :
+      _sampleRate(sampleRate),
+      // Wake often enough to top the buffer up several times before it could run dry.
+      _pollInterval(std::clamp(prefetch / 4, std::chrono::milliseconds{5}, std::chrono::milliseconds{50})),
+      _converted(musicChunkFrames * audioChannels),
+      _buffer(static_cast<size_t>(static_cast<int64_t>(sampleRate) * prefetch.count() / 1000) * audioChannels) {}
+
+  MusicStream::~MusicStream() { Close(); }
+
+  auto MusicStream::Open(const std::filesystem::path& path, const bool loop) -> bool {
+    Close();
+
+    if (_decoder = OpenDecoder(path); _decoder == nullptr) {
+      return false;
+    }
+
+    const auto spec = _decoder->GetSpec();
+    const SDL_AudioSpec mixSpec{.format = SDL_AUDIO_F32, .channels = static_cast<int>(audioChannels), .freq = _sampleRate};
+
+    if (_converter = SDL_CreateAudioStream(&spec, &mixSpec); _converter == nullptr) {
+      DEBUG_PRINT("Error creating music converter: {}\n", SDL_GetError())
+      _decoder.reset();
+      return false;
+    }
+
+    _encoded.resize(musicChunkFrames * static_cast<size_t>(SDL_AUDIO_FRAMESIZE(spec)));
+    _loop = loop;
+    _underruns.store(0u, std::memory_order_relaxed);
+
+    // Have the first chunk ready before a voice can ask for it, and leave the rest to the worker.
+    Fill(musicChunkFrames);
+
+    _worker = std::jthread{[this](const std::stop_token& stop) { Prefetch(stop); }};
+    return true;
+  }
+
+  void MusicStream::Close() {
+    if (_worker.joinable()) {
+      _worker.request_stop();
+      _worker.join();
+    }
+
+    if (_converter != nullptr) {
+      SDL_DestroyAudioStream(_converter);
+      _converter = nullptr;
+    }
+
+    _decoder.reset();
+    _buffer.Clear();
+    _ended.store(false, std::memory_order_relaxed);
+    _flushed = false;
+  }
+
+  auto MusicStream::Read(const std::span<float> out) -> size_t {
+    const auto count = _buffer.Read(out);
+
+    if (count < out.size() && !_ended.load(std::memory_order_acquire)) {
+      _underruns.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    return count;
+  }
+
+  void MusicStream::Fill(const size_t frames) {
+    const auto target = std::min(frames * audioChannels, _buffer.GetCapacity());
+    auto rewound = false;
+
+    while (!_ended.load(std::memory_order_relaxed) && _buffer.Size() < target) {
+      // Whole frames only, and no more than the ring has room for.
+      auto room = std::min(_buffer.GetFreeSpace(), _converted.size());
+      room -= room % audioChannels;
+
+      const auto bytes = SDL_GetAudioStreamData(_converter, _converted.data(), static_cast<int>(room * sizeof(float)));
+
+      if (bytes < 0) {
+        DEBUG_PRINT("Error converting music: {}\n", SDL_GetError())
+        _ended.store(true, std::memory_order_release);
+        break;
+      }
+
+      if (bytes > 0) {
+        _buffer.Write(std::span<const float>{_converted}.first(static_cast<size_t>(bytes) / sizeof(float)));
+        continue;
+      }
+
+      if (_flushed) {
+        _ended.store(true, std::memory_order_release);
+        break;
+      }
+
+      // The converter is empty, so feed it the next chunk.
+      if (const auto decoded = _decoder->Decode(_encoded); decoded > 0uz) {
+        if (!SDL_PutAudioStreamData(_converter, _encoded.data(), static_cast<int>(decoded))) {
+          DEBUG_PRINT("Error converting music: {}\n", SDL_GetError())
+          _ended.store(true, std::memory_order_release);
+          break;
+        }
+
+        rewound = false;
+      } else if (_loop && !rewound && _decoder->Rewind()) {
+        // Rewinding twice without decoding anything means the track is empty.
+        rewound = true;
+      } else {
+        SDL_FlushAudioStream(_converter);
+        _flushed = true;
+      }
+    }
+  }
+
+  void MusicStream::Prefetch(const std::stop_token& stop) {
+    std::unique_lock lock{_wakeMutex};
+
+    while (!stop.stop_requested() && !_ended.load(std::memory_order_relaxed)) {
+      Fill(GetCapacityFrames());
+
+      // The audio thread never signals the worker, since that could block it. The worker checks back a
+      // few times per buffer length instead, and only a stop request wakes it early.
+      _wake.wait_for(lock, stop, _pollInterval, [] { return false; });
+    }
+  }
+
+} // namespace swgtk
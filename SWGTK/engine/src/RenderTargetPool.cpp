@@ -0,0 +1,71 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/RenderTargetPool.hpp>
+
+#include <algorithm>
+
+namespace swgtk {
+
+  auto RenderTargetPool::Release(const Texture target) -> bool {
+    const auto entry = std::ranges::find_if(_entries, [&](const Entry& e) { return e.inUse && e.texture == target; });
+
+    if (entry == _entries.end()) {
+      return false;
+    }
+
+    entry->inUse = false;
+    --_stats.inUse;
+    return true;
+  }
+
+  void RenderTargetPool::EndFrame() {
+    ++_frame;
+
+    // Swap-and-pop, since the order of the entries doesn't matter.
+    for (auto i = 0uz; i < _entries.size();) {
+      auto& entry = _entries[i];
+      entry.inUse = false;
+
+      // A texture the registry already destroyed, e.g. by a script, just leaves the pool.
+      if (!entry.texture.IsValid() || _frame - entry.lastUsed > _idleFrames) {
+        entry.texture.Destroy();
+        entry = _entries.back();
+        _entries.pop_back();
+        ++_stats.released;
+        continue;
+      }
+
+      ++i;
+    }
+
+    _stats.inUse = 0uz;
+    _stats.pooled = _entries.size();
+  }
+
+  void RenderTargetPool::ResetStats() {
+    _stats.created = 0uz;
+    _stats.reused = 0uz;
+    _stats.released = 0uz;
+  }
+
+  void RenderTargetPool::Clear() {
+    for (const auto& entry: _entries) {
+      entry.texture.Destroy();
+    }
+
+    _entries.clear();
+    _stats.inUse = 0uz;
+    _stats.pooled = 0uz;
+  }
+
+} // namespace swgtk
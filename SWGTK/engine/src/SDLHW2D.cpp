@@ -18,14 +18,19 @@
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_surface.h>
 #include <SDL3/SDL_video.h>
+#include <array>
+#include <bit>
 #include <filesystem>
 #include <memory>
 #include <sol/optional_implementation.hpp>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
+#include <vector>
 #include "SDL3_image/SDL_image.h"
 #include "SDL3_ttf/SDL_ttf.h"
+#include "swgtk/Animation.hpp"
 #include "swgtk/RenderingDevice.hpp"
 
 namespace swgtk {
@@ -38,8 +43,30 @@ namespace swgtk {
     return false;
   }
 
+  auto SDLHW2D::PrepareHeadless(SDL_Surface* target) -> bool {
+    if (target == nullptr) {
+      return false;
+    }
+
+    _render = SDL_CreateSoftwareRenderer(target);
+
+    if (_render == nullptr) {
+      DEBUG_PRINT("Error creating software renderer: {}\n", SDL_GetError())
+    }
+
+    return IsDeviceInitialized();
+  }
+
   void SDLHW2D::DestroyDevice() {
+    _capture.Stop();
+
+    // SDL destroys a renderer's textures along with it, so release our handles to them first.
+    _targets.Clear();
+    _backBuffer = Texture{};
+    // The registry is shared with every other renderer, so only the textures made by this one go.
+    TextureRegistry().DestroyIf([this](SDL_Texture* texture) { return SDL_GetRendererFromTexture(texture) == _render; });
     SDL_DestroyRenderer(_render);
+    _render = nullptr;
   }
 
   void SDLHW2D::BufferClear(const SDL_FColor& color) {
@@ -52,7 +79,103 @@ namespace swgtk {
 
   void SDLHW2D::BufferPresent() {
     SDL_SetRenderTarget(_render, nullptr);
-    SDL_RenderPresent(_render);
+
+    if (!_dirtyRendering || _redrawn || _presentRequested) {
+      // The window's contents are undefined after a present, so the whole back buffer goes out each time.
+      if (_dirtyRendering) {
+        SDL_RenderTexture(_render, *_backBuffer, nullptr, nullptr);
+      }
+
+      // Read back before presenting, while the frame is still there to read.
+      if (_capture.IsFrameDue()) {
+        _capture.Submit(SDL_RenderReadPixels(_render, nullptr));
+      }
+
+      SDL_RenderPresent(_render);
+    } else if (_backBuffer.IsValid() && _capture.IsFrameDue()) {
+      // Nothing new to present, but a screenshot or recording still wants the frame, which the back buffer holds.
+      SDL_SetRenderTarget(_render, *_backBuffer);
+      _capture.Submit(SDL_RenderReadPixels(_render, nullptr));
+      SDL_SetRenderTarget(_render, nullptr);
+    }
+
+    _idle = _dirtyRendering && !_redrawn && !_presentRequested;
+    _redrawn = false;
+    _presentRequested = false;
+
+    // Transient targets were only lent out for the frame that just ended.
+    _targets.EndFrame();
+
+    // Nothing queued for this frame can reference a deferred texture anymore.
+    TextureRegistry().FlushDeferred();
+  }
+
+  void SDLHW2D::SetDirtyRendering(const bool enabled) {
+    _dirtyRendering = enabled;
+    _idle = false;
+
+    if (enabled) {
+      _dirty.AddAll();
+      return;
+    }
+
+    _backBuffer.Destroy();
+    _backBuffer = Texture{};
+    _dirty.Clear();
+  }
+
+  auto SDLHW2D::PrepareBackBuffer() -> bool {
+    int width{}, height{};
+    SDL_GetRenderOutputSize(_render, &width, &height);
+
+    if (_backBuffer.IsValid()) {
+      if (const auto [w, h] = _backBuffer.GetSize(); w == static_cast<float>(width) && h == static_cast<float>(height)) {
+        return true;
+      }
+
+      _backBuffer.Destroy();
+    }
+
+    _backBuffer = CreateRenderableTexture(width, height, SDL_PIXELFORMAT_RGBA32, SDL_BLENDMODE_NONE);
+    _dirty.AddAll();
+
+    return _backBuffer.IsValid();
+  }
+
+  auto SDLHW2D::BeginRedraw(const SDL_FColor& color) -> bool {
+    if (!_dirtyRendering) {
+      BufferClear(color);
+      _redrawRect = SDL_Rect{};
+      SDL_GetCurrentRenderOutputSize(_render, &_redrawRect.w, &_redrawRect.h);
+      return true;
+    }
+
+    if (!PrepareBackBuffer()) {
+      DEBUG_PRINT("Dirty rendering has no back buffer. - {}\n", SDL_GetError())
+      return false;
+    }
+
+    const auto [width, height] = _backBuffer.GetSize();
+    _redrawRect = _dirty.GetBounds(SDL_Rect{.x = 0, .y = 0, .w = static_cast<int>(width), .h = static_cast<int>(height)});
+    _dirty.Clear();
+
+    if (_redrawRect.w <= 0 || _redrawRect.h <= 0) {
+      return false;
+    }
+
+    SDL_SetRenderTarget(_render, *_backBuffer);
+    SDL_SetRenderClipRect(_render, &_redrawRect);
+
+    const auto previous = GetDrawColor();
+    const auto area = SDL_FRect{.x = static_cast<float>(_redrawRect.x), .y = static_cast<float>(_redrawRect.y),
+                                .w = static_cast<float>(_redrawRect.w), .h = static_cast<float>(_redrawRect.h)};
+
+    SetDrawColor(color);
+    SDL_RenderFillRect(_render, &area);
+    SetDrawColor(previous);
+
+    _redrawn = true;
+    return true;
   }
 
   auto SDLHW2D::LoadTextureImg(const std::filesystem::path& img, const SDL_BlendMode blendMode) const -> Texture {
@@ -85,6 +208,11 @@ namespace swgtk {
     return Texture{};
   }
 
+  auto SDLHW2D::AcquireTarget(const int width, const int height, const SDL_PixelFormat format, const SDL_BlendMode blendMode) -> Texture {
+    return _targets.Acquire(RenderTargetKey{.width = width, .height = height, .format = format, .blendMode = blendMode},
+                            [this](const RenderTargetKey& key) { return CreateRenderableTexture(key.width, key.height, key.format, key.blendMode); });
+  }
+
   auto SDLHW2D::CreateTextureFromSurface(const Surface& surface) const -> Texture {
     if (auto* texture = SDL_CreateTextureFromSurface(_render, *surface)) {
       return Texture{texture};
@@ -111,6 +239,200 @@ namespace swgtk {
     SDL_RenderTextureRotated(_render, *texture, source, destination, angle, cen, flip);
   }
 
+  void SDLHW2D::DrawGeometry(Texture texture, const VertexBuffer& buffer) const {
+    const auto vertices = buffer.Vertices();
+    const auto indices = buffer.Indices();
+
+    if (vertices.empty()) {
+      return;
+    }
+
+    SDL_RenderGeometry(_render, *texture, vertices.data(), static_cast<int>(std::ssize(vertices)),
+                       indices.empty() ? nullptr : indices.data(), static_cast<int>(std::ssize(indices)));
+  }
+
+  void SDLHW2D::DrawSpriteBatch(const SpriteBatch& batch) const {
+    DrawGeometry(batch.GetTexture(), batch.Buffer());
+  }
+
+  void SDLHW2D::DrawShapes(const ShapeBatch& shapes) const {
+    // Untextured geometry blends with the draw blend mode, which is usually none.
+    SDL_BlendMode previous{};
+    SDL_GetRenderDrawBlendMode(_render, &previous);
+    SDL_SetRenderDrawBlendMode(_render, SDL_BLENDMODE_BLEND);
+
+    DrawGeometry(Texture{}, shapes.Buffer());
+
+    SDL_SetRenderDrawBlendMode(_render, previous);
+  }
+
+  void SDLHW2D::DrawUI(const UIDrawData& data) const {
+    const auto batches = data.Batches();
+
+    if (batches.empty()) {
+      return;
+    }
+
+    const auto vertices = data.Vertices();
+    const auto indices = data.Indices();
+
+    SDL_Rect previousClip{};
+    const auto wasClipped = SDL_RenderClipEnabled(_render) && SDL_GetRenderClipRect(_render, &previousClip);
+
+    // Every batch indexes into the one vertex buffer, which SDL reads through the indices.
+    for (auto i = 0uz; i < batches.size(); ++i) {
+      const auto& batch = batches[i];
+
+      if (i == 0uz || !SDL_RectsEqual(&batch.clip, &batches[i - 1uz].clip)) {
+        SDL_SetRenderClipRect(_render, &batch.clip);
+      }
+
+      SDL_RenderGeometry(_render, *batch.texture, vertices.data(), static_cast<int>(std::ssize(vertices)),
+                         indices.data() + batch.firstIndex, static_cast<int>(batch.indexCount));
+    }
+
+    SDL_SetRenderClipRect(_render, wasClipped ? &previousClip : nullptr);
+  }
+
+  void SDLHW2D::DrawTileMap(TileMap& map, const SDL_FRect& view, const SDL_FPoint pos) {
+    const auto chunks = map.GetChunksInView(view);
+    const auto chunkWidth = static_cast<float>(map.GetChunkPixelWidth());
+    const auto chunkHeight = static_cast<float>(map.GetChunkPixelHeight());
+
+    // Where chunk (x, y) lands in the render output.
+    const auto chunkOrigin = [&](const int x, const int y) {
+      return SDL_FPoint{.x = pos.x - view.x + (static_cast<float>(x) * chunkWidth), .y = pos.y - view.y + (static_cast<float>(y) * chunkHeight)};
+    };
+
+    if (!map.IsCached()) {
+      _tileBatch.SetTexture(map.GetTileSet().texture);
+      _tileBatch.Clear();
+
+      for (auto y = chunks.y; y < chunks.y + chunks.h; ++y) {
+        for (auto x = chunks.x; x < chunks.x + chunks.w; ++x) {
+          map.AppendChunk(x, y, chunkOrigin(x, y), _tileBatch);
+        }
+      }
+
+      DrawSpriteBatch(_tileBatch);
+      return;
+    }
+
+    map.BeginDraw();
+
+    for (auto y = chunks.y; y < chunks.y + chunks.h; ++y) {
+      for (auto x = chunks.x; x < chunks.x + chunks.w; ++x) {
+        if (map.GetChunk(x, y).filled == 0uz || !RenderTileChunk(map, x, y)) {
+          continue;
+        }
+
+        const auto origin = chunkOrigin(x, y);
+        DrawTexture(map.GetChunk(x, y).texture, std::nullopt, SDL_FRect{.x = origin.x, .y = origin.y, .w = chunkWidth, .h = chunkHeight});
+      }
+    }
+
+    map.EvictChunks();
+  }
+
+  auto SDLHW2D::RenderTileChunk(TileMap& map, const int x, const int y) -> bool {
+    auto& chunk = map.GetChunk(x, y);
+
+    if (!chunk.texture.IsValid()) {
+      // The chunk's pixels are rendered with the tileset's blending over transparent black, which leaves
+      // them premultiplied.
+      chunk.texture = CreateRenderableTexture(map.GetChunkPixelWidth(), map.GetChunkPixelHeight(), SDL_PIXELFORMAT_RGBA32, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+
+      if (!chunk.texture.IsValid()) {
+        return false;
+      }
+
+      // Linear filtering would bleed the transparent edge of one chunk into the seam with the next.
+      chunk.texture.SetScaleMode(SDL_SCALEMODE_NEAREST);
+      chunk.renderedVersion = chunk.version - 1u;
+    }
+
+    map.MarkDrawn(x, y);
+
+    if (chunk.renderedVersion == chunk.version) {
+      return true;
+    }
+
+    _tileBatch.SetTexture(map.GetTileSet().texture);
+    _tileBatch.Clear();
+    map.AppendChunk(x, y, SDL_FPoint{}, _tileBatch);
+
+    auto* target = SDL_GetRenderTarget(_render);
+    const auto color = GetDrawColor();
+
+    if (!SetDrawTarget(chunk.texture)) {
+      DEBUG_PRINT("Failed to render tile chunk: {}\n", SDL_GetError())
+      return false;
+    }
+
+    SetDrawColor(SDL_FColor{});
+    SDL_RenderClear(_render);
+    DrawSpriteBatch(_tileBatch);
+
+    SDL_SetRenderTarget(_render, target);
+    SetDrawColor(color);
+
+    chunk.renderedVersion = chunk.version;
+    return true;
+  }
+
+  void SDLHW2D::DrawSdfText(SdfFont& font, const std::string_view text, const SDL_FPoint pos, const float size, const SDL_FColor& color) {
+    _textVertices.Clear();
+
+    if (auto* bucket = font.AppendQuads(text, pos, size, color, _textVertices); bucket != nullptr && UploadSdfBucket(*bucket)) {
+      DrawGeometry(bucket->texture, _textVertices);
+    }
+  }
+
+  void SDLHW2D::DrawTextLayout(const TextLayout& layout, const SDL_FPoint pos, const SDL_FColor& color) {
+    int height{};
+    SDL_GetCurrentRenderOutputSize(_render, nullptr, &height);
+
+    _textVertices.Clear();
+
+    if (auto* bucket = layout.AppendQuads(pos, color, _textVertices, -pos.y, static_cast<float>(height) - pos.y); bucket != nullptr && UploadSdfBucket(*bucket)) {
+      DrawGeometry(bucket->texture, _textVertices);
+    }
+  }
+
+  auto SDLHW2D::UploadSdfBucket(SdfBucket& bucket) const -> bool {
+    if (bucket.texture.IsValid() && bucket.uploadedVersion == bucket.version) {
+      return true;
+    }
+
+    const auto* coverage = *bucket.coverage;
+
+    if (coverage == nullptr) {
+      return false;
+    }
+
+    // Glyphs added to the atlas keep the size, so the texture can be rewritten in place.
+    if (const auto [width, height] = bucket.texture.IsValid() ? bucket.texture.GetSize() : std::make_pair(0.0f, 0.0f);
+        static_cast<int>(width) == coverage->w && static_cast<int>(height) == coverage->h) {
+      if (!SDL_UpdateTexture(*bucket.texture, nullptr, coverage->pixels, coverage->pitch)) {
+        DEBUG_PRINT("Failed to update SDF texture: {}\n", SDL_GetError())
+        return false;
+      }
+    } else {
+      bucket.texture.DestroyDeferred();
+      bucket.texture = CreateTextureFromSurface(bucket.coverage);
+
+      if (!bucket.texture.IsValid()) {
+        return false;
+      }
+
+      bucket.texture.SetBlendMode(SDL_BLENDMODE_BLEND);
+      bucket.texture.SetScaleMode(SDL_SCALEMODE_LINEAR);
+    }
+
+    bucket.uploadedVersion = bucket.version;
+    return true;
+  }
+
   void SDLHW2D::DrawPlainText(const std::string_view text, const SDL_FRect& pos, const SDL_Color& color) const {
 
     if (auto* ttf = TTF_RenderText_Solid(_currentFont, text.data(), text.size(), color); ttf != nullptr) {
@@ -197,10 +519,71 @@ namespace swgtk {
   }
 
 #ifdef SWGTK_BUILD_WITH_LUA
+  namespace {
+    /*
+      Copies a Lua array of numbers into out, each run of sizeof(T) / sizeof(float) numbers making one element, so
+      floats take one number and points an x, y pair. out is kept by the caller between calls, so filling a batch
+      from Lua does not allocate once it has grown to the working size. A table holding anything but numbers
+      reads as empty rather than having the entry turned into 0.
+    */
+    template<typename T>
+    auto ReadNumbers(const sol::table& values, std::vector<T>& out) -> std::span<const T> {
+      constexpr auto components = sizeof(T) / sizeof(float);
+
+      const auto count = values.size() / components;
+      out.resize(count);
+
+      for (auto i = 0uz; i < count; ++i) {
+        std::array<float, components> element{};
+
+        for (auto c = 0uz; c < components; ++c) {
+          const auto index = (i * components) + c + 1uz;
+          const auto value = values.raw_get<sol::optional<float>>(index);
+
+          if (!value) {
+            DEBUG_PRINT("Expected a number at index {} of the table.\n", index)
+            out.clear();
+            return {};
+          }
+
+          element[c] = *value;
+        }
+
+        out[i] = std::bit_cast<T>(element);
+      }
+
+      return out;
+    }
+
+    // The buffers ReadNumbers() fills, one set per Lua state.
+    struct LuaScratch {
+      std::vector<float> floats;
+      std::vector<SDL_FPoint> points;
+    };
+
+    // Binds a function that makes a texture so Lua owns the result, and the garbage collector destroys it.
+    template<typename Create>
+    struct OwnedByLua;
+
+    template<typename... Args>
+    struct OwnedByLua<Texture (SDLHW2D::*)(Args...) const> {
+      template<Texture (SDLHW2D::*Create)(Args...) const>
+      [[nodiscard]] static auto Bind() {
+        return [](const SDLHW2D& self, Args... args) { return UniqueTexture{(self.*Create)(std::forward<Args>(args)...)}; };
+      }
+    };
+
+    template<auto Create>
+    [[nodiscard]] auto LuaOwned() {
+      return OwnedByLua<decltype(Create)>::template Bind<Create>();
+    }
+  } // namespace
+
   void SDLHW2D::InitLua(sol::state* lua_) {
 
     auto& lua = *lua_;
     auto SWGTK = lua["swgtk"];
+    const auto scratch = std::make_shared<LuaScratch>();
 
     // NOLINTBEGIN(*-easily-swappable-parameters)
 
@@ -253,10 +636,33 @@ namespace swgtk {
                                       std::make_pair("XRGB32", SDL_PIXELFORMAT_XRGB32),
                                       std::make_pair("BGRX32", SDL_PIXELFORMAT_BGRX32),
                                       std::make_pair("XBGR32", SDL_PIXELFORMAT_XBGR32),
+                                      std::make_pair("RGBA8888", SDL_PIXELFORMAT_RGBA8888),
+                                      std::make_pair("ARGB8888", SDL_PIXELFORMAT_ARGB8888),
+                                      std::make_pair("XRGB8888", SDL_PIXELFORMAT_XRGB8888),
+                                      std::make_pair("RGB24", SDL_PIXELFORMAT_RGB24),
+                                      std::make_pair("RGB565", SDL_PIXELFORMAT_RGB565),
+                                      std::make_pair("INDEX8", SDL_PIXELFORMAT_INDEX8),
                                   });
     SWGTK["PixelFormat"] = lua["PixelFormat"];
 
-    SWGTK["Texture"] = lua.new_usertype<Texture>("Texture", sol::constructors<Texture(), Texture(SDL_Texture*), Texture(const Texture&)>());
+    lua.new_enum<CaptureFormat>("CaptureFormat",
+                                {
+                                    std::make_pair("Png", CaptureFormat::Png),
+                                    std::make_pair("Y4m", CaptureFormat::Y4m),
+                                });
+    SWGTK["CaptureFormat"] = lua["CaptureFormat"];
+
+    SWGTK["Texture"] = lua.new_usertype<Texture>("Texture", sol::factories([] { return Texture{}; }, [](const Texture& other) { return Texture{other}; },
+                                                                          [](SDL_Texture* texture) { return UniqueTexture{Texture{texture}}; }));
+
+    // Textures Lua made itself. They work anywhere a Texture does and are destroyed when collected.
+    SWGTK["UniqueTexture"] = lua.new_usertype<UniqueTexture>("UniqueTexture", sol::no_constructor, sol::base_classes, sol::bases<Texture>());
+
+    SWGTK["Texture"]["Destroy"] = &Texture::Destroy;
+
+    SWGTK["Texture"]["DestroyDeferred"] = &Texture::DestroyDeferred;
+
+    SWGTK["Texture"]["IsValid"] = &Texture::IsValid;
 
     SWGTK["Texture"]["SetBlendMode"] = &Texture::SetBlendMode;
 
@@ -274,6 +680,159 @@ namespace swgtk {
 
     SWGTK["Texture"]["GetSize"] = &Texture::GetSize;
 
+    SWGTK["VertexBuffer"] = lua.new_usertype<VertexBuffer>("VertexBuffer", sol::constructors<VertexBuffer()>());
+
+    SWGTK["VertexBuffer"]["Push"] = [](VertexBuffer& self, const float x, const float y, const float r, const float g, const float b, const float a,
+                                       const sol::optional<float> u, const sol::optional<float> v) {
+      self.Push(SDL_Vertex{
+          .position = SDL_FPoint{.x = x, .y = y},
+          .color = SDL_FColor{.r = r, .g = g, .b = b, .a = a},
+          .tex_coord = SDL_FPoint{.x = u.value_or(0.0f), .y = v.value_or(0.0f)}});
+    };
+
+    SWGTK["VertexBuffer"]["PushIndex"] = &VertexBuffer::PushIndex;
+
+    SWGTK["VertexBuffer"]["AddFlat"] = [scratch](VertexBuffer& self, const sol::table& values) { return self.AddFlat(ReadNumbers(values, scratch->floats)); };
+
+    SWGTK["VertexBuffer"]["Clear"] = &VertexBuffer::Clear;
+
+    SWGTK["VertexBuffer"]["Size"] = &VertexBuffer::Size;
+
+    SWGTK["SpriteBatch"] = lua.new_usertype<SpriteBatch>("SpriteBatch", sol::constructors<SpriteBatch(), SpriteBatch(Texture), SpriteBatch(Texture, size_t)>());
+
+    SWGTK["SpriteBatch"]["SetTexture"] = &SpriteBatch::SetTexture;
+
+    SWGTK["SpriteBatch"]["GetTexture"] = &SpriteBatch::GetTexture;
+
+    SWGTK["SpriteBatch"]["Reserve"] = &SpriteBatch::Reserve;
+
+    SWGTK["SpriteBatch"]["Clear"] = &SpriteBatch::Clear;
+
+    SWGTK["SpriteBatch"]["Size"] = &SpriteBatch::Size;
+
+    // Plain numbers instead of Rectf userdata keep the per-sprite binding cost to a single call with no conversions.
+    SWGTK["SpriteBatch"]["Add"] = [](SpriteBatch& self, const float sx, const float sy, const float sw, const float sh,
+                                     const float dx, const float dy, const float dw, const float dh) {
+      self.Add(SDL_FRect{.x = sx, .y = sy, .w = sw, .h = sh}, SDL_FRect{.x = dx, .y = dy, .w = dw, .h = dh});
+    };
+
+    SWGTK["SpriteBatch"]["AddRotated"] = [](SpriteBatch& self, const float sx, const float sy, const float sw, const float sh,
+                                            const float dx, const float dy, const float dw, const float dh, const double angle) {
+      self.Add(SDL_FRect{.x = sx, .y = sy, .w = sw, .h = sh}, SDL_FRect{.x = dx, .y = dy, .w = dw, .h = dh}, angle);
+    };
+
+    SWGTK["SpriteBatch"]["AddFlat"] = [scratch](SpriteBatch& self, const sol::table& values, const sol::optional<SDL_FColor>& color) {
+      return self.AddFlat(ReadNumbers(values, scratch->floats), color.value_or(whiteFColor));
+    };
+
+    SWGTK["ShapeBatch"] = lua.new_usertype<ShapeBatch>("ShapeBatch", sol::constructors<ShapeBatch()>());
+
+    SWGTK["ShapeBatch"]["AddLine"] = [](ShapeBatch& self, const float x1, const float y1, const float x2, const float y2,
+                                        const sol::optional<float> thickness, const sol::optional<SDL_FColor>& color) {
+      self.AddLine(SDL_FPoint{.x = x1, .y = y1}, SDL_FPoint{.x = x2, .y = y2}, thickness.value_or(1.0f), color.value_or(whiteFColor));
+    };
+
+    // Flat x1, y1, x2, y2, ... tables, so a script can submit its debug lines in one call.
+    SWGTK["ShapeBatch"]["AddLines"] = [scratch](ShapeBatch& self, const sol::table& points, const sol::optional<float> thickness,
+                                         const sol::optional<SDL_FColor>& color) {
+      return self.AddLines(ReadNumbers(points, scratch->points), thickness.value_or(1.0f), color.value_or(whiteFColor));
+    };
+
+    SWGTK["ShapeBatch"]["AddRect"] = [](ShapeBatch& self, const SDL_FRect& rect, const sol::optional<float> thickness, const sol::optional<SDL_FColor>& color) {
+      self.AddRect(rect, thickness.value_or(1.0f), color.value_or(whiteFColor));
+    };
+
+    SWGTK["ShapeBatch"]["AddFilledRect"] = [](ShapeBatch& self, const SDL_FRect& rect, const sol::optional<SDL_FColor>& color) {
+      self.AddFilledRect(rect, color.value_or(whiteFColor));
+    };
+
+    SWGTK["ShapeBatch"]["AddCircle"] = [](ShapeBatch& self, const float x, const float y, const float radius, const sol::optional<float> thickness,
+                                          const sol::optional<SDL_FColor>& color) {
+      self.AddCircle(SDL_FPoint{.x = x, .y = y}, radius, thickness.value_or(1.0f), color.value_or(whiteFColor));
+    };
+
+    SWGTK["ShapeBatch"]["AddFilledCircle"] = [](ShapeBatch& self, const float x, const float y, const float radius, const sol::optional<SDL_FColor>& color) {
+      self.AddFilledCircle(SDL_FPoint{.x = x, .y = y}, radius, color.value_or(whiteFColor));
+    };
+
+    SWGTK["ShapeBatch"]["AddPolygon"] = [scratch](ShapeBatch& self, const sol::table& points, const sol::optional<float> thickness,
+                                           const sol::optional<SDL_FColor>& color) {
+      return self.AddPolygon(ReadNumbers(points, scratch->points), thickness.value_or(1.0f), color.value_or(whiteFColor));
+    };
+
+    SWGTK["ShapeBatch"]["AddFilledPolygon"] = [scratch](ShapeBatch& self, const sol::table& points, const sol::optional<SDL_FColor>& color) {
+      return self.AddFilledPolygon(ReadNumbers(points, scratch->points), color.value_or(whiteFColor));
+    };
+
+    SWGTK["ShapeBatch"]["SetTolerance"] = &ShapeBatch::SetTolerance;
+
+    SWGTK["ShapeBatch"]["Clear"] = &ShapeBatch::Clear;
+
+    SWGTK["TileMap"] = lua.new_usertype<TileMap>(
+        "TileMap", sol::factories([](const int width, const int height, const Texture& tileset, const int tileWidth, const int tileHeight,
+                                     const int columns, const sol::optional<bool> cached) {
+          return std::make_shared<TileMap>(width, height, TileSet{.texture = tileset, .tileWidth = tileWidth, .tileHeight = tileHeight, .columns = columns},
+                                           cached.value_or(true));
+        }));
+
+    SWGTK["TileMap"]["Set"] = &TileMap::Set;
+
+    SWGTK["TileMap"]["Get"] = &TileMap::Get;
+
+    SWGTK["TileMap"]["Fill"] = [](TileMap& self, const int x, const int y, const int w, const int h, const TileID tile) {
+      self.Fill(SDL_Rect{.x = x, .y = y, .w = w, .h = h}, tile);
+    };
+
+    SWGTK["TileMap"]["GetWidth"] = &TileMap::GetWidth;
+
+    SWGTK["TileMap"]["GetHeight"] = &TileMap::GetHeight;
+
+    SWGTK["TileMap"]["SetChunkBudget"] = &TileMap::SetChunkBudget;
+
+    SWGTK["TileMap"]["Release"] = &TileMap::Release;
+
+    // Made as a shared_ptr, so Animators can keep hold of it.
+    SWGTK["SpriteSheet"] = lua.new_usertype<SpriteSheet>("SpriteSheet", sol::factories([] { return std::make_shared<SpriteSheet>(); }));
+
+    SWGTK["SpriteSheet"]["Load"] = [](SpriteSheet& self, const std::string& path) { return self.LoadJsonFile(path); };
+
+    SWGTK["SpriteSheet"]["FindClip"] = &SpriteSheet::FindClip;
+
+    SWGTK["SpriteSheet"]["SetTexture"] = &SpriteSheet::SetTexture;
+
+    SWGTK["SpriteSheet"]["GetTexture"] = &SpriteSheet::GetTexture;
+
+    SWGTK["SpriteSheet"]["GetImagePath"] = [](const SpriteSheet& self) { return self.GetImagePath().string(); };
+
+    // The deleter holds on to the sheet, so a script can't free the clips out from under its animators.
+    SWGTK["Animators"] = lua.new_usertype<Animators>(
+        "Animators", sol::factories([](const std::shared_ptr<SpriteSheet>& sheet) {
+          return std::shared_ptr<Animators>{new Animators{*sheet}, [sheet](const Animators* animators) { delete animators; }};
+        }));
+
+    SWGTK["Animators"]["Add"] = [](Animators& self, const ClipID clip, const float x, const float y, const float w, const float h,
+                                   const sol::optional<float> speed) {
+      return self.Add(clip, SDL_FRect{.x = x, .y = y, .w = w, .h = h}, speed.value_or(1.0f));
+    };
+
+    SWGTK["Animators"]["Remove"] = &Animators::Remove;
+
+    SWGTK["Animators"]["Play"] = &Animators::Play;
+
+    SWGTK["Animators"]["SetSpeed"] = &Animators::SetSpeed;
+
+    SWGTK["Animators"]["SetDest"] = [](Animators& self, const AnimatorID animator, const float x, const float y, const float w, const float h) {
+      return self.SetDest(animator, SDL_FRect{.x = x, .y = y, .w = w, .h = h});
+    };
+
+    SWGTK["Animators"]["IsFinished"] = &Animators::IsFinished;
+
+    SWGTK["Animators"]["Size"] = &Animators::Size;
+
+    SWGTK["Animators"]["Update"] = &Animators::Update;
+
+    SWGTK["Animators"]["AppendTo"] = [](const Animators& self, SpriteBatch& batch) { self.AppendTo(batch); };
+
     auto Simple2DRenderer_Type = lua.new_usertype<SDLHW2D>("RenderingContext", sol::no_constructor);
     SWGTK["Render"] = shared_from_this();
 
@@ -293,6 +852,20 @@ namespace swgtk {
 
     Simple2DRenderer_Type["SetDrawTarget"] = &SDLHW2D::SetDrawTarget;
 
+    Simple2DRenderer_Type["SetDirtyRendering"] = &SDLHW2D::SetDirtyRendering;
+
+    Simple2DRenderer_Type["IsDirtyRendering"] = &SDLHW2D::IsDirtyRendering;
+
+    Simple2DRenderer_Type["MarkDirty"] = [](const std::shared_ptr<SDLHW2D>& context, const int x, const int y, const int w, const int h) {
+      context->MarkDirty(SDL_Rect{.x = x, .y = y, .w = w, .h = h});
+    };
+
+    Simple2DRenderer_Type["MarkAllDirty"] = &SDLHW2D::MarkAllDirty;
+
+    Simple2DRenderer_Type["BeginRedraw"] = [](const std::shared_ptr<SDLHW2D>& context, const sol::optional<SDL_FColor>& color) {
+      return context->BeginRedraw(color.value_or(SDL_FColor{.r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f}));
+    };
+
     Simple2DRenderer_Type["DrawTexture"] = [](const std::shared_ptr<SDLHW2D>& context, const Texture& tex, const sol::optional<SDL_FRect>& src,
                                               const sol::optional<SDL_FRect>& dest) {
       context->DrawTexture(tex,
@@ -317,35 +890,71 @@ namespace swgtk {
 
     Simple2DRenderer_Type["GetVSync"] = &SDLHW2D::GetVSync;
 
-    Simple2DRenderer_Type["LoadTextureImg"] = &SDLHW2D::LoadTextureImg;
+    Simple2DRenderer_Type["LoadTextureImg"] = LuaOwned<&SDLHW2D::LoadTextureImg>();
 
-    Simple2DRenderer_Type["CreateRenderableTexture"] = &SDLHW2D::CreateRenderableTexture;
+    Simple2DRenderer_Type["CreateRenderableTexture"] = [](const std::shared_ptr<SDLHW2D>& context, const int width, const int height,
+                                                          const sol::optional<SDL_PixelFormat> format, const sol::optional<SDL_BlendMode> blendMode) {
+      return UniqueTexture{context->CreateRenderableTexture(width, height, format.value_or(SDL_PIXELFORMAT_RGBA32), blendMode.value_or(SDL_BLENDMODE_BLEND))};
+    };
+
+    Simple2DRenderer_Type["CreateTextureFromSurface"] = LuaOwned<&SDLHW2D::CreateTextureFromSurface>();
+
+    Simple2DRenderer_Type["AcquireTarget"] = [](const std::shared_ptr<SDLHW2D>& context, const int width, const int height,
+                                                const sol::optional<SDL_PixelFormat> format, const sol::optional<SDL_BlendMode> blendMode) {
+      return context->AcquireTarget(width, height, format.value_or(SDL_PIXELFORMAT_RGBA32), blendMode.value_or(SDL_BLENDMODE_BLEND));
+    };
+
+    Simple2DRenderer_Type["ReleaseTarget"] = &SDLHW2D::ReleaseTarget;
+
+    Simple2DRenderer_Type["GetTargetReuseRate"] = [](const std::shared_ptr<SDLHW2D>& context) { return context->GetTargetPool().GetStats().ReuseRate(); };
+
+    Simple2DRenderer_Type["Screenshot"] = [](const std::shared_ptr<SDLHW2D>& context, const std::string& path) { context->GetCapture().Screenshot(path); };
 
-    Simple2DRenderer_Type["CreateTextureFromSurface"] = &SDLHW2D::CreateTextureFromSurface;
+    Simple2DRenderer_Type["StartCapture"] = [](const std::shared_ptr<SDLHW2D>& context, const std::string& path, const CaptureFormat format,
+                                               const sol::optional<uint32_t> every) { return context->GetCapture().Start(path, format, every.value_or(1u)); };
+
+    Simple2DRenderer_Type["StopCapture"] = [](const std::shared_ptr<SDLHW2D>& context) { context->GetCapture().Stop(); };
+
+    Simple2DRenderer_Type["GetCaptureStats"] = [](const std::shared_ptr<SDLHW2D>& context) {
+      const auto stats = context->GetCapture().GetStats();
+      return std::make_tuple(stats.captured, stats.written, stats.dropped, stats.failed);
+    };
 
     Simple2DRenderer_Type["GetDrawColor"] = &SDLHW2D::GetDrawColor;
 
-    Simple2DRenderer_Type["DrawGeometry"] = &SDLHW2D::DrawGeometry;
+    Simple2DRenderer_Type["DrawGeometry"] = sol::overload(
+        [](const std::shared_ptr<SDLHW2D>& context, const Texture texture, const std::span<SDL_Vertex> vertices, const std::span<int> indices) {
+          context->DrawGeometry(texture, vertices, indices);
+        },
+        sol::resolve<void(Texture, const VertexBuffer&) const>(&SDLHW2D::DrawGeometry));
+
+    Simple2DRenderer_Type["DrawSpriteBatch"] = &SDLHW2D::DrawSpriteBatch;
+
+    Simple2DRenderer_Type["DrawShapes"] = &SDLHW2D::DrawShapes;
+
+    Simple2DRenderer_Type["DrawTileMap"] = [](const std::shared_ptr<SDLHW2D>& context, TileMap& map, const SDL_FRect& view, const sol::optional<SDL_FPoint>& pos) {
+      context->DrawTileMap(map, view, pos.value_or(SDL_FPoint{}));
+    };
 
     Simple2DRenderer_Type["DrawPlainText"] = &SDLHW2D::DrawPlainText;
 
     Simple2DRenderer_Type["DrawPlainWrapText"] = &SDLHW2D::DrawPlainWrapText;
 
-    Simple2DRenderer_Type["LoadPlainText"] = &SDLHW2D::LoadPlainText;
+    Simple2DRenderer_Type["LoadPlainText"] = LuaOwned<&SDLHW2D::LoadPlainText>();
 
-    Simple2DRenderer_Type["LoadBlendedText"] = &SDLHW2D::LoadBlendedText;
+    Simple2DRenderer_Type["LoadBlendedText"] = LuaOwned<&SDLHW2D::LoadBlendedText>();
 
-    Simple2DRenderer_Type["LoadShadedText"] = &SDLHW2D::LoadShadedText;
+    Simple2DRenderer_Type["LoadShadedText"] = LuaOwned<&SDLHW2D::LoadShadedText>();
 
-    Simple2DRenderer_Type["LoadLCDText"] = &SDLHW2D::LoadLCDText;
+    Simple2DRenderer_Type["LoadLCDText"] = LuaOwned<&SDLHW2D::LoadLCDText>();
 
-    Simple2DRenderer_Type["LoadPlainWrapText"] = &SDLHW2D::LoadPlainWrapText;
+    Simple2DRenderer_Type["LoadPlainWrapText"] = LuaOwned<&SDLHW2D::LoadPlainWrapText>();
 
-    Simple2DRenderer_Type["LoadBlendedWrapText"] = &SDLHW2D::LoadBlendedWrapText;
+    Simple2DRenderer_Type["LoadBlendedWrapText"] = LuaOwned<&SDLHW2D::LoadBlendedWrapText>();
 
-    Simple2DRenderer_Type["LoadShadedWrapText"] = &SDLHW2D::LoadShadedWrapText;
+    Simple2DRenderer_Type["LoadShadedWrapText"] = LuaOwned<&SDLHW2D::LoadShadedWrapText>();
 
-    Simple2DRenderer_Type["LoadLCDWrapText"] = &SDLHW2D::LoadLCDWrapText;
+    Simple2DRenderer_Type["LoadLCDWrapText"] = LuaOwned<&SDLHW2D::LoadLCDWrapText>();
   }
 
 #endif // SWGTK_BUILD_WITH_LUA
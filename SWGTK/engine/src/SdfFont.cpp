@@ -0,0 +1,403 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include "swgtk/SdfFont.hpp"
+
+#include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+#include <cmath>
+#include <swgtk/Utility.hpp>
+
+namespace {
+  using swgtk::PixelRGBA32;
+
+  constexpr auto glyphPadding = 2;
+  constexpr auto firstAtlasHeight = 128;
+  constexpr auto smallBucketLimit = 32.0f;
+  constexpr auto largeBucketStep = 4.0f;
+  constexpr auto maxBucketScale = 4.0f;
+  constexpr auto edgeValue = 127.5f;
+
+  // Calls fn for each codepoint of UTF-8 text.
+  void ForEachCodepoint(const std::string_view text, auto&& fn) {
+    const char* next = text.data();
+    auto left = text.size();
+
+    while (left > 0uz) {
+      fn(SDL_StepUTF8(&next, &left));
+    }
+  }
+
+  /*
+    Resample one glyph's field into coverage. Samples are clamped to the glyph's own texels so neighbours in the
+    atlas never bleed in, and written with max() because rounding can make neighbouring glyphs share a pixel.
+  */
+  void ResampleGlyph(const std::span<const uint8_t> field, const SDL_Rect& rect, const float scale, const swgtk::PixelView<PixelRGBA32>& out) {
+    const auto x0 = std::max(0, static_cast<int>(std::floor(static_cast<float>(rect.x) * scale)));
+    const auto y0 = std::max(0, static_cast<int>(std::floor(static_cast<float>(rect.y) * scale)));
+    const auto x1 = std::min(out.Width(), static_cast<int>(std::ceil(static_cast<float>(rect.x + rect.w) * scale)));
+    const auto y1 = std::min(out.Height(), static_cast<int>(std::ceil(static_cast<float>(rect.y + rect.h) * scale)));
+
+    const auto minX = static_cast<float>(rect.x);
+    const auto minY = static_cast<float>(rect.y);
+    const auto maxX = static_cast<float>(rect.x + rect.w - 1);
+    const auto maxY = static_cast<float>(rect.y + rect.h - 1);
+
+    // One texel of distance at the base size is scale pixels of distance in the bucket.
+    const auto toPixels = swgtk::sdfSpread / edgeValue * scale;
+
+    const auto texel = [&field](const int x, const int y) {
+      return static_cast<float>(field[(static_cast<size_t>(y) * static_cast<size_t>(swgtk::sdfAtlasWidth)) + static_cast<size_t>(x)]);
+    };
+
+    for (auto y = y0; y < y1; ++y) {
+      const auto fy = std::clamp(((static_cast<float>(y) + 0.5f) / scale) - 0.5f, minY, maxY);
+      const auto ty = static_cast<int>(fy);
+      const auto ty1 = std::min(ty + 1, rect.y + rect.h - 1);
+      const auto wy = fy - static_cast<float>(ty);
+
+      const auto row = out.Row(y);
+
+      for (auto x = x0; x < x1; ++x) {
+        const auto fx = std::clamp(((static_cast<float>(x) + 0.5f) / scale) - 0.5f, minX, maxX);
+        const auto tx = static_cast<int>(fx);
+        const auto tx1 = std::min(tx + 1, rect.x + rect.w - 1);
+        const auto wx = fx - static_cast<float>(tx);
+
+        const auto top = std::lerp(texel(tx, ty), texel(tx1, ty), wx);
+        const auto bottom = std::lerp(texel(tx, ty1), texel(tx1, ty1), wx);
+        const auto distance = (std::lerp(top, bottom, wy) - edgeValue) * toPixels;
+
+        const auto coverage = static_cast<uint8_t>(std::lround(std::clamp(0.5f + distance, 0.0f, 1.0f) * 255.0f));
+        auto& pixel = row[static_cast<size_t>(x)];
+
+        pixel = PixelRGBA32{.r = 255u, .g = 255u, .b = 255u, .a = std::max(pixel.a, coverage)};
+      }
+    }
+  }
+} // namespace
+
+namespace swgtk {
+
+  auto SdfFont::Load(TTF_Font* font, const float baseSize) -> bool {
+    Release();
+
+    if (font == nullptr || baseSize <= 0.0f) {
+      return false;
+    }
+
+    _font = TTF_CopyFont(font);
+
+    if (_font == nullptr || !TTF_SetFontSize(_font, baseSize) || !TTF_SetFontSDF(_font, true)) {
+      DEBUG_PRINT("Failed to prepare SDF font: {}\n", SDL_GetError())
+      Release();
+      return false;
+    }
+
+    _baseSize = baseSize;
+    _ascent = static_cast<float>(TTF_GetFontAscent(_font));
+    _lineSkip = static_cast<float>(TTF_GetFontLineSkip(_font));
+
+    _atlasHeight = firstAtlasHeight;
+    _distances.assign(static_cast<size_t>(sdfAtlasWidth) * static_cast<size_t>(_atlasHeight), 0u);
+    _shelf = SDL_Point{.x = glyphPadding, .y = glyphPadding};
+    _shelfHeight = 0;
+
+    return true;
+  }
+
+  void SdfFont::Release() {
+    EvictBuckets(0uz);
+
+    _glyphs.clear();
+    _order.clear();
+    _distances.clear();
+    _atlasHeight = 0;
+
+    if (_font != nullptr) {
+      TTF_CloseFont(_font);
+      _font = nullptr;
+    }
+  }
+
+  auto SdfFont::AddGlyphs(const std::string_view text) -> size_t {
+    const auto before = _glyphs.size();
+
+    ForEachCodepoint(text, [this](const uint32_t codepoint) { [[maybe_unused]] const auto* glyph = GetGlyph(codepoint); });
+
+    return _glyphs.size() - before;
+  }
+
+  auto SdfFont::GetGlyph(const uint32_t codepoint) -> const SdfGlyph* {
+    if (const auto found = _glyphs.find(codepoint); found != _glyphs.end()) {
+      return &found->second;
+    }
+
+    return (_font != nullptr) ? Rasterize(codepoint) : nullptr;
+  }
+
+  auto SdfFont::Rasterize(const uint32_t codepoint) -> const SdfGlyph* {
+    int minX{}, maxX{}, minY{}, maxY{}, advance{};
+
+    if (!TTF_FontHasGlyph(_font, codepoint) || !TTF_GetGlyphMetrics(_font, codepoint, &minX, &maxX, &minY, &maxY, &advance)) {
+      return nullptr;
+    }
+
+    auto glyph = SdfGlyph{.advance = static_cast<float>(advance)};
+
+    TTF_ImageType imageType{};
+    SDL_Surface* image = TTF_GetGlyphImage(_font, codepoint, &imageType);
+    SDL_Surface* rgba = (image != nullptr && image->w > 0 && image->h > 0) ? SDL_ConvertSurface(image, SDL_PIXELFORMAT_RGBA32) : nullptr;
+
+    // Nothing at a sane base size comes close, but a glyph wider than the atlas can't be packed.
+    if (rgba != nullptr && rgba->w + (glyphPadding * 2) <= sdfAtlasWidth && SDL_LockSurface(rgba)) {
+      const auto width = static_cast<size_t>(rgba->w);
+      const auto* pixels = static_cast<const uint8_t*>(rgba->pixels);
+      std::vector<uint8_t> field(width * static_cast<size_t>(rgba->h));
+
+      for (auto y = 0uz; y < static_cast<size_t>(rgba->h); ++y) {
+        const auto* source = pixels + (y * static_cast<size_t>(rgba->pitch)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        for (auto x = 0uz; x < width; ++x) {
+          field[(y * width) + x] = source[(x * 4uz) + 3uz]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+      }
+
+      SDL_UnlockSurface(rgba);
+
+      // Whitespace can come back as a field with nothing inside it. Keep the advance and skip the texels.
+      if (std::ranges::any_of(field, [](const uint8_t value) { return static_cast<float>(value) > edgeValue; })) {
+        // The field is the outline's box grown by the spread on every side, so center that box in it.
+        const auto padX = static_cast<float>(rgba->w - (maxX - minX)) / 2.0f;
+        const auto padY = static_cast<float>(rgba->h - (maxY - minY)) / 2.0f;
+
+        glyph.offsetX = static_cast<float>(minX) - padX;
+        glyph.offsetY = _ascent - (static_cast<float>(maxY) + padY);
+
+        const auto position = Pack(rgba->w, rgba->h);
+        glyph.atlas = SDL_Rect{.x = position.x, .y = position.y, .w = rgba->w, .h = rgba->h};
+
+        for (auto y = 0uz; y < static_cast<size_t>(rgba->h); ++y) {
+          const auto row = std::span{field}.subspan(y * width, width);
+          std::ranges::copy(row, _distances.begin() + static_cast<ptrdiff_t>(((static_cast<size_t>(position.y) + y) * static_cast<size_t>(sdfAtlasWidth)) + static_cast<size_t>(position.x)));
+        }
+      }
+    }
+
+    SDL_DestroySurface(rgba);
+    SDL_DestroySurface(image);
+
+    const auto* added = &_glyphs.emplace(codepoint, glyph).first->second;
+    _order.push_back(added);
+
+    return added;
+  }
+
+  auto SdfFont::Pack(const int width, const int height) -> SDL_Point {
+    if (_shelf.x + width + glyphPadding > sdfAtlasWidth) {
+      _shelf = SDL_Point{.x = glyphPadding, .y = _shelf.y + _shelfHeight + glyphPadding};
+      _shelfHeight = 0;
+    }
+
+    // Rows are appended at the bottom, so the glyphs already packed stay where they are.
+    while (_shelf.y + height + glyphPadding > _atlasHeight) {
+      _atlasHeight *= 2;
+      _distances.resize(static_cast<size_t>(sdfAtlasWidth) * static_cast<size_t>(_atlasHeight), 0u);
+    }
+
+    const auto position = _shelf;
+
+    _shelf.x += width + glyphPadding;
+    _shelfHeight = std::max(_shelfHeight, height);
+
+    return position;
+  }
+
+  auto SdfFont::BucketSize(const float size) const -> float {
+    const auto rounded = (size < smallBucketLimit) ? std::round(size) : std::round(size / largeBucketStep) * largeBucketStep;
+    return std::clamp(rounded, 1.0f, _baseSize * maxBucketScale);
+  }
+
+  auto SdfFont::GetBucket(const float size) -> SdfBucket* {
+    if (_font == nullptr || size <= 0.0f) {
+      return nullptr;
+    }
+
+    const auto bucketSize = BucketSize(size);
+    auto found = std::ranges::find(_buckets, bucketSize, &SdfBucket::size);
+
+    if (found != _buckets.end()) {
+      _buckets.splice(_buckets.begin(), _buckets, found);
+    } else {
+      EvictBuckets(_bucketLimit - 1uz);
+
+      auto& added = _buckets.emplace_front();
+      added.size = bucketSize;
+      added.scale = bucketSize / _baseSize;
+    }
+
+    auto& bucket = _buckets.front();
+    Refresh(bucket);
+
+    return &bucket;
+  }
+
+  void SdfFont::Refresh(SdfBucket& bucket) const {
+    const auto width = static_cast<int>(std::ceil(static_cast<float>(sdfAtlasWidth) * bucket.scale));
+    const auto height = static_cast<int>(std::ceil(static_cast<float>(_atlasHeight) * bucket.scale));
+
+    // A taller atlas needs a taller bucket; start it again from the first glyph.
+    if (!bucket.coverage.IsValid() || (*bucket.coverage)->h != height) {
+      bucket.coverage.Destroy();
+      bucket.coverage = Surface{width, height, SDL_PIXELFORMAT_RGBA32};
+      bucket.coverage.Lock().View<PixelRGBA32>().Fill(PixelRGBA32{.r = 255u, .g = 255u, .b = 255u, .a = 0u});
+      bucket.glyphs = 0uz;
+      ++bucket.version;
+    }
+
+    if (bucket.glyphs == _order.size()) {
+      return;
+    }
+
+    auto lock = bucket.coverage.Lock();
+    const auto view = lock.View<PixelRGBA32>();
+
+    for (const auto* glyph: std::span{_order}.subspan(bucket.glyphs)) {
+      if (glyph->atlas.w > 0) {
+        ResampleGlyph(_distances, glyph->atlas, bucket.scale, view);
+      }
+    }
+
+    bucket.glyphs = _order.size();
+    ++bucket.version;
+  }
+
+  auto SdfFont::AppendQuads(const std::string_view text, const SDL_FPoint pos, const float size, const SDL_FColor color, VertexBuffer& out) -> SdfBucket* {
+    if (_font == nullptr || size <= 0.0f) {
+      return nullptr;
+    }
+
+    // Every glyph has to be in the atlas before the bucket is brought up to date.
+    AddGlyphs(text);
+    auto* bucket = GetBucket(size);
+
+    if (*bucket->coverage == nullptr) {
+      return nullptr;
+    }
+
+    const auto scale = size / _baseSize;
+    auto pen = pos;
+    auto previous = 0u;
+
+    ForEachCodepoint(text, [&](const uint32_t codepoint) {
+      if (codepoint == '\n') {
+        pen = SDL_FPoint{.x = pos.x, .y = pen.y + (_lineSkip * scale)};
+        previous = 0u;
+        return;
+      }
+
+      const auto found = _glyphs.find(codepoint);
+
+      if (found == _glyphs.end()) {
+        return;
+      }
+
+      if (previous != 0u) {
+        pen.x += GetKerning(previous, codepoint) * scale;
+      }
+
+      previous = codepoint;
+
+      AppendGlyph(found->second, pen, size, color, *bucket, out);
+      pen.x += found->second.advance * scale;
+    });
+
+    return bucket;
+  }
+
+  void SdfFont::AppendGlyph(const SdfGlyph& glyph, const SDL_FPoint pen, const float size, const SDL_FColor color, const SdfBucket& bucket, VertexBuffer& out) const {
+    const auto* coverage = *bucket.coverage;
+
+    if (glyph.atlas.w <= 0 || coverage == nullptr) {
+      return;
+    }
+
+    const auto scale = size / _baseSize;
+    const auto left = pen.x + (glyph.offsetX * scale);
+    const auto top = pen.y + (glyph.offsetY * scale);
+    const auto right = left + (static_cast<float>(glyph.atlas.w) * scale);
+    const auto bottom = top + (static_cast<float>(glyph.atlas.h) * scale);
+
+    const auto texWidth = static_cast<float>(coverage->w);
+    const auto texHeight = static_cast<float>(coverage->h);
+
+    const auto u0 = static_cast<float>(glyph.atlas.x) * bucket.scale / texWidth;
+    const auto v0 = static_cast<float>(glyph.atlas.y) * bucket.scale / texHeight;
+    const auto u1 = static_cast<float>(glyph.atlas.x + glyph.atlas.w) * bucket.scale / texWidth;
+    const auto v1 = static_cast<float>(glyph.atlas.y + glyph.atlas.h) * bucket.scale / texHeight;
+
+    const auto base = static_cast<int>(out.Size());
+
+    out.Push(SDL_Vertex{.position = SDL_FPoint{.x = left, .y = top}, .color = color, .tex_coord = SDL_FPoint{.x = u0, .y = v0}});
+    out.Push(SDL_Vertex{.position = SDL_FPoint{.x = right, .y = top}, .color = color, .tex_coord = SDL_FPoint{.x = u1, .y = v0}});
+    out.Push(SDL_Vertex{.position = SDL_FPoint{.x = right, .y = bottom}, .color = color, .tex_coord = SDL_FPoint{.x = u1, .y = v1}});
+    out.Push(SDL_Vertex{.position = SDL_FPoint{.x = left, .y = bottom}, .color = color, .tex_coord = SDL_FPoint{.x = u0, .y = v1}});
+
+    for (const auto offset: {0, 1, 2, 2, 3, 0}) {
+      out.PushIndex(base + offset);
+    }
+  }
+
+  auto SdfFont::GetKerning(const uint32_t previous, const uint32_t codepoint) const -> float {
+    int kerning{};
+    return (_font != nullptr && TTF_GetGlyphKerning(_font, previous, codepoint, &kerning)) ? static_cast<float>(kerning) : 0.0f;
+  }
+
+  auto SdfFont::MeasureText(const std::string_view text, const float size) -> SDL_FPoint {
+    if (_font == nullptr || text.empty()) {
+      return SDL_FPoint{};
+    }
+
+    const auto scale = size / _baseSize;
+    auto width = 0.0f;
+    auto line = 0.0f;
+    auto lines = 1;
+
+    ForEachCodepoint(text, [&](const uint32_t codepoint) {
+      if (codepoint == '\n') {
+        width = std::max(width, line);
+        line = 0.0f;
+        ++lines;
+      } else if (const auto* glyph = GetGlyph(codepoint); glyph != nullptr) {
+        line += glyph->advance * scale;
+      }
+    });
+
+    return SDL_FPoint{.x = std::max(width, line), .y = static_cast<float>(lines) * _lineSkip * scale};
+  }
+
+  void SdfFont::SetBucketLimit(const size_t limit) {
+    _bucketLimit = std::max(limit, 1uz);
+    EvictBuckets(_bucketLimit);
+  }
+
+  void SdfFont::EvictBuckets(const size_t limit) {
+    while (_buckets.size() > limit) {
+      const auto& oldest = _buckets.back();
+
+      oldest.coverage.Destroy();
+      oldest.texture.DestroyDeferred();
+      _buckets.pop_back();
+    }
+  }
+
+} // namespace swgtk
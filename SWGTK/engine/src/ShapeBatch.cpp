@@ -0,0 +1,277 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/ShapeBatch.hpp>
+#include <swgtk/Utility.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+  // How far past the half thickness a sharp polygon corner may reach before its miter is cut short.
+  constexpr auto miterLimit = 4.0f;
+  constexpr auto minTolerance = 0.01f;
+
+  [[nodiscard]] auto Vertex(const float x, const float y, const SDL_FColor& color) -> SDL_Vertex {
+    return SDL_Vertex{.position = SDL_FPoint{.x = x, .y = y}, .color = color, .tex_coord = SDL_FPoint{}};
+  }
+
+  [[nodiscard]] auto Normalized(const float x, const float y) -> SDL_FPoint {
+    const auto length = std::sqrt((x * x) + (y * y));
+
+    if (length <= 0.0f) {
+      return SDL_FPoint{};
+    }
+
+    return SDL_FPoint{.x = x / length, .y = y / length};
+  }
+} // namespace
+
+namespace swgtk {
+
+  void ShapeBatch::AddLine(const SDL_FPoint from, const SDL_FPoint to, const float thickness, const SDL_FColor& color) {
+    const auto dx = to.x - from.x;
+    const auto dy = to.y - from.y;
+    const auto length = std::sqrt((dx * dx) + (dy * dy));
+
+    if (length <= 0.0f || thickness <= 0.0f) {
+      return;
+    }
+
+    // Half the thickness along the line's normal.
+    const auto scale = thickness * 0.5f / length;
+    const auto nx = -dy * scale;
+    const auto ny = dx * scale;
+    const auto base = static_cast<int>(_buffer.Size());
+
+    _buffer.Push(Vertex(from.x + nx, from.y + ny, color));
+    _buffer.Push(Vertex(to.x + nx, to.y + ny, color));
+    _buffer.Push(Vertex(to.x - nx, to.y - ny, color));
+    _buffer.Push(Vertex(from.x - nx, from.y - ny, color));
+
+    for (const auto offset: {0, 1, 2, 2, 3, 0}) {
+      _buffer.PushIndex(base + offset);
+    }
+  }
+
+  auto ShapeBatch::AddLines(const std::span<const SDL_FPoint> points, const float thickness, const SDL_FColor& color) -> size_t {
+    const auto count = points.size() / 2uz;
+
+    for (auto i = 0uz; i < count; ++i) {
+      AddLine(points[i * 2uz], points[(i * 2uz) + 1uz], thickness, color);
+    }
+
+    return count;
+  }
+
+  void ShapeBatch::AddFilledRect(const SDL_FRect& rect, const SDL_FColor& color) {
+    if (rect.w <= 0.0f || rect.h <= 0.0f) {
+      return;
+    }
+
+    const auto base = static_cast<int>(_buffer.Size());
+
+    _buffer.Push(Vertex(rect.x, rect.y, color));
+    _buffer.Push(Vertex(rect.x + rect.w, rect.y, color));
+    _buffer.Push(Vertex(rect.x + rect.w, rect.y + rect.h, color));
+    _buffer.Push(Vertex(rect.x, rect.y + rect.h, color));
+
+    for (const auto offset: {0, 1, 2, 2, 3, 0}) {
+      _buffer.PushIndex(base + offset);
+    }
+  }
+
+  void ShapeBatch::AddRect(const SDL_FRect& rect, const float thickness, const SDL_FColor& color) {
+    if (rect.w <= 0.0f || rect.h <= 0.0f || thickness <= 0.0f) {
+      return;
+    }
+
+    // An outline that meets itself in the middle is the whole rect.
+    if (thickness * 2.0f >= std::min(rect.w, rect.h)) {
+      AddFilledRect(rect, color);
+      return;
+    }
+
+    const auto base = static_cast<int>(_buffer.Size());
+    const auto right = rect.x + rect.w;
+    const auto bottom = rect.y + rect.h;
+
+    _buffer.Push(Vertex(rect.x, rect.y, color));
+    _buffer.Push(Vertex(rect.x + thickness, rect.y + thickness, color));
+    _buffer.Push(Vertex(right, rect.y, color));
+    _buffer.Push(Vertex(right - thickness, rect.y + thickness, color));
+    _buffer.Push(Vertex(right, bottom, color));
+    _buffer.Push(Vertex(right - thickness, bottom - thickness, color));
+    _buffer.Push(Vertex(rect.x, bottom, color));
+    _buffer.Push(Vertex(rect.x + thickness, bottom - thickness, color));
+
+    PushRingIndices(base, 4);
+  }
+
+  void ShapeBatch::AddFilledCircle(const SDL_FPoint center, const float radius, const SDL_FColor& color) {
+    if (radius <= 0.0f) {
+      return;
+    }
+
+    const auto segments = CircleSegments(radius, _tolerance);
+    const auto step = (2.0f * std::numbers::pi_v<float>) / static_cast<float>(segments);
+    const auto cosStep = std::cos(step);
+    const auto sinStep = std::sin(step);
+    const auto base = static_cast<int>(_buffer.Size());
+
+    _buffer.Push(Vertex(center.x, center.y, color));
+
+    // Rotating one offset round the circle saves a cos() and sin() per vertex.
+    auto x = radius;
+    auto y = 0.0f;
+
+    for (auto i = 0; i < segments; ++i) {
+      _buffer.Push(Vertex(center.x + x, center.y + y, color));
+
+      const auto nextX = (x * cosStep) - (y * sinStep);
+      y = (x * sinStep) + (y * cosStep);
+      x = nextX;
+
+      _buffer.PushIndex(base);
+      _buffer.PushIndex(base + 1 + i);
+      _buffer.PushIndex(base + 1 + ((i + 1) % segments));
+    }
+  }
+
+  void ShapeBatch::AddCircle(const SDL_FPoint center, const float radius, const float thickness, const SDL_FColor& color) {
+    if (radius <= 0.0f || thickness <= 0.0f) {
+      return;
+    }
+
+    if (thickness >= radius) {
+      AddFilledCircle(center, radius, color);
+      return;
+    }
+
+    const auto segments = CircleSegments(radius, _tolerance);
+    const auto step = (2.0f * std::numbers::pi_v<float>) / static_cast<float>(segments);
+    const auto cosStep = std::cos(step);
+    const auto sinStep = std::sin(step);
+    const auto inner = radius - thickness;
+    const auto base = static_cast<int>(_buffer.Size());
+
+    auto x = 1.0f;
+    auto y = 0.0f;
+
+    for (auto i = 0; i < segments; ++i) {
+      _buffer.Push(Vertex(center.x + (x * radius), center.y + (y * radius), color));
+      _buffer.Push(Vertex(center.x + (x * inner), center.y + (y * inner), color));
+
+      const auto nextX = (x * cosStep) - (y * sinStep);
+      y = (x * sinStep) + (y * cosStep);
+      x = nextX;
+    }
+
+    PushRingIndices(base, segments);
+  }
+
+  auto ShapeBatch::AddFilledPolygon(const std::span<const SDL_FPoint> points, const SDL_FColor& color) -> bool {
+    if (points.size() < 3uz) {
+      DEBUG_PRINT("A polygon needs at least 3 points, not {}.\n", points.size())
+      return false;
+    }
+
+    const auto base = static_cast<int>(_buffer.Size());
+
+    for (const auto& point: points) {
+      _buffer.Push(Vertex(point.x, point.y, color));
+    }
+
+    // A fan from the first point covers any convex polygon.
+    const auto count = static_cast<int>(points.size());
+
+    for (auto i = 1; i < count - 1; ++i) {
+      _buffer.PushIndex(base);
+      _buffer.PushIndex(base + i);
+      _buffer.PushIndex(base + i + 1);
+    }
+
+    return true;
+  }
+
+  auto ShapeBatch::AddPolygon(const std::span<const SDL_FPoint> points, const float thickness, const SDL_FColor& color) -> bool {
+    if (points.size() < 3uz) {
+      DEBUG_PRINT("A polygon needs at least 3 points, not {}.\n", points.size())
+      return false;
+    }
+
+    if (thickness <= 0.0f) {
+      return true;
+    }
+
+    const auto half = thickness * 0.5f;
+    const auto count = points.size();
+    const auto base = static_cast<int>(_buffer.Size());
+
+    for (auto i = 0uz; i < count; ++i) {
+      const auto& prev = points[(i + count - 1uz) % count];
+      const auto& point = points[i];
+      const auto& next = points[(i + 1uz) % count];
+
+      const auto in = Normalized(point.x - prev.x, point.y - prev.y);
+      const auto out = Normalized(next.x - point.x, next.y - point.y);
+
+      // The corner is pushed out along the average of the two edge normals, far enough to keep both edges
+      // at half the thickness, up to the miter limit.
+      auto miter = Normalized(-in.y - out.y, in.x + out.x);
+      auto scale = half;
+
+      if (miter.x == 0.0f && miter.y == 0.0f) {
+        miter = SDL_FPoint{.x = -in.y, .y = in.x};
+      } else {
+        const auto cosine = (miter.x * -in.y) + (miter.y * in.x);
+        scale = half / std::max(cosine, 1.0f / miterLimit);
+      }
+
+      _buffer.Push(Vertex(point.x + (miter.x * scale), point.y + (miter.y * scale), color));
+      _buffer.Push(Vertex(point.x - (miter.x * scale), point.y - (miter.y * scale), color));
+    }
+
+    PushRingIndices(base, static_cast<int>(count));
+    return true;
+  }
+
+  void ShapeBatch::SetTolerance(const float pixels) {
+    _tolerance = std::max(pixels, minTolerance);
+  }
+
+  auto ShapeBatch::CircleSegments(const float radius, const float tolerance) -> int {
+    // Written so NaN takes the early return too.
+    if (!(radius > tolerance) || !(tolerance > 0.0f)) {
+      return minCircleSegments;
+    }
+
+    // Each segment's chord may sag at most tolerance from the arc it replaces.
+    const auto step = 2.0f * std::acos(1.0f - (tolerance / radius));
+    const auto segments = std::ceil((2.0f * std::numbers::pi_v<float>) / step);
+
+    return static_cast<int>(std::clamp(segments, static_cast<float>(minCircleSegments), static_cast<float>(maxCircleSegments)));
+  }
+
+  void ShapeBatch::PushRingIndices(const int base, const int corners) {
+    for (auto i = 0; i < corners; ++i) {
+      const auto outer = base + (i * 2);
+      const auto nextOuter = base + (((i + 1) % corners) * 2);
+
+      for (const auto index: {outer, nextOuter, nextOuter + 1, nextOuter + 1, outer + 1, outer}) {
+        _buffer.PushIndex(index);
+      }
+    }
+  }
+
+} // namespace swgtk
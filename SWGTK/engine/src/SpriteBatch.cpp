@@ -0,0 +1,117 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/SpriteBatch.hpp>
+
+#include <cmath>
+#include <numbers>
+
+namespace swgtk {
+
+  auto VertexBuffer::AddFlat(const std::span<const float> values) -> size_t {
+    const auto count = values.size() / flatStride;
+
+    GrowVector(_vertices, count);
+
+    for (auto i = 0uz; i < count; ++i) {
+      const auto v = values.subspan(i * flatStride, flatStride);
+
+      _vertices.push_back(SDL_Vertex{
+          .position = SDL_FPoint{.x = v[0], .y = v[1]},
+          .color = SDL_FColor{.r = v[2], .g = v[3], .b = v[4], .a = v[5]},
+          .tex_coord = SDL_FPoint{.x = v[6], .y = v[7]},
+      });
+    }
+
+    return count;
+  }
+
+  void SpriteBatch::SetTexture(const Texture texture) {
+    _texture = texture;
+
+    if (const auto [w, h] = texture.GetSize(); w > 0.0f && h > 0.0f) {
+      _texWidth = w;
+      _texHeight = h;
+    } else {
+      _texWidth = 1.0f;
+      _texHeight = 1.0f;
+    }
+  }
+
+  void SpriteBatch::Reserve(const size_t sprites) {
+    _buffer.Reserve(sprites * verticesPerSprite, sprites * indicesPerSprite);
+  }
+
+  void SpriteBatch::Grow(const size_t sprites) {
+    _buffer.Grow(sprites * verticesPerSprite, sprites * indicesPerSprite);
+  }
+
+  void SpriteBatch::Add(const SDL_FRect& src, const SDL_FRect& dest, const SDL_FColor& color) {
+    PushQuad(src, {SDL_FPoint{.x = dest.x, .y = dest.y},
+                   SDL_FPoint{.x = dest.x + dest.w, .y = dest.y},
+                   SDL_FPoint{.x = dest.x + dest.w, .y = dest.y + dest.h},
+                   SDL_FPoint{.x = dest.x, .y = dest.y + dest.h}},
+             color);
+  }
+
+  void SpriteBatch::Add(const SDL_FRect& src, const SDL_FRect& dest, const double angle, const SDL_FColor& color) {
+    const auto radians = static_cast<float>(angle * (std::numbers::pi / 180.0));
+    const auto cosA = std::cos(radians);
+    const auto sinA = std::sin(radians);
+    const auto halfW = dest.w * 0.5f;
+    const auto halfH = dest.h * 0.5f;
+    const auto centerX = dest.x + halfW;
+    const auto centerY = dest.y + halfH;
+
+    const auto rotate = [&](const float x, const float y) {
+      return SDL_FPoint{.x = centerX + (x * cosA) - (y * sinA), .y = centerY + (x * sinA) + (y * cosA)};
+    };
+
+    PushQuad(src, {rotate(-halfW, -halfH), rotate(halfW, -halfH), rotate(halfW, halfH), rotate(-halfW, halfH)}, color);
+  }
+
+  auto SpriteBatch::AddFlat(const std::span<const float> values, const SDL_FColor& color) -> size_t {
+    const auto count = values.size() / flatStride;
+
+    Grow(count);
+
+    for (auto i = 0uz; i < count; ++i) {
+      const auto v = values.subspan(i * flatStride, flatStride);
+
+      Add(SDL_FRect{.x = v[0], .y = v[1], .w = v[2], .h = v[3]},
+          SDL_FRect{.x = v[4], .y = v[5], .w = v[6], .h = v[7]},
+          color);
+    }
+
+    return count;
+  }
+
+  void SpriteBatch::PushQuad(const SDL_FRect& src, const std::array<SDL_FPoint, verticesPerSprite>& corners, const SDL_FColor& color) {
+    const auto useWholeTexture = src.w <= 0.0f || src.h <= 0.0f;
+    const auto u0 = useWholeTexture ? 0.0f : src.x / _texWidth;
+    const auto v0 = useWholeTexture ? 0.0f : src.y / _texHeight;
+    const auto u1 = useWholeTexture ? 1.0f : (src.x + src.w) / _texWidth;
+    const auto v1 = useWholeTexture ? 1.0f : (src.y + src.h) / _texHeight;
+
+    const auto base = static_cast<int>(_buffer.Size());
+
+    _buffer.Push(SDL_Vertex{.position = corners[0], .color = color, .tex_coord = SDL_FPoint{.x = u0, .y = v0}});
+    _buffer.Push(SDL_Vertex{.position = corners[1], .color = color, .tex_coord = SDL_FPoint{.x = u1, .y = v0}});
+    _buffer.Push(SDL_Vertex{.position = corners[2], .color = color, .tex_coord = SDL_FPoint{.x = u1, .y = v1}});
+    _buffer.Push(SDL_Vertex{.position = corners[3], .color = color, .tex_coord = SDL_FPoint{.x = u0, .y = v1}});
+
+    for (const auto offset: {0, 1, 2, 2, 3, 0}) {
+      _buffer.PushIndex(base + offset);
+    }
+  }
+
+} // namespace swgtk
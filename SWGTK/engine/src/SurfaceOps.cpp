@@ -0,0 +1,685 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/SurfaceOps.hpp>
+
+#include <SDL3/SDL_cpuinfo.h>
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SWGTK_SURFACE_OPS_X86 1
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SWGTK_TARGET_SSE2 __attribute__((target("sse2")))
+#define SWGTK_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SWGTK_TARGET_SSE2
+#define SWGTK_TARGET_AVX2
+#endif
+#endif
+
+// NOLINTBEGIN(*-pointer-arithmetic, *-reinterpret-cast, *-magic-numbers)
+
+namespace {
+  using namespace swgtk;
+
+  constexpr uint32_t alphaMask = 0xFF000000u;
+  constexpr uint32_t colorMask = 0x00FFFFFFu;
+  constexpr uint32_t channelMax = 255u;
+
+  // Blend, tint and premultiply all divide by 255 like this, so every path produces the same bytes.
+  [[nodiscard]] constexpr auto Div255(uint32_t value) -> uint32_t {
+    value += 128u;
+    return (value + (value >> 8u)) >> 8u;
+  }
+
+  static_assert(Div255(255u * 255u) == 255u && Div255(127u * 255u) == 127u && Div255(128u) == 1u);
+
+  [[nodiscard]] constexpr auto Channel(const uint32_t pixel, const uint32_t index) -> uint32_t { return (pixel >> (index * 8u)) & channelMax; }
+
+  /*
+    Scalar kernels. These define the results the SIMD versions have to match.
+  */
+  namespace scalar {
+    [[nodiscard]] constexpr auto BlendPixel(const uint32_t source, const uint32_t dest) -> uint32_t {
+      // Treating the source alpha channel as 255 turns the color formula into dstA = srcA + dstA * (1 - srcA).
+      const auto opaque = source | alphaMask;
+      const auto alpha = source >> 24u;
+      auto result = 0u;
+
+      for (auto index = 0u; index < 4u; ++index) {
+        result |= Div255((Channel(opaque, index) * alpha) + (Channel(dest, index) * (channelMax - alpha))) << (index * 8u);
+      }
+
+      return result;
+    }
+
+    [[nodiscard]] constexpr auto MultiplyPixel(const uint32_t pixel, const uint32_t factors) -> uint32_t {
+      auto result = 0u;
+
+      for (auto index = 0u; index < 4u; ++index) {
+        result |= Div255(Channel(pixel, index) * Channel(factors, index)) << (index * 8u);
+      }
+
+      return result;
+    }
+
+    void BlendRow(const uint32_t* source, uint32_t* dest, const size_t count) {
+      for (auto i = 0uz; i < count; ++i) {
+        dest[i] = BlendPixel(source[i], dest[i]);
+      }
+    }
+
+    void ColorKeyRow(const uint32_t* source, uint32_t* dest, const size_t count, const uint32_t key) {
+      for (auto i = 0uz; i < count; ++i) {
+        if ((source[i] & colorMask) != key) {
+          dest[i] = source[i];
+        }
+      }
+    }
+
+    void TintRow(uint32_t* pixels, const size_t count, const uint32_t color) {
+      for (auto i = 0uz; i < count; ++i) {
+        pixels[i] = MultiplyPixel(pixels[i], color);
+      }
+    }
+
+    void PremultiplyRow(uint32_t* pixels, const size_t count) {
+      for (auto i = 0uz; i < count; ++i) {
+        const auto alpha = pixels[i] >> 24u;
+        pixels[i] = MultiplyPixel(pixels[i], (alpha * 0x010101u) | alphaMask);
+      }
+    }
+
+    // Horizontal then vertical interpolation with 8-bit weights, rounding after each pass.
+    [[nodiscard]] constexpr auto Lerp(const uint32_t a, const uint32_t b, const uint32_t weight) -> uint32_t {
+      return ((a * (256u - weight)) + (b * weight) + 128u) >> 8u;
+    }
+
+    [[nodiscard]] constexpr auto BilinearPixel(const uint32_t p00, const uint32_t p01, const uint32_t p10, const uint32_t p11, const uint32_t wx, const uint32_t wy) -> uint32_t {
+      auto result = 0u;
+
+      for (auto index = 0u; index < 4u; ++index) {
+        const auto top = Lerp(Channel(p00, index), Channel(p01, index), wx);
+        const auto bottom = Lerp(Channel(p10, index), Channel(p11, index), wx);
+        result |= Lerp(top, bottom, wy) << (index * 8u);
+      }
+
+      return result;
+    }
+  } // namespace scalar
+
+  // Where each output column samples the source, shared by every row of a scaled blit.
+  struct ScaleColumns {
+    std::vector<uint32_t> x0;
+    std::vector<uint32_t> x1;
+    std::vector<uint16_t> weight;
+  };
+
+  // One output row of a bilinear blit. The column arrays start at the first column being written.
+  struct BilinearRowArgs {
+    const uint32_t* top = nullptr;
+    const uint32_t* bottom = nullptr;
+    const uint32_t* x0 = nullptr;
+    const uint32_t* x1 = nullptr;
+    const uint16_t* wx = nullptr;
+    uint32_t weight = 0u;
+  };
+
+  void ScalarBilinearRow(const BilinearRowArgs& args, uint32_t* dest, const size_t count) {
+    const auto* x0 = args.x0;
+    const auto* x1 = args.x1;
+    const auto* wx = args.wx;
+
+    for (auto i = 0uz; i < count; ++i) {
+      dest[i] = scalar::BilinearPixel(args.top[x0[i]], args.top[x1[i]], args.bottom[x0[i]], args.bottom[x1[i]], wx[i], args.weight);
+    }
+  }
+
+#ifdef SWGTK_SURFACE_OPS_X86
+  namespace sse2 {
+    SWGTK_TARGET_SSE2 inline auto Div255(__m128i value) -> __m128i {
+      value = _mm_add_epi16(value, _mm_set1_epi16(128));
+      return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+    }
+
+    SWGTK_TARGET_SSE2 inline auto BroadcastAlpha(const __m128i pixels) -> __m128i {
+      return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, 0xFF), 0xFF);
+    }
+
+    // Two pixels widened to 16-bit channels.
+    SWGTK_TARGET_SSE2 inline auto Blend(const __m128i source, const __m128i dest) -> __m128i {
+      const auto alpha = BroadcastAlpha(source);
+      const auto opaque = _mm_or_si128(source, _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+      const auto inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+
+      return Div255(_mm_add_epi16(_mm_mullo_epi16(opaque, alpha), _mm_mullo_epi16(dest, inverse)));
+    }
+
+    SWGTK_TARGET_SSE2 void BlendRow(const uint32_t* source, uint32_t* dest, const size_t count) {
+      const auto zero = _mm_setzero_si128();
+      auto i = 0uz;
+
+      for (; i + 4uz <= count; i += 4uz) {
+        const auto s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+
+        const auto low = Blend(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+        const auto high = Blend(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_packus_epi16(low, high));
+      }
+
+      scalar::BlendRow(source + i, dest + i, count - i);
+    }
+
+    SWGTK_TARGET_SSE2 void ColorKeyRow(const uint32_t* source, uint32_t* dest, const size_t count, const uint32_t key) {
+      const auto keys = _mm_set1_epi32(static_cast<int>(key));
+      const auto mask = _mm_set1_epi32(static_cast<int>(colorMask));
+      auto i = 0uz;
+
+      for (; i + 4uz <= count; i += 4uz) {
+        const auto s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+        const auto keep = _mm_cmpeq_epi32(_mm_and_si128(s, mask), keys);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, s)));
+      }
+
+      scalar::ColorKeyRow(source + i, dest + i, count - i, key);
+    }
+
+    SWGTK_TARGET_SSE2 void TintRow(uint32_t* pixels, const size_t count, const uint32_t color) {
+      const auto zero = _mm_setzero_si128();
+      const auto factors = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero);
+      auto i = 0uz;
+
+      for (; i + 4uz <= count; i += 4uz) {
+        const auto p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+        const auto low = Div255(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), factors));
+        const auto high = Div255(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), factors));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_packus_epi16(low, high));
+      }
+
+      scalar::TintRow(pixels + i, count - i, color);
+    }
+
+    SWGTK_TARGET_SSE2 inline auto Premultiply(const __m128i pixels) -> __m128i {
+      const auto alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+      const auto factors = _mm_or_si128(_mm_andnot_si128(alphaLanes, BroadcastAlpha(pixels)), alphaLanes);
+
+      return Div255(_mm_mullo_epi16(pixels, factors));
+    }
+
+    SWGTK_TARGET_SSE2 void PremultiplyRow(uint32_t* pixels, const size_t count) {
+      const auto zero = _mm_setzero_si128();
+      auto i = 0uz;
+
+      for (; i + 4uz <= count; i += 4uz) {
+        const auto p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+        const auto low = Premultiply(_mm_unpacklo_epi8(p, zero));
+        const auto high = Premultiply(_mm_unpackhi_epi8(p, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_packus_epi16(low, high));
+      }
+
+      scalar::PremultiplyRow(pixels + i, count - i);
+    }
+
+    // Lanes 0-3 and 4-7 hold two pixels. Weight them, add the halves and round, leaving one pixel in lanes 0-3.
+    SWGTK_TARGET_SSE2 inline auto LerpHalves(const __m128i pair, const uint32_t weight) -> __m128i {
+      const auto first = static_cast<int16_t>(256u - weight);
+      const auto second = static_cast<int16_t>(weight);
+      const auto weighted = _mm_mullo_epi16(pair, _mm_set_epi16(second, second, second, second, first, first, first, first));
+      const auto sum = _mm_add_epi16(_mm_add_epi16(weighted, _mm_srli_si128(weighted, 8)), _mm_set1_epi16(128));
+
+      return _mm_srli_epi16(sum, 8);
+    }
+
+    SWGTK_TARGET_SSE2 void BilinearRow(const BilinearRowArgs& args, uint32_t* dest, const size_t count) {
+      const auto* x0 = args.x0;
+      const auto* x1 = args.x1;
+      const auto* wx = args.wx;
+      const auto zero = _mm_setzero_si128();
+
+      for (auto i = 0uz; i < count; ++i) {
+        const auto top = _mm_unpacklo_epi32(_mm_cvtsi32_si128(static_cast<int>(args.top[x0[i]])), _mm_cvtsi32_si128(static_cast<int>(args.top[x1[i]])));
+        const auto bottom = _mm_unpacklo_epi32(_mm_cvtsi32_si128(static_cast<int>(args.bottom[x0[i]])), _mm_cvtsi32_si128(static_cast<int>(args.bottom[x1[i]])));
+
+        const auto topRow = LerpHalves(_mm_unpacklo_epi8(top, zero), wx[i]);
+        const auto bottomRow = LerpHalves(_mm_unpacklo_epi8(bottom, zero), wx[i]);
+        const auto pixel = LerpHalves(_mm_unpacklo_epi64(topRow, bottomRow), args.weight);
+
+        dest[i] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(pixel, zero)));
+      }
+    }
+  } // namespace sse2
+
+  namespace avx2 {
+    SWGTK_TARGET_AVX2 inline auto Div255(__m256i value) -> __m256i {
+      value = _mm256_add_epi16(value, _mm256_set1_epi16(128));
+      return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+    }
+
+    SWGTK_TARGET_AVX2 inline auto BroadcastAlpha(const __m256i pixels) -> __m256i {
+      return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, 0xFF), 0xFF);
+    }
+
+    SWGTK_TARGET_AVX2 inline auto AlphaLanes() -> __m256i {
+      return _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+    }
+
+    SWGTK_TARGET_AVX2 inline auto Blend(const __m256i source, const __m256i dest) -> __m256i {
+      const auto alpha = BroadcastAlpha(source);
+      const auto opaque = _mm256_or_si256(source, AlphaLanes());
+      const auto inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+
+      return Div255(_mm256_add_epi16(_mm256_mullo_epi16(opaque, alpha), _mm256_mullo_epi16(dest, inverse)));
+    }
+
+    // Unpacking and packing both work within 128-bit lanes, so the pixel order survives the round trip.
+    SWGTK_TARGET_AVX2 void BlendRow(const uint32_t* source, uint32_t* dest, const size_t count) {
+      const auto zero = _mm256_setzero_si256();
+      auto i = 0uz;
+
+      for (; i + 8uz <= count; i += 8uz) {
+        const auto s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        const auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i));
+
+        const auto low = Blend(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero));
+        const auto high = Blend(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_packus_epi16(low, high));
+      }
+
+      sse2::BlendRow(source + i, dest + i, count - i);
+    }
+
+    SWGTK_TARGET_AVX2 void ColorKeyRow(const uint32_t* source, uint32_t* dest, const size_t count, const uint32_t key) {
+      const auto keys = _mm256_set1_epi32(static_cast<int>(key));
+      const auto mask = _mm256_set1_epi32(static_cast<int>(colorMask));
+      auto i = 0uz;
+
+      for (; i + 8uz <= count; i += 8uz) {
+        const auto s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        const auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i));
+        const auto keep = _mm256_cmpeq_epi32(_mm256_and_si256(s, mask), keys);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_blendv_epi8(s, d, keep));
+      }
+
+      sse2::ColorKeyRow(source + i, dest + i, count - i, key);
+    }
+
+    SWGTK_TARGET_AVX2 void TintRow(uint32_t* pixels, const size_t count, const uint32_t color) {
+      const auto zero = _mm256_setzero_si256();
+      const auto factors = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color)), zero);
+      auto i = 0uz;
+
+      for (; i + 8uz <= count; i += 8uz) {
+        const auto p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+        const auto low = Div255(_mm256_mullo_epi16(_mm256_unpacklo_epi8(p, zero), factors));
+        const auto high = Div255(_mm256_mullo_epi16(_mm256_unpackhi_epi8(p, zero), factors));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), _mm256_packus_epi16(low, high));
+      }
+
+      sse2::TintRow(pixels + i, count - i, color);
+    }
+
+    SWGTK_TARGET_AVX2 inline auto Premultiply(const __m256i pixels) -> __m256i {
+      const auto factors = _mm256_or_si256(_mm256_andnot_si256(AlphaLanes(), BroadcastAlpha(pixels)), AlphaLanes());
+      return Div255(_mm256_mullo_epi16(pixels, factors));
+    }
+
+    SWGTK_TARGET_AVX2 void PremultiplyRow(uint32_t* pixels, const size_t count) {
+      const auto zero = _mm256_setzero_si256();
+      auto i = 0uz;
+
+      for (; i + 8uz <= count; i += 8uz) {
+        const auto p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+        const auto low = Premultiply(_mm256_unpacklo_epi8(p, zero));
+        const auto high = Premultiply(_mm256_unpackhi_epi8(p, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), _mm256_packus_epi16(low, high));
+      }
+
+      sse2::PremultiplyRow(pixels + i, count - i);
+    }
+  } // namespace avx2
+#endif // SWGTK_SURFACE_OPS_X86
+
+  struct Kernels {
+    void (*blend)(const uint32_t*, uint32_t*, size_t) = &scalar::BlendRow;
+    void (*colorKey)(const uint32_t*, uint32_t*, size_t, uint32_t) = &scalar::ColorKeyRow;
+    void (*tint)(uint32_t*, size_t, uint32_t) = &scalar::TintRow;
+    void (*premultiply)(uint32_t*, size_t) = &scalar::PremultiplyRow;
+    void (*bilinear)(const BilinearRowArgs&, uint32_t*, size_t) = &ScalarBilinearRow;
+  };
+
+  [[nodiscard]] auto DetectSimdLevel() -> SimdLevel {
+#ifdef SWGTK_SURFACE_OPS_X86
+    if (SDL_HasAVX2()) {
+      return SimdLevel::AVX2;
+    }
+
+    if (SDL_HasSSE2()) {
+      return SimdLevel::SSE2;
+    }
+#endif
+
+    return SimdLevel::Scalar;
+  }
+
+  [[nodiscard]] auto KernelsFor([[maybe_unused]] const SimdLevel level) -> Kernels {
+    Kernels kernels;
+
+#ifdef SWGTK_SURFACE_OPS_X86
+    if (level == SimdLevel::AVX2) {
+      // Bilinear filtering gathers pixels one at a time, so the wider registers do not help it.
+      kernels = Kernels{&avx2::BlendRow, &avx2::ColorKeyRow, &avx2::TintRow, &avx2::PremultiplyRow, &sse2::BilinearRow};
+    } else if (level == SimdLevel::SSE2) {
+      kernels = Kernels{&sse2::BlendRow, &sse2::ColorKeyRow, &sse2::TintRow, &sse2::PremultiplyRow, &sse2::BilinearRow};
+    }
+#endif
+
+    return kernels;
+  }
+
+  struct Dispatch {
+    SimdLevel detected = DetectSimdLevel();
+    SimdLevel level = detected;
+    Kernels kernels = KernelsFor(detected);
+  };
+
+  [[nodiscard]] auto GetDispatch() -> Dispatch& {
+    static Dispatch dispatch;
+    return dispatch;
+  }
+
+  [[nodiscard]] auto IsSupported(const SurfaceLock& lock) -> bool {
+    if (!lock.IsLocked()) {
+      return false;
+    }
+
+    const auto* details = SDL_GetPixelFormatDetails(lock.Format());
+
+    if (details == nullptr || details->bytes_per_pixel != 4u || details->Ashift != 24u || details->Abits != 8u) {
+      DEBUG_PRINT("Surface format {} is not supported by the raster kernels.\n", SDL_GetPixelFormatName(lock.Format()))
+      return false;
+    }
+
+    return true;
+  }
+
+  struct BlitArea {
+    int sourceX = 0;
+    int sourceY = 0;
+    int destX = 0;
+    int destY = 0;
+    int width = 0;
+    int height = 0;
+  };
+
+  [[nodiscard]] auto FullRect(const SurfaceLock& lock) -> SDL_Rect { return SDL_Rect{.x = 0, .y = 0, .w = lock.Width(), .h = lock.Height()}; }
+
+  // Clip a rectangle to a surface's bounds.
+  [[nodiscard]] auto ClipToSurface(const SDL_Rect& rect, const SurfaceLock& lock) -> SDL_Rect {
+    const auto left = std::max(rect.x, 0);
+    const auto top = std::max(rect.y, 0);
+    const auto right = std::min(rect.x + rect.w, lock.Width());
+    const auto bottom = std::min(rect.y + rect.h, lock.Height());
+
+    return SDL_Rect{.x = left, .y = top, .w = std::max(right - left, 0), .h = std::max(bottom - top, 0)};
+  }
+
+  [[nodiscard]] auto ClipBlit(const SurfaceLock& source, const SDL_Rect* sourceRect, const SurfaceLock& dest, const int x, const int y) -> std::optional<BlitArea> {
+    const auto requested = (sourceRect != nullptr) ? *sourceRect : FullRect(source);
+    const auto clipped = ClipToSurface(requested, source);
+
+    // Whatever was cut off the top-left of the source moves the destination with it.
+    const auto placed = SDL_Rect{.x = x + (clipped.x - requested.x), .y = y + (clipped.y - requested.y), .w = clipped.w, .h = clipped.h};
+    const auto visible = ClipToSurface(placed, dest);
+
+    if (visible.w <= 0 || visible.h <= 0) {
+      return std::nullopt;
+    }
+
+    return BlitArea{
+        .sourceX = clipped.x + (visible.x - placed.x),
+        .sourceY = clipped.y + (visible.y - placed.y),
+        .destX = visible.x,
+        .destY = visible.y,
+        .width = visible.w,
+        .height = visible.h,
+    };
+  }
+
+  [[nodiscard]] auto BuildColumns(const int sourceX, const int sourceWidth, const int destWidth, const ScaleFilter filter) -> ScaleColumns {
+    ScaleColumns columns;
+    const auto count = static_cast<size_t>(destWidth);
+
+    columns.x0.resize(count);
+    columns.x1.resize(count);
+    columns.weight.resize(count);
+
+    // 16.16 fixed point. Bilinear samples pixel centers, nearest samples the pixel each center falls in.
+    const auto step = (static_cast<int64_t>(sourceWidth) << 16) / destWidth;
+    const auto last = static_cast<int64_t>(sourceWidth - 1);
+
+    for (auto i = 0uz; i < count; ++i) {
+      auto position = (static_cast<int64_t>(i) * step) + (step / 2);
+
+      if (filter == ScaleFilter::Bilinear) {
+        position = std::max<int64_t>(position - 0x8000, 0);
+      }
+
+      const auto whole = std::min(position >> 16, last);
+
+      columns.x0[i] = static_cast<uint32_t>(sourceX + whole);
+      columns.x1[i] = static_cast<uint32_t>(sourceX + std::min(whole + 1, last));
+      columns.weight[i] = (whole == last) ? uint16_t{0} : static_cast<uint16_t>((position >> 8) & 0xFF);
+    }
+
+    return columns;
+  }
+} // namespace
+
+namespace swgtk {
+
+  auto GetSimdLevel() -> SimdLevel { return GetDispatch().level; }
+
+  auto SetSimdLevel(const SimdLevel level) -> SimdLevel {
+    auto& dispatch = GetDispatch();
+
+    dispatch.level = std::min(level, dispatch.detected);
+    dispatch.kernels = KernelsFor(dispatch.level);
+
+    return dispatch.level;
+  }
+
+  auto BlitBlend(const Surface& source, const SDL_Rect* sourceRect, const Surface& dest, const int x, const int y) -> bool {
+    const auto sourceLock = source.Lock();
+    const auto destLock = dest.Lock();
+
+    if (!IsSupported(sourceLock) || !IsSupported(destLock) || sourceLock.Format() != destLock.Format()) {
+      return false;
+    }
+
+    const auto area = ClipBlit(sourceLock, sourceRect, destLock, x, y);
+
+    if (!area) {
+      return true;
+    }
+
+    const auto sourceView = sourceLock.View<const uint32_t>();
+    const auto destView = destLock.View<uint32_t>();
+    const auto blend = GetDispatch().kernels.blend;
+
+    for (auto row = 0; row < area->height; ++row) {
+      blend(&sourceView[area->sourceX, area->sourceY + row], &destView[area->destX, area->destY + row], static_cast<size_t>(area->width));
+    }
+
+    return true;
+  }
+
+  auto BlitColorKey(const Surface& source, const SDL_Rect* sourceRect, const Surface& dest, const int x, const int y, const SDL_Color key) -> bool {
+    const auto sourceLock = source.Lock();
+    const auto destLock = dest.Lock();
+
+    if (!IsSupported(sourceLock) || !IsSupported(destLock) || sourceLock.Format() != destLock.Format()) {
+      return false;
+    }
+
+    const auto area = ClipBlit(sourceLock, sourceRect, destLock, x, y);
+
+    if (!area) {
+      return true;
+    }
+
+    const auto mappedKey = sourceLock.MapRGBA(key.r, key.g, key.b, 0u) & colorMask;
+    const auto sourceView = sourceLock.View<const uint32_t>();
+    const auto destView = destLock.View<uint32_t>();
+    const auto colorKey = GetDispatch().kernels.colorKey;
+
+    for (auto row = 0; row < area->height; ++row) {
+      colorKey(&sourceView[area->sourceX, area->sourceY + row], &destView[area->destX, area->destY + row], static_cast<size_t>(area->width), mappedKey);
+    }
+
+    return true;
+  }
+
+  auto BlitScaled(const Surface& source, const SDL_Rect* sourceRect, const Surface& dest, const SDL_Rect* destRect, const ScaleFilter filter) -> bool {
+    const auto sourceLock = source.Lock();
+    const auto destLock = dest.Lock();
+
+    if (!IsSupported(sourceLock) || !IsSupported(destLock) || sourceLock.Format() != destLock.Format()) {
+      return false;
+    }
+
+    const auto from = ClipToSurface((sourceRect != nullptr) ? *sourceRect : FullRect(sourceLock), sourceLock);
+    const auto to = (destRect != nullptr) ? *destRect : FullRect(destLock);
+    const auto visible = ClipToSurface(to, destLock);
+
+    if (from.w <= 0 || from.h <= 0 || visible.w <= 0 || visible.h <= 0) {
+      return true;
+    }
+
+    // Columns and rows are mapped over the whole destination rectangle, then only the visible part is drawn.
+    const auto columns = BuildColumns(from.x, from.w, to.w, filter);
+    const auto rows = BuildColumns(from.y, from.h, to.h, filter);
+
+    const auto sourceView = sourceLock.View<const uint32_t>();
+    const auto destView = destLock.View<uint32_t>();
+    const auto bilinear = GetDispatch().kernels.bilinear;
+
+    const auto firstColumn = static_cast<size_t>(visible.x - to.x);
+    const auto count = static_cast<size_t>(visible.w);
+
+    for (auto row = visible.y; row < visible.y + visible.h; ++row) {
+      const auto index = static_cast<size_t>(row - to.y);
+      auto* out = &destView[visible.x, row];
+
+      if (filter == ScaleFilter::Nearest) {
+        const auto* in = sourceView.Row(static_cast<int>(rows.x0[index])).data();
+
+        for (auto i = 0uz; i < count; ++i) {
+          out[i] = in[columns.x0[firstColumn + i]];
+        }
+
+        continue;
+      }
+
+      const auto args = BilinearRowArgs{
+          .top = sourceView.Row(static_cast<int>(rows.x0[index])).data(),
+          .bottom = sourceView.Row(static_cast<int>(rows.x1[index])).data(),
+          .x0 = columns.x0.data() + firstColumn,
+          .x1 = columns.x1.data() + firstColumn,
+          .wx = columns.weight.data() + firstColumn,
+          .weight = rows.weight[index],
+      };
+
+      bilinear(args, out, count);
+    }
+
+    return true;
+  }
+
+  auto Premultiply(const Surface& surface) -> bool {
+    const auto lock = surface.Lock();
+
+    if (!IsSupported(lock)) {
+      return false;
+    }
+
+    const auto view = lock.View<uint32_t>();
+    const auto premultiply = GetDispatch().kernels.premultiply;
+
+    for (auto y = 0; y < view.Height(); ++y) {
+      premultiply(view.Row(y).data(), static_cast<size_t>(view.Width()));
+    }
+
+    return true;
+  }
+
+  auto Unpremultiply(const Surface& surface) -> bool {
+    const auto lock = surface.Lock();
+
+    if (!IsSupported(lock)) {
+      return false;
+    }
+
+    lock.View<uint32_t>().ForEach([](int, int, uint32_t& pixel) {
+      const auto alpha = pixel >> 24u;
+
+      if (alpha == 0u) {
+        pixel = 0u;
+        return;
+      }
+
+      auto result = pixel & alphaMask;
+
+      for (auto index = 0u; index < 3u; ++index) {
+        result |= std::min(((Channel(pixel, index) * channelMax) + (alpha / 2u)) / alpha, channelMax) << (index * 8u);
+      }
+
+      pixel = result;
+    });
+
+    return true;
+  }
+
+  auto Tint(const Surface& surface, const SDL_Color color) -> bool {
+    const auto lock = surface.Lock();
+
+    if (!IsSupported(lock)) {
+      return false;
+    }
+
+    const auto factors = lock.MapRGBA(color.r, color.g, color.b, color.a);
+    const auto view = lock.View<uint32_t>();
+    const auto tint = GetDispatch().kernels.tint;
+
+    for (auto y = 0; y < view.Height(); ++y) {
+      tint(view.Row(y).data(), static_cast<size_t>(view.Width()), factors);
+    }
+
+    return true;
+  }
+
+} // namespace swgtk
+
+// NOLINTEND(*-pointer-arithmetic, *-reinterpret-cast, *-magic-numbers)
@@ -0,0 +1,401 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include "swgtk/TextLayout.hpp"
+
+#include <SDL3/SDL_stdinc.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <span>
+
+namespace {
+  [[nodiscard]] constexpr auto IsSpace(const uint32_t codepoint) -> bool { return codepoint == ' ' || codepoint == '\t'; }
+} // namespace
+
+namespace swgtk {
+
+  void TextLayout::SetFont(SdfFont* font, const float size) {
+    _font = font;
+    _size = size;
+    SetText(GetText());
+  }
+
+  void TextLayout::SetWrapWidth(const float width) {
+    _wrapWidth = width;
+
+    for (auto& paragraph: _paragraphs) {
+      Wrap(paragraph, 0uz);
+    }
+
+    UpdateStarts(0uz);
+  }
+
+  void TextLayout::SetText(const std::string_view text) {
+    _paragraphs.clear();
+    _length = text.size();
+
+    auto start = 0uz;
+
+    while (true) {
+      const auto newline = text.find('\n', start);
+      auto& paragraph = _paragraphs.emplace_back();
+
+      paragraph.text = text.substr(start, newline == std::string_view::npos ? std::string_view::npos : newline - start);
+      Relayout(paragraph);
+
+      if (newline == std::string_view::npos) {
+        break;
+      }
+
+      start = newline + 1uz;
+    }
+
+    UpdateStarts(0uz);
+  }
+
+  void TextLayout::Append(const std::string_view text) { Insert(_length, text); }
+
+  void TextLayout::Insert(const size_t offset, const std::string_view text) {
+    if (text.empty()) {
+      return;
+    }
+
+    const auto [index, local] = Locate(offset);
+    auto& paragraph = _paragraphs[index];
+
+    _length += text.size();
+
+    const auto newline = text.find('\n');
+    const auto atEnd = local == paragraph.text.size();
+    auto tail = atEnd ? std::string{} : paragraph.text.substr(local);
+
+    paragraph.text.resize(local);
+    paragraph.text.append(text.substr(0uz, newline));
+
+    // Text added to the end of a paragraph is shaped on its own and only the last line is wrapped again.
+    if (atEnd) {
+      Shape(paragraph, local);
+      Wrap(paragraph, paragraph.lines.size() - 1uz);
+    } else if (newline == std::string_view::npos) {
+      paragraph.text.append(tail);
+      Relayout(paragraph);
+    } else {
+      Relayout(paragraph);
+    }
+
+    std::vector<Paragraph> added;
+
+    for (auto next = newline; next != std::string_view::npos;) {
+      const auto start = next + 1uz;
+      next = text.find('\n', start);
+
+      added.emplace_back().text = text.substr(start, next == std::string_view::npos ? std::string_view::npos : next - start);
+    }
+
+    if (!added.empty()) {
+      added.back().text.append(tail);
+
+      for (auto& created: added) {
+        Relayout(created);
+      }
+
+      _paragraphs.insert(_paragraphs.begin() + static_cast<ptrdiff_t>(index + 1uz), std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()));
+    }
+
+    UpdateStarts(index + 1uz);
+  }
+
+  void TextLayout::Erase(const size_t offset, const size_t count) {
+    if (count == 0uz || offset >= _length) {
+      return;
+    }
+
+    const auto end = offset + std::min(count, _length - offset);
+    const auto [first, firstLocal] = Locate(offset);
+    const auto [last, lastLocal] = Locate(end);
+
+    auto& paragraph = _paragraphs[first];
+
+    if (first == last) {
+      paragraph.text.erase(firstLocal, lastLocal - firstLocal);
+    } else {
+      paragraph.text.resize(firstLocal);
+      paragraph.text.append(_paragraphs[last].text, lastLocal);
+      _paragraphs.erase(_paragraphs.begin() + static_cast<ptrdiff_t>(first + 1uz), _paragraphs.begin() + static_cast<ptrdiff_t>(last + 1uz));
+    }
+
+    _length -= end - offset;
+
+    Relayout(_paragraphs[first]);
+    UpdateStarts(first + 1uz);
+  }
+
+  auto TextLayout::GetText() const -> std::string {
+    std::string text;
+    text.reserve(_length);
+
+    for (const auto& paragraph: _paragraphs) {
+      if (&paragraph != &_paragraphs.front()) {
+        text.push_back('\n');
+      }
+
+      text.append(paragraph.text);
+    }
+
+    return text;
+  }
+
+  auto TextLayout::GetLineCount() const -> size_t { return _paragraphs.back().line + _paragraphs.back().lines.size(); }
+
+  auto TextLayout::GetLine(const size_t index) const -> TextLine {
+    if (index >= GetLineCount()) {
+      return TextLine{};
+    }
+
+    const auto [paragraphIndex, lineIndex] = FindLine(index);
+    const auto& paragraph = _paragraphs[paragraphIndex];
+    const auto& line = paragraph.lines[lineIndex];
+
+    const auto byteAt = [&paragraph](const size_t glyph) { return glyph < paragraph.glyphs.size() ? paragraph.glyphs[glyph].byte : paragraph.text.size(); };
+    const auto start = byteAt(line.first);
+
+    return TextLine{
+        .offset = paragraph.byte + start,
+        .length = byteAt(line.last) - start,
+        .y = static_cast<float>(index) * GetLineHeight(),
+        .width = line.width,
+    };
+  }
+
+  auto TextLayout::GetLineHeight() const -> float {
+    if (_font == nullptr || !_font->IsLoaded()) {
+      return _size;
+    }
+
+    return _font->GetLineSkip() * _size / _font->GetBaseSize();
+  }
+
+  auto TextLayout::Measure() const -> SDL_FPoint {
+    auto width = 0.0f;
+
+    for (const auto& paragraph: _paragraphs) {
+      for (const auto& line: paragraph.lines) {
+        width = std::max(width, line.width);
+      }
+    }
+
+    return SDL_FPoint{.x = width, .y = static_cast<float>(GetLineCount()) * GetLineHeight()};
+  }
+
+  auto TextLayout::HitTest(const SDL_FPoint point) const -> size_t {
+    const auto lineHeight = GetLineHeight();
+    const auto count = GetLineCount();
+
+    const auto row = point.y / lineHeight;
+    const auto lineNumber = (row <= 0.0f) ? 0uz : std::min(count - 1uz, static_cast<size_t>(std::min(row, static_cast<float>(count))));
+
+    const auto [paragraphIndex, lineIndex] = FindLine(lineNumber);
+    const auto& paragraph = _paragraphs[paragraphIndex];
+    const auto& line = paragraph.lines[lineIndex];
+    const auto startX = LineStartX(paragraph, line);
+
+    const auto glyphs = std::span{paragraph.glyphs}.subspan(line.first, line.last - line.first);
+    const auto hit = std::ranges::partition_point(glyphs, [&](const LayoutGlyph& glyph) { return glyph.x - startX + (glyph.advance / 2.0f) < point.x; });
+    auto glyph = line.first + static_cast<size_t>(std::distance(glyphs.begin(), hit));
+
+    // Past the end of a wrapped line stays on that line, before the glyph it was broken after.
+    if (glyph == line.last && glyph > line.first && lineIndex + 1uz < paragraph.lines.size()) {
+      --glyph;
+    }
+
+    return paragraph.byte + (glyph < paragraph.glyphs.size() ? paragraph.glyphs[glyph].byte : paragraph.text.size());
+  }
+
+  auto TextLayout::GetCaretRect(const size_t offset) const -> SDL_FRect {
+    const auto [paragraphIndex, local] = Locate(offset);
+    const auto& paragraph = _paragraphs[paragraphIndex];
+
+    const auto glyph = static_cast<size_t>(std::distance(paragraph.glyphs.begin(), std::ranges::partition_point(paragraph.glyphs, [local](const LayoutGlyph& value) { return value.byte < local; })));
+    const auto found = std::ranges::partition_point(paragraph.lines, [glyph](const LayoutLine& value) { return value.last <= glyph; });
+    const auto lineIndex = std::min(static_cast<size_t>(std::distance(paragraph.lines.begin(), found)), paragraph.lines.size() - 1uz);
+    const auto& line = paragraph.lines[lineIndex];
+
+    const auto endX = paragraph.glyphs.empty() ? 0.0f : paragraph.glyphs.back().x + paragraph.glyphs.back().advance;
+    const auto x = (glyph < paragraph.glyphs.size() ? paragraph.glyphs[glyph].x : endX) - LineStartX(paragraph, line);
+    const auto lineHeight = GetLineHeight();
+
+    return SDL_FRect{.x = x, .y = static_cast<float>(paragraph.line + lineIndex) * lineHeight, .w = 1.0f, .h = lineHeight};
+  }
+
+  auto TextLayout::AppendQuads(const SDL_FPoint pos, const SDL_FColor color, VertexBuffer& out, const float top, const float bottom) const -> SdfBucket* {
+    if (_font == nullptr || !_font->IsLoaded()) {
+      return nullptr;
+    }
+
+    auto* bucket = _font->GetBucket(_size);
+
+    if (bucket == nullptr) {
+      return nullptr;
+    }
+
+    const auto lineHeight = GetLineHeight();
+    const auto count = static_cast<float>(GetLineCount());
+    const auto firstLine = static_cast<size_t>(std::clamp(top / lineHeight, 0.0f, count));
+    const auto lastLine = static_cast<size_t>(std::clamp(std::ceil(bottom / lineHeight), 0.0f, count));
+
+    if (firstLine >= lastLine) {
+      return bucket;
+    }
+
+    auto [paragraphIndex, lineIndex] = FindLine(firstLine);
+
+    for (auto lineNumber = firstLine; lineNumber < lastLine; ++paragraphIndex, lineIndex = 0uz) {
+      const auto& paragraph = _paragraphs[paragraphIndex];
+
+      for (; lineIndex < paragraph.lines.size() && lineNumber < lastLine; ++lineIndex, ++lineNumber) {
+        const auto& line = paragraph.lines[lineIndex];
+        const auto startX = LineStartX(paragraph, line);
+        const auto y = pos.y + (static_cast<float>(lineNumber) * lineHeight);
+
+        for (const auto& glyph: std::span{paragraph.glyphs}.subspan(line.first, line.last - line.first)) {
+          if (glyph.glyph != nullptr) {
+            _font->AppendGlyph(*glyph.glyph, SDL_FPoint{.x = pos.x + glyph.x - startX, .y = y}, _size, color, *bucket, out);
+          }
+        }
+      }
+    }
+
+    return bucket;
+  }
+
+  void TextLayout::Shape(Paragraph& paragraph, const size_t byte) const {
+    const auto loaded = _font != nullptr && _font->IsLoaded();
+    const auto scale = loaded ? _size / _font->GetBaseSize() : 0.0f;
+
+    auto x = paragraph.glyphs.empty() ? 0.0f : paragraph.glyphs.back().x + paragraph.glyphs.back().advance;
+    auto previous = paragraph.glyphs.empty() ? 0u : paragraph.glyphs.back().codepoint;
+
+    const char* start = paragraph.text.data();
+    const char* next = start + byte; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto left = paragraph.text.size() - byte;
+
+    while (left > 0uz) {
+      const auto at = static_cast<size_t>(next - start);
+      const auto codepoint = SDL_StepUTF8(&next, &left);
+      const auto* glyph = loaded ? _font->GetGlyph(codepoint) : nullptr;
+
+      if (glyph != nullptr && previous != 0u) {
+        x += _font->GetKerning(previous, codepoint) * scale;
+      }
+
+      const auto advance = (glyph != nullptr) ? glyph->advance * scale : 0.0f;
+
+      paragraph.glyphs.push_back(LayoutGlyph{.glyph = glyph, .codepoint = codepoint, .byte = at, .x = x, .advance = advance});
+
+      x += advance;
+      previous = codepoint;
+    }
+  }
+
+  void TextLayout::Wrap(Paragraph& paragraph, const size_t fromLine) const {
+    const auto& glyphs = paragraph.glyphs;
+    auto& lines = paragraph.lines;
+
+    lines.resize(std::min(fromLine, lines.size()));
+
+    const auto count = glyphs.size();
+    auto first = lines.empty() ? 0uz : lines.back().last;
+
+    if (!lines.empty() && first >= count) {
+      return;
+    }
+
+    // Greedy: break after the last space that fits, or mid-word when a word is wider than the line.
+    do {
+      const auto startX = (first < count) ? glyphs[first].x : 0.0f;
+      auto last = count;
+      auto space = count;
+
+      for (auto i = first; i < count; ++i) {
+        const auto& glyph = glyphs[i];
+        const auto isSpace = IsSpace(glyph.codepoint);
+
+        if (_wrapWidth > 0.0f && i > first && !isSpace && glyph.x + glyph.advance - startX > _wrapWidth) {
+          last = (space < count) ? space + 1uz : i;
+          break;
+        }
+
+        if (isSpace) {
+          space = i;
+        }
+      }
+
+      auto end = last;
+
+      while (end > first && IsSpace(glyphs[end - 1uz].codepoint)) {
+        --end;
+      }
+
+      const auto width = (end > first) ? glyphs[end - 1uz].x + glyphs[end - 1uz].advance - startX : 0.0f;
+
+      lines.push_back(LayoutLine{.first = first, .last = last, .width = width});
+      first = last;
+    } while (first < count);
+  }
+
+  void TextLayout::Relayout(Paragraph& paragraph) const {
+    paragraph.glyphs.clear();
+    paragraph.lines.clear();
+
+    Shape(paragraph, 0uz);
+    Wrap(paragraph, 0uz);
+  }
+
+  void TextLayout::UpdateStarts(const size_t from) {
+    if (from == 0uz) {
+      _paragraphs.front().byte = 0uz;
+      _paragraphs.front().line = 0uz;
+    }
+
+    for (auto i = std::max(from, 1uz); i < _paragraphs.size(); ++i) {
+      const auto& previous = _paragraphs[i - 1uz];
+
+      _paragraphs[i].byte = previous.byte + previous.text.size() + 1uz;
+      _paragraphs[i].line = previous.line + previous.lines.size();
+    }
+  }
+
+  auto TextLayout::Locate(const size_t offset) const -> std::pair<size_t, size_t> {
+    const auto clamped = std::min(offset, _length);
+    const auto found = std::ranges::upper_bound(_paragraphs, clamped, {}, &Paragraph::byte);
+    const auto index = static_cast<size_t>(std::distance(_paragraphs.begin(), found)) - 1uz;
+
+    return std::make_pair(index, std::min(clamped - _paragraphs[index].byte, _paragraphs[index].text.size()));
+  }
+
+  auto TextLayout::FindLine(const size_t line) const -> std::pair<size_t, size_t> {
+    const auto found = std::ranges::upper_bound(_paragraphs, line, {}, &Paragraph::line);
+    const auto index = static_cast<size_t>(std::distance(_paragraphs.begin(), found)) - 1uz;
+
+    return std::make_pair(index, line - _paragraphs[index].line);
+  }
+
+  auto TextLayout::LineStartX(const Paragraph& paragraph, const LayoutLine& line) const -> float {
+    if (line.first < paragraph.glyphs.size()) {
+      return paragraph.glyphs[line.first].x;
+    }
+
+    return paragraph.glyphs.empty() ? 0.0f : paragraph.glyphs.back().x + paragraph.glyphs.back().advance;
+  }
+
+} // namespace swgtk
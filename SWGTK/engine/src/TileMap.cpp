@@ -0,0 +1,202 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/TileMap.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  // The chunk boundary nearest edge, rounded down or up. Clamped in floats so huge views can't overflow.
+  [[nodiscard]] auto ChunkEdge(const float edge, const float chunkSize, const int count, const bool roundUp) -> int {
+    const auto chunks = edge / chunkSize;
+    return static_cast<int>(std::clamp(roundUp ? std::ceil(chunks) : std::floor(chunks), 0.0f, static_cast<float>(count)));
+  }
+} // namespace
+
+namespace swgtk {
+
+  TileMap::TileMap(const int width, const int height, const TileSet& tileset, const bool cached) :
+      _width(std::max(width, 0)),
+      _height(std::max(height, 0)),
+      _chunkColumns((_width + tileChunkSize - 1) / tileChunkSize),
+      _chunkRows((_height + tileChunkSize - 1) / tileChunkSize),
+      _tileset(tileset),
+      _cached(cached),
+      _chunks(static_cast<size_t>(_chunkColumns) * static_cast<size_t>(_chunkRows)) {
+    _tileset.columns = std::max(_tileset.columns, 1);
+  }
+
+  auto TileMap::Set(const int x, const int y, const TileID tile) -> bool {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) {
+      return false;
+    }
+
+    auto& chunk = _chunks[ChunkIndex(x / tileChunkSize, y / tileChunkSize)];
+    auto& cell = chunk.tiles[static_cast<size_t>(((y % tileChunkSize) * tileChunkSize) + (x % tileChunkSize))];
+
+    if (cell == tile) {
+      return true;
+    }
+
+    if (cell == emptyTile) {
+      ++chunk.filled;
+    } else if (tile == emptyTile) {
+      --chunk.filled;
+    }
+
+    cell = tile;
+    ++chunk.version;
+
+    return true;
+  }
+
+  auto TileMap::Get(const int x, const int y) const -> TileID {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) {
+      return emptyTile;
+    }
+
+    const auto& chunk = _chunks[ChunkIndex(x / tileChunkSize, y / tileChunkSize)];
+    return chunk.tiles[static_cast<size_t>(((y % tileChunkSize) * tileChunkSize) + (x % tileChunkSize))];
+  }
+
+  void TileMap::Fill(const SDL_Rect& area, const TileID tile) {
+    const auto left = std::max(area.x, 0);
+    const auto top = std::max(area.y, 0);
+    const auto right = std::min(area.x + area.w, _width);
+    const auto bottom = std::min(area.y + area.h, _height);
+
+    for (auto y = top; y < bottom; ++y) {
+      for (auto x = left; x < right; ++x) {
+        Set(x, y, tile);
+      }
+    }
+  }
+
+  auto TileMap::Load(const std::span<const TileID> tiles) -> bool {
+    if (tiles.size() != static_cast<size_t>(_width) * static_cast<size_t>(_height)) {
+      return false;
+    }
+
+    for (auto y = 0; y < _height; ++y) {
+      for (auto x = 0; x < _width; ++x) {
+        Set(x, y, tiles[(static_cast<size_t>(y) * static_cast<size_t>(_width)) + static_cast<size_t>(x)]);
+      }
+    }
+
+    return true;
+  }
+
+  auto TileMap::GetPixelSize() const -> SDL_FPoint {
+    return SDL_FPoint{.x = static_cast<float>(_width * _tileset.tileWidth), .y = static_cast<float>(_height * _tileset.tileHeight)};
+  }
+
+  auto TileMap::GetChunksInView(const SDL_FRect& view) const -> SDL_Rect {
+    const auto chunkWidth = static_cast<float>(GetChunkPixelWidth());
+    const auto chunkHeight = static_cast<float>(GetChunkPixelHeight());
+
+    if (chunkWidth <= 0.0f || chunkHeight <= 0.0f || view.w <= 0.0f || view.h <= 0.0f) {
+      return SDL_Rect{};
+    }
+
+    const auto left = ChunkEdge(view.x, chunkWidth, _chunkColumns, false);
+    const auto top = ChunkEdge(view.y, chunkHeight, _chunkRows, false);
+    const auto right = ChunkEdge(view.x + view.w, chunkWidth, _chunkColumns, true);
+    const auto bottom = ChunkEdge(view.y + view.h, chunkHeight, _chunkRows, true);
+
+    return SDL_Rect{.x = left, .y = top, .w = right - left, .h = bottom - top};
+  }
+
+  void TileMap::AppendChunk(const int x, const int y, const SDL_FPoint origin, SpriteBatch& out) const {
+    const auto& chunk = GetChunk(x, y);
+
+    if (chunk.filled == 0uz) {
+      return;
+    }
+
+    const auto tileWidth = static_cast<float>(_tileset.tileWidth);
+    const auto tileHeight = static_cast<float>(_tileset.tileHeight);
+
+    for (auto row = 0; row < tileChunkSize; ++row) {
+      for (auto column = 0; column < tileChunkSize; ++column) {
+        const auto tile = chunk.tiles[static_cast<size_t>((row * tileChunkSize) + column)];
+
+        if (tile == emptyTile) {
+          continue;
+        }
+
+        const auto dest = SDL_FRect{
+            .x = origin.x + (static_cast<float>(column) * tileWidth),
+            .y = origin.y + (static_cast<float>(row) * tileHeight),
+            .w = tileWidth,
+            .h = tileHeight,
+        };
+
+        out.Add(_tileset.GetSource(tile), dest);
+      }
+    }
+  }
+
+  void TileMap::MarkDrawn(const int x, const int y) {
+    auto& chunk = GetChunk(x, y);
+    chunk.lastDrawn = _drawCount;
+
+    if (!chunk.cached) {
+      chunk.cached = true;
+      _cachedChunks.push_back(ChunkIndex(x, y));
+    }
+  }
+
+  auto TileMap::EvictChunks() -> size_t {
+    if (_cachedChunks.size() <= _chunkBudget) {
+      return 0uz;
+    }
+
+    // There are only ever about a budget's worth of these, so sorting them is cheap.
+    std::ranges::sort(_cachedChunks, {}, [this](const size_t index) { return _chunks[index].lastDrawn; });
+
+    const auto excess = _cachedChunks.size() - _chunkBudget;
+    auto evicted = 0uz;
+
+    // Chunks on screen now stay, even over budget, or they would be rendered again every frame.
+    while (evicted < excess && _chunks[_cachedChunks[evicted]].lastDrawn != _drawCount) {
+      auto& chunk = _chunks[_cachedChunks[evicted]];
+
+      chunk.texture.DestroyDeferred();
+      chunk.texture = Texture{};
+      chunk.cached = false;
+      ++evicted;
+    }
+
+    _cachedChunks.erase(_cachedChunks.begin(), _cachedChunks.begin() + static_cast<std::ptrdiff_t>(evicted));
+    return evicted;
+  }
+
+  void TileMap::Invalidate() {
+    for (const auto index: _cachedChunks) {
+      ++_chunks[index].version;
+    }
+  }
+
+  void TileMap::Release() {
+    for (const auto index: _cachedChunks) {
+      auto& chunk = _chunks[index];
+
+      chunk.texture.DestroyDeferred();
+      chunk.texture = Texture{};
+      chunk.cached = false;
+    }
+
+    _cachedChunks.clear();
+  }
+
+} // namespace swgtk
@@ -0,0 +1,463 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/Tween.hpp>
+#include <swgtk/Utility.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace {
+  using swgtk::Ease;
+
+  constexpr auto halfPi = std::numbers::pi_v<float> / 2.0f;
+  constexpr auto backOvershoot = 1.70158f;
+  constexpr auto elasticPeriod = (2.0f * std::numbers::pi_v<float>) / 3.0f;
+
+  /*
+    Call visit with the function for ease, so a loop over many values is compiled once per easing with the
+    function inlined, instead of switching on every value.
+  */
+  template<typename Visitor>
+  auto VisitEase(const Ease ease, Visitor&& visit) {
+    switch (ease) {
+      case Ease::QuadIn:
+        return visit([](const float t) { return t * t; });
+      case Ease::QuadOut:
+        return visit([](const float t) { return t * (2.0f - t); });
+      case Ease::QuadInOut:
+        return visit([](const float t) { return t < 0.5f ? 2.0f * t * t : 1.0f - (2.0f * (1.0f - t) * (1.0f - t)); });
+      case Ease::CubicIn:
+        return visit([](const float t) { return t * t * t; });
+      case Ease::CubicOut:
+        return visit([](const float t) { return 1.0f - ((1.0f - t) * (1.0f - t) * (1.0f - t)); });
+      case Ease::CubicInOut:
+        return visit([](const float t) { return t < 0.5f ? 4.0f * t * t * t : 1.0f - (4.0f * (1.0f - t) * (1.0f - t) * (1.0f - t)); });
+      case Ease::SineIn:
+        return visit([](const float t) { return 1.0f - std::cos(t * halfPi); });
+      case Ease::SineOut:
+        return visit([](const float t) { return std::sin(t * halfPi); });
+      case Ease::SineInOut:
+        return visit([](const float t) { return 0.5f * (1.0f - std::cos(t * 2.0f * halfPi)); });
+      case Ease::BackIn:
+        return visit([](const float t) { return t * t * (((backOvershoot + 1.0f) * t) - backOvershoot); });
+      case Ease::BackOut:
+        return visit([](const float t) {
+          const auto u = t - 1.0f;
+          return 1.0f + (u * u * (((backOvershoot + 1.0f) * u) + backOvershoot));
+        });
+      case Ease::ElasticOut:
+        return visit([](const float t) {
+          return t <= 0.0f ? 0.0f : t >= 1.0f ? 1.0f : (std::exp2(-10.0f * t) * std::sin(((10.0f * t) - 0.75f) * elasticPeriod)) + 1.0f;
+        });
+      case Ease::BounceOut:
+        return visit([](float t) {
+          constexpr auto strength = 7.5625f;
+          constexpr auto span = 2.75f;
+
+          if (t < 1.0f / span) {
+            return strength * t * t;
+          }
+
+          if (t < 2.0f / span) {
+            t -= 1.5f / span;
+            return (strength * t * t) + 0.75f;
+          }
+
+          if (t < 2.5f / span) {
+            t -= 2.25f / span;
+            return (strength * t * t) + 0.9375f;
+          }
+
+          t -= 2.625f / span;
+          return (strength * t * t) + 0.984375f;
+        });
+      default:
+        return visit([](const float t) { return t; });
+    }
+  }
+} // namespace
+
+namespace swgtk {
+
+  auto EaseValue(const Ease ease, const float t) -> float {
+    return VisitEase(ease, [t](const auto function) { return function(t); });
+  }
+
+  void EaseValues(const Ease ease, const std::span<float> values) {
+    VisitEase(ease, [values](const auto function) {
+      for (auto& value: values) {
+        value = function(value);
+      }
+    });
+  }
+
+  auto Tweens::To(float& target, const float to, const float seconds, const Ease ease, const float delay) -> TweenID {
+    const auto slot = Make(target, 0.0f, false, to, seconds, ease, delay);
+
+    if (slot == noSlot) {
+      return nullTween;
+    }
+
+    Wait(slot, _slots[slot].delay);
+    return MakeID(slot);
+  }
+
+  auto Tweens::FromTo(float& target, const float from, const float to, const float seconds, const Ease ease, const float delay) -> TweenID {
+    const auto slot = Make(target, from, true, to, seconds, ease, delay);
+
+    if (slot == noSlot) {
+      return nullTween;
+    }
+
+    Wait(slot, _slots[slot].delay);
+    return MakeID(slot);
+  }
+
+  auto Tweens::Then(const TweenID after, float& target, const float to, const float seconds, const Ease ease, const float delay) -> TweenID {
+    const auto leader = Find(after);
+
+    if (leader == noSlot) {
+      return nullTween;
+    }
+
+    const auto slot = Make(target, 0.0f, false, to, seconds, ease, delay);
+
+    if (slot == noSlot) {
+      return nullTween;
+    }
+
+    _slots[slot].leader = leader;
+
+    // Followers start in the order they were queued.
+    auto* link = &_slots[leader].firstFollower;
+
+    while (*link != noSlot) {
+      link = &_slots[*link].nextFollower;
+    }
+
+    *link = slot;
+    return MakeID(slot);
+  }
+
+  auto Tweens::Cancel(const TweenID tween) -> bool {
+    const auto slot = Find(tween);
+
+    if (slot == noSlot) {
+      return false;
+    }
+
+    Detach(slot);
+
+    // Everything queued behind the tween would never start, so it goes too. The list grows as it is walked.
+    _cancelled.clear();
+    _cancelled.push_back(slot);
+
+    for (auto i = 0uz; i < _cancelled.size(); ++i) {
+      const auto current = _cancelled[i];
+
+      for (auto follower = _slots[current].firstFollower; follower != noSlot; follower = _slots[follower].nextFollower) {
+        _cancelled.push_back(follower);
+      }
+
+      Unlink(current);
+    }
+
+    for (const auto current: _cancelled) {
+      Free(current);
+    }
+
+    return true;
+  }
+
+  auto Tweens::IsActive(const TweenID tween) const -> bool { return Find(tween) != noSlot; }
+
+  auto Tweens::GetRunningCount() const -> size_t {
+    auto running = 0uz;
+
+    for (const auto& pool: _pools) {
+      running += pool.Size();
+    }
+
+    return running;
+  }
+
+  void Tweens::Reserve(const size_t tweens) {
+    _slots.reserve(tweens);
+    _freeSlots.reserve(tweens);
+    _waitSlots.reserve(tweens);
+    _waitLeft.reserve(tweens);
+    _finished.reserve(tweens);
+    _overshoot.reserve(tweens);
+    _cancelled.reserve(tweens);
+
+    for (auto& pool: _pools) {
+      pool.elapsed.reserve(tweens);
+      pool.duration.reserve(tweens);
+      pool.from.reserve(tweens);
+      pool.to.reserve(tweens);
+      pool.value.reserve(tweens);
+      pool.target.reserve(tweens);
+      pool.slotOf.reserve(tweens);
+    }
+  }
+
+  void Tweens::Clear() {
+    for (auto slot = 0u; slot < _slots.size(); ++slot) {
+      if (_slots[slot].state != State::Free) {
+        Free(slot);
+      }
+    }
+
+    _waitSlots.clear();
+    _waitLeft.clear();
+
+    for (auto& pool: _pools) {
+      pool.elapsed.clear();
+      pool.duration.clear();
+      pool.from.clear();
+      pool.to.clear();
+      pool.value.clear();
+      pool.target.clear();
+      pool.slotOf.clear();
+    }
+  }
+
+  void Tweens::Update(const float seconds) {
+    _finished.clear();
+    _overshoot.clear();
+
+    for (auto ease = 0uz; ease < _pools.size(); ++ease) {
+      auto& pool = _pools[ease];
+      const auto count = pool.Size();
+
+      if (count == 0uz) {
+        continue;
+      }
+
+      for (auto i = 0uz; i < count; ++i) {
+        pool.elapsed[i] += seconds;
+        pool.value[i] = std::min(pool.elapsed[i] / pool.duration[i], 1.0f);
+      }
+
+      EaseValues(static_cast<Ease>(ease), pool.value);
+
+      for (auto i = 0uz; i < count; ++i) {
+        pool.value[i] = pool.from[i] + ((pool.to[i] - pool.from[i]) * pool.value[i]);
+      }
+
+      for (auto i = 0uz; i < count; ++i) {
+        *pool.target[i] = pool.value[i];
+      }
+
+      for (auto i = 0uz; i < count; ++i) {
+        if (pool.elapsed[i] >= pool.duration[i]) {
+          _finished.push_back(pool.slotOf[i]);
+          _overshoot.push_back(pool.elapsed[i] - pool.duration[i]);
+        }
+      }
+    }
+
+    // Started after the pools, so a tween that starts now doesn't also get this frame's time added.
+    for (auto i = 0uz; i < _waitSlots.size();) {
+      _waitLeft[i] -= seconds;
+
+      if (_waitLeft[i] > 0.0f) {
+        ++i;
+        continue;
+      }
+
+      const auto slot = _waitSlots[i];
+      const auto elapsed = -_waitLeft[i];
+
+      Unlink(slot);
+      Start(slot, elapsed);
+    }
+
+    // Followers that start already finished are added to the end, so chains of short tweens finish in one go.
+    for (auto i = 0uz; i < _finished.size(); ++i) {
+      const auto slot = _finished[i];
+      const auto overshoot = _overshoot[i];
+      auto follower = _slots[slot].firstFollower;
+
+      // Land exactly on the end value, whatever the easing did with the last step.
+      *_slots[slot].target = _slots[slot].to;
+
+      Unlink(slot);
+      Free(slot);
+
+      while (follower != noSlot) {
+        const auto next = _slots[follower].nextFollower;
+
+        _slots[follower].leader = noSlot;
+        _slots[follower].nextFollower = noSlot;
+        Follow(follower, overshoot);
+
+        follower = next;
+      }
+    }
+  }
+
+  auto Tweens::Make(float& target, const float from, const bool hasFrom, const float to, const float seconds, const Ease ease, const float delay) -> uint32_t {
+    uint32_t slot{};
+
+    if (!_freeSlots.empty()) {
+      slot = _freeSlots.back();
+      _freeSlots.pop_back();
+    } else if (_slots.size() < noSlot) {
+      slot = static_cast<uint32_t>(_slots.size());
+      _slots.emplace_back();
+    } else {
+      DEBUG_PRINT("Too many tweens, {} are already active.\n", _active)
+      return noSlot;
+    }
+
+    auto& tween = _slots[slot];
+
+    tween.target = &target;
+    tween.from = from;
+    tween.hasFrom = hasFrom;
+    tween.to = to;
+    tween.duration = std::max(seconds, 0.0f);
+    tween.delay = std::max(delay, 0.0f);
+    tween.ease = ease < Ease::Count ? ease : Ease::Linear;
+    tween.state = State::Queued;
+
+    ++_active;
+    return slot;
+  }
+
+  auto Tweens::Find(const TweenID tween) const -> uint32_t {
+    const auto slot = tween & slotMask;
+
+    if (slot >= _slots.size() || _slots[slot].state == State::Free || _slots[slot].generation != (tween >> slotBits)) {
+      return noSlot;
+    }
+
+    return slot;
+  }
+
+  void Tweens::Wait(const uint32_t slot, const float seconds) {
+    _slots[slot].state = State::Waiting;
+    _slots[slot].dense = static_cast<uint32_t>(_waitSlots.size());
+
+    _waitSlots.push_back(slot);
+    _waitLeft.push_back(seconds);
+  }
+
+  void Tweens::Start(const uint32_t slot, const float elapsed) {
+    auto& tween = _slots[slot];
+    auto& pool = _pools[static_cast<size_t>(tween.ease)];
+
+    if (!tween.hasFrom) {
+      tween.from = *tween.target;
+    }
+
+    tween.state = State::Running;
+    tween.dense = static_cast<uint32_t>(pool.Size());
+
+    pool.elapsed.push_back(elapsed);
+    pool.duration.push_back(tween.duration);
+    pool.from.push_back(tween.from);
+    pool.to.push_back(tween.to);
+    pool.value.push_back(tween.from);
+    pool.target.push_back(tween.target);
+    pool.slotOf.push_back(slot);
+
+    if (elapsed >= tween.duration) {
+      _finished.push_back(slot);
+      _overshoot.push_back(elapsed - tween.duration);
+      return;
+    }
+
+    *tween.target = tween.from + ((tween.to - tween.from) * EaseValue(tween.ease, elapsed / tween.duration));
+  }
+
+  void Tweens::Follow(const uint32_t slot, const float overshoot) {
+    if (const auto left = _slots[slot].delay - overshoot; left > 0.0f) {
+      Wait(slot, left);
+    } else {
+      Start(slot, -left);
+    }
+  }
+
+  void Tweens::Unlink(const uint32_t slot) {
+    const auto index = _slots[slot].dense;
+
+    const auto swapOut = [index](auto& values) {
+      values[index] = values.back();
+      values.pop_back();
+    };
+
+    if (_slots[slot].state == State::Waiting) {
+      swapOut(_waitSlots);
+      swapOut(_waitLeft);
+
+      if (index < _waitSlots.size()) {
+        _slots[_waitSlots[index]].dense = index;
+      }
+    } else if (_slots[slot].state == State::Running) {
+      auto& pool = _pools[static_cast<size_t>(_slots[slot].ease)];
+
+      swapOut(pool.elapsed);
+      swapOut(pool.duration);
+      swapOut(pool.from);
+      swapOut(pool.to);
+      swapOut(pool.value);
+      swapOut(pool.target);
+      swapOut(pool.slotOf);
+
+      if (index < pool.Size()) {
+        _slots[pool.slotOf[index]].dense = index;
+      }
+    }
+
+    _slots[slot].state = State::Queued;
+  }
+
+  void Tweens::Detach(const uint32_t slot) {
+    const auto leader = _slots[slot].leader;
+
+    if (leader == noSlot) {
+      return;
+    }
+
+    auto* link = &_slots[leader].firstFollower;
+
+    while (*link != slot) {
+      link = &_slots[*link].nextFollower;
+    }
+
+    *link = _slots[slot].nextFollower;
+    _slots[slot].nextFollower = noSlot;
+    _slots[slot].leader = noSlot;
+  }
+
+  void Tweens::Free(const uint32_t slot) {
+    auto& tween = _slots[slot];
+
+    tween.state = State::Free;
+    tween.target = nullptr;
+    tween.leader = noSlot;
+    tween.firstFollower = noSlot;
+    tween.nextFollower = noSlot;
+    --_active;
+
+    // A slot whose generation is used up is retired rather than risk an old ID matching again.
+    if (++tween.generation <= (std::numeric_limits<TweenID>::max() >> slotBits)) {
+      _freeSlots.push_back(slot);
+    }
+  }
+
+} // namespace swgtk
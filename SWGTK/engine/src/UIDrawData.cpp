@@ -0,0 +1,142 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/UIDrawData.hpp>
+#include <swgtk/Utility.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+  constexpr auto byteToFloat = 1.0f / 255.0f;
+
+  [[nodiscard]] auto ToClip(const swgtk::UIClipRect& clip) -> SDL_Rect {
+    const auto left = static_cast<int>(std::floor(clip.x1));
+    const auto top = static_cast<int>(std::floor(clip.y1));
+
+    return SDL_Rect{
+        .x = left,
+        .y = top,
+        .w = static_cast<int>(std::ceil(clip.x2)) - left,
+        .h = static_cast<int>(std::ceil(clip.y2)) - top,
+    };
+  }
+
+  [[nodiscard]] auto ToColor(const uint32_t color) -> SDL_FColor {
+    return SDL_FColor{
+        .r = static_cast<float>(color & 0xFFu) * byteToFloat,
+        .g = static_cast<float>((color >> 8u) & 0xFFu) * byteToFloat,
+        .b = static_cast<float>((color >> 16u) & 0xFFu) * byteToFloat,
+        .a = static_cast<float>(color >> 24u) * byteToFloat,
+    };
+  }
+} // namespace
+
+namespace swgtk {
+
+  void UIDrawData::Clear() {
+    _vertices.clear();
+    _indices.clear();
+    _batches.clear();
+    _commandCount = 0uz;
+  }
+
+  auto UIDrawData::AddList(const std::span<const UIVertex> vertices, const std::span<const uint16_t> indices,
+                           const std::span<const UIDrawCommand> commands) -> bool {
+    return Add(vertices, indices, commands);
+  }
+
+  auto UIDrawData::AddList(const std::span<const UIVertex> vertices, const std::span<const uint32_t> indices,
+                           const std::span<const UIDrawCommand> commands) -> bool {
+    return Add(vertices, indices, commands);
+  }
+
+  template<typename Index>
+  auto UIDrawData::Add(const std::span<const UIVertex> vertices, const std::span<const Index> indices,
+                       const std::span<const UIDrawCommand> commands) -> bool {
+    const auto base = _vertices.size();
+
+    // SDL_RenderGeometry() takes int indices, so the whole frame has to stay addressable with them.
+    if (base + vertices.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+      DEBUG_PRINT("UI frame has too many vertices to add {} more.\n", vertices.size())
+      return false;
+    }
+
+    // Check every command first, so a bad list leaves the frame as it was.
+    for (const auto& command: commands) {
+      if (static_cast<size_t>(command.indexOffset) + command.elementCount > indices.size() || command.vertexOffset > vertices.size()) {
+        DEBUG_PRINT("UI draw command reaches past its list's {} indices.\n", indices.size())
+        return false;
+      }
+    }
+
+    // Enough to undo this list if one of its indices turns out to be bad.
+    const auto firstIndex = _indices.size();
+    const auto firstBatch = _batches.size();
+    const auto lastBatchCount = _batches.empty() ? 0uz : _batches.back().indexCount;
+    const auto commandCount = _commandCount;
+
+    for (const auto& command: commands) {
+      const auto clip = ToClip(command.clip);
+
+      if (command.elementCount == 0u || clip.w <= 0 || clip.h <= 0) {
+        continue;
+      }
+
+      const auto listBase = base + command.vertexOffset;
+      const auto limit = vertices.size() - command.vertexOffset;
+      const auto start = _indices.size();
+      auto highest = size_t{0};
+
+      for (auto i = 0uz; i < command.elementCount; ++i) {
+        const auto index = static_cast<size_t>(indices[command.indexOffset + i]);
+
+        highest = std::max(highest, index);
+        _indices.push_back(static_cast<int>(listBase + index));
+      }
+
+      if (highest >= limit) {
+        DEBUG_PRINT("UI draw command uses vertex {}, past the end of its list.\n", highest)
+
+        _indices.resize(firstIndex);
+        _batches.resize(firstBatch);
+        _commandCount = commandCount;
+
+        if (!_batches.empty()) {
+          _batches.back().indexCount = lastBatchCount;
+        }
+
+        return false;
+      }
+
+      ++_commandCount;
+
+      // Indices go in the order of the commands, so a matching batch before this one always ends where these start.
+      if (!_batches.empty()) {
+        if (auto& last = _batches.back(); last.texture == command.texture && SDL_RectsEqual(&last.clip, &clip)) {
+          last.indexCount += command.elementCount;
+          continue;
+        }
+      }
+
+      _batches.push_back(UIBatch{.texture = command.texture, .clip = clip, .firstIndex = start, .indexCount = command.elementCount});
+    }
+
+    for (const auto& vertex: vertices) {
+      _vertices.push_back(SDL_Vertex{.position = vertex.position, .color = ToColor(vertex.color), .tex_coord = vertex.uv});
+    }
+
+    return true;
+  }
+
+} // namespace swgtk
@@ -0,0 +1,45 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <cstdio>
+#include <span>
+#include <swgtk/LuaBytecode.hpp>
+
+/*
+  Build step for LuaBytecodeCache.
+
+  Usage: swgtk_luac <cache directory> <script>...
+
+  Every script is compiled and stored under the same name the runtime cache looks for.
+  The exit code is non-zero if any script fails to compile.
+*/
+auto main(const int argc, char** argv) -> int {
+  const auto args = std::span{argv, static_cast<size_t>(argc)};
+
+  if (args.size() < 2uz) {
+    std::fputs("Usage: swgtk_luac <cache directory> <script>...\n", stderr);
+    return 1;
+  }
+
+  auto lua = sol::state{};
+  auto cache = swgtk::LuaBytecodeCache{args[1]};
+  auto failed = false;
+
+  for (const auto* script: args.subspan(2uz)) {
+    if (!cache.Precompile(lua.lua_state(), script)) {
+      std::fprintf(stderr, "swgtk_luac: failed to compile %s\n", script); // NOLINT(*-vararg)
+      failed = true;
+    }
+  }
+
+  return failed ? 1 : 0;
+}
@@ -4,5 +4,8 @@ option(SWGTK_BUILD_EXAMPLES "Include the example programs." ON)
 option(SWGTK_NO_CCACHE "Disable ccache support." OFF)
 option(SWGTK_INSTALL_FREETYPE "Build the Freetype font library from source." OFF)
 option(SWGTK_LUA_BINDINGS "Enable Lua scripting support via sol3." ON)
+option(SWGTK_LUA_BYTECODE "Precompile Lua scripts and cache their bytecode." ON)
 option(SWGTK_BUILD_TESTS "Build the unit tests." ON)
 option(SWGTK_EXCEPTIONS "Build with exceptions enabled." OFF)
+option(SWGTK_OGG_VORBIS "Stream .ogg music with stb_vorbis." ON)
+option(SWGTK_MEMORY_TRACKING "Count SWGTK, SDL and Lua allocations per frame." OFF)
@@ -0,0 +1,45 @@
+# Compile a file into a target as a byte array, so nothing has to be found on disk at run time.
+#
+# swgtk_embed_file(<target> <file> <symbol>) generates a source file defining
+#
+#   namespace swgtk::embedded {
+#     extern const unsigned char <symbol>[];
+#     extern const size_t <symbol>Size;
+#   }
+#
+# and adds it to the target's private sources. C++23 has no #embed, so the array is written out at
+# configure time instead. The file is a configure dependency, so editing it regenerates the array.
+function(swgtk_embed_file TARGET INPUT SYMBOL)
+  set(OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/embedded/${SYMBOL}.cpp)
+
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${INPUT})
+
+  file(READ ${INPUT} EMBED_HEX HEX)
+  file(SIZE ${INPUT} EMBED_SIZE)
+
+  # Sixteen bytes to a line keeps the generated file readable in a debugger.
+  string(REPEAT "[0-9a-f][0-9a-f]" 16 EMBED_LINE)
+  string(REGEX REPLACE "(${EMBED_LINE})" "\\1\n    " EMBED_HEX "${EMBED_HEX}")
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," EMBED_BYTES "${EMBED_HEX}")
+
+  # file(CONFIGURE) leaves the output alone when nothing changed, so the array isn't recompiled every configure.
+  file(CONFIGURE OUTPUT ${OUTPUT} @ONLY CONTENT [=[
+// Generated from @INPUT@ by swgtk_embed_file(). Do not edit.
+#include <cstddef>
+
+// NOLINTBEGIN
+namespace swgtk::embedded {
+  extern const unsigned char @SYMBOL@[];
+  extern const size_t @SYMBOL@Size;
+
+  alignas(16) const unsigned char @SYMBOL@[] = {
+    @EMBED_BYTES@
+  };
+
+  const size_t @SYMBOL@Size = @EMBED_SIZE@;
+} // namespace swgtk::embedded
+// NOLINTEND
+]=])
+
+  target_sources(${TARGET} PRIVATE ${OUTPUT})
+endfunction()
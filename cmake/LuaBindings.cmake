@@ -9,6 +9,9 @@ endif()
 
 target_compile_features(swgtk_lua PRIVATE cxx_std_23)
 
+# Lua.cpp includes App.hpp, so it has to see the same Lua-only members as the rest of the engine.
+target_compile_definitions(swgtk_lua PUBLIC SWGTK_BUILD_WITH_LUA="1")
+
 if(NOT EMSCRIPTEN)
   target_compile_definitions(
     swgtk_lua PUBLIC
@@ -24,6 +27,19 @@ else()
   )
 endif()
 
+if(${SWGTK_MEMORY_TRACKING} MATCHES ON)
+  target_compile_definitions(swgtk_lua PRIVATE SWGTK_TRACK_MEMORY="1")
+endif()
+
+# Emscripten builds cannot run the compiler on the host, so they always load scripts from source.
+if(${SWGTK_LUA_BYTECODE} MATCHES ON AND NOT EMSCRIPTEN)
+  # Only the directory's name is compiled in. swgtk::LuaCacheDirectory() finds it next to the executable at runtime.
+  set(SWGTK_LUA_CACHE_DIR luac CACHE INTERNAL "Name of the directory for precompiled Lua bytecode.")
+  target_compile_definitions(swgtk_lua PUBLIC SWGTK_LUA_CACHE_DIR="${SWGTK_LUA_CACHE_DIR}")
+else()
+  unset(SWGTK_LUA_CACHE_DIR CACHE)
+endif()
+
 if(${CMAKE_BUILD_TYPE} MATCHES "Debug")
   target_compile_definitions(swgtk_lua PRIVATE _DEBUG)
 endif()
@@ -51,9 +67,19 @@ target_sources(
 
   PUBLIC
   ${SWGTK_SOURCE_DIR}/SWGTK/engine/include/swgtk/Lua.hpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/include/swgtk/LuaBytecode.hpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/include/swgtk/LuaCloseGuard.hpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/include/swgtk/LuaGC.hpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/include/swgtk/LuaProfiler.hpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/include/swgtk/LuaScheduler.hpp
 
   PRIVATE
   ${SWGTK_SOURCE_DIR}/SWGTK/engine/src/Lua.cpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/src/LuaBytecode.cpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/src/LuaCloseGuard.cpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/src/LuaGC.cpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/src/LuaProfiler.cpp
+  ${SWGTK_SOURCE_DIR}/SWGTK/engine/src/LuaScheduler.cpp
 )
 
 target_link_libraries(
@@ -65,4 +91,54 @@ target_link_libraries(
   SDL3_ttf::SDL3_ttf
   lua
   sol2
-)
\ No newline at end of file
+)
+# Build step for the Lua bytecode cache. It only needs Lua, so it does not pull in SDL.
+if(DEFINED SWGTK_LUA_CACHE_DIR)
+  add_executable(swgtk_luac)
+
+  target_compile_options(swgtk_luac PRIVATE ${CompilerFlags})
+  target_link_options(swgtk_luac PRIVATE ${LinkerFlags})
+  target_compile_features(swgtk_luac PRIVATE cxx_std_23)
+
+  target_include_directories(swgtk_luac PRIVATE ${SWGTK_SOURCE_DIR}/SWGTK/engine/include)
+
+  target_sources(
+    swgtk_luac
+
+    PRIVATE
+    ${SWGTK_SOURCE_DIR}/SWGTK/tools/LuaCompile.cpp
+    ${SWGTK_SOURCE_DIR}/SWGTK/engine/src/LuaBytecode.cpp
+  )
+
+  target_link_libraries(swgtk_luac PRIVATE lua sol2)
+endif()
+
+#[[
+  swgtk_precompile_lua(<target> SCRIPTS <file>...)
+
+  Compile Lua scripts, and the engine's own swgtk.lua, into the bytecode cache whenever they change, before
+  the executable <target> is built. The cache goes in a luac directory next to the executable, where
+  swgtk::LuaCacheDirectory() looks for it; load scripts through a swgtk::LuaBytecodeCache made with that.
+  Does nothing when the cache is disabled, and scripts then load from source as usual.
+]]
+function(swgtk_precompile_lua TARGET)
+  cmake_parse_arguments(PARSE_ARGV 1 SWGTK_LUAC "" "" "SCRIPTS")
+
+  if(NOT DEFINED SWGTK_LUA_CACHE_DIR OR NOT SWGTK_LUAC_SCRIPTS)
+    return()
+  endif()
+
+  set(stamp ${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_luac.stamp)
+
+  add_custom_command(
+    OUTPUT ${stamp}
+    COMMAND swgtk_luac $<TARGET_FILE_DIR:${TARGET}>/${SWGTK_LUA_CACHE_DIR} ${SWGTK_ENGINE_INTERNALS}/swgtk.lua ${SWGTK_LUAC_SCRIPTS}
+    COMMAND ${CMAKE_COMMAND} -E touch ${stamp}
+    DEPENDS swgtk_luac ${SWGTK_ENGINE_INTERNALS}/swgtk.lua ${SWGTK_LUAC_SCRIPTS}
+    COMMENT "Compiling Lua bytecode for ${TARGET}"
+    VERBATIM
+  )
+
+  add_custom_target(${TARGET}_luac DEPENDS ${stamp})
+  add_dependencies(${TARGET} ${TARGET}_luac)
+endfunction()
@@ -0,0 +1,52 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <swgtk/App.hpp>
+#include <swgtk/Lua.hpp>
+#include <swgtk/LuaBytecode.hpp>
+#include <swgtk/SDLHW2D.hpp>
+
+/*
+  Runs scripts/sprite_batch_bench.lua, which drives its own frame loop through the Lua bindings.
+  An optional first argument replaces the script path.
+*/
+auto main(const int argc, const char **argv) -> int {
+  constexpr auto windowWidth = 800;
+  constexpr auto windowHeight = 600;
+
+  auto app = swgtk::App{};
+
+  if (!app.InitGraphics("Lua Sprite Batch.", windowWidth, windowHeight, swgtk::SDLHW2D::Create())) {
+    return 1;
+  }
+
+  auto lua = sol::state{};
+  swgtk::InitLua(&app, lua, swgtk::LuaPrivledges::All);
+
+  if (const auto renderer = app.Renderer().lock(); renderer != nullptr) {
+    renderer->InitLua(&lua);
+  }
+
+  const auto *script = (argc > 1) ? argv[1] : SWGTK_SPRITE_BATCH_SCRIPT; // NOLINT(*-pointer-arithmetic)
+
+#ifdef SWGTK_LUA_CACHE_DIR
+  return app.GetLuaCache()->RunFile(lua, script) ? 0 : 1;
+#else
+  if (const auto result = lua.safe_script_file(script, sol::script_pass_on_error); !result.valid()) {
+    [[maybe_unused]] const sol::error error = result;
+    DEBUG_PRINT("Lua script failed: {}\n", error.what())
+    return 1;
+  }
+
+  return 0;
+#endif
+}
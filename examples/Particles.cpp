@@ -14,6 +14,9 @@
 #include <algorithm>
 #include <cmath>
 #include <format>
+#include <iterator>
+#include <memory_resource>
+#include <string>
 #include <swgtk/App.hpp>
 #include <swgtk/Math.hpp>
 
@@ -30,7 +33,7 @@ namespace swgtk {
 
     _child = std::make_shared<TimeToFramesScene>(_scene->GetRootNode<ParticlesTest>());
 
-    _mouse.texture = _render->CreateRenderableTexture(particleSize, particleSize);
+    _mouse.texture = UniqueTexture{_render->CreateRenderableTexture(particleSize, particleSize)};
 
     if (!_render->SetDrawTarget(_mouse.texture)) {
       return false;
@@ -119,8 +122,22 @@ namespace swgtk {
 
   auto TimeToFramesScene::Update([[maybe_unused]] const float deltaTime) -> bool {
     const auto p = GetParent<ParticlesTest>().lock();
-    p->Draw()->DrawPlainText(std::format("Time between frames: {}", p->GetAverageTime()),
-                             SDL_FRect{.x = 5.f, .y = 10.f, .w = 400.f, .h = 40.f}); // NOLINT
+
+    // Format into frame memory so the overlay does not touch the heap every frame.
+    auto text = std::pmr::string{_scene->GetApp()->GetFrameArena()};
+    std::format_to(std::back_inserter(text), "Time between frames: {}", p->GetAverageTime());
+
+    p->Draw()->DrawPlainText(text, SDL_FRect{.x = 5.f, .y = 10.f, .w = 400.f, .h = 40.f}); // NOLINT
+
+#ifdef SWGTK_TRACK_MEMORY
+    const auto memory = MemoryTracker::GetTotalFrameStats();
+
+    text.clear();
+    std::format_to(std::back_inserter(text), "Allocations: {} ({} bytes), resident: {} KB, peak: {} KB",
+                   memory.allocations, memory.bytesAllocated, memory.residentBytes / 1024uz, memory.peakResidentBytes / 1024uz); // NOLINT
+
+    p->Draw()->DrawPlainText(text, SDL_FRect{.x = 5.f, .y = 50.f, .w = 600.f, .h = 40.f}); // NOLINT
+#endif
 
     return true;
   }
@@ -26,7 +26,7 @@ namespace swgtk {
 
   struct MouseCursor {
     SDL_FPoint pos{};
-    Texture texture;
+    UniqueTexture texture;
   };
 
   struct Particle {
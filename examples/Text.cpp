@@ -22,11 +22,13 @@ namespace swgtk {
     _app = _scene->GetApp();
     _render = _scene->AppRenderer<SDLHW2D>();
 
-    _mouse.texture = _render->LoadPlainWrapText("Hello\nWorld!", 0, SDL_Color{colorDefault, 0u, 0u, colorDefault});
+    _mouse.texture = UniqueTexture{_render->LoadPlainWrapText("Hello\nWorld!", 0, SDL_Color{colorDefault, 0u, 0u, colorDefault})};
+
+    _sdf.Load(_app->GetDefaultFont().ptr);
 
     FontGroup::SetFontStyle(_app->GetDefaultFont(), FontStyle::Underlined);
 
-    _background = _render->LoadLCDWrapText("EAT!\nSLEEP!\nCODE!");
+    _background = UniqueTexture{_render->LoadLCDWrapText("EAT!\nSLEEP!\nCODE!")};
 
     return true;
   }
@@ -51,6 +53,15 @@ namespace swgtk {
 
     _render->DrawTexture(_background);
 
+    // One distance field atlas, drawn at a few sizes. Each size is resampled into its own bucket, so a size
+    // swept every frame would go through more buckets than the font keeps and resample them all the time.
+    auto textY = 370.0f;
+
+    for (const auto size : {16.0f, 24.0f, 40.0f, 64.0f}) {
+      _render->DrawSdfText(_sdf, "Scalable SDF text", SDL_FPoint{.x = 20.0f, .y = textY}, size, SDL_FColor{.r = 0.4f, .g = 0.8f, .b = 1.0f, .a = 1.0f});
+      textY += size + 4.0f;
+    }
+
     // Rotating in SDL3 is in degrees...
     _render->DrawTexture(_mouse.texture, std::nullopt, rect, RadiansToDegrees(_mouse.angle).value());
 
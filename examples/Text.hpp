@@ -21,7 +21,7 @@ namespace swgtk {
 
   struct MouseCursor {
     SDL_FPoint pos{};
-    Texture texture;
+    UniqueTexture texture;
     Rads angle{};
   };
 
@@ -35,7 +35,8 @@ namespace swgtk {
 
   private:
     MouseCursor _mouse{};
-    Texture _background;
+    UniqueTexture _background;
+    SdfFont _sdf;
     ObjectRef<App> _app;
     ObjectRef<SDLHW2D> _render;
   };
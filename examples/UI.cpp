@@ -0,0 +1,154 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <UI.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <swgtk/App.hpp>
+#include <swgtk/Timer.hpp>
+
+static constexpr auto widgetsPerWindow = 120;
+static constexpr auto windowWidth = 180.0f;
+static constexpr auto windowHeight = 220.0f;
+static constexpr auto rowHeight = 14.0f;
+
+namespace swgtk {
+
+  void UIDemoList::AddQuad(const SDL_FRect& rect, const uint32_t color, const Texture texture, const UIClipRect& clip) {
+    const auto base = static_cast<uint16_t>(vertices.size());
+    const auto first = static_cast<uint32_t>(indices.size());
+
+    vertices.push_back(UIVertex{.position = {.x = rect.x, .y = rect.y}, .uv = {.x = 0.0f, .y = 0.0f}, .color = color});
+    vertices.push_back(UIVertex{.position = {.x = rect.x + rect.w, .y = rect.y}, .uv = {.x = 1.0f, .y = 0.0f}, .color = color});
+    vertices.push_back(UIVertex{.position = {.x = rect.x + rect.w, .y = rect.y + rect.h}, .uv = {.x = 1.0f, .y = 1.0f}, .color = color});
+    vertices.push_back(UIVertex{.position = {.x = rect.x, .y = rect.y + rect.h}, .uv = {.x = 0.0f, .y = 1.0f}, .color = color});
+
+    for (const auto corner: {0, 1, 2, 0, 2, 3}) {
+      indices.push_back(static_cast<uint16_t>(base + corner));
+    }
+
+    commands.push_back(UIDrawCommand{.clip = clip, .texture = texture, .indexOffset = first, .elementCount = 6u});
+  }
+
+  auto UITest::Create() -> bool {
+    _app = _scene->GetApp();
+    _render = _scene->AppRenderer<SDLHW2D>();
+
+    _label = UniqueTexture{_render->LoadBlendedText("Label")};
+
+    return _label.IsValid();
+  }
+
+  void UITest::BuildWindow(UIDemoList& list, const int window) const {
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers) - Reason: It's pointless to create constants for a demo layout.
+
+    const auto column = static_cast<float>(window % 6);
+    const auto row = static_cast<float>(window / 6);
+    const auto drift = std::sin(_time + static_cast<float>(window)) * 10.0f;
+
+    const auto frame = SDL_FRect{.x = 10.0f + (column * 130.0f) + drift, .y = 10.0f + (row * 150.0f), .w = windowWidth, .h = windowHeight};
+    const auto body = UIClipRect{.x1 = frame.x + 4.0f, .y1 = frame.y + 20.0f, .x2 = frame.x + frame.w - 4.0f, .y2 = frame.y + frame.h - 4.0f};
+    const auto whole = UIClipRect{.x1 = frame.x, .y1 = frame.y, .x2 = frame.x + frame.w, .y2 = frame.y + frame.h};
+
+    list.Clear();
+    list.AddQuad(frame, 0xF0302020u, Texture{}, whole);
+    list.AddQuad(SDL_FRect{.x = frame.x, .y = frame.y, .w = frame.w, .h = 18.0f}, 0xFF804020u, Texture{}, whole);
+
+    // Rows of a button and a label, scrolling, so some are clipped by the body and some fall outside it. The
+    // buttons go in before the labels, like a draw list split into channels, so each kind merges into one batch.
+    const auto scroll = std::fmod(_time * 20.0f, rowHeight * 4.0f);
+    const auto rows = widgetsPerWindow / 2;
+
+    for (auto widget = 0; widget < rows; ++widget) {
+      const auto y = body.y1 + (static_cast<float>(widget) * rowHeight) - scroll;
+      list.AddQuad(SDL_FRect{.x = body.x1, .y = y, .w = 60.0f, .h = rowHeight - 2.0f}, 0xFF606060u, Texture{}, body);
+    }
+
+    for (auto widget = 0; widget < rows; ++widget) {
+      const auto y = body.y1 + (static_cast<float>(widget) * rowHeight) - scroll;
+      list.AddQuad(SDL_FRect{.x = body.x1 + 64.0f, .y = y, .w = 50.0f, .h = rowHeight - 2.0f}, 0xFFFFFFFFu, _label, body);
+    }
+
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+  }
+
+  auto UITest::Update(const float dt) -> bool {
+    constexpr auto maxWindows = 60;
+
+    _time += dt;
+
+    if (_app->IsKeyPressed(LayoutCode::Up)) {
+      _windows = std::min(_windows + 6, maxWindows);
+    } else if (_app->IsKeyPressed(LayoutCode::Down)) {
+      _windows = std::max(_windows - 6, 1);
+    }
+
+    _lists.resize(static_cast<size_t>(_windows));
+
+    Timer timer;
+
+    // What a UI library's backend does each frame: take the finished draw lists and convert them.
+    _drawData.Clear();
+
+    for (auto window = 0; window < _windows; ++window) {
+      auto& list = _lists[static_cast<size_t>(window)];
+
+      BuildWindow(list, window);
+      _drawData.AddList(list.vertices, list.indices, list.commands);
+    }
+
+    const auto buildTime = timer.GetElapsedMilliseconds();
+    timer.UpdateTime();
+
+    _render->BufferClear();
+    _render->DrawUI(_drawData);
+
+    const auto drawTime = timer.GetElapsedMilliseconds();
+
+    _buildTotal += buildTime;
+    _drawTotal += drawTime;
+
+    if (++_frames == 60u) {
+      _buildAverage = _buildTotal / _frames;
+      _drawAverage = _drawTotal / _frames;
+      _buildTotal = 0.0;
+      _drawTotal = 0.0;
+      _frames = 0u;
+
+      std::puts(std::format("{} windows, {} commands in {} draw calls: build and convert {:.3f} ms, draw {:.3f} ms",
+                            _windows, _drawData.GetCommandCount(), _drawData.Batches().size(), _buildAverage, _drawAverage).c_str());
+    }
+
+    auto text = std::pmr::string{_app->GetFrameArena()};
+    std::format_to(std::back_inserter(text), "{} commands, {} draw calls, build {:.3f} ms, draw {:.3f} ms (Up/Down: windows)",
+                   _drawData.GetCommandCount(), _drawData.Batches().size(), _buildAverage, _drawAverage);
+
+    _render->DrawPlainText(text, SDL_FRect{.x = 5.f, .y = 575.f, .w = 790.f, .h = 20.f}); // NOLINT
+
+    return true;
+  }
+
+} // namespace swgtk
+
+auto main([[maybe_unused]] int argc, [[maybe_unused]] const char **argv) -> int {
+  constexpr auto w = 800;
+  constexpr auto h = 600;
+
+  if (swgtk::App app; app.InitGraphics("UI Test", w, h, swgtk::SDLHW2D::Create())) {
+    app.RunGame<swgtk::UITest>();
+  }
+}
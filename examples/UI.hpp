@@ -0,0 +1,74 @@
+/*
+    MIT License
+    Copyright (c) 2023 Samuel Bridgham
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#ifndef SWGTK_TESTS_TEST_CPP_UI_HPP_
+#define SWGTK_TESTS_TEST_CPP_UI_HPP_
+
+#include <cstdint>
+#include <swgtk/SDLHW2D.hpp>
+#include <swgtk/Scene.hpp>
+#include <swgtk/UIDrawData.hpp>
+#include <vector>
+
+namespace swgtk {
+
+  // One window's worth of output, in the shape a Dear ImGui draw list has.
+  struct UIDemoList {
+    std::vector<UIVertex> vertices;
+    std::vector<uint16_t> indices;
+    std::vector<UIDrawCommand> commands;
+
+    void Clear() {
+      vertices.clear();
+      indices.clear();
+      commands.clear();
+    }
+
+    // A quad with its own command, like a clipped widget.
+    void AddQuad(const SDL_FRect& rect, uint32_t color, Texture texture, const UIClipRect& clip);
+  };
+
+  /*
+    Draws a busy UI through UIDrawData and SDLHW2D::DrawUI(), and shows what it costs each frame.
+    Up and Down change the number of windows.
+  */
+  class UITest final : public Scene::Node {
+  public:
+    explicit UITest(const ObjectRef<Scene> &scene) :
+        Node(scene) {}
+
+    auto Create() -> bool override;
+    auto Update(float dt) -> bool override;
+
+  private:
+    void BuildWindow(UIDemoList& list, int window) const;
+
+    ObjectRef<App> _app;
+    ObjectRef<SDLHW2D> _render;
+    UniqueTexture _label;
+
+    std::vector<UIDemoList> _lists;
+    UIDrawData _drawData;
+    int _windows = 24;
+    float _time = 0.0f;
+
+    // Averages over the last second, in milliseconds.
+    uint32_t _frames = 0u;
+    double _buildTotal = 0.0;
+    double _drawTotal = 0.0;
+    double _buildAverage = 0.0;
+    double _drawAverage = 0.0;
+  };
+
+} // namespace swgtk
+
+#endif // SWGTK_TESTS_TEST_CPP_UI_HPP_
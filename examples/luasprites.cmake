@@ -0,0 +1,81 @@
+add_executable(LuaSpritesSample)
+
+target_compile_options(LuaSpritesSample PRIVATE ${CompilerFlags})
+target_link_options(LuaSpritesSample PRIVATE ${LinkerFlags})
+
+target_compile_features(LuaSpritesSample PRIVATE cxx_std_23)
+
+if(${CMAKE_BUILD_TYPE} MATCHES "Debug")
+  target_compile_definitions(LuaSpritesSample PRIVATE _DEBUG)
+endif()
+
+if(EMSCRIPTEN)
+  target_compile_definitions(LuaSpritesSample PRIVATE SWGTK_SPRITE_BATCH_SCRIPT="scripts/sprite_batch_bench.lua")
+else()
+  target_compile_definitions(LuaSpritesSample PRIVATE SWGTK_SPRITE_BATCH_SCRIPT="${CMAKE_CURRENT_LIST_DIR}/scripts/sprite_batch_bench.lua")
+endif()
+
+if(CLANG_TIDY_PROGRAM)
+
+  set_property(TARGET LuaSpritesSample PROPERTY CXX_CLANG_TIDY ${CLANG_TIDY_PROGRAM})
+
+endif()
+
+if(CPPCHECK_PROGRAM)
+
+  set_target_properties(LuaSpritesSample PROPERTIES CXX_CPPCHECK ${CPPCHECK_PROGRAM})
+
+endif()
+
+target_include_directories(
+  LuaSpritesSample
+
+  PUBLIC
+
+  ${SWGTK_ROOT_DIRECTORY}/engine/include
+  ${CMAKE_CURRENT_LIST_DIR}
+  ${lua_SOURCE_DIR}
+)
+
+target_link_libraries(
+  LuaSpritesSample
+
+  PRIVATE
+
+  swgtk
+  swgtk::SDLHW2D
+)
+
+target_sources(
+  LuaSpritesSample
+
+  PRIVATE
+
+  ${CMAKE_CURRENT_LIST_DIR}/LuaSprites.cpp
+)
+
+swgtk_precompile_lua(LuaSpritesSample SCRIPTS ${CMAKE_CURRENT_LIST_DIR}/scripts/sprite_batch_bench.lua)
+if(NOT EMSCRIPTEN)
+  if(WIN32) # Windows
+    add_custom_command(
+      TARGET LuaSpritesSample POST_BUILD
+      COMMAND ${CMAKE_COMMAND} -E copy -t $<TARGET_FILE_DIR:LuaSpritesSample> $<TARGET_RUNTIME_DLLS:LuaSpritesSample>
+      COMMAND_EXPAND_LISTS
+    )
+  else() # Unix-based systems
+    add_custom_command(
+      TARGET LuaSpritesSample POST_BUILD
+      COMMAND ${CMAKE_COMMAND} -E copy -t $<TARGET_FILE_DIR:LuaSpritesSample>
+      ${SWGTK_SHARED_LIBARIES}
+      COMMAND_EXPAND_LISTS
+    )
+  endif()
+else()
+  target_link_libraries(
+    LuaSpritesSample PRIVATE
+    "--embed-file assets/swgtk.lua"
+    "--embed-file ${CMAKE_CURRENT_LIST_DIR}/scripts/sprite_batch_bench.lua@scripts/sprite_batch_bench.lua"
+  )
+
+  target_link_options(LuaSpritesSample PRIVATE "-s" "ALLOW_MEMORY_GROWTH=1")
+endif()
\ No newline at end of file
@@ -69,7 +69,6 @@ if(NOT EMSCRIPTEN)
 else()
   target_link_libraries(
     ParticlesSample PRIVATE
-    "--embed-file assets/Natural_Mono-Regular.ttf"
     "--embed-file assets/swgtk.lua"
   )
 
@@ -0,0 +1,102 @@
+-- Compares drawing sprites one call at a time against submitting them through a SpriteBatch.
+-- Press Space to switch modes. The average frame time of each mode is printed every 120 frames.
+-- Press P to start the Lua profiler and again to stop it and write sprite_batch_bench.folded.
+
+local spriteCount = 10000
+local spriteSize = 4
+local framesToAverage = 120
+
+local app = swgtk.App
+local render = swgtk.Render
+
+local width, height = app:GetWindowSize()
+
+local texture = render:CreateRenderableTexture(spriteSize, spriteSize)
+render:SetDrawTarget(texture)
+render:BufferClear(swgtk.Colorf.new(0.7, 0.0, 0.0, 1.0))
+render:SetDrawTarget(swgtk.Texture.new())
+
+local xs, ys, angles = {}, {}, {}
+
+for i = 1, spriteCount do
+  xs[i] = math.random() * width
+  ys[i] = math.random() * height
+  angles[i] = math.random() * 360.0
+end
+
+local batch = swgtk.SpriteBatch.new(texture, spriteCount)
+local dest = swgtk.Rectf.new()
+dest.w = spriteSize
+dest.h = spriteSize
+
+local black = swgtk.Colorf.new(0.0, 0.0, 0.0, 1.0)
+
+local function DrawPerCall()
+  for i = 1, spriteCount do
+    dest.x = xs[i]
+    dest.y = ys[i]
+    render:DrawTextureRotated(texture, nil, dest, angles[i])
+  end
+end
+
+local function DrawBatched()
+  batch:Clear()
+
+  for i = 1, spriteCount do
+    batch:AddRotated(0, 0, 0, 0, xs[i], ys[i], spriteSize, spriteSize, angles[i])
+  end
+
+  render:DrawSpriteBatch(batch)
+end
+
+local modes = {
+  { name = "per-call", draw = DrawPerCall },
+  { name = "batched", draw = DrawBatched },
+}
+
+local current = 1
+local frames = 0
+local elapsed = 0.0
+
+while app:IsAppRunning() do
+  app:EventsAndTimeStep()
+
+  if app:IsKeyReleased(swgtk.KeyCode.Space) then
+    current = (current % #modes) + 1
+    frames = 0
+    elapsed = 0.0
+  end
+
+  if app:IsKeyReleased(swgtk.KeyCode.P) then
+    if app:IsProfiling() then
+      app:StopProfiler()
+      app:SaveProfile("sprite_batch_bench.folded")
+
+      for i, profile in ipairs(app:GetProfile()) do
+        if i > 5 then break end
+        print(string.format("%6.2f ms self %6.2f ms total  %s", profile.selfMilliseconds, profile.totalMilliseconds, profile.name))
+      end
+
+      app:ResetProfile()
+    else
+      app:StartProfiler()
+    end
+  end
+
+  for i = 1, spriteCount do
+    angles[i] = (angles[i] + 1.0) % 360.0
+  end
+
+  render:BufferClear(black)
+  modes[current].draw()
+  render:BufferPresent()
+
+  frames = frames + 1
+  elapsed = elapsed + app:DeltaTime()
+
+  if frames == framesToAverage then
+    print(string.format("%s: %d sprites, %.3f ms per frame", modes[current].name, spriteCount, (elapsed / frames) * 1000.0))
+    frames = 0
+    elapsed = 0.0
+  end
+end
@@ -70,7 +70,6 @@ if(NOT EMSCRIPTEN)
 else()
   target_link_libraries(
     TextSample PRIVATE
-    "--embed-file assets/Natural_Mono-Regular.ttf"
     "--embed-file assets/swgtk.lua"
   )
 
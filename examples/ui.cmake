@@ -0,0 +1,77 @@
+add_executable(UISample)
+
+target_compile_options(UISample PRIVATE ${CompilerFlags})
+target_link_options(UISample PRIVATE ${LinkerFlags})
+
+target_compile_features(UISample PRIVATE cxx_std_23)
+
+if(${CMAKE_BUILD_TYPE} MATCHES "Debug")
+  target_compile_definitions(UISample PRIVATE _DEBUG)
+endif()
+
+if(CLANG_TIDY_PROGRAM)
+
+  set_property(TARGET UISample PROPERTY CXX_CLANG_TIDY ${CLANG_TIDY_PROGRAM})
+
+endif()
+
+if(CPPCHECK_PROGRAM)
+
+  set_target_properties(UISample PROPERTIES CXX_CPPCHECK ${CPPCHECK_PROGRAM})
+
+endif()
+
+target_include_directories(
+  UISample
+
+  PUBLIC
+
+  ${SWGTK_ROOT_DIRECTORY}/engine/include
+  ${CMAKE_CURRENT_LIST_DIR}
+  ${lua_SOURCE_DIR}
+)
+
+target_link_libraries(
+  UISample
+
+  PRIVATE
+
+  swgtk
+  swgtk::SDLHW2D
+)
+
+target_sources(
+  UISample
+
+  PUBLIC
+
+  ${CMAKE_CURRENT_LIST_DIR}/UI.hpp
+
+  PRIVATE
+
+  ${CMAKE_CURRENT_LIST_DIR}/UI.cpp
+)
+
+if(NOT EMSCRIPTEN)
+  if(WIN32) # Windows
+    add_custom_command(
+      TARGET UISample POST_BUILD
+      COMMAND ${CMAKE_COMMAND} -E copy -t $<TARGET_FILE_DIR:UISample> $<TARGET_RUNTIME_DLLS:UISample>
+      COMMAND_EXPAND_LISTS
+    )
+  else() # Unix-based systems
+    add_custom_command(
+      TARGET UISample POST_BUILD
+      COMMAND ${CMAKE_COMMAND} -E copy -t $<TARGET_FILE_DIR:UISample>
+      ${SWGTK_SHARED_LIBARIES}
+      COMMAND_EXPAND_LISTS
+    )
+  endif()
+else()
+  target_link_libraries(
+    UISample PRIVATE
+    "--embed-file assets/swgtk.lua"
+  )
+
+  target_link_options(UISample PRIVATE "-s" "ALLOW_MEMORY_GROWTH=1")
+endif()
\ No newline at end of file
@@ -0,0 +1,258 @@
+#ifndef SWGTK_TESTS_VISUALHARNESS_HPP_
+#define SWGTK_TESTS_VISUALHARNESS_HPP_
+
+#include <SDL3/SDL_surface.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <swgtk/SDLHW2D.hpp>
+#include <swgtk/Timer.hpp>
+#include <vector>
+
+/*
+  Visual regression harness. Scenes are run for a number of frames on SDL's software renderer, so no display is
+  needed. The last frame is compared against tests/golden/<scene>.png. A scene without a golden image is skipped,
+  not failed, and its frame is left in the build directory. Set SWGTK_UPDATE_GOLDEN=1 to record the images, the
+  only time anything is written to tests/golden. Failed comparisons leave the frame and a diff image there too.
+
+  Timings only compare on the machine that recorded them, so the frame time check is off unless
+  SWGTK_PERF_BASELINE names a baseline file. SWGTK_UPDATE_BASELINE=1 records the timings into it, and
+  SWGTK_PERF_THRESHOLD changes how much slower than the baseline a scene may get, 0.5 by default.
+*/
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace swgtk::test {
+  struct SurfaceDeleter {
+    void operator()(SDL_Surface* surface) const { SDL_DestroySurface(surface); }
+  };
+
+  using SurfacePtr = std::unique_ptr<SDL_Surface, SurfaceDeleter>;
+  using Scene = std::function<void(SDLHW2D& renderer, int frame)>;
+
+  constexpr auto sceneWidth = 256;
+  constexpr auto sceneHeight = 192;
+  constexpr auto sceneFrames = 60;
+
+  // Below this, a slower median is timer noise rather than a regression.
+  constexpr auto perfSlackMs = 0.1;
+
+  struct FrameTimes {
+    double median = 0.0;
+    double p95 = 0.0;
+  };
+
+  struct SceneResult {
+    SurfacePtr image;
+    FrameTimes times;
+  };
+
+  struct ImageTolerance {
+    int channel = 2;          // Largest difference in any channel that still counts as the same pixel.
+    double mismatched = 0.0;  // Fraction of pixels allowed to differ by more than that.
+  };
+
+  [[nodiscard]] inline auto EnvironmentFlag(const char* name) -> bool {
+    const auto* value = std::getenv(name);
+    return value != nullptr && std::string{value} != "0";
+  }
+
+  [[nodiscard]] inline auto PerfThreshold() -> double {
+    const auto* value = std::getenv("SWGTK_PERF_THRESHOLD");
+    return value != nullptr ? std::atof(value) : 0.5;
+  }
+
+  [[nodiscard]] inline auto GoldenDirectory() -> std::filesystem::path { return SWGTK_TEST_GOLDEN_DIR; }
+  [[nodiscard]] inline auto OutputDirectory() -> std::filesystem::path { return SWGTK_TEST_OUTPUT_DIR; }
+
+  // Empty when no baseline was asked for, and frame times aren't checked.
+  [[nodiscard]] inline auto BaselinePath() -> std::filesystem::path {
+    const auto* value = std::getenv("SWGTK_PERF_BASELINE");
+    return value != nullptr ? std::filesystem::path{value} : std::filesystem::path{};
+  }
+
+  inline void SaveActual(const std::string& name, SDL_Surface* image) {
+    std::filesystem::create_directories(OutputDirectory());
+    IMG_SavePNG(image, (OutputDirectory() / (name + ".actual.png")).string().c_str());
+  }
+
+  [[nodiscard]] inline auto ToRgba(SDL_Surface* surface) -> SurfacePtr {
+    return SurfacePtr{surface != nullptr ? SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32) : nullptr};
+  }
+
+  [[nodiscard]] inline auto PixelAt(const SDL_Surface* rgba, const int x, const int y) -> const Uint8* {
+    return static_cast<const Uint8*>(rgba->pixels) + static_cast<ptrdiff_t>(y) * rgba->pitch + static_cast<ptrdiff_t>(x) * 4;
+  }
+
+  [[nodiscard]] inline auto PixelAt(SDL_Surface* rgba, const int x, const int y) -> Uint8* {
+    return static_cast<Uint8*>(rgba->pixels) + static_cast<ptrdiff_t>(y) * rgba->pitch + static_cast<ptrdiff_t>(x) * 4;
+  }
+
+  [[nodiscard]] inline auto Summarize(std::vector<double> times) -> FrameTimes {
+    std::ranges::sort(times);
+
+    return FrameTimes{
+        .median = times[times.size() / 2uz],
+        .p95 = times[std::min(times.size() * 95uz / 100uz, times.size() - 1uz)],
+    };
+  }
+
+  // Runs scene for the given number of frames, each one timed up to and including BufferPresent().
+  [[nodiscard]] inline auto RunScene(const Scene& scene, const int frames = sceneFrames, const bool dirtyRendering = false) -> SceneResult {
+    SurfacePtr target{SDL_CreateSurface(sceneWidth, sceneHeight, SDL_PIXELFORMAT_RGBA32)};
+    std::vector<double> times;
+    times.reserve(static_cast<size_t>(frames));
+
+    {
+      SDLHW2D renderer;
+
+      if (!renderer.PrepareHeadless(target.get())) {
+        return SceneResult{};
+      }
+
+      renderer.SetDirtyRendering(dirtyRendering);
+      Timer timer;
+
+      for (auto frame = 0; frame < frames; ++frame) {
+        timer.UpdateTime();
+        scene(renderer, frame);
+        renderer.BufferPresent();
+        times.push_back(timer.GetElapsedMilliseconds());
+      }
+    }
+
+    return SceneResult{.image = ToRgba(target.get()), .times = Summarize(std::move(times))};
+  }
+
+  // Counts the pixels that differ by more than the tolerance, and marks them red in diff.
+  [[nodiscard]] inline auto CountMismatched(const SDL_Surface* actual, const SDL_Surface* expected, const int channel, SDL_Surface* diff) -> size_t {
+    auto mismatched = 0uz;
+
+    for (auto y = 0; y < actual->h; ++y) {
+      for (auto x = 0; x < actual->w; ++x) {
+        const auto* a = PixelAt(actual, x, y);
+        const auto* e = PixelAt(expected, x, y);
+        auto* d = PixelAt(diff, x, y);
+        auto delta = 0;
+
+        for (auto c = 0; c < 4; ++c) {
+          delta = std::max(delta, std::abs(static_cast<int>(a[c]) - static_cast<int>(e[c])));
+        }
+
+        const auto differs = delta > channel;
+        mismatched += differs ? 1uz : 0uz;
+
+        // Differences in red over a faded copy of the expected image.
+        const auto faded = static_cast<Uint8>((e[0] + e[1] + e[2]) / 12);
+        d[0] = differs ? Uint8{255} : faded;
+        d[1] = differs ? Uint8{0} : faded;
+        d[2] = differs ? Uint8{0} : faded;
+        d[3] = Uint8{255};
+      }
+    }
+
+    return mismatched;
+  }
+
+  inline void CheckAgainstGolden(const std::string& name, SDL_Surface* image, const ImageTolerance& tolerance = ImageTolerance{}) {
+    REQUIRE(image != nullptr);
+
+    const auto golden = GoldenDirectory() / (name + ".png");
+
+    if (EnvironmentFlag("SWGTK_UPDATE_GOLDEN")) {
+      std::filesystem::create_directories(GoldenDirectory());
+      REQUIRE(IMG_SavePNG(image, golden.string().c_str()));
+      WARN(std::format("Recorded golden image {}", golden.string()));
+      return;
+    }
+
+    if (!std::filesystem::exists(golden)) {
+      SaveActual(name, image);
+      SKIP(std::format("No golden image {}, skipping the comparison. Check {} and run with SWGTK_UPDATE_GOLDEN=1 to record it.", golden.string(),
+                       (OutputDirectory() / (name + ".actual.png")).string()));
+    }
+
+    const SurfacePtr loaded{IMG_Load(golden.string().c_str())};
+    const auto expected = ToRgba(loaded.get());
+    REQUIRE(expected != nullptr);
+    REQUIRE(expected->w == image->w);
+    REQUIRE(expected->h == image->h);
+
+    const SurfacePtr diff{SDL_CreateSurface(image->w, image->h, SDL_PIXELFORMAT_RGBA32)};
+    const auto mismatched = CountMismatched(image, expected.get(), tolerance.channel, diff.get());
+    const auto allowed = static_cast<size_t>(tolerance.mismatched * static_cast<double>(image->w * image->h));
+
+    if (mismatched > allowed) {
+      SaveActual(name, image);
+      IMG_SavePNG(diff.get(), (OutputDirectory() / (name + ".diff.png")).string().c_str());
+    }
+
+    INFO(std::format("{}: {} pixels differ from {}, {} allowed", name, mismatched, golden.string(), allowed));
+    CHECK(mismatched <= allowed);
+  }
+
+  [[nodiscard]] inline auto ReadBaselines(const std::filesystem::path& path) -> std::map<std::string, double> {
+    std::map<std::string, double> baselines;
+    std::ifstream file{path};
+    std::string name;
+    double median = 0.0;
+
+    while (file >> name >> median) {
+      baselines[name] = median;
+    }
+
+    return baselines;
+  }
+
+  inline void CheckAgainstBaseline(const std::string& name, const FrameTimes& times) {
+    const auto path = BaselinePath();
+
+    if (path.empty()) {
+      WARN(std::format("{}: median {:.3f} ms, p95 {:.3f} ms. Frame time check disabled, set SWGTK_PERF_BASELINE to enable it.", name,
+                       times.median, times.p95));
+      return;
+    }
+
+    auto baselines = ReadBaselines(path);
+    const auto baseline = baselines.find(name);
+
+    if (EnvironmentFlag("SWGTK_UPDATE_BASELINE")) {
+      baselines[name] = times.median;
+
+      if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+      }
+
+      std::ofstream file{path, std::ios::trunc};
+
+      for (const auto& [scene, median]: baselines) {
+        file << scene << ' ' << median << '\n';
+      }
+
+      WARN(std::format("Recorded frame time baseline for {}: {:.3f} ms", name, times.median));
+      return;
+    }
+
+    if (baseline == baselines.end()) {
+      FAIL(std::format("No frame time baseline for {} in {}. Run with SWGTK_UPDATE_BASELINE=1 to record it.", name, path.string()));
+    }
+
+    const auto limit = baseline->second * (1.0 + PerfThreshold()) + perfSlackMs;
+
+    INFO(std::format("{}: median {:.3f} ms, p95 {:.3f} ms, baseline {:.3f} ms, limit {:.3f} ms", name, times.median, times.p95,
+                     baseline->second, limit));
+    CHECK(times.median <= limit);
+  }
+} // namespace swgtk::test
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
+
+#endif
@@ -0,0 +1,312 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <swgtk/Animation.hpp>
+#include <swgtk/SpriteBatch.hpp>
+#include <swgtk/Timer.hpp>
+#include <vector>
+
+#ifdef SWGTK_BUILD_WITH_LUA
+#include <sol/sol.hpp>
+#include <swgtk/SDLHW2D.hpp>
+#endif
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  constexpr auto hashSheet = R"({
+    "frames": {
+      "walk 0.aseprite": { "frame": { "x": 0, "y": 0, "w": 16, "h": 16 }, "duration": 100 },
+      "walk 1.aseprite": { "frame": { "x": 16, "y": 0, "w": 16, "h": 16 }, "duration": 200 },
+      "walk 2.aseprite": { "frame": { "x": 32, "y": 0, "w": 16, "h": 16 }, "duration": 100 },
+      "jump 3.aseprite": { "frame": { "x": 48, "y": 0, "w": 16, "h": 16 }, "duration": 50 }
+    },
+    "meta": {
+      "app": "http://www.aseprite.org/",
+      "image": "hero.png",
+      "frameTags": [
+        { "name": "walk", "from": 0, "to": 2, "direction": "pingpong" },
+        { "name": "back", "from": 0, "to": 2, "direction": "reverse" },
+        { "name": "jump", "from": 3, "to": 3, "direction": "forward", "repeat": "1" }
+      ]
+    }
+  })";
+
+  constexpr auto arraySheet = R"({
+    "frames": [
+      { "filename": "a", "frame": { "x": 0, "y": 0, "w": 8, "h": 8 } },
+      { "filename": "bé😀", "frame": { "x": 8, "y": 0, "w": 8, "h": 8 }, "duration": 1e2 }
+    ],
+    "meta": { "image": "tiles.png" }
+  })";
+
+  // Three frames that each last a tenth of a second.
+  constexpr auto threeFrames = std::array{
+      swgtk::AnimationFrame{.source = SDL_FRect{.x = 0.0f, .y = 0.0f, .w = 8.0f, .h = 8.0f}, .duration = 0.1f},
+      swgtk::AnimationFrame{.source = SDL_FRect{.x = 8.0f, .y = 0.0f, .w = 8.0f, .h = 8.0f}, .duration = 0.1f},
+      swgtk::AnimationFrame{.source = SDL_FRect{.x = 16.0f, .y = 0.0f, .w = 8.0f, .h = 8.0f}, .duration = 0.1f},
+  };
+
+  constexpr auto dest = SDL_FRect{.x = 0.0f, .y = 0.0f, .w = 8.0f, .h = 8.0f};
+} // namespace
+
+TEST_CASE("Animation Tests") {
+  SECTION("Test a hash sheet becomes a clip per tag") {
+    swgtk::SpriteSheet sheet;
+    REQUIRE(sheet.LoadJson(hashSheet));
+
+    REQUIRE(sheet.GetClipCount() == 3uz);
+    REQUIRE(sheet.GetImagePath() == "hero.png");
+
+    const auto* walk = sheet.GetClip(sheet.FindClip("walk"));
+    REQUIRE(walk != nullptr);
+    REQUIRE(walk->loop == swgtk::AnimationLoop::PingPong);
+
+    // 0 1 2 then back through 1.
+    REQUIRE(walk->frames.size() == 4uz);
+    REQUIRE(walk->frames[3].source.x == 16.0f);
+    REQUIRE(walk->length > 0.59f);
+    REQUIRE(walk->length < 0.61f);
+
+    const auto* back = sheet.GetClip(sheet.FindClip("back"));
+    REQUIRE(back->frames.front().source.x == 32.0f);
+    REQUIRE(back->loop == swgtk::AnimationLoop::Loop);
+
+    REQUIRE(sheet.GetClip(sheet.FindClip("jump"))->loop == swgtk::AnimationLoop::Once);
+    REQUIRE(sheet.FindClip("run") == swgtk::nullClip);
+    REQUIRE(sheet.GetClip(swgtk::nullClip) == nullptr);
+  }
+
+  SECTION("Test an array sheet without tags becomes one looping clip") {
+    swgtk::SpriteSheet sheet;
+    REQUIRE(sheet.LoadJson(arraySheet));
+
+    const auto* clip = sheet.GetClip(sheet.FindClip("default"));
+    REQUIRE(clip != nullptr);
+    REQUIRE(clip->frames.size() == 2uz);
+    REQUIRE(clip->frames[0].duration == swgtk::defaultFrameDuration);
+    REQUIRE(clip->frames[1].source.x == 8.0f);
+  }
+
+  SECTION("Test broken sheets are rejected and leave the sheet alone") {
+    swgtk::SpriteSheet sheet;
+    REQUIRE(sheet.LoadJson(arraySheet));
+
+    REQUIRE_FALSE(sheet.LoadJson(R"({ "frames": [ { "frame": { "x": 0 } }, ] })"));
+    REQUIRE_FALSE(sheet.LoadJson(R"({ "frames": [] })"));
+    REQUIRE_FALSE(sheet.LoadJson(R"({ "meta": {} })"));
+    REQUIRE_FALSE(sheet.LoadJson(R"({ "frames": [ { "frame": {} } ] } trailing)"));
+    REQUIRE_FALSE(sheet.LoadJson(std::string(1000uz, '[')));
+
+    REQUIRE(sheet.GetClipCount() == 1uz);
+  }
+
+  SECTION("Test looping clips wrap and play from the right frame") {
+    swgtk::SpriteSheet sheet;
+    const auto clip = sheet.AddClip("spin", threeFrames);
+
+    swgtk::Animators animators{sheet};
+    const auto animator = animators.Add(clip, dest);
+
+    animators.Update(0.05f);
+    REQUIRE(animators.GetFrame(animator) == 0uz);
+
+    animators.Update(0.1f);
+    REQUIRE(animators.GetFrame(animator) == 1uz);
+    REQUIRE(animators.GetSource(animator).x == 8.0f);
+
+    // Past the end and into the second frame again, in one step.
+    animators.Update(0.3f);
+    REQUIRE(animators.GetFrame(animator) == 1uz);
+    REQUIRE_FALSE(animators.IsFinished(animator));
+  }
+
+  SECTION("Test clips that play once hold their last frame") {
+    swgtk::SpriteSheet sheet;
+    const auto clip = sheet.AddClip("hit", threeFrames, swgtk::AnimationLoop::Once);
+
+    swgtk::Animators animators{sheet};
+    const auto animator = animators.Add(clip, dest);
+
+    animators.Update(0.25f);
+    REQUIRE_FALSE(animators.IsFinished(animator));
+
+    animators.Update(10.0f);
+    REQUIRE(animators.IsFinished(animator));
+    REQUIRE(animators.GetFrame(animator) == 2uz);
+
+    REQUIRE(animators.Play(animator, clip));
+    REQUIRE(animators.GetFrame(animator) == 0uz);
+    REQUIRE_FALSE(animators.IsFinished(animator));
+  }
+
+  SECTION("Test speed scales and pauses an animator") {
+    swgtk::SpriteSheet sheet;
+    const auto clip = sheet.AddClip("spin", threeFrames);
+
+    swgtk::Animators animators{sheet};
+    const auto fast = animators.Add(clip, dest, 2.0f);
+    const auto paused = animators.Add(clip, dest);
+
+    REQUIRE(animators.SetSpeed(paused, 0.0f));
+    animators.Update(0.1f);
+
+    REQUIRE(animators.GetFrame(fast) == 2uz);
+    REQUIRE(animators.GetFrame(paused) == 0uz);
+  }
+
+  SECTION("Test removed IDs stay invalid and the rest keep their animators") {
+    swgtk::SpriteSheet sheet;
+    const auto clip = sheet.AddClip("spin", threeFrames);
+
+    swgtk::Animators animators{sheet};
+    REQUIRE(animators.Add(swgtk::nullClip, dest) == swgtk::nullAnimator);
+
+    const auto first = animators.Add(clip, dest);
+    const auto second = animators.Add(clip, dest);
+    REQUIRE(animators.SetSpeed(second, 2.0f));
+
+    REQUIRE(animators.Remove(first));
+    REQUIRE_FALSE(animators.Remove(first));
+    REQUIRE_FALSE(animators.IsValid(first));
+
+    // The freed slot is used again, under a new ID.
+    const auto third = animators.Add(clip, dest);
+    REQUIRE(third != first);
+    REQUIRE_FALSE(animators.IsValid(first));
+    REQUIRE(animators.Size() == 2uz);
+
+    animators.Update(0.1f);
+    REQUIRE(animators.GetFrame(second) == 2uz);
+    REQUIRE(animators.GetFrame(third) == 1uz);
+
+    animators.Clear();
+    REQUIRE(animators.Size() == 0uz);
+    REQUIRE_FALSE(animators.IsValid(second));
+  }
+
+  SECTION("Test animators hold their frame once their clip is gone") {
+    swgtk::SpriteSheet sheet;
+    const auto clip = sheet.AddClip("spin", threeFrames);
+
+    swgtk::Animators animators{sheet};
+    const auto animator = animators.Add(clip, dest);
+
+    animators.Update(0.15f);
+    sheet.Clear();
+
+    animators.Update(0.1f);
+    REQUIRE(animators.GetFrame(animator) == 1uz);
+    REQUIRE(animators.GetSource(animator).x == 8.0f);
+    REQUIRE(animators.IsFinished(animator));
+
+    REQUIRE_FALSE(animators.Play(animator, clip));
+    REQUIRE(animators.Play(animator, sheet.AddClip("spin", threeFrames)));
+    REQUIRE_FALSE(animators.IsFinished(animator));
+  }
+
+  SECTION("Test every animator is appended to the batch") {
+    swgtk::SpriteSheet sheet;
+    const auto clip = sheet.AddClip("spin", threeFrames);
+
+    swgtk::Animators animators{sheet};
+    swgtk::SpriteBatch batch;
+
+    for (auto i = 0; i < 10; ++i) {
+      animators.Add(clip, SDL_FRect{.x = static_cast<float>(i) * 8.0f, .y = 0.0f, .w = 8.0f, .h = 8.0f});
+    }
+
+    animators.Update(0.15f);
+    animators.AppendTo(batch);
+
+    REQUIRE(batch.Size() == 10uz);
+    REQUIRE(batch.Buffer().Vertices()[4].position.x == 8.0f);
+  }
+}
+
+#ifdef SWGTK_BUILD_WITH_LUA
+TEST_CASE("Animation Lua Tests") {
+  const auto path = std::filesystem::temp_directory_path() / "swgtk_lua_sheet.json";
+  std::ofstream{path} << hashSheet;
+
+  sol::state lua;
+  lua.open_libraries(sol::lib::base);
+  lua["swgtk"] = lua.create_table();
+  lua["sheetPath"] = path.string();
+
+  const auto renderer = std::make_shared<swgtk::SDLHW2D>();
+  renderer->InitLua(&lua);
+
+  SECTION("Test animators are made from a sheet made in Lua") {
+    lua.script(R"(
+      local sheet = swgtk.SpriteSheet.new()
+      assert(sheet:Load(sheetPath))
+
+      animators = swgtk.Animators.new(sheet)
+      walker = animators:Add(sheet:FindClip("walk"), 0, 0, 16, 16)
+      jumper = animators:Add(sheet:FindClip("jump"), 16, 0, 16, 16)
+
+      -- The animators keep the sheet alive after the script lets go of it.
+      sheet = nil
+      collectgarbage()
+      animators:Update(1.0)
+
+      count = animators:Size()
+      walkerFinished = animators:IsFinished(walker)
+      jumperFinished = animators:IsFinished(jumper)
+    )");
+
+    REQUIRE(lua.get<size_t>("count") == 2uz);
+    REQUIRE_FALSE(lua.get<bool>("walkerFinished"));
+    REQUIRE(lua.get<bool>("jumperFinished"));
+  }
+
+  std::filesystem::remove(path);
+}
+#endif
+
+TEST_CASE("Animator update benchmark", "[.][benchmark]") {
+  constexpr auto count = 100'000uz;
+  constexpr auto frames = 600;
+
+  swgtk::SpriteSheet sheet;
+  const auto clip = sheet.AddClip("spin", threeFrames);
+
+  swgtk::Animators animators{sheet};
+  animators.Reserve(count);
+
+  for (auto i = 0uz; i < count; ++i) {
+    animators.Add(clip, dest, 0.5f + (static_cast<float>(i % 100uz) / 100.0f));
+  }
+
+  swgtk::SpriteBatch batch;
+  batch.Reserve(count);
+
+  swgtk::Timer timer;
+
+  for (auto frame = 0; frame < frames; ++frame) {
+    animators.Update(1.0f / 60.0f);
+  }
+
+  const auto updateTime = timer.GetElapsedMilliseconds();
+
+  timer.UpdateTime();
+
+  for (auto frame = 0; frame < frames; ++frame) {
+    batch.Clear();
+    animators.AppendTo(batch);
+  }
+
+  const auto appendTime = timer.GetElapsedMilliseconds();
+
+  std::puts(std::format("{} animators over {} frames: Update {:.3f} ms/frame, AppendTo {:.3f} ms/frame",
+                        count, frames, updateTime / frames, appendTime / frames).c_str());
+
+  REQUIRE(batch.Size() == count);
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,293 @@
+#include <SDL3/SDL_hints.h>
+#include <SDL3/SDL_init.h>
+#include <SDL3/SDL_timer.h>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <memory>
+#include <random>
+#include <swgtk/AudioMixer.hpp>
+#include <swgtk/SpscQueue.hpp>
+#include <swgtk/SurfaceOps.hpp>
+#include <swgtk/Timer.hpp>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  // A sound holding the same left and right sample in every frame.
+  [[nodiscard]] auto MakeSound(const size_t frames, const float left, const float right) -> std::shared_ptr<const swgtk::Sound> {
+    std::vector<float> samples;
+
+    for (auto i = 0uz; i < frames; ++i) {
+      samples.push_back(left);
+      samples.push_back(right);
+    }
+
+    return std::make_shared<const swgtk::Sound>(std::move(samples));
+  }
+
+  [[nodiscard]] auto MakeNoise(const size_t frames, const uint32_t seed) -> std::shared_ptr<const swgtk::Sound> {
+    std::mt19937 random{seed};
+    std::uniform_real_distribution noise{-0.25f, 0.25f};
+    std::vector<float> samples(frames * swgtk::audioChannels);
+
+    for (auto& sample: samples) {
+      sample = noise(random);
+    }
+
+    return std::make_shared<const swgtk::Sound>(std::move(samples));
+  }
+
+  [[nodiscard]] auto Near(const float a, const float b) -> bool { return std::abs(a - b) < 1e-5f; }
+
+  constexpr auto allLevels = std::array{swgtk::SimdLevel::Scalar, swgtk::SimdLevel::SSE2, swgtk::SimdLevel::AVX2};
+} // namespace
+
+TEST_CASE("SPSC Queue Tests") {
+  SECTION("Test items come out in order until the queue is empty") {
+    swgtk::SpscQueue<int, 4uz> queue;
+
+    REQUIRE(queue.TryPush(1));
+    REQUIRE(queue.TryPush(2));
+    REQUIRE(queue.TryPush(3));
+    REQUIRE(queue.TryPush(4));
+    REQUIRE_FALSE(queue.TryPush(5));
+    REQUIRE(queue.Size() == 4uz);
+
+    REQUIRE(queue.TryPop() == 1);
+    REQUIRE(queue.TryPush(5));
+    REQUIRE(queue.TryPop() == 2);
+    REQUIRE(queue.TryPop() == 3);
+    REQUIRE(queue.TryPop() == 4);
+    REQUIRE(queue.TryPop() == 5);
+    REQUIRE_FALSE(queue.TryPop().has_value());
+    REQUIRE(queue.IsEmpty());
+  }
+
+  SECTION("Test a producer and consumer thread see every item once") {
+    constexpr auto count = 200'000;
+    swgtk::SpscQueue<int, 256uz> queue;
+
+    std::jthread producer{[&queue] {
+      for (auto i = 0; i < count;) {
+        if (queue.TryPush(i)) {
+          ++i;
+        }
+      }
+    }};
+
+    auto expected = 0;
+    auto inOrder = true;
+
+    while (expected < count) {
+      if (const auto value = queue.TryPop()) {
+        inOrder = inOrder && *value == expected;
+        ++expected;
+      }
+    }
+
+    REQUIRE(inOrder);
+    REQUIRE(queue.IsEmpty());
+  }
+}
+
+TEST_CASE("Audio Mixer Tests") {
+  swgtk::AudioMixer mixer;
+  std::vector<float> out(64uz * swgtk::audioChannels);
+
+  SECTION("Test voices are mixed with gain and balance") {
+    const auto sound = MakeSound(256uz, 0.5f, 0.25f);
+
+    REQUIRE(mixer.Play(sound, swgtk::VoiceParams{.gain = 0.5f}) != swgtk::nullVoice);
+    REQUIRE(mixer.Play(sound, swgtk::VoiceParams{.gain = 1.0f, .pan = -1.0f}) != swgtk::nullVoice);
+
+    mixer.Mix(out);
+
+    REQUIRE(Near(out[0], 0.75f));
+    REQUIRE(Near(out[1], 0.125f));
+    REQUIRE(Near(out[126], 0.75f));
+    REQUIRE(Near(out[127], 0.125f));
+  }
+
+  SECTION("Test finished voices release their sound") {
+    const auto sound = MakeSound(100uz, 0.5f, 0.5f);
+    const auto voice = mixer.Play(sound);
+
+    mixer.Mix(out);
+    mixer.Update();
+    REQUIRE(mixer.IsPlaying(voice));
+    REQUIRE(sound.use_count() == 2);
+
+    mixer.Mix(out);
+    REQUIRE(Near(out[(35uz * 2uz)], 0.5f));
+    REQUIRE(out[(36uz * 2uz)] == 0.0f);
+
+    mixer.Update();
+    REQUIRE_FALSE(mixer.IsPlaying(voice));
+    REQUIRE(mixer.GetPlayingCount() == 0uz);
+    REQUIRE(sound.use_count() == 1);
+  }
+
+  SECTION("Test looping voices wrap around") {
+    const auto sound = std::make_shared<const swgtk::Sound>(std::vector{0.1f, 0.1f, 0.2f, 0.2f, 0.3f, 0.3f});
+    const auto voice = mixer.Play(sound, swgtk::VoiceParams{.loop = true});
+
+    mixer.Mix(out);
+    mixer.Update();
+
+    REQUIRE(Near(out[0], 0.1f));
+    REQUIRE(Near(out[4], 0.3f));
+    REQUIRE(Near(out[6], 0.1f));
+    REQUIRE(Near(out[(63uz * 2uz)], 0.1f));
+    REQUIRE(mixer.IsPlaying(voice));
+  }
+
+  SECTION("Test changes and stops are ramped over one mix") {
+    const auto sound = MakeSound(10'000uz, 1.0f, 1.0f);
+    const auto voice = mixer.Play(sound);
+
+    mixer.Mix(out);
+    REQUIRE(mixer.SetGain(voice, 0.0f));
+    mixer.Mix(out);
+
+    REQUIRE(out[0] > 0.9f);
+    REQUIRE(out[0] > out[64]);
+    REQUIRE(out[64] > out[126]);
+    REQUIRE(Near(out[126], 0.0f));
+
+    REQUIRE(mixer.SetGain(voice, 1.0f));
+    REQUIRE(mixer.Stop(voice));
+    mixer.Mix(out);
+    mixer.Update();
+
+    REQUIRE_FALSE(mixer.IsPlaying(voice));
+    REQUIRE_FALSE(mixer.Stop(voice));
+  }
+
+  SECTION("Test master gain and clipping") {
+    const auto sound = MakeSound(256uz, 0.75f, -0.75f);
+
+    REQUIRE(mixer.Play(sound) != swgtk::nullVoice);
+    REQUIRE(mixer.Play(sound) != swgtk::nullVoice);
+    mixer.Mix(out);
+
+    REQUIRE(out[0] == 1.0f);
+    REQUIRE(out[1] == -1.0f);
+
+    REQUIRE(mixer.SetMasterGain(0.5f));
+    mixer.Mix(out);
+
+    REQUIRE(Near(out[0], 0.75f));
+    REQUIRE(Near(out[1], -0.75f));
+  }
+
+  SECTION("Test voices are capped") {
+    swgtk::AudioMixer small{swgtk::defaultSampleRate, 2uz};
+    const auto sound = MakeSound(16uz, 0.1f, 0.1f);
+
+    REQUIRE(small.Play(sound) != swgtk::nullVoice);
+    REQUIRE(small.Play(sound) != swgtk::nullVoice);
+    REQUIRE(small.Play(sound) == swgtk::nullVoice);
+
+    small.Mix(out);
+    small.Update();
+    REQUIRE(small.Play(sound) != swgtk::nullVoice);
+  }
+
+  SECTION("Test every instruction set mixes the same samples") {
+    const auto detected = swgtk::SetSimdLevel(swgtk::SimdLevel::AVX2);
+    std::vector<std::vector<float>> results;
+
+    for (const auto level: allLevels) {
+      if (swgtk::SetSimdLevel(level) != level) {
+        continue;
+      }
+
+      swgtk::AudioMixer levelMixer;
+
+      for (auto i = 0u; i < 5u; ++i) {
+        REQUIRE(levelMixer.Play(MakeNoise(333uz, i), swgtk::VoiceParams{.gain = 0.3f, .pan = (static_cast<float>(i) * 0.4f) - 0.8f}) != swgtk::nullVoice);
+      }
+
+      // Odd frame counts leave a tail for the scalar loop of each kernel.
+      std::vector<float> mixed(77uz * swgtk::audioChannels);
+      levelMixer.Mix(mixed);
+      results.push_back(mixed);
+    }
+
+    swgtk::SetSimdLevel(detected);
+
+    for (const auto& result: results) {
+      for (auto i = 0uz; i < result.size(); ++i) {
+        REQUIRE(Near(result[i], results.front()[i]));
+      }
+    }
+  }
+
+  SECTION("Test voices play through SDL's dummy audio driver") {
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    REQUIRE(SDL_InitSubSystem(SDL_INIT_AUDIO));
+
+    REQUIRE(mixer.Open());
+    REQUIRE(mixer.IsOpen());
+
+    // A fiftieth of a second, so the device finishes it quickly.
+    const auto voice = mixer.Play(MakeSound(static_cast<size_t>(swgtk::defaultSampleRate / 50), 0.1f, 0.1f));
+    REQUIRE(voice != swgtk::nullVoice);
+
+    for (auto wait = 0; wait < 200 && mixer.IsPlaying(voice); ++wait) {
+      SDL_Delay(10u);
+      mixer.Update();
+    }
+
+    REQUIRE_FALSE(mixer.IsPlaying(voice));
+
+    mixer.Close();
+    REQUIRE_FALSE(mixer.IsOpen());
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+  }
+}
+
+TEST_CASE("Audio mixer voice benchmark", "[.][benchmark]") {
+  constexpr auto voices = 64uz;
+  constexpr auto blockFrames = 512uz;
+  constexpr auto blocks = 2000;
+
+  const auto detected = swgtk::SetSimdLevel(swgtk::SimdLevel::AVX2);
+  const auto sound = MakeNoise(48'000uz, 1u);
+
+  std::vector<float> out(blockFrames * swgtk::audioChannels);
+
+  for (const auto level: allLevels) {
+    if (swgtk::SetSimdLevel(level) != level) {
+      continue;
+    }
+
+    swgtk::AudioMixer mixer{swgtk::defaultSampleRate, voices};
+
+    for (auto i = 0uz; i < voices; ++i) {
+      mixer.Play(sound, swgtk::VoiceParams{.gain = 0.01f, .loop = true});
+    }
+
+    swgtk::Timer timer;
+
+    for (auto i = 0; i < blocks; ++i) {
+      mixer.Mix(out);
+    }
+
+    // Each voice is one block of blockFrames frames mixed.
+    const auto milliseconds = timer.GetElapsedMilliseconds();
+    constexpr auto levelNames = std::array{"scalar", "SSE2", "AVX2"};
+    std::puts(std::format("{:<6} {:>10.1f} voices/ms ({} frame blocks)", levelNames.at(static_cast<size_t>(level)),
+                          static_cast<double>(voices) * blocks / milliseconds, blockFrames)
+                  .c_str());
+  }
+
+  swgtk::SetSimdLevel(detected);
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,199 @@
+#include <SDL3/SDL_surface.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <swgtk/DirtyRegion.hpp>
+#include <swgtk/SDLHW2D.hpp>
+#include <swgtk/Timer.hpp>
+#include <system_error>
+#include <tuple>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  constexpr auto output = SDL_Rect{.x = 0, .y = 0, .w = 800, .h = 600};
+
+  constexpr auto blue = SDL_FColor{.r = 0.0f, .g = 0.0f, .b = 1.0f, .a = 1.0f};
+  constexpr auto red = SDL_FColor{.r = 1.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f};
+
+  // Whether the pixel at x, y is the color, which has to have channels of exactly 0 or 1.
+  [[nodiscard]] auto PixelIs(SDL_Surface* surface, const int x, const int y, const SDL_FColor& color) -> bool {
+    Uint8 r = 0u;
+    Uint8 g = 0u;
+    Uint8 b = 0u;
+    Uint8 a = 0u;
+    SDL_ReadSurfacePixel(surface, x, y, &r, &g, &b, &a);
+
+    return static_cast<float>(r) == color.r * 255.0f && static_cast<float>(g) == color.g * 255.0f && static_cast<float>(b) == color.b * 255.0f;
+  }
+
+  // Painted straight into the headless target, bypassing the renderer, so a test can see whether a frame went out.
+  constexpr auto marker = SDL_FColor{.r = 1.0f, .g = 0.0f, .b = 1.0f, .a = 1.0f};
+
+  void PaintMarker(SDL_Surface* target) { SDL_FillSurfaceRect(target, nullptr, SDL_MapSurfaceRGB(target, 255, 0, 255)); }
+} // namespace
+
+TEST_CASE("Dirty Region Tests") {
+  SECTION("Test marked rects grow into their union") {
+    swgtk::DirtyRegion region;
+    REQUIRE(region.IsEmpty());
+
+    region.Add(SDL_Rect{.x = 10, .y = 10, .w = 20, .h = 20});
+    region.Add(SDL_Rect{.x = 100, .y = 5, .w = 10, .h = 10});
+    region.Add(SDL_Rect{.x = 50, .y = 50, .w = 0, .h = 10});
+
+    REQUIRE(region.GetCount() == 2uz);
+
+    const auto bounds = region.GetBounds(output);
+    REQUIRE(bounds.x == 10);
+    REQUIRE(bounds.y == 5);
+    REQUIRE(bounds.w == 100);
+    REQUIRE(bounds.h == 25);
+  }
+
+  SECTION("Test the region is clipped to the output") {
+    swgtk::DirtyRegion region;
+
+    region.Add(SDL_Rect{.x = -20, .y = 590, .w = 40, .h = 40});
+    const auto bounds = region.GetBounds(output);
+
+    REQUIRE(bounds.x == 0);
+    REQUIRE(bounds.y == 590);
+    REQUIRE(bounds.w == 20);
+    REQUIRE(bounds.h == 10);
+
+    region.Clear();
+    region.Add(SDL_Rect{.x = 900, .y = 0, .w = 10, .h = 10});
+    REQUIRE_FALSE(region.IsEmpty());
+    REQUIRE(region.GetBounds(output).w == 0);
+  }
+
+  SECTION("Test marking everything covers the output") {
+    swgtk::DirtyRegion region;
+
+    region.AddAll();
+    REQUIRE_FALSE(region.IsEmpty());
+    REQUIRE(region.GetBounds(output).w == 800);
+    REQUIRE(region.GetBounds(output).h == 600);
+
+    region.Clear();
+    REQUIRE(region.IsEmpty());
+    REQUIRE(region.GetBounds(output).w == 0);
+  }
+}
+
+TEST_CASE("Dirty Rendering Tests") {
+  auto* target = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32);
+  REQUIRE(target != nullptr);
+
+  {
+    swgtk::SDLHW2D renderer;
+    REQUIRE(renderer.PrepareHeadless(target));
+
+    // Everything is dirty once enabled, so the first frame draws the whole back buffer.
+    renderer.SetDirtyRendering(true);
+    REQUIRE(renderer.BeginRedraw(blue));
+    renderer.BufferPresent();
+    REQUIRE_FALSE(renderer.IsIdle());
+    REQUIRE(PixelIs(target, 40, 40, blue));
+
+    PaintMarker(target);
+
+    SECTION("Test frames with nothing marked dirty are skipped") {
+      for (auto frame = 0; frame < 3; ++frame) {
+        REQUIRE_FALSE(renderer.BeginRedraw(blue));
+        renderer.BufferPresent();
+        REQUIRE(renderer.IsIdle());
+      }
+
+      REQUIRE(PixelIs(target, 8, 8, marker));
+    }
+
+    SECTION("Test a dirty rect is redrawn and presented") {
+      renderer.MarkDirty(SDL_Rect{.x = 0, .y = 0, .w = 16, .h = 16});
+      REQUIRE(renderer.BeginRedraw(red));
+      REQUIRE(renderer.GetRedrawRect().w == 16);
+      renderer.BufferPresent();
+      REQUIRE_FALSE(renderer.IsIdle());
+
+      // The whole back buffer goes out, the new rect and the old frame around it.
+      REQUIRE(PixelIs(target, 8, 8, red));
+      REQUIRE(PixelIs(target, 40, 40, blue));
+
+      REQUIRE_FALSE(renderer.BeginRedraw(blue));
+      renderer.BufferPresent();
+      REQUIRE(renderer.IsIdle());
+    }
+
+    SECTION("Test a screenshot is taken while idle") {
+      const auto path = std::filesystem::temp_directory_path() / "swgtk_idle_screenshot.png";
+      std::error_code error;
+      std::filesystem::remove(path, error);
+
+      renderer.GetCapture().Screenshot(path);
+      REQUIRE_FALSE(renderer.BeginRedraw(blue));
+      renderer.BufferPresent();
+      REQUIRE(renderer.IsIdle());
+
+      // Read from the back buffer, so the target wasn't presented to.
+      REQUIRE(PixelIs(target, 8, 8, marker));
+
+      renderer.GetCapture().Stop();
+      REQUIRE(renderer.GetCapture().GetStats().written == 1u);
+      REQUIRE(std::filesystem::exists(path));
+      std::filesystem::remove(path, error);
+    }
+
+    SECTION("Test a requested present shows the last frame again") {
+      renderer.RequestPresent();
+      REQUIRE_FALSE(renderer.BeginRedraw(blue));
+      renderer.BufferPresent();
+      REQUIRE_FALSE(renderer.IsIdle());
+      REQUIRE(PixelIs(target, 8, 8, blue));
+    }
+  }
+
+  SDL_DestroySurface(target);
+}
+
+TEST_CASE("Dirty rendering idle benchmark", "[.][benchmark]") {
+  constexpr auto frames = 600;
+
+  auto* target = SDL_CreateSurface(1280, 720, SDL_PIXELFORMAT_RGBA32);
+  REQUIRE(target != nullptr);
+
+  {
+    swgtk::SDLHW2D renderer;
+    REQUIRE(renderer.PrepareHeadless(target));
+
+    swgtk::Timer timer;
+
+    for (auto frame = 0; frame < frames; ++frame) {
+      std::ignore = renderer.BeginRedraw(blue);
+      renderer.BufferPresent();
+    }
+
+    const auto redrawing = timer.GetElapsedMilliseconds() / frames;
+
+    renderer.SetDirtyRendering(true);
+    std::ignore = renderer.BeginRedraw(blue);
+    renderer.BufferPresent();
+
+    timer.UpdateTime();
+
+    for (auto frame = 0; frame < frames; ++frame) {
+      std::ignore = renderer.BeginRedraw(blue);
+      renderer.BufferPresent();
+    }
+
+    const auto idle = timer.GetElapsedMilliseconds() / frames;
+
+    std::puts(std::format("720p software frames: {:.3f} ms clearing everything, {:.3f} ms idle with dirty rendering", redrawing, idle).c_str());
+    REQUIRE(renderer.IsIdle());
+  }
+
+  SDL_DestroySurface(target);
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <string>
+#include <swgtk/FontGroup.hpp>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+TEST_CASE("Font Group Tests") {
+  REQUIRE(TTF_Init());
+
+  swgtk::FontGroup fonts;
+  REQUIRE(fonts.LoadDefaultFont());
+
+  SECTION("Test lookups by name") {
+    const std::string name{SWGTK_DEFAULT_FONT_ID};
+
+    REQUIRE(fonts.GetFont(name).ptr == fonts.GetDefaultFont().ptr);
+    REQUIRE(fonts.GetFont("missing").ptr == nullptr);
+    REQUIRE(fonts.GetFont("missing", 12.0f).ptr == nullptr);
+    REQUIRE(fonts.GetVariantCount() == 0uz);
+  }
+
+  SECTION("Test sizes get their own font") {
+    const auto small = fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 12.0f);
+    const auto large = fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 32.0f);
+    const auto bold = fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 12.0f, swgtk::FontStyle::Bold);
+
+    REQUIRE(small.ptr != nullptr);
+    REQUIRE(small.ptr != large.ptr);
+    REQUIRE(small.ptr != bold.ptr);
+    REQUIRE(small.ptr != fonts.GetDefaultFont().ptr);
+
+    REQUIRE(TTF_GetFontSize(small.ptr) == 12.0f);
+    REQUIRE(TTF_GetFontSize(large.ptr) == 32.0f);
+    REQUIRE(TTF_GetFontSize(fonts.GetDefaultFont().ptr) == swgtk::defaultFontSize);
+    REQUIRE(swgtk::FontGroup::GetFontStyle(bold) == swgtk::FontStyle::Bold);
+
+    // Asking again hands back the same copy.
+    REQUIRE(fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 12.0f).ptr == small.ptr);
+    REQUIRE(fonts.GetVariantCount() == 3uz);
+  }
+
+  SECTION("Test the least recently used size is closed first") {
+    fonts.SetVariantLimit(2uz);
+
+    const auto first = fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 10.0f);
+    [[maybe_unused]] const auto second = fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 20.0f);
+
+    // Touch the first so the second is the oldest.
+    REQUIRE(fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 10.0f).ptr == first.ptr);
+
+    [[maybe_unused]] const auto third = fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 30.0f);
+    REQUIRE(fonts.GetVariantCount() == 2uz);
+    REQUIRE(fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 10.0f).ptr == first.ptr);
+    REQUIRE(fonts.GetVariantCount() == 2uz);
+
+    fonts.SetVariantLimit(1uz);
+    REQUIRE(fonts.GetVariantCount() == 1uz);
+    REQUIRE(fonts.GetFont(SWGTK_DEFAULT_FONT_ID, 10.0f).ptr == first.ptr);
+  }
+
+  SECTION("Test fonts load from memory") {
+    REQUIRE(fonts.AddFontFromMemory("copy", swgtk::FontGroup::GetDefaultFontData()));
+    REQUIRE(fonts.GetFont("copy").ptr != nullptr);
+    REQUIRE(fonts.GetFont("copy").ptr != fonts.GetDefaultFont().ptr);
+
+    // Names are only taken once, like AddFont().
+    REQUIRE_FALSE(fonts.AddFontFromMemory("copy", swgtk::FontGroup::GetDefaultFontData()));
+
+    const auto data = swgtk::FontGroup::GetDefaultFontData();
+    REQUIRE(fonts.AddFontFromMemory("owned", std::vector<std::byte>{data.begin(), data.end()}));
+    REQUIRE(fonts.GetFont("owned", 24.0f).ptr != nullptr);
+
+    const auto garbage = std::vector<std::byte>(64uz, std::byte{7});
+    REQUIRE_FALSE(fonts.AddFontFromMemory("garbage", garbage));
+    REQUIRE(fonts.GetFont("garbage").ptr == nullptr);
+  }
+
+  fonts.ClearFonts();
+  REQUIRE(fonts.GetDefaultFont().ptr == nullptr);
+  REQUIRE(fonts.GetVariantCount() == 0uz);
+
+  TTF_Quit();
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <swgtk/FrameArena.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+TEST_CASE("Frame Arena Tests") {
+  SECTION("Test typed allocations") {
+    swgtk::FrameArena arena{1024uz};
+
+    const auto ints = arena.Allocate<int>(16uz);
+    const auto doubles = arena.Allocate<double>(4uz);
+
+    REQUIRE(ints.size() == 16uz);
+    REQUIRE(ints[3] == 0);
+    REQUIRE(doubles.size() == 4uz);
+    REQUIRE(reinterpret_cast<uintptr_t>(doubles.data()) % alignof(double) == 0uz); // NOLINT(*-reinterpret-cast)
+    REQUIRE(arena.Allocate<int>(0uz).empty());
+  }
+
+  SECTION("Test steady state frames do not grow") {
+    swgtk::FrameArena arena{128uz};
+
+    const auto runFrame = [&arena] {
+      arena.Reset();
+      std::pmr::string text{&arena};
+
+      for (auto i = 0; i < 64; ++i) {
+        text += "frame data ";
+      }
+
+      return arena.GetUsedBytes();
+    };
+
+    runFrame();
+    runFrame();
+
+    const auto blocks = arena.GetBlockAllocations();
+
+    for (auto i = 0; i < 10; ++i) {
+      runFrame();
+    }
+
+    REQUIRE(arena.GetBlockAllocations() == blocks);
+    REQUIRE(arena.GetHighWaterMark() >= arena.GetUsedBytes());
+    REQUIRE(arena.GetCapacity() >= arena.GetHighWaterMark());
+  }
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
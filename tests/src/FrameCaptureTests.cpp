@@ -0,0 +1,161 @@
+#include <SDL3/SDL_surface.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <swgtk/FrameCapture.hpp>
+#include <swgtk/Timer.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  // A frame the way SDL_RenderReadPixels() hands it over, owned by whoever it's submitted to.
+  [[nodiscard]] auto SolidFrame(const int width, const int height, const Uint8 r, const Uint8 g, const Uint8 b) -> SDL_Surface* {
+    auto* frame = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+    SDL_FillSurfaceRect(frame, nullptr, SDL_MapSurfaceRGB(frame, r, g, b));
+    return frame;
+  }
+
+  [[nodiscard]] auto ReadFile(const std::filesystem::path& path) -> std::string {
+    std::ifstream file{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  }
+} // namespace
+
+TEST_CASE("Frame Capture Tests") {
+  const auto directory = std::filesystem::temp_directory_path() / "swgtk_frame_capture";
+  std::error_code error;
+  std::filesystem::remove_all(directory, error);
+  std::filesystem::create_directories(directory, error);
+
+  SECTION("Test Y4M video is written as 4:2:0 full range") {
+    const auto path = directory / "red.y4m";
+    swgtk::FrameCapture capture;
+    REQUIRE(capture.Start(path, swgtk::CaptureFormat::Y4m, 1u, 30));
+    REQUIRE(capture.IsRecording());
+
+    for (auto i = 0; i < 2; ++i) {
+      REQUIRE(capture.IsFrameDue());
+      capture.Submit(SolidFrame(4, 2, 255, 0, 0));
+    }
+
+    capture.Stop();
+    REQUIRE_FALSE(capture.IsRecording());
+    REQUIRE(capture.GetStats().written == 2u);
+
+    const auto header = std::string{"YUV4MPEG2 W4 H2 F30:1 Ip A1:1 C420jpeg\n"};
+    const auto frameSize = 4uz * 2uz + 2uz * 2uz;
+    const auto video = ReadFile(path);
+    REQUIRE(video.size() == header.size() + 2uz * (6uz + frameSize));
+    REQUIRE(video.starts_with(header));
+
+    const auto first = header.size() + 6uz;
+    REQUIRE(video.substr(header.size(), 6uz) == "FRAME\n");
+    REQUIRE(static_cast<uint8_t>(video[first]) == 76u);
+    REQUIRE(static_cast<uint8_t>(video[first + 8uz]) == 85u);
+    REQUIRE(static_cast<uint8_t>(video[first + 10uz]) == 255u);
+  }
+
+  SECTION("Test every Nth frame is recorded") {
+    swgtk::FrameCapture capture;
+    REQUIRE(capture.Start(directory / "nth.y4m", swgtk::CaptureFormat::Y4m, 3u));
+
+    auto due = 0;
+
+    for (auto i = 0; i < 9; ++i) {
+      if (capture.IsFrameDue()) {
+        ++due;
+        capture.Submit(SolidFrame(2, 2, 0, 0, 0));
+      }
+    }
+
+    capture.Stop();
+    REQUIRE(due == 3);
+    REQUIRE(capture.GetStats().captured == 3u);
+  }
+
+  SECTION("Test the queue is bounded and every due frame is accounted for") {
+    swgtk::FrameCapture capture;
+    capture.SetQueueDepth(1uz);
+    REQUIRE(capture.Start(directory / "bounded.y4m", swgtk::CaptureFormat::Y4m));
+
+    for (auto i = 0; i < 50; ++i) {
+      if (capture.IsFrameDue()) {
+        capture.Submit(SolidFrame(64, 64, 0, 0, 255));
+      }
+    }
+
+    capture.Stop();
+    const auto stats = capture.GetStats();
+    REQUIRE(stats.captured + stats.dropped == 50u);
+    REQUIRE(stats.written == stats.captured);
+    REQUIRE(stats.failed == 0u);
+  }
+
+  SECTION("Test frames of another size fail instead of corrupting the video") {
+    swgtk::FrameCapture capture;
+    REQUIRE(capture.Start(directory / "resized.y4m", swgtk::CaptureFormat::Y4m));
+
+    REQUIRE(capture.IsFrameDue());
+    capture.Submit(SolidFrame(4, 4, 0, 0, 0));
+    REQUIRE(capture.IsFrameDue());
+    capture.Submit(SolidFrame(8, 4, 0, 0, 0));
+    capture.Stop();
+
+    REQUIRE(capture.GetStats().written == 1u);
+    REQUIRE(capture.GetStats().failed == 1u);
+  }
+
+  SECTION("Test screenshots and PNG frames are written") {
+    swgtk::FrameCapture capture;
+    REQUIRE_FALSE(capture.IsFrameDue());
+
+    capture.Screenshot(directory / "shot.png");
+    REQUIRE(capture.IsFrameDue());
+    capture.Submit(SolidFrame(8, 8, 0, 255, 0));
+
+    REQUIRE(capture.Start(directory / "frames", swgtk::CaptureFormat::Png));
+    REQUIRE(capture.IsFrameDue());
+    capture.Submit(SolidFrame(8, 8, 0, 255, 0));
+    capture.Stop();
+
+    REQUIRE(std::filesystem::exists(directory / "shot.png"));
+    REQUIRE(std::filesystem::exists(directory / "frames" / "frame_000000.png"));
+    REQUIRE(capture.GetStats().written == 2u);
+  }
+
+  std::filesystem::remove_all(directory, error);
+}
+
+TEST_CASE("Frame capture benchmark", "[.][benchmark]") {
+  constexpr auto frames = 120;
+  const auto path = std::filesystem::temp_directory_path() / "swgtk_capture_benchmark.y4m";
+
+  swgtk::FrameCapture capture;
+  REQUIRE(capture.Start(path, swgtk::CaptureFormat::Y4m));
+
+  swgtk::Timer timer;
+
+  for (auto i = 0; i < frames; ++i) {
+    if (capture.IsFrameDue()) {
+      capture.Submit(SolidFrame(1280, 720, static_cast<Uint8>(i), 64, 128));
+    }
+  }
+
+  const auto submitting = timer.GetElapsedMilliseconds() / frames;
+  capture.Stop();
+  const auto stats = capture.GetStats();
+
+  std::puts(std::format("720p Y4M capture: {:.3f} ms per frame on the caller, {:.3f} ms to finish, {} written, {} dropped", submitting,
+                        timer.GetElapsedMilliseconds(), stats.written, stats.dropped).c_str());
+
+  std::error_code error;
+  std::filesystem::remove(path, error);
+  REQUIRE(stats.written + stats.dropped == static_cast<uint64_t>(frames));
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,252 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <swgtk/HandlePool.hpp>
+#include <swgtk/Texture.hpp>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  struct Dummy {
+    int value = 0;
+  };
+
+  int destroyedCount = 0;
+
+  void DestroyDummy(Dummy* dummy) {
+    ++destroyedCount;
+    delete dummy; // NOLINT(cppcoreguidelines-owning-memory)
+  }
+
+  using DummyPool = swgtk::HandlePool<Dummy, DestroyDummy>;
+
+  DummyPool dummyRegistry;
+
+  struct DummyHandle {
+    swgtk::HandleID id = swgtk::nullHandle;
+
+    void Destroy() const { dummyRegistry.Destroy(id); }
+  };
+
+  // The shape of Texture before it became a handle, kept here so the benchmark can compare the two.
+  struct SharedTexture {
+    std::shared_ptr<SDL_Texture> texture;
+  };
+
+  template<typename TextureType>
+  struct DrawCommand {
+    TextureType texture;
+    SDL_FRect dest{};
+  };
+} // namespace
+
+TEST_CASE("Handle Pool Tests") {
+  destroyedCount = 0;
+
+  SECTION("Test type traits") {
+    STATIC_REQUIRE(std::is_trivially_copyable_v<swgtk::Texture>);
+    STATIC_REQUIRE(std::is_trivially_destructible_v<swgtk::Texture>);
+    STATIC_REQUIRE(sizeof(swgtk::Texture) == sizeof(swgtk::HandleID));
+  }
+
+  SECTION("Test insert and lookup") {
+    DummyPool pool;
+    auto* first = new Dummy{.value = 1}; // NOLINT(cppcoreguidelines-owning-memory)
+    auto* second = new Dummy{.value = 2}; // NOLINT(cppcoreguidelines-owning-memory)
+
+    const auto a = pool.Insert(first);
+    const auto b = pool.Insert(second);
+
+    REQUIRE(a != swgtk::nullHandle);
+    REQUIRE(b != swgtk::nullHandle);
+    REQUIRE(a != b);
+    REQUIRE(pool.Get(a) == first);
+    REQUIRE(pool.Get(b) == second);
+    REQUIRE(pool.Size() == 2u);
+    REQUIRE(pool.Insert(nullptr) == swgtk::nullHandle);
+    REQUIRE(pool.Get(swgtk::nullHandle) == nullptr);
+  }
+
+  SECTION("Test stale handles after reuse") {
+    DummyPool pool;
+    const auto a = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+    const auto b = pool.Insert(new Dummy{.value = 2}); // NOLINT(cppcoreguidelines-owning-memory)
+
+    REQUIRE(pool.Destroy(a));
+    REQUIRE_FALSE(pool.Destroy(a));
+    REQUIRE(destroyedCount == 1);
+    REQUIRE(pool.Get(b)->value == 2);
+
+    const auto c = pool.Insert(new Dummy{.value = 3}); // NOLINT(cppcoreguidelines-owning-memory)
+
+    REQUIRE((c & DummyPool::indexMask) == (a & DummyPool::indexMask));
+    REQUIRE_FALSE(pool.IsValid(a));
+    REQUIRE(pool.Get(c)->value == 3);
+  }
+
+  SECTION("Test a slot is retired once its generations run out") {
+    DummyPool pool;
+    const auto first = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+    auto id = first;
+    auto sameSlot = true;
+
+    for (auto generation = 1u; generation < DummyPool::maxGeneration; ++generation) {
+      pool.Destroy(id);
+      id = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+      sameSlot = sameSlot && (id & DummyPool::indexMask) == (first & DummyPool::indexMask);
+    }
+
+    REQUIRE(sameSlot);
+    REQUIRE(pool.Destroy(id));
+
+    const auto next = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+
+    REQUIRE((next & DummyPool::indexMask) != (first & DummyPool::indexMask));
+    REQUIRE_FALSE(pool.IsValid(first));
+    REQUIRE_FALSE(pool.IsValid(id));
+  }
+
+  SECTION("Test unique handles destroy what they own") {
+    {
+      swgtk::UniqueHandle<DummyHandle> owner{DummyHandle{.id = dummyRegistry.Insert(new Dummy{})}}; // NOLINT(cppcoreguidelines-owning-memory)
+      swgtk::UniqueHandle<DummyHandle> moved{std::move(owner)};
+
+      REQUIRE(owner.id == swgtk::nullHandle); // NOLINT(bugprone-use-after-move)
+      REQUIRE(dummyRegistry.IsValid(moved.id));
+
+      const DummyHandle released = swgtk::UniqueHandle<DummyHandle>{DummyHandle{.id = dummyRegistry.Insert(new Dummy{})}}.Release(); // NOLINT(cppcoreguidelines-owning-memory)
+      REQUIRE(dummyRegistry.IsValid(released.id));
+      released.Destroy();
+
+      moved.Reset(DummyHandle{.id = dummyRegistry.Insert(new Dummy{})}); // NOLINT(cppcoreguidelines-owning-memory)
+      REQUIRE(destroyedCount == 2);
+    }
+
+    REQUIRE(destroyedCount == 3);
+    REQUIRE(dummyRegistry.Size() == 0uz);
+  }
+
+  SECTION("Test deferred destruction") {
+    DummyPool pool;
+    const auto a = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+
+    pool.DestroyDeferred(a);
+    pool.DestroyDeferred(a);
+
+    REQUIRE(pool.IsValid(a));
+    REQUIRE(pool.PendingCount() == 2u);
+
+    pool.FlushDeferred();
+
+    REQUIRE_FALSE(pool.IsValid(a));
+    REQUIRE(destroyedCount == 1);
+    REQUIRE(pool.PendingCount() == 0u);
+  }
+
+  SECTION("Test clear") {
+    {
+      DummyPool pool;
+      const auto a = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+      std::ignore = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+
+      pool.Clear();
+
+      REQUIRE(destroyedCount == 2);
+      REQUIRE_FALSE(pool.IsValid(a));
+
+      std::ignore = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    REQUIRE(destroyedCount == 3);
+  }
+
+  SECTION("Test destroying only some resources") {
+    DummyPool pool;
+    const auto a = pool.Insert(new Dummy{.value = 1}); // NOLINT(cppcoreguidelines-owning-memory)
+    const auto b = pool.Insert(new Dummy{.value = 2}); // NOLINT(cppcoreguidelines-owning-memory)
+    const auto c = pool.Insert(new Dummy{.value = 1}); // NOLINT(cppcoreguidelines-owning-memory)
+
+    REQUIRE(pool.DestroyIf([](const Dummy* dummy) { return dummy->value == 1; }) == 2u);
+    REQUIRE(destroyedCount == 2);
+    REQUIRE_FALSE(pool.IsValid(a));
+    REQUIRE(pool.IsValid(b));
+    REQUIRE_FALSE(pool.IsValid(c));
+    REQUIRE(pool.Get(b)->value == 2);
+  }
+
+  SECTION("Test move assignment releases what the pool held") {
+    {
+      DummyPool pool;
+      DummyPool other;
+      std::ignore = pool.Insert(new Dummy{}); // NOLINT(cppcoreguidelines-owning-memory)
+      const auto kept = other.Insert(new Dummy{.value = 7}); // NOLINT(cppcoreguidelines-owning-memory)
+
+      pool = std::move(other);
+
+      REQUIRE(destroyedCount == 1);
+      REQUIRE(pool.Get(kept)->value == 7);
+    }
+
+    REQUIRE(destroyedCount == 2);
+  }
+}
+
+TEST_CASE("Draw submission benchmark", "[.][benchmark]") {
+  constexpr auto drawCount = 10'000uz;
+  constexpr auto targetSize = 256;
+
+  auto* target = SDL_CreateSurface(targetSize, targetSize, SDL_PIXELFORMAT_RGBA32);
+  auto* renderer = SDL_CreateSoftwareRenderer(target);
+  auto* raw = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 8, 8);
+
+  REQUIRE(raw != nullptr);
+
+  const auto shared = SharedTexture{.texture = std::shared_ptr<SDL_Texture>{raw, [](SDL_Texture*) {}}};
+  const auto handle = swgtk::Texture{raw};
+
+  std::vector<DrawCommand<SharedTexture>> sharedCommands;
+  std::vector<DrawCommand<swgtk::Texture>> handleCommands;
+  sharedCommands.reserve(drawCount);
+  handleCommands.reserve(drawCount);
+
+  BENCHMARK("Queue draws, shared_ptr texture") {
+    sharedCommands.clear();
+    for (auto i = 0uz; i < drawCount; ++i) {
+      sharedCommands.push_back(DrawCommand<SharedTexture>{.texture = shared, .dest = SDL_FRect{.x = static_cast<float>(i % 200uz), .y = 0.0f, .w = 8.0f, .h = 8.0f}});
+    }
+    return sharedCommands.size();
+  };
+
+  BENCHMARK("Queue draws, handle texture") {
+    handleCommands.clear();
+    for (auto i = 0uz; i < drawCount; ++i) {
+      handleCommands.push_back(DrawCommand<swgtk::Texture>{.texture = handle, .dest = SDL_FRect{.x = static_cast<float>(i % 200uz), .y = 0.0f, .w = 8.0f, .h = 8.0f}});
+    }
+    return handleCommands.size();
+  };
+
+  BENCHMARK("Submit draws, shared_ptr texture") {
+    for (const auto& [texture, dest]: sharedCommands) {
+      const auto copy = texture;
+      SDL_RenderTexture(renderer, copy.texture.get(), nullptr, &dest);
+    }
+    return SDL_FlushRenderer(renderer);
+  };
+
+  BENCHMARK("Submit draws, handle texture") {
+    for (const auto& [texture, dest]: handleCommands) {
+      const auto copy = texture;
+      SDL_RenderTexture(renderer, *copy, nullptr, &dest);
+    }
+    return SDL_FlushRenderer(renderer);
+  };
+
+  swgtk::TextureRegistry().Clear();
+  SDL_DestroyRenderer(renderer);
+  SDL_DestroySurface(target);
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,208 @@
+#ifdef SWGTK_BUILD_WITH_LUA
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <swgtk/LuaBytecode.hpp>
+#include <swgtk/Timer.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  auto TempDirectory(const std::string& name) -> std::filesystem::path {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::error_code error;
+
+    std::filesystem::remove_all(path, error);
+    std::filesystem::create_directories(path, error);
+
+    return path;
+  }
+
+  void WriteText(const std::filesystem::path& path, const std::string& text) {
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file << text;
+  }
+
+  auto RunChunk(sol::state& lua, swgtk::LuaBytecodeCache& cache, const std::filesystem::path& script) -> int {
+    auto chunk = cache.Load(lua, script);
+
+    if (!chunk.valid()) {
+      return -1;
+    }
+
+    const sol::protected_function function = chunk;
+    return function().get<int>();
+  }
+
+  // Roughly the size of a few hundred KB of game scripts: many small functions with tables and string work.
+  auto GenerateScript(const size_t functions) -> std::string {
+    std::string source;
+
+    for (auto i = 0uz; i < functions; ++i) {
+      source += std::format(
+          "local function Update{0}(state, dt)\n"
+          "  local t = {{ x = state.x + dt * {0}, y = state.y - dt, name = \"entity{0}\" }}\n"
+          "  for i = 1, 4 do t.x = t.x + i * 0.5 end\n"
+          "  if t.x > 100 then t.name = t.name .. \"_far\" end\n"
+          "  return t\n"
+          "end\n",
+          i);
+    }
+
+    return source + "return 0\n";
+  }
+} // namespace
+
+TEST_CASE("Lua Bytecode Cache Tests") {
+  const auto directory = TempDirectory("swgtk_luac_tests");
+  const auto script = directory / "script.lua";
+  const auto cacheDir = directory / "cache";
+
+  WriteText(script, "local a = 20\nreturn a + 22\n");
+
+  std::error_code error;
+  std::filesystem::create_directories(cacheDir, error);
+
+  SECTION("Test a miss writes an entry that later loads hit") {
+    sol::state lua;
+    auto cache = swgtk::LuaBytecodeCache{cacheDir};
+
+    REQUIRE(RunChunk(lua, cache, script) == 42);
+    REQUIRE(cache.GetStats().misses == 1uz);
+    REQUIRE(cache.GetStats().writes == 1uz);
+
+    auto reopened = swgtk::LuaBytecodeCache{cacheDir};
+
+    REQUIRE(RunChunk(lua, reopened, script) == 42);
+    REQUIRE(reopened.GetStats().hits == 1uz);
+  }
+
+  SECTION("Test edited sources do not use the old entry") {
+    sol::state lua;
+    auto cache = swgtk::LuaBytecodeCache{cacheDir};
+
+    REQUIRE(RunChunk(lua, cache, script) == 42);
+
+    WriteText(script, "return 7\n");
+
+    REQUIRE(RunChunk(lua, cache, script) == 7);
+    REQUIRE(cache.GetStats().misses == 2uz);
+    REQUIRE(cache.GetStats().hits == 0uz);
+  }
+
+  SECTION("Test corrupt entries fall back to source") {
+    sol::state lua;
+    auto cache = swgtk::LuaBytecodeCache{cacheDir};
+
+    REQUIRE(RunChunk(lua, cache, script) == 42);
+
+    const auto entry = cache.EntryPath(swgtk::LuaBytecodeCache::HashSource("local a = 20\nreturn a + 22\n"));
+
+    REQUIRE(std::filesystem::exists(entry));
+
+    auto text = std::string(std::filesystem::file_size(entry), '\0');
+    {
+      auto file = std::ifstream{entry, std::ios::binary};
+      file.read(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    // Damage Lua's own signature, which follows the 32 byte cache header, so only lua_load() can notice.
+    text[32uz] = 'X';
+    WriteText(entry, text);
+
+    auto readOnly = swgtk::LuaBytecodeCache{cacheDir, false};
+
+    REQUIRE(RunChunk(lua, readOnly, script) == 42);
+    REQUIRE(readOnly.GetStats().rejected == 1uz);
+    REQUIRE_FALSE(std::filesystem::exists(entry));
+  }
+
+  SECTION("Test loading never creates the cache directory") {
+    sol::state lua;
+    const auto missing = directory / "missing";
+    auto cache = swgtk::LuaBytecodeCache{missing};
+
+    REQUIRE(RunChunk(lua, cache, script) == 42);
+    REQUIRE(cache.GetStats().writes == 0uz);
+    REQUIRE_FALSE(std::filesystem::exists(missing));
+  }
+
+  SECTION("Test the build step produces entries the runtime accepts") {
+    sol::state compiler;
+    auto buildCache = swgtk::LuaBytecodeCache{cacheDir};
+
+    REQUIRE(buildCache.Precompile(compiler.lua_state(), script));
+
+    sol::state lua;
+    auto cache = swgtk::LuaBytecodeCache{cacheDir, false};
+
+    REQUIRE(RunChunk(lua, cache, script) == 42);
+    REQUIRE(cache.GetStats().hits == 1uz);
+  }
+
+  SECTION("Test scripts that do not compile are not cached") {
+    sol::state lua;
+    auto cache = swgtk::LuaBytecodeCache{cacheDir};
+
+    WriteText(script, "return (\n");
+
+    REQUIRE(RunChunk(lua, cache, script) == -1);
+    REQUIRE(cache.GetStats().writes == 0uz);
+    REQUIRE_FALSE(cache.Precompile(lua.lua_state(), script));
+  }
+
+  std::filesystem::remove_all(directory, error);
+}
+
+TEST_CASE("Lua startup benchmark", "[.][benchmark]") {
+  const auto directory = TempDirectory("swgtk_luac_bench");
+  const auto script = directory / "game.lua";
+  const auto source = GenerateScript(1500uz);
+
+  WriteText(script, source);
+
+  sol::state lua;
+  auto cache = swgtk::LuaBytecodeCache{directory / "cache"};
+
+  REQUIRE(cache.Precompile(lua.lua_state(), script));
+  INFO(std::format("Source size: {} KB", source.size() / 1024uz));
+
+  BENCHMARK("Load from source") {
+    return lua.load_file(script.string()).valid();
+  };
+
+  BENCHMARK("Load from bytecode cache") {
+    return cache.Load(lua, script).valid();
+  };
+
+  // What a launch saves: a fresh state loading the game once, from source and then through the cache.
+  const auto launch = [&](const bool cached) {
+    constexpr auto launches = 20;
+    swgtk::Timer timer;
+
+    for (auto i = 0; i < launches; ++i) {
+      sol::state fresh;
+      REQUIRE((cached ? cache.Load(fresh, script) : fresh.load_file(script.string())).valid());
+    }
+
+    return timer.GetElapsedMilliseconds() / launches;
+  };
+
+  const auto fromSource = launch(false);
+  const auto fromCache = launch(true);
+
+  std::puts(std::format("Startup with {} KB of scripts: {:.3f} ms from source, {:.3f} ms from bytecode, {:.0f}% saved", source.size() / 1024uz,
+                        fromSource, fromCache, 100.0 * (1.0 - fromCache / fromSource)).c_str());
+
+  std::error_code error;
+  std::filesystem::remove_all(directory, error);
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
+
+#endif
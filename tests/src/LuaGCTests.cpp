@@ -0,0 +1,120 @@
+#ifdef SWGTK_BUILD_WITH_LUA
+
+#include <catch2/catch_test_macros.hpp>
+#include <sol/sol.hpp>
+#include <swgtk/LuaGC.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  // Roughly 100 KB of short-lived tables per call.
+  constexpr auto makeGarbage = R"(
+    local t = {}
+    for i = 1, 2000 do t[i] = { i, i * 2, tostring(i) } end
+  )";
+} // namespace
+
+TEST_CASE("Lua GC Tests") {
+  SECTION("Test stepping stops the automatic collector") {
+    sol::state lua;
+
+    {
+      swgtk::LuaGC gc{lua.lua_state()};
+
+      REQUIRE(gc.IsAttached());
+      REQUIRE_FALSE(gc.IsStepping());
+      REQUIRE(lua_gc(lua.lua_state(), LUA_GCISRUNNING) == 1);
+
+      gc.Step(0.0);
+
+      REQUIRE(gc.IsStepping());
+      REQUIRE(lua_gc(lua.lua_state(), LUA_GCISRUNNING) == 0);
+    }
+
+    REQUIRE(lua_gc(lua.lua_state(), LUA_GCISRUNNING) == 1);
+  }
+
+  SECTION("Test garbage is collected when nothing steps") {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+
+    swgtk::LuaGC gc{lua.lua_state()};
+    gc.Step(0.0);
+    gc.HandBack();
+
+    REQUIRE_FALSE(gc.IsStepping());
+    REQUIRE(lua_gc(lua.lua_state(), LUA_GCISRUNNING) == 1);
+
+    for (auto i = 0; i < 200; ++i) {
+      lua.script(makeGarbage);
+    }
+
+    REQUIRE(gc.GetHeapBytes() < 16uz * 1024uz * 1024uz);
+  }
+
+  SECTION("Test frame steps keep the heap bounded") {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+
+    swgtk::LuaGC gc{lua.lua_state()};
+    gc.SetStepLimits(0.5, 2.0);
+
+    for (auto frame = 0; frame < 300; ++frame) {
+      lua.script(makeGarbage);
+      gc.Step(0.0);
+    }
+
+    // Without stepping, 300 frames of garbage would be about 30 MB.
+    REQUIRE(gc.GetStats().cycles > 0uz);
+    REQUIRE(gc.GetStats().peakHeapBytes < 16uz * 1024uz * 1024uz);
+  }
+
+  SECTION("Test frames with no idle time still make progress") {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+
+    swgtk::LuaGC gc{lua.lua_state()};
+
+    for (auto frame = 0; frame < 300; ++frame) {
+      lua.script(makeGarbage);
+      gc.Step(swgtk::LuaGC::defaultFrameBudget * 2.0);
+      REQUIRE(gc.GetStats().lastSteps > 0uz);
+
+      if (gc.GetStats().cycles > 0uz) {
+        break;
+      }
+    }
+
+    REQUIRE(gc.GetStats().cycles > 0uz);
+  }
+
+  SECTION("Test generational mode collects") {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+
+    swgtk::LuaGC gc{lua.lua_state(), swgtk::LuaGCMode::Generational};
+
+    for (auto frame = 0; frame < 50; ++frame) {
+      lua.script(makeGarbage);
+      gc.Step(0.0);
+    }
+
+    REQUIRE(gc.GetStats().cycles > 0uz);
+  }
+
+  SECTION("Test closing the state first releases the collector") {
+    swgtk::LuaGC gc;
+
+    {
+      sol::state lua;
+      gc.Attach(lua.lua_state());
+      REQUIRE(gc.IsAttached());
+    }
+
+    REQUIRE_FALSE(gc.IsAttached());
+  }
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
+
+#endif
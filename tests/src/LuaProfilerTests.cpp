@@ -0,0 +1,182 @@
+#ifdef SWGTK_BUILD_WITH_LUA
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <sol/sol.hpp>
+#include <string>
+#include <string_view>
+#include <swgtk/LuaProfiler.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  constexpr auto workload = R"(
+    function leaf(n)
+      local x = 0
+      for i = 1, n do x = x + i % 7 end
+      return x
+    end
+
+    function heavy() return leaf(200000) end
+    function light() return leaf(20000) end
+
+    function run()
+      for i = 1, 5 do
+        heavy()
+        light()
+      end
+    end
+  )";
+
+  auto FindProfile(const std::vector<swgtk::LuaFunctionProfile>& profiles, const std::string_view name) -> const swgtk::LuaFunctionProfile* {
+    const auto found = std::ranges::find_if(profiles, [name](const auto& profile) { return profile.name.starts_with(name); });
+    return (found != profiles.end()) ? &*found : nullptr;
+  }
+} // namespace
+
+TEST_CASE("Lua Profiler Tests") {
+  sol::state lua;
+  lua.open_libraries(sol::lib::base);
+  lua.script(workload);
+
+  swgtk::LuaProfiler profiler;
+
+  SECTION("Test nothing is sampled while stopped") {
+    lua.script("run()");
+
+    REQUIRE_FALSE(profiler.IsRunning());
+    REQUIRE(profiler.GetSampleCount() == 0uz);
+    REQUIRE(profiler.GetFoldedStacks().empty());
+  }
+
+  SECTION("Test samples follow where the instructions are spent") {
+    profiler.Start(lua.lua_state(), 100);
+    lua.script("run()");
+    profiler.Stop();
+
+    REQUIRE(profiler.GetSampleCount() > 100uz);
+
+    const auto profiles = profiler.GetFunctionProfiles();
+    const auto* leaf = FindProfile(profiles, "leaf");
+    const auto* heavy = FindProfile(profiles, "heavy");
+    const auto* light = FindProfile(profiles, "light");
+    const auto* run = FindProfile(profiles, "run");
+
+    REQUIRE(leaf != nullptr);
+    REQUIRE(heavy != nullptr);
+    REQUIRE(light != nullptr);
+    REQUIRE(run != nullptr);
+
+    // Nearly every instruction runs in leaf(), and heavy() calls it with ten times the work of light().
+    REQUIRE(leaf->selfSamples > run->selfSamples);
+    REQUIRE(heavy->totalSamples > light->totalSamples * 5uz);
+    REQUIRE(run->totalSamples >= heavy->totalSamples + light->totalSamples);
+    REQUIRE(run->totalSamples <= profiler.GetSampleCount());
+  }
+
+  SECTION("Test folded stacks list each path outermost first") {
+    profiler.Start(lua.lua_state(), 100);
+    lua.script("run()");
+    profiler.Stop();
+
+    const auto folded = profiler.GetFoldedStacks();
+
+    REQUIRE(folded.contains(";run ("));
+    REQUIRE(folded.contains(";heavy ("));
+    REQUIRE(folded.contains(";leaf ("));
+
+    // Every line ends in a positive weight, and the weights add up to the sample count.
+    auto total = 0uz;
+    auto lines = std::string_view{folded};
+
+    while (!lines.empty()) {
+      const auto end = lines.find('\n');
+      const auto line = lines.substr(0uz, end);
+      total += std::stoull(std::string{line.substr(line.rfind(' ') + 1uz)});
+      lines.remove_prefix(end + 1uz);
+    }
+
+    REQUIRE(total == profiler.GetSampleCount());
+  }
+
+  SECTION("Test restarting keeps samples until reset") {
+    profiler.Start(lua.lua_state(), 100);
+    lua.script("light()");
+    profiler.Stop();
+
+    const auto first = profiler.GetSampleCount();
+    REQUIRE(first > 0uz);
+
+    lua.script("light()");
+    REQUIRE(profiler.GetSampleCount() == first);
+
+    profiler.Start(lua.lua_state(), 100);
+    lua.script("light()");
+    profiler.Stop();
+    REQUIRE(profiler.GetSampleCount() > first);
+
+    profiler.Reset();
+    REQUIRE(profiler.GetSampleCount() == 0uz);
+    REQUIRE(profiler.GetFunctionProfiles().empty());
+  }
+}
+
+TEST_CASE("Lua Profiler closures of one function are counted together") {
+  sol::state lua;
+  lua.open_libraries(sol::lib::base);
+  lua.script(workload);
+
+  swgtk::LuaProfiler profiler;
+  profiler.Start(lua.lua_state(), 100);
+  lua.script(R"(
+    for i = 1, 20 do
+      local closure = function() return leaf(20000) end
+      closure()
+    end
+  )");
+  profiler.Stop();
+
+  const auto profiles = profiler.GetFunctionProfiles();
+  const auto closures = std::ranges::count_if(profiles, [](const auto& profile) { return profile.name.starts_with("closure ("); });
+  REQUIRE(closures == 1);
+}
+
+TEST_CASE("Lua Profiler coroutines of another state are not sampled") {
+  sol::state other;
+  other.open_libraries(sol::lib::base, sol::lib::coroutine);
+  other.script(workload);
+
+  sol::state lua;
+  lua.open_libraries(sol::lib::base);
+
+  swgtk::LuaProfiler profiler;
+
+  // The coroutine inherits the hook from its state while that state is profiled.
+  profiler.Start(other.lua_state(), 100);
+  other.script("task = coroutine.create(function() coroutine.yield(); run() end)");
+  other.script("coroutine.resume(task)");
+
+  profiler.Start(lua.lua_state(), 100);
+  profiler.Reset();
+  other.script("coroutine.resume(task)");
+
+  REQUIRE(profiler.IsRunning());
+  REQUIRE(profiler.GetSampleCount() == 0uz);
+  profiler.Stop();
+}
+
+TEST_CASE("Lua Profiler closing the state first releases the profiler") {
+  swgtk::LuaProfiler profiler;
+
+  {
+    sol::state lua;
+    profiler.Start(lua.lua_state());
+    REQUIRE(profiler.IsRunning());
+  }
+
+  REQUIRE_FALSE(profiler.IsRunning());
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
+
+#endif
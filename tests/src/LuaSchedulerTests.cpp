@@ -0,0 +1,215 @@
+#ifdef SWGTK_BUILD_WITH_LUA
+
+#include <catch2/catch_test_macros.hpp>
+#include <sol/sol.hpp>
+#include <swgtk/LuaScheduler.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  constexpr auto frameTime = 1.0 / 60.0;
+
+  void RunFrames(swgtk::LuaScheduler& tasks, const int frames) {
+    for (auto frame = 0; frame < frames; ++frame) {
+      tasks.Update(frameTime);
+    }
+  }
+} // namespace
+
+TEST_CASE("Lua Scheduler Tests") {
+  sol::state lua;
+  lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+
+  swgtk::LuaScheduler tasks;
+  tasks.Attach(lua.lua_state());
+
+  SECTION("Test spawned tasks start on the next update") {
+    lua.script(R"(
+      count = 0
+      id = swgtk.spawn(function(step)
+        for i = 1, 3 do
+          count = count + step
+          coroutine.yield()
+        end
+      end, 2)
+    )");
+
+    REQUIRE(lua.get<int>("count") == 0);
+    REQUIRE(tasks.IsRunning(lua.get<swgtk::LuaTaskID>("id")));
+
+    RunFrames(tasks, 1);
+    REQUIRE(lua.get<int>("count") == 2);
+
+    RunFrames(tasks, 3);
+    REQUIRE(lua.get<int>("count") == 6);
+    REQUIRE(tasks.GetStats().running == 0uz);
+    REQUIRE_FALSE(tasks.IsRunning(lua.get<swgtk::LuaTaskID>("id")));
+  }
+
+  SECTION("Test wait_frames skips the right number of updates") {
+    lua.script(R"(
+      resumed = 0
+      swgtk.spawn(function()
+        swgtk.wait_frames(5)
+        resumed = resumed + 1
+      end)
+    )");
+
+    RunFrames(tasks, 5);
+    REQUIRE(lua.get<int>("resumed") == 0);
+
+    RunFrames(tasks, 1);
+    REQUIRE(lua.get<int>("resumed") == 1);
+  }
+
+  SECTION("Test wait_seconds uses frame time") {
+    lua.script(R"(
+      done = false
+      swgtk.spawn(function()
+        swgtk.wait_seconds(0.5)
+        done = true
+      end)
+    )");
+
+    RunFrames(tasks, 1);
+    tasks.Update(0.25);
+    REQUIRE_FALSE(lua.get<bool>("done"));
+
+    tasks.Update(0.25);
+    REQUIRE(lua.get<bool>("done"));
+  }
+
+  SECTION("Test wait_until checks its predicate every frame") {
+    lua.script(R"(
+      ready = false
+      done = false
+      swgtk.spawn(function()
+        swgtk.wait_until(function() return ready end)
+        done = true
+      end)
+    )");
+
+    RunFrames(tasks, 10);
+    REQUIRE_FALSE(lua.get<bool>("done"));
+
+    lua["ready"] = true;
+    RunFrames(tasks, 1);
+    REQUIRE(lua.get<bool>("done"));
+  }
+
+  SECTION("Test a spent budget defers the remaining tasks") {
+    tasks.SetBudget(0.0);
+
+    lua.script(R"(
+      runs = 0
+      for i = 1, 4 do
+        swgtk.spawn(function()
+          while true do
+            runs = runs + 1
+            coroutine.yield()
+          end
+        end)
+      end
+    )");
+
+    // With no budget, one task still gets its turn each frame, and the turns rotate.
+    RunFrames(tasks, 1);
+    REQUIRE(tasks.GetStats().lastResumed == 1uz);
+    REQUIRE(tasks.GetStats().lastDeferred == 3uz);
+
+    RunFrames(tasks, 3);
+    REQUIRE(lua.get<int>("runs") == 4);
+
+    tasks.SetBudget(swgtk::LuaScheduler::defaultBudget);
+    RunFrames(tasks, 1);
+    REQUIRE(tasks.GetStats().lastResumed == 4uz);
+  }
+
+  SECTION("Test cancelled tasks are not resumed") {
+    lua.script(R"(
+      runs = 0
+      id = swgtk.spawn(function()
+        while true do
+          runs = runs + 1
+          coroutine.yield()
+        end
+      end)
+    )");
+
+    RunFrames(tasks, 2);
+    REQUIRE(lua.get<int>("runs") == 2);
+
+    lua.script("assert(swgtk.cancel(id))");
+    RunFrames(tasks, 2);
+
+    REQUIRE(lua.get<int>("runs") == 2);
+    REQUIRE(tasks.GetStats().running == 0uz);
+    REQUIRE_FALSE(tasks.Cancel(lua.get<swgtk::LuaTaskID>("id")));
+  }
+
+  SECTION("Test an error only stops the failing task") {
+    lua.script(R"(
+      survivor = 0
+      swgtk.spawn(function() error("boom") end)
+      swgtk.spawn(function()
+        swgtk.wait_frames(1)
+        survivor = 1
+      end)
+    )");
+
+    RunFrames(tasks, 2);
+
+    REQUIRE(tasks.GetStats().failed == 1uz);
+    REQUIRE(lua.get<int>("survivor") == 1);
+  }
+
+  SECTION("Test updating from inside a task is skipped") {
+    lua["update"] = [&tasks] { tasks.Update(frameTime); };
+
+    lua.script(R"(
+      turns = 0
+      swgtk.spawn(function()
+        for i = 1, 3 do
+          turns = turns + 1
+          update()
+          coroutine.yield()
+        end
+      end)
+    )");
+
+    RunFrames(tasks, 4);
+
+    REQUIRE(lua.get<int>("turns") == 3);
+    REQUIRE(tasks.GetStats().failed == 0uz);
+    REQUIRE(tasks.GetStats().running == 0uz);
+  }
+
+  SECTION("Test detaching disables the task functions") {
+    tasks.Detach();
+
+    const auto result = lua.safe_script("swgtk.spawn(function() end)", sol::script_pass_on_error);
+    REQUIRE_FALSE(result.valid());
+  }
+}
+
+TEST_CASE("Lua Scheduler closing the state first releases the scheduler") {
+  swgtk::LuaScheduler tasks;
+
+  {
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+    tasks.Attach(lua.lua_state());
+
+    lua.script("swgtk.spawn(function() swgtk.wait_frames(100) end)");
+    tasks.Update(frameTime);
+    REQUIRE(tasks.IsAttached());
+  }
+
+  REQUIRE_FALSE(tasks.IsAttached());
+  REQUIRE(tasks.GetStats().running == 0uz);
+  tasks.Update(frameTime);
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
+
+#endif
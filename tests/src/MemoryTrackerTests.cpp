@@ -0,0 +1,78 @@
+#include <SDL3/SDL_stdinc.h>
+#include <catch2/catch_test_macros.hpp>
+#include <memory_resource>
+#include <string>
+#include <swgtk/FrameArena.hpp>
+#include <swgtk/MemoryTracker.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+TEST_CASE("Memory Tracker Tests") {
+  SECTION("Test Lua allocator accounting") {
+    swgtk::MemoryTracker::NewFrame();
+    const auto before = swgtk::MemoryTracker::GetFrameStats(swgtk::MemoryTag::Lua);
+
+    auto* block = swgtk::MemoryTracker::LuaAllocator(nullptr, nullptr, 0uz, 100uz);
+    block = swgtk::MemoryTracker::LuaAllocator(nullptr, block, 100uz, 200uz);
+
+    swgtk::MemoryTracker::NewFrame();
+    const auto grown = swgtk::MemoryTracker::GetFrameStats(swgtk::MemoryTag::Lua);
+
+    REQUIRE(grown.allocations == 2uz);
+    REQUIRE(grown.bytesAllocated == 300uz);
+    REQUIRE(grown.residentBytes == before.residentBytes + 200uz);
+    REQUIRE(grown.peakResidentBytes >= grown.residentBytes);
+
+    REQUIRE(swgtk::MemoryTracker::LuaAllocator(nullptr, block, 200uz, 0uz) == nullptr);
+
+    swgtk::MemoryTracker::NewFrame();
+    REQUIRE(swgtk::MemoryTracker::GetFrameStats(swgtk::MemoryTag::Lua).residentBytes == before.residentBytes);
+  }
+
+  SECTION("Test steady state frames are allocation-free") {
+    swgtk::TrackedResource tracked{swgtk::MemoryTag::Engine};
+    swgtk::FrameArena arena{256uz, &tracked};
+
+    const auto runFrame = [&arena] {
+      swgtk::MemoryTracker::NewFrame();
+      arena.Reset();
+
+      std::pmr::string text{&arena};
+      for (auto i = 0; i < 100; ++i) {
+        text += "steady ";
+      }
+    };
+
+    runFrame();
+    runFrame();
+    runFrame();
+    swgtk::MemoryTracker::NewFrame();
+
+    REQUIRE(swgtk::MemoryTracker::GetFrameStats(swgtk::MemoryTag::Engine).allocations == 0uz);
+  }
+
+  SECTION("Test SDL blocks from before the allocator was installed") {
+    auto* early = SDL_malloc(64uz);
+
+    REQUIRE(swgtk::MemoryTracker::InstallSDLAllocator());
+    swgtk::MemoryTracker::NewFrame();
+    const auto before = swgtk::MemoryTracker::GetFrameStats(swgtk::MemoryTag::SDL);
+
+    auto* tracked = SDL_malloc(32uz);
+    early = SDL_realloc(early, 128uz);
+
+    swgtk::MemoryTracker::NewFrame();
+    const auto grown = swgtk::MemoryTracker::GetFrameStats(swgtk::MemoryTag::SDL);
+
+    REQUIRE(grown.allocations == 2uz);
+    REQUIRE(grown.residentBytes == before.residentBytes + 160uz);
+
+    SDL_free(tracked);
+    SDL_free(early);
+
+    swgtk::MemoryTracker::NewFrame();
+    REQUIRE(swgtk::MemoryTracker::GetFrameStats(swgtk::MemoryTag::SDL).residentBytes == before.residentBytes);
+  }
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
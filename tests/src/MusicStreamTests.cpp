@@ -0,0 +1,222 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <swgtk/AudioMixer.hpp>
+#include <swgtk/MusicStream.hpp>
+#include <swgtk/SpscQueue.hpp>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  // A 16-bit stereo .wav file whose frame n holds n in the left channel and -n in the right, then trailing zero bytes.
+  [[nodiscard]] auto WriteRampWav(const std::string& name, const uint32_t frames, const uint32_t trailing = 0u) -> std::filesystem::path {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream file{path, std::ios::binary};
+
+    const auto put16 = [&file](const uint16_t value) {
+      const std::array bytes{static_cast<char>(value & 0xFFu), static_cast<char>(value >> 8u)};
+      file.write(bytes.data(), bytes.size());
+    };
+
+    const auto put32 = [&put16](const uint32_t value) {
+      put16(static_cast<uint16_t>(value & 0xFFFFu));
+      put16(static_cast<uint16_t>(value >> 16u));
+    };
+
+    const auto dataSize = (frames * 4u) + trailing;
+
+    file.write("RIFF", 4);
+    put32(36u + dataSize);
+    file.write("WAVEfmt ", 8);
+    put32(16u);
+    put16(1u);
+    put16(2u);
+    put32(static_cast<uint32_t>(swgtk::defaultSampleRate));
+    put32(static_cast<uint32_t>(swgtk::defaultSampleRate) * 4u);
+    put16(4u);
+    put16(16u);
+    file.write("data", 4);
+    put32(dataSize);
+
+    for (auto i = 0u; i < frames; ++i) {
+      put16(static_cast<uint16_t>(i));
+      put16(static_cast<uint16_t>(-static_cast<int16_t>(i)));
+    }
+
+    for (auto i = 0u; i < trailing; ++i) {
+      file.put('\0');
+    }
+
+    return path;
+  }
+
+  // The frame number a sample of the ramp was decoded from.
+  [[nodiscard]] auto RampFrame(const float sample) -> int { return static_cast<int>(std::lround(sample * 32768.0f)); }
+
+  // Read until the stream is finished, waiting out underruns.
+  [[nodiscard]] auto ReadAll(swgtk::MusicStream& stream) -> std::vector<float> {
+    std::vector<float> samples;
+    std::vector<float> block(512uz * swgtk::audioChannels);
+
+    while (!stream.IsFinished()) {
+      const auto count = stream.Read(block);
+      samples.insert(samples.end(), block.begin(), block.begin() + static_cast<std::ptrdiff_t>(count));
+
+      if (count < block.size()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      }
+    }
+
+    return samples;
+  }
+} // namespace
+
+TEST_CASE("SPSC Ring Buffer Tests") {
+  SECTION("Test writes and reads wrap around the end of the buffer") {
+    swgtk::SpscRingBuffer<int> ring{6uz};
+    std::array<int, 8> out{};
+
+    REQUIRE(ring.GetCapacity() == 8uz);
+    REQUIRE(ring.Write(std::array{1, 2, 3, 4, 5, 6}) == 6uz);
+    REQUIRE(ring.Read(std::span{out}.first(4uz)) == 4uz);
+    REQUIRE(ring.Write(std::array{7, 8, 9, 10, 11, 12, 13}) == 6uz);
+    REQUIRE(ring.GetFreeSpace() == 0uz);
+
+    REQUIRE(ring.Read(out) == 8uz);
+    REQUIRE(out == std::array{5, 6, 7, 8, 9, 10, 11, 12});
+    REQUIRE(ring.Read(out) == 0uz);
+  }
+}
+
+TEST_CASE("Music Stream Tests") {
+  SECTION("Test a track streams through a buffer smaller than itself") {
+    constexpr auto frames = 20'000u;
+    const auto path = WriteRampWav("swgtk_stream_ramp.wav", frames);
+
+    swgtk::MusicStream stream{swgtk::defaultSampleRate, std::chrono::milliseconds{50}};
+    REQUIRE(stream.Open(path));
+    REQUIRE(stream.GetCapacityFrames() < frames);
+    REQUIRE(stream.GetBufferedFrames() > 0uz);
+
+    const auto samples = ReadAll(stream);
+    REQUIRE(samples.size() == frames * swgtk::audioChannels);
+
+    auto inOrder = true;
+
+    for (auto i = 0uz; i < frames; ++i) {
+      inOrder = inOrder && RampFrame(samples[(i * 2uz)]) == static_cast<int>(i) && RampFrame(samples[(i * 2uz) + 1uz]) == -static_cast<int>(i);
+    }
+
+    REQUIRE(inOrder);
+
+    stream.Close();
+    REQUIRE_FALSE(stream.IsOpen());
+    std::filesystem::remove(path);
+  }
+
+  SECTION("Test a data chunk ending part way through a frame only streams whole frames") {
+    constexpr auto frames = 1'000u;
+    const auto path = WriteRampWav("swgtk_stream_partial.wav", frames, 2u);
+
+    swgtk::MusicStream stream;
+    REQUIRE(stream.Open(path));
+
+    const auto samples = ReadAll(stream);
+    REQUIRE(samples.size() == frames * swgtk::audioChannels);
+    REQUIRE(RampFrame(samples.back()) == -static_cast<int>(frames - 1u));
+
+    stream.Close();
+    std::filesystem::remove(path);
+  }
+
+  SECTION("Test looping streams start over from the first frame") {
+    constexpr auto frames = 3'000u;
+    const auto path = WriteRampWav("swgtk_stream_loop.wav", frames);
+
+    swgtk::MusicStream stream{swgtk::defaultSampleRate, std::chrono::milliseconds{20}};
+    REQUIRE(stream.Open(path, true));
+
+    std::vector<float> block(2uz * swgtk::audioChannels);
+    auto read = 0uz;
+
+    // Read past the end of the track, one short block at a time.
+    while (read < frames + 10uz) {
+      if (stream.Read(block) == block.size()) {
+        read += 2uz;
+      }
+    }
+
+    REQUIRE(RampFrame(block[0]) == 8);
+    REQUIRE_FALSE(stream.IsFinished());
+
+    stream.Close();
+    std::filesystem::remove(path);
+  }
+
+  SECTION("Test reading faster than the worker decodes counts underruns") {
+    const auto path = WriteRampWav("swgtk_stream_underrun.wav", 48'000u);
+
+    swgtk::MusicStream stream{swgtk::defaultSampleRate, std::chrono::milliseconds{200}};
+    REQUIRE(stream.Open(path));
+    REQUIRE(stream.GetUnderrunCount() == 0u);
+
+    // Ask for a whole second at once, more than the buffer can ever hold.
+    std::vector<float> second(48'000uz * swgtk::audioChannels);
+    REQUIRE(stream.Read(second) < second.size());
+    REQUIRE(stream.GetUnderrunCount() == 1u);
+
+    stream.Close();
+    std::filesystem::remove(path);
+  }
+
+  SECTION("Test files that aren't music fail to open") {
+    const auto path = std::filesystem::temp_directory_path() / "swgtk_stream_text.wav";
+    std::ofstream{path} << "Not a wave file at all.";
+
+    swgtk::MusicStream stream;
+    REQUIRE_FALSE(stream.Open(path));
+    REQUIRE_FALSE(stream.Open(std::filesystem::temp_directory_path() / "swgtk_stream_missing.wav"));
+    REQUIRE_FALSE(stream.IsOpen());
+
+    std::filesystem::remove(path);
+  }
+
+  SECTION("Test the mixer plays a stream once and releases it at the end") {
+    const auto path = WriteRampWav("swgtk_stream_mixer.wav", 300u);
+
+    swgtk::AudioMixer mixer;
+    const auto stream = mixer.OpenMusic(path);
+    REQUIRE(stream != nullptr);
+
+    const auto voice = mixer.Play(stream);
+    REQUIRE(voice != swgtk::nullVoice);
+    REQUIRE(mixer.Play(stream) == swgtk::nullVoice);
+
+    std::vector<float> out(256uz * swgtk::audioChannels);
+    mixer.Mix(out);
+    REQUIRE(RampFrame(out[(100uz * 2uz)]) == 100);
+
+    for (auto wait = 0; wait < 200 && mixer.IsPlaying(voice); ++wait) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      mixer.Mix(out);
+      mixer.Update();
+    }
+
+    REQUIRE_FALSE(mixer.IsPlaying(voice));
+    REQUIRE(stream.use_count() == 1);
+
+    stream->Close();
+    std::filesystem::remove(path);
+  }
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
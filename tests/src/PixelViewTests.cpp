@@ -0,0 +1,158 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <swgtk/Surface.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+TEST_CASE("Pixel View Tests") {
+  SECTION("Test typed views write the surface's pixels") {
+    const swgtk::Surface surface{8, 4, SDL_PIXELFORMAT_RGBA32};
+
+    {
+      auto lock = surface.Lock();
+      const auto view = lock.View<swgtk::PixelRGBA32>();
+
+      REQUIRE_FALSE(view.Empty());
+      REQUIRE(view.Width() == 8);
+      REQUIRE(view.Height() == 4);
+
+      view.Fill(swgtk::PixelRGBA32{.r = 0u, .g = 0u, .b = 0u, .a = 255u});
+      view[3, 2] = swgtk::PixelRGBA32{.r = 255u, .g = 128u, .b = 0u, .a = 255u};
+    }
+
+    const auto color = surface.ReadPixel(3, 2);
+    REQUIRE(color.r == 1.0f);
+    REQUIRE(color.b == 0.0f);
+    REQUIRE(surface.ReadPixel(0, 0).r == 0.0f);
+
+    surface.Destroy();
+  }
+
+  SECTION("Test views refuse a pixel type that does not fit the format") {
+    const swgtk::Surface surface{4, 4, SDL_PIXELFORMAT_BGRA32};
+    auto lock = surface.Lock();
+
+    REQUIRE(lock.View<swgtk::PixelRGBA32>().Empty());
+    REQUIRE(lock.View<uint16_t>().Empty());
+    REQUIRE_FALSE(lock.View<swgtk::PixelBGRA32>().Empty());
+    REQUIRE_FALSE(lock.View<uint32_t>().Empty());
+
+    lock.Unlock();
+    REQUIRE(lock.View<uint32_t>().Empty());
+
+    surface.Destroy();
+  }
+
+  SECTION("Test rows step by the pitch") {
+    // Three bytes per pixel and an odd width, so rows are padded to a 4 byte boundary.
+    const swgtk::Surface surface{5, 3, SDL_PIXELFORMAT_RGB24};
+    auto lock = surface.Lock();
+    const auto view = lock.View<swgtk::PixelRGB24>();
+
+    REQUIRE_FALSE(view.IsContiguous());
+
+    view.ForEach([](const int x, const int y, swgtk::PixelRGB24& pixel) { pixel = swgtk::PixelRGB24{.r = static_cast<uint8_t>(x), .g = static_cast<uint8_t>(y), .b = 7u}; });
+
+    REQUIRE(view[4, 2] == swgtk::PixelRGB24{.r = 4u, .g = 2u, .b = 7u});
+    REQUIRE(lock.GetRGBA(lock.ReadRaw(4, 2)).r == 4u);
+    REQUIRE(lock.ReadBytes().size() == 5uz * 3uz * 3uz);
+
+    lock.Unlock();
+    surface.Destroy();
+  }
+
+  SECTION("Test raw values round trip through the surface format") {
+    const swgtk::Surface surface{2, 2, SDL_PIXELFORMAT_ARGB8888};
+    auto lock = surface.Lock();
+
+    const auto pixel = lock.MapRGBA(10u, 20u, 30u, 40u);
+    lock.WriteRaw(1, 1, pixel);
+
+    REQUIRE(lock.ReadRaw(1, 1) == pixel);
+
+    const auto color = lock.GetRGBA(pixel);
+    REQUIRE(color.r == 10u);
+    REQUIRE(color.a == 40u);
+
+    auto bytes = lock.ReadBytes();
+    REQUIRE(lock.WriteBytes(bytes));
+    REQUIRE_FALSE(lock.WriteBytes(bytes.substr(1uz)));
+
+    lock.Unlock();
+    surface.Destroy();
+  }
+
+  SECTION("Test batch conversion between formats") {
+    const swgtk::Surface source{16, 16, SDL_PIXELFORMAT_RGBA32};
+    const swgtk::Surface dest{16, 16, SDL_PIXELFORMAT_BGRA32};
+
+    auto sourceLock = source.Lock();
+    auto destLock = dest.Lock();
+
+    sourceLock.View<swgtk::PixelRGBA32>().Fill(swgtk::PixelRGBA32{.r = 1u, .g = 2u, .b = 3u, .a = 4u});
+
+    REQUIRE(swgtk::ConvertPixels(sourceLock.View<const swgtk::PixelRGBA32>(), destLock.View<swgtk::PixelBGRA32>()));
+    REQUIRE(destLock.View<swgtk::PixelBGRA32>()[15, 15] == swgtk::PixelBGRA32{.b = 3u, .g = 2u, .r = 1u, .a = 4u});
+
+    sourceLock.Unlock();
+
+    const auto converted = source.Convert(SDL_PIXELFORMAT_BGRA32);
+    REQUIRE(converted.IsValid());
+    REQUIRE((*converted)->format == SDL_PIXELFORMAT_BGRA32);
+
+    destLock.Unlock();
+    source.Destroy();
+    dest.Destroy();
+    converted.Destroy();
+  }
+
+  SECTION("Test destroying a locked surface") {
+    const swgtk::Surface surface{4, 4, SDL_PIXELFORMAT_RGBA32};
+    auto lock = surface.Lock();
+
+    REQUIRE(surface.IsLocked());
+
+    // Queued instead, so the lock is still usable for the rest of the frame.
+    surface.Destroy();
+    REQUIRE(surface.IsValid());
+    REQUIRE(lock.Width() == 4);
+
+    swgtk::SurfaceRegistry().FlushDeferred();
+
+    REQUIRE_FALSE(surface.IsValid());
+    REQUIRE_FALSE(lock.IsLocked());
+    REQUIRE(lock.Width() == 0);
+    REQUIRE(lock.View<uint32_t>().Empty());
+    REQUIRE(lock.ReadBytes().empty());
+
+    lock.WriteRaw(0, 0, 1u);
+    lock.Unlock();
+  }
+}
+
+TEST_CASE("Pixel write benchmark", "[.][benchmark]") {
+  constexpr auto size = 256;
+  const swgtk::Surface surface{size, size, SDL_PIXELFORMAT_RGBA32};
+
+  BENCHMARK("DrawPixel per pixel") {
+    for (auto y = 0; y < size; ++y) {
+      for (auto x = 0; x < size; ++x) {
+        surface.DrawPixel(x, y, SDL_FColor{.r = static_cast<float>(x) / size, .g = static_cast<float>(y) / size, .b = 0.5f, .a = 1.0f});
+      }
+    }
+    return surface.GetID();
+  };
+
+  BENCHMARK("PixelView") {
+    auto lock = surface.Lock();
+    lock.View<swgtk::PixelRGBA32>().ForEach([](const int x, const int y, swgtk::PixelRGBA32& pixel) {
+      pixel = swgtk::PixelRGBA32{.r = static_cast<uint8_t>(x), .g = static_cast<uint8_t>(y), .b = 128u, .a = 255u};
+    });
+    return lock.IsLocked();
+  };
+
+  surface.Destroy();
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
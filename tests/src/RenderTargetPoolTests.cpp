@@ -0,0 +1,161 @@
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_surface.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <format>
+#include <swgtk/RenderTargetPool.hpp>
+#include <swgtk/Timer.hpp>
+#include <tuple>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  // A software renderer, so targets can be created without a window.
+  struct SoftwareRenderer {
+    SoftwareRenderer() :
+        surface(SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32)),
+        renderer(SDL_CreateSoftwareRenderer(surface)) {}
+
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer(SoftwareRenderer&&) noexcept = delete;
+    auto operator=(const SoftwareRenderer&) -> SoftwareRenderer& = delete;
+    auto operator=(SoftwareRenderer&&) noexcept -> SoftwareRenderer& = delete;
+
+    ~SoftwareRenderer() {
+      SDL_DestroyRenderer(renderer);
+      SDL_DestroySurface(surface);
+    }
+
+    [[nodiscard]] auto Create(const swgtk::RenderTargetKey& key) -> swgtk::Texture {
+      ++creates;
+
+      if (auto* texture = SDL_CreateTexture(renderer, key.format, SDL_TEXTUREACCESS_TARGET, key.width, key.height); texture != nullptr) {
+        return swgtk::Texture{texture};
+      }
+
+      return swgtk::Texture{};
+    }
+
+    SDL_Surface* surface = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    int creates = 0;
+  };
+} // namespace
+
+TEST_CASE("Render Target Pool Tests") {
+  SoftwareRenderer software;
+  const auto create = [&](const swgtk::RenderTargetKey& key) { return software.Create(key); };
+
+  SECTION("Test targets are reused after the frame ends") {
+    swgtk::RenderTargetPool pool;
+    const auto key = swgtk::RenderTargetKey{.width = 32, .height = 32};
+
+    const auto first = pool.Acquire(key, create);
+    const auto second = pool.Acquire(key, create);
+
+    REQUIRE(first.IsValid());
+    REQUIRE(first != second);
+    REQUIRE(pool.GetStats().inUse == 2uz);
+
+    pool.EndFrame();
+    REQUIRE(pool.GetStats().inUse == 0uz);
+
+    const auto again = pool.Acquire(key, create);
+    REQUIRE((again == first || again == second));
+    REQUIRE(software.creates == 2);
+    REQUIRE(pool.GetStats().pooled == 2uz);
+    REQUIRE(pool.GetStats().reused == 1uz);
+    REQUIRE(pool.GetStats().ReuseRate() > 0.3);
+  }
+
+  SECTION("Test targets only stand in for the same key") {
+    swgtk::RenderTargetPool pool;
+
+    std::ignore = pool.Acquire(swgtk::RenderTargetKey{.width = 32, .height = 32}, create);
+    pool.EndFrame();
+
+    std::ignore = pool.Acquire(swgtk::RenderTargetKey{.width = 32, .height = 16}, create);
+    std::ignore = pool.Acquire(swgtk::RenderTargetKey{.width = 32, .height = 32, .blendMode = SDL_BLENDMODE_ADD}, create);
+
+    REQUIRE(software.creates == 3);
+    REQUIRE(pool.GetStats().reused == 0uz);
+  }
+
+  SECTION("Test released targets can be used again in the same frame") {
+    swgtk::RenderTargetPool pool;
+    const auto key = swgtk::RenderTargetKey{.width = 16, .height = 16};
+
+    const auto target = pool.Acquire(key, create);
+    REQUIRE(pool.Release(target));
+    REQUIRE_FALSE(pool.Release(target));
+    REQUIRE_FALSE(pool.Release(swgtk::Texture{}));
+
+    REQUIRE(pool.Acquire(key, create) == target);
+    REQUIRE(software.creates == 1);
+  }
+
+  SECTION("Test idle targets are destroyed") {
+    swgtk::RenderTargetPool pool;
+    pool.SetIdleFrames(2u);
+
+    const auto target = pool.Acquire(swgtk::RenderTargetKey{.width = 8, .height = 8}, create);
+
+    pool.EndFrame();
+    pool.EndFrame();
+    REQUIRE(target.IsValid());
+
+    pool.EndFrame();
+    REQUIRE_FALSE(target.IsValid());
+    REQUIRE(pool.GetStats().pooled == 0uz);
+    REQUIRE(pool.GetStats().released == 1uz);
+  }
+
+  SECTION("Test failed creates aren't pooled") {
+    swgtk::RenderTargetPool pool;
+
+    REQUIRE_FALSE(pool.Acquire(swgtk::RenderTargetKey{.width = 8, .height = 8}, [](const swgtk::RenderTargetKey&) { return swgtk::Texture{}; }).IsValid());
+    REQUIRE(pool.GetStats().pooled == 0uz);
+    REQUIRE(pool.GetStats().inUse == 0uz);
+
+    std::ignore = pool.Acquire(swgtk::RenderTargetKey{.width = 8, .height = 8}, create);
+    pool.Clear();
+    REQUIRE(pool.GetStats().pooled == 0uz);
+  }
+}
+
+TEST_CASE("Render target pool benchmark", "[.][benchmark]") {
+  constexpr auto frames = 200;
+  constexpr auto passes = 4;
+  const auto key = swgtk::RenderTargetKey{.width = 512, .height = 512};
+
+  SoftwareRenderer software;
+  const auto create = [&](const swgtk::RenderTargetKey& k) { return software.Create(k); };
+
+  swgtk::Timer timer;
+
+  for (auto frame = 0; frame < frames; ++frame) {
+    for (auto pass = 0; pass < passes; ++pass) {
+      software.Create(key).Destroy();
+    }
+  }
+
+  const auto unpooled = timer.GetElapsedMilliseconds() / frames;
+
+  swgtk::RenderTargetPool pool;
+  timer.UpdateTime();
+
+  for (auto frame = 0; frame < frames; ++frame) {
+    for (auto pass = 0; pass < passes; ++pass) {
+      std::ignore = pool.Acquire(key, create);
+    }
+
+    pool.EndFrame();
+  }
+
+  std::puts(std::format("{} targets per frame: created each frame {:.3f} ms, pooled {:.3f} ms, reuse rate {:.3f}", passes, unpooled,
+                        timer.GetElapsedMilliseconds() / frames, pool.GetStats().ReuseRate()).c_str());
+
+  REQUIRE(pool.GetStats().pooled == static_cast<size_t>(passes));
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
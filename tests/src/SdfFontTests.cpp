@@ -0,0 +1,107 @@
+#include <SDL3/SDL_iostream.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <swgtk/FontGroup.hpp>
+#include <swgtk/SdfFont.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  [[nodiscard]] auto CoverageAt(const swgtk::SdfBucket& bucket, const int x, const int y) -> uint8_t {
+    return bucket.coverage.Lock().View<const swgtk::PixelRGBA32>()[x, y].a;
+  }
+} // namespace
+
+TEST_CASE("SDF Font Tests") {
+  REQUIRE(TTF_Init());
+
+  const auto data = swgtk::FontGroup::GetDefaultFontData();
+  TTF_Font* ttf = TTF_OpenFontIO(SDL_IOFromConstMem(data.data(), data.size()), true, 16.0f);
+  REQUIRE(ttf != nullptr);
+
+  swgtk::SdfFont font;
+  REQUIRE(font.Load(ttf, 48.0f));
+
+  SECTION("Test glyphs are packed into the atlas once") {
+    REQUIRE(font.AddGlyphs("HI H") == 3uz);
+    REQUIRE(font.AddGlyphs("IH") == 0uz);
+
+    const auto* glyph = font.GetGlyph('H');
+    REQUIRE(glyph != nullptr);
+    REQUIRE(glyph->atlas.w > 0);
+    REQUIRE(glyph->advance > 0.0f);
+
+    // The field is darkest far outside the outline and brightest inside it.
+    const auto distances = font.GetDistances();
+    REQUIRE(distances[(static_cast<size_t>(glyph->atlas.y) * static_cast<size_t>(swgtk::sdfAtlasWidth)) + static_cast<size_t>(glyph->atlas.x)] < 64u);
+
+    const auto* space = font.GetGlyph(' ');
+    REQUIRE(space != nullptr);
+    REQUIRE(space->advance > 0.0f);
+  }
+
+  SECTION("Test sizes are rounded to buckets") {
+    REQUIRE(font.BucketSize(13.4f) == 13.0f);
+    REQUIRE(font.BucketSize(50.0f) == 52.0f);
+    REQUIRE(font.BucketSize(1000.0f) == 192.0f);
+    REQUIRE(font.GetBucket(0.0f) == nullptr);
+
+    const auto* bucket = font.GetBucket(24.2f);
+    REQUIRE(bucket != nullptr);
+    REQUIRE(bucket->size == 24.0f);
+    REQUIRE((*bucket->coverage)->w == swgtk::sdfAtlasWidth / 2);
+    REQUIRE(font.GetBucket(23.8f) == bucket);
+    REQUIRE(font.GetBucketCount() == 1uz);
+  }
+
+  SECTION("Test buckets hold coverage of the glyph outlines") {
+    swgtk::VertexBuffer buffer;
+    auto* bucket = font.AppendQuads("I I", SDL_FPoint{}, 96.0f, swgtk::whiteFColor, buffer);
+
+    REQUIRE(bucket != nullptr);
+    REQUIRE(buffer.Size() == 8uz);
+    REQUIRE(buffer.Indices().size() == 12uz);
+
+    // The middle of the field is inside the stem of the I, the corner is well outside it.
+    const auto& rect = font.GetGlyph('I')->atlas;
+    const auto centerX = static_cast<int>(static_cast<float>(rect.x + (rect.w / 2)) * bucket->scale);
+    const auto centerY = static_cast<int>(static_cast<float>(rect.y + (rect.h / 2)) * bucket->scale);
+
+    REQUIRE(CoverageAt(*bucket, centerX, centerY) == 255u);
+    REQUIRE(CoverageAt(*bucket, static_cast<int>(static_cast<float>(rect.x) * bucket->scale), static_cast<int>(static_cast<float>(rect.y) * bucket->scale)) == 0u);
+
+    // Adding a glyph afterwards updates the bucket in place.
+    const auto version = bucket->version;
+    REQUIRE(font.AddGlyphs("W") == 1uz);
+    REQUIRE(font.GetBucket(96.0f) == bucket);
+    REQUIRE(bucket->version > version);
+  }
+
+  SECTION("Test the least recently used bucket is dropped first") {
+    font.SetBucketLimit(2uz);
+
+    [[maybe_unused]] const auto* small = font.GetBucket(12.0f);
+    const auto* medium = font.GetBucket(20.0f);
+    [[maybe_unused]] const auto* large = font.GetBucket(40.0f);
+
+    REQUIRE(font.GetBucketCount() == 2uz);
+    REQUIRE(font.GetBucket(20.0f) == medium);
+  }
+
+  SECTION("Test text is measured per line") {
+    const auto one = font.MeasureText("HH", 24.0f);
+    const auto two = font.MeasureText("HH\nH", 24.0f);
+
+    REQUIRE(one.x > 0.0f);
+    REQUIRE(two.x == one.x);
+    REQUIRE(two.y == one.y * 2.0f);
+  }
+
+  font.Release();
+  REQUIRE_FALSE(font.IsLoaded());
+
+  TTF_CloseFont(ttf);
+  TTF_Quit();
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,173 @@
+#include <array>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <memory>
+#include <swgtk/ShapeBatch.hpp>
+#include <swgtk/Timer.hpp>
+#include <vector>
+
+#ifdef SWGTK_BUILD_WITH_LUA
+#include <sol/sol.hpp>
+#include <swgtk/SDLHW2D.hpp>
+#endif
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+TEST_CASE("Shape Batch Tests") {
+  SECTION("Test lines are quads as wide as their thickness") {
+    swgtk::ShapeBatch shapes;
+
+    shapes.AddLine(SDL_FPoint{.x = 0.0f, .y = 0.0f}, SDL_FPoint{.x = 10.0f, .y = 0.0f}, 4.0f);
+    shapes.AddLine(SDL_FPoint{.x = 5.0f, .y = 5.0f}, SDL_FPoint{.x = 5.0f, .y = 5.0f});
+
+    const auto vertices = shapes.Buffer().Vertices();
+
+    // The second line has no length, so it adds nothing.
+    REQUIRE(vertices.size() == 4uz);
+    REQUIRE(shapes.Buffer().Indices().size() == 6uz);
+    REQUIRE(vertices[0].position.y == 2.0f);
+    REQUIRE(vertices[2].position.x == 10.0f);
+    REQUIRE(vertices[2].position.y == -2.0f);
+
+    const auto points = std::array{SDL_FPoint{.x = 0.0f, .y = 0.0f}, SDL_FPoint{.x = 1.0f, .y = 1.0f}, SDL_FPoint{.x = 2.0f, .y = 2.0f}};
+    REQUIRE(shapes.AddLines(points) == 1uz);
+    REQUIRE(shapes.Buffer().Indices()[6] == 4);
+  }
+
+  SECTION("Test rect outlines stay inside the rect") {
+    swgtk::ShapeBatch shapes;
+
+    shapes.AddRect(SDL_FRect{.x = 10.0f, .y = 10.0f, .w = 20.0f, .h = 10.0f}, 2.0f);
+
+    const auto vertices = shapes.Buffer().Vertices();
+
+    REQUIRE(vertices.size() == 8uz);
+    REQUIRE(shapes.Buffer().Indices().size() == 24uz);
+
+    for (const auto& vertex: vertices) {
+      REQUIRE(vertex.position.x >= 10.0f);
+      REQUIRE(vertex.position.x <= 30.0f);
+      REQUIRE(vertex.position.y >= 10.0f);
+      REQUIRE(vertex.position.y <= 20.0f);
+    }
+
+    REQUIRE(vertices[1].position.x == 12.0f);
+    REQUIRE(vertices[5].position.y == 18.0f);
+
+    // Thick enough to close up, so it's drawn filled.
+    shapes.Clear();
+    shapes.AddRect(SDL_FRect{.x = 0.0f, .y = 0.0f, .w = 4.0f, .h = 4.0f}, 2.0f);
+    REQUIRE(shapes.Buffer().Size() == 4uz);
+  }
+
+  SECTION("Test circle segments follow the radius") {
+    REQUIRE(swgtk::ShapeBatch::CircleSegments(0.1f) == swgtk::ShapeBatch::minCircleSegments);
+    REQUIRE(swgtk::ShapeBatch::CircleSegments(1e6f) == swgtk::ShapeBatch::maxCircleSegments);
+    REQUIRE(swgtk::ShapeBatch::CircleSegments(std::nanf("")) == swgtk::ShapeBatch::minCircleSegments);
+
+    const auto small = swgtk::ShapeBatch::CircleSegments(10.0f);
+    const auto large = swgtk::ShapeBatch::CircleSegments(100.0f);
+
+    REQUIRE(small < large);
+    REQUIRE(swgtk::ShapeBatch::CircleSegments(100.0f, 1.0f) < large);
+  }
+
+  SECTION("Test circle rims lie on the radius") {
+    swgtk::ShapeBatch shapes;
+    const auto segments = static_cast<size_t>(swgtk::ShapeBatch::CircleSegments(50.0f));
+
+    shapes.AddFilledCircle(SDL_FPoint{.x = 100.0f, .y = 100.0f}, 50.0f);
+    REQUIRE(shapes.Buffer().Size() == segments + 1uz);
+    REQUIRE(shapes.Buffer().Indices().size() == segments * 3uz);
+
+    for (const auto& vertex: shapes.Buffer().Vertices().subspan(1uz)) {
+      REQUIRE(std::hypot(vertex.position.x - 100.0f, vertex.position.y - 100.0f) == Catch::Approx(50.0f).margin(1e-3));
+    }
+
+    shapes.Clear();
+    shapes.AddCircle(SDL_FPoint{.x = 0.0f, .y = 0.0f}, 50.0f, 5.0f);
+    REQUIRE(shapes.Buffer().Size() == segments * 2uz);
+    REQUIRE(std::hypot(shapes.Buffer().Vertices()[3].position.x, shapes.Buffer().Vertices()[3].position.y) == Catch::Approx(45.0f).margin(1e-3));
+  }
+
+  SECTION("Test polygons") {
+    swgtk::ShapeBatch shapes;
+
+    const auto square = std::array{SDL_FPoint{.x = 0.0f, .y = 0.0f}, SDL_FPoint{.x = 10.0f, .y = 0.0f},
+                                   SDL_FPoint{.x = 10.0f, .y = 10.0f}, SDL_FPoint{.x = 0.0f, .y = 10.0f}};
+
+    REQUIRE(shapes.AddFilledPolygon(square));
+    REQUIRE(shapes.Buffer().Indices().size() == 6uz);
+
+    // Square corners are mitered out to exactly half the thickness on both edges.
+    shapes.Clear();
+    REQUIRE(shapes.AddPolygon(square, 2.0f));
+    REQUIRE(shapes.Buffer().Size() == 8uz);
+
+    const auto corner = shapes.Buffer().Vertices()[0].position;
+    REQUIRE(std::abs(corner.x) == Catch::Approx(1.0f));
+    REQUIRE(std::abs(corner.y) == Catch::Approx(1.0f));
+
+    REQUIRE_FALSE(shapes.AddFilledPolygon(std::span{square}.first(2uz)));
+    REQUIRE_FALSE(shapes.AddPolygon(std::span{square}.first(2uz)));
+    REQUIRE(shapes.Buffer().Size() == 8uz);
+  }
+}
+
+TEST_CASE("Shape batch benchmark", "[.][benchmark]") {
+  constexpr auto lines = 100'000uz;
+  constexpr auto frames = 60;
+
+  std::vector<SDL_FPoint> points;
+  points.reserve(lines * 2uz);
+
+  for (auto i = 0uz; i < lines; ++i) {
+    const auto x = static_cast<float>(i % 800uz);
+    const auto y = static_cast<float>((i / 800uz) % 600uz);
+
+    points.push_back(SDL_FPoint{.x = x, .y = y});
+    points.push_back(SDL_FPoint{.x = x + 7.0f, .y = y + 3.0f});
+  }
+
+  swgtk::ShapeBatch shapes;
+  shapes.Reserve(lines * 4uz, lines * 6uz);
+
+  swgtk::Timer timer;
+
+  for (auto frame = 0; frame < frames; ++frame) {
+    shapes.Clear();
+    shapes.AddLines(points, 1.0f);
+  }
+
+  std::puts(std::format("{} lines: {:.3f} ms per frame", lines, timer.GetElapsedMilliseconds() / frames).c_str());
+
+  REQUIRE(shapes.Buffer().Size() == lines * 4uz);
+}
+
+#ifdef SWGTK_BUILD_WITH_LUA
+TEST_CASE("Shape Batch Lua Tests") {
+  sol::state lua;
+  lua.open_libraries(sol::lib::base);
+  lua["swgtk"] = lua.create_table();
+
+  const auto renderer = std::make_shared<swgtk::SDLHW2D>();
+  renderer->InitLua(&lua);
+
+  SECTION("Test point tables are read as pairs and anything but numbers is refused") {
+    lua.script(R"(
+      shapes = swgtk.ShapeBatch.new()
+      added = shapes:AddLines({ 0, 0, 10, 0, 0, 5, 10, 5 })
+      refused = shapes:AddLines({ 0, 0, "10", 0, 0, 5, {}, 5 })
+    )");
+
+    REQUIRE(lua.get<size_t>("added") == 2uz);
+    REQUIRE(lua.get<size_t>("refused") == 0uz);
+    REQUIRE(lua.get<swgtk::ShapeBatch&>("shapes").Buffer().Size() == 8uz);
+  }
+}
+#endif
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,74 @@
+#include <array>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <swgtk/SpriteBatch.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+TEST_CASE("Sprite Batch Tests") {
+  SECTION("Test quads share vertices through indices") {
+    swgtk::SpriteBatch batch;
+
+    batch.Add(SDL_FRect{}, SDL_FRect{.x = 10.0f, .y = 20.0f, .w = 4.0f, .h = 8.0f});
+    batch.Add(SDL_FRect{}, SDL_FRect{.x = 0.0f, .y = 0.0f, .w = 1.0f, .h = 1.0f});
+
+    const auto& buffer = batch.Buffer();
+
+    REQUIRE(batch.Size() == 2uz);
+    REQUIRE(buffer.Size() == 8uz);
+    REQUIRE(buffer.Indices().size() == 12uz);
+    REQUIRE(buffer.Indices()[6] == 4);
+    REQUIRE(buffer.Vertices()[2].position.x == 14.0f);
+    REQUIRE(buffer.Vertices()[2].position.y == 28.0f);
+    REQUIRE(buffer.Vertices()[2].tex_coord.x == 1.0f);
+  }
+
+  SECTION("Test rotation is around the destination center") {
+    swgtk::SpriteBatch batch;
+
+    batch.Add(SDL_FRect{}, SDL_FRect{.x = 0.0f, .y = 0.0f, .w = 2.0f, .h = 2.0f}, 90.0);
+
+    const auto first = batch.Buffer().Vertices()[0].position;
+
+    REQUIRE(first.x == Catch::Approx(2.0f));
+    REQUIRE(first.y == Catch::Approx(0.0f).margin(1e-5));
+  }
+
+  SECTION("Test flat arrays ignore partial entries") {
+    swgtk::SpriteBatch batch;
+    swgtk::VertexBuffer buffer;
+
+    constexpr auto sprites = std::array{0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    constexpr auto vertices = std::array{1.0f, 2.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.5f, 0.5f, 9.0f, 9.0f};
+
+    REQUIRE(batch.AddFlat(sprites) == 1uz);
+    REQUIRE(buffer.AddFlat(vertices) == 1uz);
+    REQUIRE(buffer.Vertices()[0].tex_coord.x == 0.5f);
+
+    batch.Clear();
+    REQUIRE(batch.Size() == 0uz);
+    REQUIRE(batch.Buffer().Indices().empty());
+  }
+
+  SECTION("Test appending one sprite at a time grows geometrically") {
+    swgtk::SpriteBatch batch;
+    constexpr auto sprite = std::array{0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+
+    const SDL_Vertex* storage = nullptr;
+    auto moves = 0;
+
+    for (auto i = 0; i < 1000; ++i) {
+      REQUIRE(batch.AddFlat(sprite) == 1uz);
+
+      if (batch.Buffer().Vertices().data() != storage) {
+        storage = batch.Buffer().Vertices().data();
+        ++moves;
+      }
+    }
+
+    REQUIRE(batch.Size() == 1000uz);
+    REQUIRE(moves <= 16);
+  }
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,217 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <random>
+#include <string>
+#include <swgtk/SurfaceOps.hpp>
+#include <swgtk/Timer.hpp>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  using swgtk::PixelRGBA32;
+
+  void FillSurface(const swgtk::Surface& surface, const PixelRGBA32 color) { surface.Lock().View<PixelRGBA32>().Fill(color); }
+
+  [[nodiscard]] auto PixelAt(const swgtk::Surface& surface, const int x, const int y) -> PixelRGBA32 {
+    return surface.Lock().View<const PixelRGBA32>()[x, y];
+  }
+
+  void FillRandom(const swgtk::Surface& surface, const uint32_t seed) {
+    std::mt19937 random{seed};
+    surface.Lock().View<uint32_t>().ForEach([&random](int, int, uint32_t& pixel) { pixel = static_cast<uint32_t>(random()); });
+  }
+
+  [[nodiscard]] auto ReadAll(const swgtk::Surface& surface) -> std::string { return surface.Lock().ReadBytes(); }
+
+  constexpr auto allLevels = std::array{swgtk::SimdLevel::Scalar, swgtk::SimdLevel::SSE2, swgtk::SimdLevel::AVX2};
+} // namespace
+
+TEST_CASE("Surface Ops Tests") {
+  const auto detected = swgtk::SetSimdLevel(swgtk::SimdLevel::AVX2);
+
+  const swgtk::Surface source{16, 16, SDL_PIXELFORMAT_RGBA32};
+  const swgtk::Surface dest{16, 16, SDL_PIXELFORMAT_RGBA32};
+
+  SECTION("Test blending follows source alpha") {
+    FillSurface(dest, PixelRGBA32{.r = 0u, .g = 0u, .b = 200u, .a = 255u});
+    FillSurface(source, PixelRGBA32{.r = 200u, .g = 0u, .b = 0u, .a = 255u});
+
+    {
+      auto lock = source.Lock();
+      const auto view = lock.View<PixelRGBA32>();
+      view[1, 0].a = 0u;
+      view[2, 0].a = 128u;
+    }
+
+    REQUIRE(swgtk::BlitBlend(source, nullptr, dest, 0, 0));
+
+    REQUIRE(PixelAt(dest, 0, 0) == PixelRGBA32{.r = 200u, .g = 0u, .b = 0u, .a = 255u});
+    REQUIRE(PixelAt(dest, 1, 0) == PixelRGBA32{.r = 0u, .g = 0u, .b = 200u, .a = 255u});
+    REQUIRE(PixelAt(dest, 2, 0) == PixelRGBA32{.r = 100u, .g = 0u, .b = 100u, .a = 255u});
+  }
+
+  SECTION("Test blits are clipped to both surfaces") {
+    FillSurface(dest, PixelRGBA32{});
+    FillSurface(source, PixelRGBA32{.r = 255u, .g = 255u, .b = 255u, .a = 255u});
+
+    REQUIRE(swgtk::BlitBlend(source, nullptr, dest, -12, 14));
+
+    REQUIRE(PixelAt(dest, 3, 15).r == 255u);
+    REQUIRE(PixelAt(dest, 4, 15).r == 0u);
+    REQUIRE(PixelAt(dest, 3, 13).r == 0u);
+
+    // Entirely off the surface is not an error.
+    REQUIRE(swgtk::BlitBlend(source, nullptr, dest, 100, 100));
+  }
+
+  SECTION("Test color keyed pixels are skipped") {
+    FillSurface(dest, PixelRGBA32{.r = 1u, .g = 2u, .b = 3u, .a = 255u});
+    FillSurface(source, PixelRGBA32{.r = 255u, .g = 0u, .b = 255u, .a = 255u});
+    source.Lock().View<PixelRGBA32>()[5, 5] = PixelRGBA32{.r = 9u, .g = 9u, .b = 9u, .a = 255u};
+
+    REQUIRE(swgtk::BlitColorKey(source, nullptr, dest, 0, 0, SDL_Color{.r = 255u, .g = 0u, .b = 255u, .a = 255u}));
+
+    REQUIRE(PixelAt(dest, 0, 0) == PixelRGBA32{.r = 1u, .g = 2u, .b = 3u, .a = 255u});
+    REQUIRE(PixelAt(dest, 5, 5) == PixelRGBA32{.r = 9u, .g = 9u, .b = 9u, .a = 255u});
+  }
+
+  SECTION("Test scaled blits") {
+    const swgtk::Surface small{2, 2, SDL_PIXELFORMAT_RGBA32};
+
+    {
+      auto lock = small.Lock();
+      const auto view = lock.View<PixelRGBA32>();
+      view[0, 0] = PixelRGBA32{.r = 0u, .a = 255u};
+      view[1, 0] = PixelRGBA32{.r = 255u, .a = 255u};
+      view[0, 1] = PixelRGBA32{.r = 0u, .a = 255u};
+      view[1, 1] = PixelRGBA32{.r = 255u, .a = 255u};
+    }
+
+    REQUIRE(swgtk::BlitScaled(small, nullptr, dest, nullptr, swgtk::ScaleFilter::Nearest));
+    REQUIRE(PixelAt(dest, 7, 3).r == 0u);
+    REQUIRE(PixelAt(dest, 8, 12).r == 255u);
+
+    // Bilinear output ramps between the two columns and holds the edge values.
+    REQUIRE(swgtk::BlitScaled(small, nullptr, dest, nullptr, swgtk::ScaleFilter::Bilinear));
+    REQUIRE(PixelAt(dest, 0, 0).r == 0u);
+    REQUIRE(PixelAt(dest, 15, 0).r == 255u);
+    REQUIRE(PixelAt(dest, 6, 0).r < PixelAt(dest, 9, 0).r);
+    REQUIRE(PixelAt(dest, 9, 0).a == 255u);
+
+    small.Destroy();
+  }
+
+  SECTION("Test premultiply and tint") {
+    FillSurface(dest, PixelRGBA32{.r = 200u, .g = 100u, .b = 50u, .a = 128u});
+
+    REQUIRE(swgtk::Premultiply(dest));
+    REQUIRE(PixelAt(dest, 0, 0) == PixelRGBA32{.r = 100u, .g = 50u, .b = 25u, .a = 128u});
+
+    REQUIRE(swgtk::Unpremultiply(dest));
+    REQUIRE(PixelAt(dest, 0, 0) == PixelRGBA32{.r = 199u, .g = 100u, .b = 50u, .a = 128u});
+
+    REQUIRE(swgtk::Tint(dest, SDL_Color{.r = 255u, .g = 0u, .b = 128u, .a = 255u}));
+    REQUIRE(PixelAt(dest, 0, 0) == PixelRGBA32{.r = 199u, .g = 0u, .b = 25u, .a = 128u});
+  }
+
+  SECTION("Test unsupported formats are refused") {
+    const swgtk::Surface rgb{4, 4, SDL_PIXELFORMAT_RGB24};
+    const swgtk::Surface bgra{4, 4, SDL_PIXELFORMAT_BGRA32};
+
+    REQUIRE_FALSE(swgtk::Premultiply(rgb));
+    REQUIRE_FALSE(swgtk::BlitBlend(bgra, nullptr, dest, 0, 0));
+
+    rgb.Destroy();
+    bgra.Destroy();
+  }
+
+  SECTION("Test every instruction set produces the same pixels") {
+    // Odd sizes leave a remainder for the scalar tail of each SIMD loop.
+    const swgtk::Surface wide{37, 9, SDL_PIXELFORMAT_RGBA32};
+    const swgtk::Surface target{53, 11, SDL_PIXELFORMAT_RGBA32};
+
+    std::vector<std::string> results;
+
+    for (const auto level: allLevels) {
+      if (swgtk::SetSimdLevel(level) != level) {
+        continue;
+      }
+
+      FillRandom(wide, 1u);
+      FillRandom(target, 2u);
+
+      REQUIRE(swgtk::BlitBlend(wide, nullptr, target, 3, 1));
+      REQUIRE(swgtk::BlitColorKey(wide, nullptr, target, 9, 2, SDL_Color{}));
+      REQUIRE(swgtk::Tint(target, SDL_Color{.r = 10u, .g = 200u, .b = 255u, .a = 99u}));
+      REQUIRE(swgtk::Premultiply(target));
+
+      const auto destRect = SDL_Rect{.x = -5, .y = 2, .w = 40, .h = 7};
+      REQUIRE(swgtk::BlitScaled(wide, nullptr, target, &destRect, swgtk::ScaleFilter::Bilinear));
+
+      results.push_back(ReadAll(target));
+    }
+
+    for (const auto& result: results) {
+      REQUIRE(result == results.front());
+    }
+
+    wide.Destroy();
+    target.Destroy();
+  }
+
+  swgtk::SetSimdLevel(detected);
+  source.Destroy();
+  dest.Destroy();
+}
+
+TEST_CASE("Surface ops throughput benchmark", "[.][benchmark]") {
+  constexpr auto size = 1024;
+  constexpr auto repeats = 20;
+  constexpr auto megapixels = static_cast<double>(size) * size * repeats / 1'000'000.0;
+
+  const auto detected = swgtk::SetSimdLevel(swgtk::SimdLevel::AVX2);
+
+  const swgtk::Surface source{size, size, SDL_PIXELFORMAT_RGBA32};
+  const swgtk::Surface dest{size, size, SDL_PIXELFORMAT_RGBA32};
+  const swgtk::Surface half{size / 2, size / 2, SDL_PIXELFORMAT_RGBA32};
+
+  FillRandom(source, 1u);
+  FillRandom(dest, 2u);
+  FillRandom(half, 3u);
+
+  const auto measure = [&](const char* name, auto&& kernel) {
+    for (const auto level: allLevels) {
+      if (swgtk::SetSimdLevel(level) != level) {
+        continue;
+      }
+
+      swgtk::Timer timer;
+
+      for (auto i = 0; i < repeats; ++i) {
+        kernel();
+      }
+
+      const auto seconds = timer.GetElapsedMilliseconds() / 1000.0;
+      constexpr auto levelNames = std::array{"scalar", "SSE2", "AVX2"};
+      std::puts(std::format("{:<20} {:<6} {:>10.1f} MPixels/s", name, levelNames.at(static_cast<size_t>(level)), megapixels / seconds).c_str());
+    }
+  };
+
+  measure("BlitBlend", [&] { swgtk::BlitBlend(source, nullptr, dest, 0, 0); });
+  measure("BlitColorKey", [&] { swgtk::BlitColorKey(source, nullptr, dest, 0, 0, SDL_Color{}); });
+  measure("BlitScaled nearest", [&] { swgtk::BlitScaled(half, nullptr, dest, nullptr, swgtk::ScaleFilter::Nearest); });
+  measure("BlitScaled bilinear", [&] { swgtk::BlitScaled(half, nullptr, dest, nullptr, swgtk::ScaleFilter::Bilinear); });
+  measure("Premultiply", [&] { swgtk::Premultiply(dest); });
+  measure("Tint", [&] { swgtk::Tint(dest, SDL_Color{.r = 200u, .g = 100u, .b = 50u, .a = 255u}); });
+
+  swgtk::SetSimdLevel(detected);
+  source.Destroy();
+  dest.Destroy();
+  half.Destroy();
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,165 @@
+#include <SDL3/SDL_iostream.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <string>
+#include <swgtk/FontGroup.hpp>
+#include <swgtk/TextLayout.hpp>
+#include <swgtk/Timer.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  [[nodiscard]] auto SameLines(const swgtk::TextLayout& first, const swgtk::TextLayout& second) -> bool {
+    if (first.GetText() != second.GetText() || first.GetLineCount() != second.GetLineCount()) {
+      return false;
+    }
+
+    for (auto i = 0uz; i < first.GetLineCount(); ++i) {
+      const auto a = first.GetLine(i);
+      const auto b = second.GetLine(i);
+
+      if (a.offset != b.offset || a.length != b.length || a.width != b.width) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+} // namespace
+
+TEST_CASE("Text Layout Tests") {
+  REQUIRE(TTF_Init());
+
+  const auto data = swgtk::FontGroup::GetDefaultFontData();
+  TTF_Font* ttf = TTF_OpenFontIO(SDL_IOFromConstMem(data.data(), data.size()), true, 16.0f);
+  REQUIRE(ttf != nullptr);
+
+  swgtk::SdfFont font;
+  REQUIRE(font.Load(ttf));
+
+  // The default font is monospaced, so the wrap width holds ten columns with room for rounding.
+  const auto column = font.MeasureText("M", 20.0f).x;
+  swgtk::TextLayout layout{&font, 20.0f, column * 10.5f};
+
+  SECTION("Test lines break after spaces") {
+    layout.SetText("one two three four\n\nfive");
+
+    REQUIRE(layout.GetLineCount() == 4uz);
+    REQUIRE(layout.GetLine(0uz).length == 8uz);
+    REQUIRE(layout.GetLine(1uz).offset == 8uz);
+    REQUIRE(layout.GetLine(2uz).length == 0uz);
+    REQUIRE(layout.GetLine(3uz).y == 3.0f * layout.GetLineHeight());
+
+    // Trailing spaces don't count towards the width.
+    REQUIRE(std::abs(layout.GetLine(0uz).width - (column * 7.0f)) < 0.01f);
+
+    // A word longer than the line is broken where it overflows.
+    layout.SetText("abcdefghijklmno");
+    REQUIRE(layout.GetLineCount() == 2uz);
+    REQUIRE(layout.GetLine(0uz).length == 10uz);
+  }
+
+  SECTION("Test edits match laying out from scratch") {
+    const std::string text = "The quick brown fox\njumps over the lazy dog.\n\nAgain!";
+
+    for (const auto c: text) {
+      layout.Append(std::string(1uz, c));
+    }
+
+    swgtk::TextLayout expected{&font, 20.0f, column * 10.5f};
+    expected.SetText(text);
+    REQUIRE(SameLines(layout, expected));
+
+    auto edited = text;
+
+    layout.Insert(4uz, "very\nslow ");
+    edited.insert(4uz, "very\nslow ");
+    expected.SetText(edited);
+    REQUIRE(SameLines(layout, expected));
+
+    layout.Erase(10uz, 20uz);
+    edited.erase(10uz, 20uz);
+    expected.SetText(edited);
+    REQUIRE(SameLines(layout, expected));
+
+    layout.Erase(0uz, 1000uz);
+    REQUIRE(layout.GetTextLength() == 0uz);
+    REQUIRE(layout.GetLineCount() == 1uz);
+  }
+
+  SECTION("Test hit testing and carets agree") {
+    layout.SetText("hello world\nsecond");
+
+    const auto lineHeight = layout.GetLineHeight();
+
+    REQUIRE(layout.HitTest(SDL_FPoint{.x = -10.0f, .y = -10.0f}) == 0uz);
+    REQUIRE(layout.HitTest(SDL_FPoint{.x = column * 2.2f, .y = 1.0f}) == 2uz);
+    REQUIRE(layout.HitTest(SDL_FPoint{.x = column * 2.2f, .y = lineHeight * 2.5f}) == 14uz);
+    REQUIRE(layout.HitTest(SDL_FPoint{.x = 1000.0f, .y = 1000.0f}) == layout.GetTextLength());
+
+    const auto caret = layout.GetCaretRect(14uz);
+    REQUIRE(std::abs(caret.x - (column * 2.0f)) < 0.01f);
+    REQUIRE(caret.y == lineHeight * 2.0f);
+    REQUIRE(layout.HitTest(SDL_FPoint{.x = caret.x, .y = caret.y + 1.0f}) == 14uz);
+  }
+
+  SECTION("Test only visible lines are emitted") {
+    layout.SetText("aaaa\nbbbb\ncccc");
+
+    swgtk::VertexBuffer buffer;
+    REQUIRE(layout.AppendQuads(SDL_FPoint{}, swgtk::whiteFColor, buffer) != nullptr);
+    REQUIRE(buffer.Size() == 48uz);
+
+    const auto lineHeight = layout.GetLineHeight();
+
+    buffer.Clear();
+    REQUIRE(layout.AppendQuads(SDL_FPoint{}, swgtk::whiteFColor, buffer, lineHeight * 1.5f, lineHeight * 2.5f) != nullptr);
+    REQUIRE(buffer.Size() == 32uz);
+  }
+
+  font.Release();
+  TTF_CloseFont(ttf);
+  TTF_Quit();
+}
+
+TEST_CASE("Text layout append benchmark", "[.][benchmark]") {
+  REQUIRE(TTF_Init());
+
+  const auto data = swgtk::FontGroup::GetDefaultFontData();
+  TTF_Font* ttf = TTF_OpenFontIO(SDL_IOFromConstMem(data.data(), data.size()), true, 16.0f);
+  REQUIRE(ttf != nullptr);
+
+  swgtk::SdfFont font;
+  REQUIRE(font.Load(ttf));
+
+  constexpr auto appends = 1000;
+  const std::string line = "[12:00:00] player joined the game and said hello\n";
+
+  for (const auto lines: {1'000, 10'000, 100'000}) {
+    swgtk::TextLayout log{&font, 16.0f, 400.0f};
+    std::string text;
+
+    for (auto i = 0; i < lines; ++i) {
+      text += line;
+    }
+
+    log.SetText(text);
+
+    swgtk::Timer timer;
+
+    for (auto i = 0; i < appends; ++i) {
+      log.Append(line);
+    }
+
+    // Appending shapes and wraps the new line only, so this stays flat as the log grows.
+    std::puts(std::format("{:>7} lines: {:.3f} us per appended line", lines, timer.GetElapsedMilliseconds() * 1000.0 / appends).c_str());
+  }
+
+  font.Release();
+  TTF_CloseFont(ttf);
+  TTF_Quit();
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include <swgtk/SpriteBatch.hpp>
+#include <swgtk/TileMap.hpp>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  const auto tileset = swgtk::TileSet{.tileWidth = 16, .tileHeight = 16, .columns = 8};
+} // namespace
+
+TEST_CASE("Tile Map Tests") {
+  SECTION("Test tiles are stored in the chunk that covers them") {
+    swgtk::TileMap map{100, 70, tileset};
+
+    REQUIRE(map.GetChunkColumns() == 4);
+    REQUIRE(map.GetChunkRows() == 3);
+
+    REQUIRE(map.Set(33, 65, 5u));
+    REQUIRE_FALSE(map.Set(100, 0, 5u));
+    REQUIRE_FALSE(map.Set(-1, 0, 5u));
+
+    REQUIRE(map.Get(33, 65) == 5u);
+    REQUIRE(map.Get(100, 0) == swgtk::emptyTile);
+    REQUIRE(map.GetChunk(1, 2).filled == 1uz);
+    REQUIRE(map.GetChunk(1, 2).tiles[(1uz * 32uz) + 1uz] == 5u);
+    REQUIRE(map.GetChunk(0, 0).filled == 0uz);
+  }
+
+  SECTION("Test only real changes move a chunk's version") {
+    swgtk::TileMap map{64, 64, tileset};
+    const auto& chunk = map.GetChunk(0, 0);
+
+    map.Set(1, 1, 3u);
+    const auto version = chunk.version;
+
+    map.Set(1, 1, 3u);
+    REQUIRE(chunk.version == version);
+
+    map.Set(1, 1, swgtk::emptyTile);
+    REQUIRE(chunk.version == version + 1u);
+    REQUIRE(chunk.filled == 0uz);
+    REQUIRE(map.GetChunk(1, 1).version == 0u);
+  }
+
+  SECTION("Test fills and loads are clipped to the map") {
+    swgtk::TileMap map{40, 40, tileset};
+
+    map.Fill(SDL_Rect{.x = 30, .y = -5, .w = 20, .h = 10}, 2u);
+    REQUIRE(map.Get(39, 4) == 2u);
+    REQUIRE(map.Get(39, 5) == swgtk::emptyTile);
+    REQUIRE(map.GetChunk(1, 0).filled == 8uz * 5uz);
+
+    REQUIRE_FALSE(map.Load(std::vector<swgtk::TileID>(10uz, 1u)));
+    REQUIRE(map.Load(std::vector<swgtk::TileID>(40uz * 40uz, 1u)));
+    REQUIRE(map.GetChunk(1, 1).filled == 8uz * 8uz);
+  }
+
+  SECTION("Test tile sources follow the tileset's columns") {
+    const auto source = tileset.GetSource(10u);
+
+    REQUIRE(source.x == 16.0f);
+    REQUIRE(source.y == 16.0f);
+    REQUIRE(source.w == 16.0f);
+  }
+
+  SECTION("Test only chunks overlapping the view are visited") {
+    // Four million tiles, and the view still only covers a handful of chunks.
+    swgtk::TileMap map{2048, 2048, tileset};
+
+    const auto visible = map.GetChunksInView(SDL_FRect{.x = 1000.0f, .y = 500.0f, .w = 1280.0f, .h = 720.0f});
+    REQUIRE(visible.x == 1);
+    REQUIRE(visible.y == 0);
+    REQUIRE(visible.w == 4);
+    REQUIRE(visible.h == 3);
+
+    const auto past = map.GetChunksInView(SDL_FRect{.x = -1e12f, .y = 1e12f, .w = 100.0f, .h = 100.0f});
+    REQUIRE(past.w == 0);
+    REQUIRE(past.h == 0);
+
+    const auto edge = map.GetChunksInView(SDL_FRect{.x = 32700.0f, .y = -100.0f, .w = 500.0f, .h = 200.0f});
+    REQUIRE(edge.x == 63);
+    REQUIRE(edge.w == 1);
+    REQUIRE(edge.h == 1);
+  }
+
+  SECTION("Test chunks append a quad per tile") {
+    swgtk::TileMap map{64, 64, tileset};
+    swgtk::SpriteBatch batch;
+
+    map.Set(33, 32, 1u);
+    map.Set(63, 63, 2u);
+    map.AppendChunk(1, 1, SDL_FPoint{.x = 100.0f, .y = 50.0f}, batch);
+
+    REQUIRE(batch.Size() == 2uz);
+    REQUIRE(batch.Buffer().Vertices()[0].position.x == 116.0f);
+    REQUIRE(batch.Buffer().Vertices()[0].position.y == 50.0f);
+
+    map.AppendChunk(0, 0, SDL_FPoint{}, batch);
+    REQUIRE(batch.Size() == 2uz);
+  }
+
+  SECTION("Test the least recently drawn chunks are evicted first") {
+    swgtk::TileMap map{256, 32, tileset};
+    map.SetChunkBudget(3uz);
+
+    for (auto x = 0; x < 8; ++x) {
+      map.BeginDraw();
+      map.MarkDrawn(x, 0);
+      map.EvictChunks();
+    }
+
+    REQUIRE(map.GetCachedChunkCount() == 3uz);
+    REQUIRE(map.GetChunk(7, 0).cached);
+    REQUIRE(map.GetChunk(5, 0).cached);
+    REQUIRE_FALSE(map.GetChunk(4, 0).cached);
+
+    // Everything on screen in one draw stays, even past the budget.
+    map.BeginDraw();
+
+    for (auto x = 0; x < 5; ++x) {
+      map.MarkDrawn(x, 0);
+    }
+
+    REQUIRE(map.EvictChunks() == 3uz);
+    REQUIRE(map.GetCachedChunkCount() == 5uz);
+    REQUIRE_FALSE(map.GetChunk(7, 0).cached);
+
+    const auto version = map.GetChunk(2, 0).version;
+    map.Invalidate();
+    REQUIRE(map.GetChunk(2, 0).version == version + 1u);
+
+    map.Release();
+    REQUIRE(map.GetCachedChunkCount() == 0uz);
+  }
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
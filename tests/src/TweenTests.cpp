@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <format>
+#include <swgtk/Timer.hpp>
+#include <swgtk/Tween.hpp>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  [[nodiscard]] auto Near(const float a, const float b) -> bool { return a - b < 1e-4f && b - a < 1e-4f; }
+} // namespace
+
+TEST_CASE("Tween Tests") {
+  SECTION("Test easings start at 0 and end at 1") {
+    for (auto ease = 0u; ease < static_cast<uint32_t>(swgtk::Ease::Count); ++ease) {
+      REQUIRE(Near(swgtk::EaseValue(static_cast<swgtk::Ease>(ease), 0.0f), 0.0f));
+      REQUIRE(Near(swgtk::EaseValue(static_cast<swgtk::Ease>(ease), 1.0f), 1.0f));
+    }
+
+    REQUIRE(Near(swgtk::EaseValue(swgtk::Ease::QuadIn, 0.5f), 0.25f));
+    REQUIRE(Near(swgtk::EaseValue(swgtk::Ease::QuadInOut, 0.5f), 0.5f));
+    REQUIRE(swgtk::EaseValue(swgtk::Ease::BackIn, 0.2f) < 0.0f);
+
+    std::vector<float> values{0.0f, 0.5f, 1.0f};
+    swgtk::EaseValues(swgtk::Ease::CubicIn, values);
+    REQUIRE(Near(values[1], 0.125f));
+  }
+
+  SECTION("Test a tween starts from the target and lands on its end value") {
+    swgtk::Tweens tweens;
+    auto x = 10.0f;
+
+    const auto tween = tweens.To(x, 20.0f, 1.0f);
+    REQUIRE(tweens.IsActive(tween));
+    REQUIRE(x == 10.0f);
+
+    tweens.Update(0.25f);
+    REQUIRE(Near(x, 12.5f));
+    REQUIRE(tweens.GetRunningCount() == 1uz);
+
+    tweens.Update(0.8f);
+    REQUIRE(x == 20.0f);
+    REQUIRE_FALSE(tweens.IsActive(tween));
+    REQUIRE(tweens.Size() == 0uz);
+  }
+
+  SECTION("Test a delay holds a tween back without touching its target") {
+    swgtk::Tweens tweens;
+    auto x = 5.0f;
+
+    tweens.FromTo(x, 0.0f, 10.0f, 1.0f, swgtk::Ease::Linear, 0.5f);
+
+    tweens.Update(0.4f);
+    REQUIRE(x == 5.0f);
+    REQUIRE(tweens.GetRunningCount() == 0uz);
+
+    // 0.1 seconds past the delay.
+    tweens.Update(0.2f);
+    REQUIRE(Near(x, 1.0f));
+  }
+
+  SECTION("Test sequences carry leftover time to the next step") {
+    swgtk::Tweens tweens;
+    auto x = 0.0f;
+    auto y = 0.0f;
+
+    const auto first = tweens.To(x, 1.0f, 0.5f);
+    const auto second = tweens.Then(first, x, 3.0f, 0.5f);
+    const auto third = tweens.Then(second, y, 1.0f, 0.0f);
+    REQUIRE(tweens.Size() == 3uz);
+
+    tweens.Update(0.75f);
+    REQUIRE_FALSE(tweens.IsActive(first));
+    REQUIRE(Near(x, 2.0f));
+
+    // The last step takes no time, so it finishes in the same update as the one before it.
+    tweens.Update(0.25f);
+    REQUIRE(x == 3.0f);
+    REQUIRE(y == 1.0f);
+    REQUIRE_FALSE(tweens.IsActive(third));
+    REQUIRE(tweens.Size() == 0uz);
+  }
+
+  SECTION("Test cancelling stops a tween and everything after it") {
+    swgtk::Tweens tweens;
+    auto x = 0.0f;
+    auto y = 0.0f;
+
+    const auto first = tweens.To(x, 10.0f, 1.0f);
+    const auto second = tweens.Then(first, y, 10.0f, 1.0f);
+    const auto third = tweens.Then(second, x, 0.0f, 1.0f);
+    const auto other = tweens.Then(first, y, 5.0f, 1.0f, swgtk::Ease::Linear, 10.0f);
+
+    tweens.Update(0.5f);
+    REQUIRE(tweens.Cancel(second));
+    REQUIRE_FALSE(tweens.Cancel(second));
+    REQUIRE_FALSE(tweens.IsActive(third));
+    REQUIRE(tweens.IsActive(other));
+    REQUIRE(tweens.Then(second, x, 1.0f, 1.0f) == swgtk::nullTween);
+
+    REQUIRE(tweens.Cancel(first));
+    REQUIRE(Near(x, 5.0f));
+    REQUIRE_FALSE(tweens.IsActive(other));
+    REQUIRE(tweens.Size() == 0uz);
+
+    tweens.Update(1.0f);
+    REQUIRE(Near(x, 5.0f));
+    REQUIRE(y == 0.0f);
+  }
+
+  SECTION("Test IDs of finished tweens don't match new ones") {
+    swgtk::Tweens tweens;
+    auto x = 0.0f;
+
+    const auto old = tweens.To(x, 1.0f, 0.1f);
+    tweens.Update(1.0f);
+
+    const auto fresh = tweens.To(x, 2.0f, 1.0f, swgtk::Ease::SineOut);
+    REQUIRE(fresh != old);
+    REQUIRE_FALSE(tweens.Cancel(old));
+    REQUIRE(tweens.IsActive(fresh));
+
+    tweens.Clear();
+    REQUIRE_FALSE(tweens.IsActive(fresh));
+    REQUIRE(tweens.GetRunningCount() == 0uz);
+  }
+
+  SECTION("Test tweens in different easings update together") {
+    swgtk::Tweens tweens;
+    std::vector<float> values(6uz, 0.0f);
+
+    for (auto i = 0uz; i < values.size(); ++i) {
+      tweens.To(values[i], 1.0f, 1.0f, i % 2uz == 0uz ? swgtk::Ease::QuadIn : swgtk::Ease::QuadOut);
+    }
+
+    tweens.Update(0.0f);
+    REQUIRE(tweens.GetRunningCount() == 6uz);
+
+    tweens.Update(0.5f);
+    REQUIRE(Near(values[0], 0.25f));
+    REQUIRE(Near(values[1], 0.75f));
+    REQUIRE(Near(values[4], 0.25f));
+  }
+}
+
+TEST_CASE("Tween update benchmark", "[.][benchmark]") {
+  constexpr auto count = 100'000uz;
+  constexpr auto frames = 600;
+
+  swgtk::Tweens tweens;
+  std::vector<float> values(count, 0.0f);
+  tweens.Reserve(count);
+
+  for (auto i = 0uz; i < count; ++i) {
+    tweens.To(values[i], 100.0f, 20.0f, static_cast<swgtk::Ease>(i % static_cast<size_t>(swgtk::Ease::Count)));
+  }
+
+  swgtk::Timer timer;
+
+  for (auto frame = 0; frame < frames; ++frame) {
+    tweens.Update(1.0f / 60.0f);
+  }
+
+  std::puts(std::format("{} tweens: {:.3f} ms per update", count, timer.GetElapsedMilliseconds() / frames).c_str());
+
+  REQUIRE(tweens.GetRunningCount() == count);
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
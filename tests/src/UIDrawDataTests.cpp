@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <swgtk/Timer.hpp>
+#include <swgtk/UIDrawData.hpp>
+#include <vector>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  constexpr auto screen = swgtk::UIClipRect{.x1 = 0.0f, .y1 = 0.0f, .x2 = 800.0f, .y2 = 600.0f};
+
+  // A list of quads, the way an immediate-mode UI writes rectangles.
+  struct QuadList {
+    std::vector<swgtk::UIVertex> vertices;
+    std::vector<uint16_t> indices;
+
+    void Add(const float x, const float y, const uint32_t color = 0xFF0000FFu) {
+      const auto base = static_cast<uint16_t>(vertices.size());
+
+      vertices.push_back(swgtk::UIVertex{.position = {.x = x, .y = y}, .color = color});
+      vertices.push_back(swgtk::UIVertex{.position = {.x = x + 10.0f, .y = y}, .color = color});
+      vertices.push_back(swgtk::UIVertex{.position = {.x = x + 10.0f, .y = y + 10.0f}, .color = color});
+      vertices.push_back(swgtk::UIVertex{.position = {.x = x, .y = y + 10.0f}, .color = color});
+
+      for (const auto corner: {0, 1, 2, 0, 2, 3}) {
+        indices.push_back(static_cast<uint16_t>(base + corner));
+      }
+    }
+  };
+} // namespace
+
+TEST_CASE("UI Draw Data Tests") {
+  SECTION("Test vertices are converted once for the whole frame") {
+    QuadList list;
+    list.Add(5.0f, 5.0f, 0x80FF0000u);
+
+    const auto commands = std::vector{swgtk::UIDrawCommand{.clip = screen, .elementCount = 6u}};
+    swgtk::UIDrawData data;
+
+    REQUIRE(data.AddList(list.vertices, list.indices, commands));
+    REQUIRE(data.AddList(list.vertices, list.indices, commands));
+
+    REQUIRE(data.Vertices().size() == 8uz);
+    REQUIRE(data.Vertices()[0].color.b == 1.0f);
+    REQUIRE(data.Vertices()[0].color.r == 0.0f);
+    REQUIRE(data.Vertices()[0].color.a > 0.5f);
+
+    // The second list's indices point past the first list's vertices.
+    REQUIRE(data.Indices().size() == 12uz);
+    REQUIRE(data.Indices()[6] == 4);
+  }
+
+  SECTION("Test contiguous commands with the same state merge") {
+    QuadList list;
+
+    for (auto i = 0; i < 4; ++i) {
+      list.Add(static_cast<float>(i) * 20.0f, 0.0f);
+    }
+
+    const auto panel = swgtk::UIClipRect{.x1 = 10.2f, .y1 = 10.0f, .x2 = 99.5f, .y2 = 50.0f};
+    const auto commands = std::vector{
+        swgtk::UIDrawCommand{.clip = screen, .indexOffset = 0u, .elementCount = 6u},
+        swgtk::UIDrawCommand{.clip = screen, .indexOffset = 6u, .elementCount = 6u},
+        swgtk::UIDrawCommand{.clip = panel, .indexOffset = 12u, .elementCount = 6u},
+        swgtk::UIDrawCommand{.clip = panel, .indexOffset = 18u, .elementCount = 0u},
+        swgtk::UIDrawCommand{.clip = screen, .indexOffset = 18u, .elementCount = 6u},
+    };
+
+    swgtk::UIDrawData data;
+    REQUIRE(data.AddList(list.vertices, list.indices, commands));
+
+    // Lists added one after another merge too.
+    REQUIRE(data.AddList(list.vertices, list.indices, std::vector{commands.back()}));
+
+    REQUIRE(data.GetCommandCount() == 5uz);
+    REQUIRE(data.Batches().size() == 3uz);
+    REQUIRE(data.Batches()[0].indexCount == 12uz);
+    REQUIRE(data.Batches()[1].clip.x == 10);
+    REQUIRE(data.Batches()[1].clip.w == 90);
+    REQUIRE(data.Batches()[2].firstIndex == 18uz);
+    REQUIRE(data.Batches()[2].indexCount == 12uz);
+  }
+
+  SECTION("Test commands that can't be seen are dropped") {
+    QuadList list;
+    list.Add(0.0f, 0.0f);
+
+    const auto commands = std::vector{
+        swgtk::UIDrawCommand{.clip = swgtk::UIClipRect{.x1 = 50.0f, .y1 = 0.0f, .x2 = 50.0f, .y2 = 10.0f}, .elementCount = 6u},
+        swgtk::UIDrawCommand{.clip = swgtk::UIClipRect{.x1 = 0.0f, .y1 = 20.0f, .x2 = 10.0f, .y2 = 5.0f}, .elementCount = 6u},
+    };
+
+    swgtk::UIDrawData data;
+    REQUIRE(data.AddList(list.vertices, list.indices, commands));
+    REQUIRE(data.Batches().empty());
+    REQUIRE(data.Indices().empty());
+  }
+
+  SECTION("Test vertex offsets and 32-bit indices") {
+    QuadList list;
+    list.Add(0.0f, 0.0f);
+    list.Add(50.0f, 0.0f);
+
+    const std::vector<uint32_t> indices{0u, 1u, 2u, 0u, 2u, 3u};
+    const auto commands = std::vector{swgtk::UIDrawCommand{.clip = screen, .vertexOffset = 4u, .elementCount = 6u}};
+
+    swgtk::UIDrawData data;
+    REQUIRE(data.AddList(list.vertices, indices, commands));
+    REQUIRE(data.Indices()[0] == 4);
+    REQUIRE(data.Vertices()[static_cast<size_t>(data.Indices()[1])].position.x == 60.0f);
+  }
+
+  SECTION("Test bad lists are rejected and leave the frame alone") {
+    QuadList list;
+    list.Add(0.0f, 0.0f);
+
+    swgtk::UIDrawData data;
+    REQUIRE(data.AddList(list.vertices, list.indices, std::vector{swgtk::UIDrawCommand{.clip = screen, .elementCount = 6u}}));
+
+    REQUIRE_FALSE(data.AddList(list.vertices, list.indices, std::vector{swgtk::UIDrawCommand{.clip = screen, .elementCount = 7u}}));
+
+    // Merges into the first batch before its last index is found to be out of range.
+    list.indices.back() = 9u;
+    REQUIRE_FALSE(data.AddList(list.vertices, list.indices, std::vector{swgtk::UIDrawCommand{.clip = screen, .elementCount = 6u}}));
+
+    REQUIRE(data.Vertices().size() == 4uz);
+    REQUIRE(data.Indices().size() == 6uz);
+    REQUIRE(data.Batches().size() == 1uz);
+    REQUIRE(data.Batches()[0].indexCount == 6uz);
+    REQUIRE(data.GetCommandCount() == 1uz);
+
+    data.Clear();
+    REQUIRE(data.Batches().empty());
+    REQUIRE(data.Vertices().empty());
+  }
+}
+
+TEST_CASE("UI draw data benchmark", "[.][benchmark]") {
+  // Forty windows of a hundred and fifty widgets, each widget its own command like a clipped text item.
+  constexpr auto windows = 40;
+  constexpr auto widgets = 150;
+  constexpr auto frames = 300;
+
+  QuadList list;
+  std::vector<swgtk::UIDrawCommand> commands;
+
+  for (auto widget = 0; widget < widgets; ++widget) {
+    const auto first = static_cast<uint32_t>(list.indices.size());
+
+    list.Add(static_cast<float>(widget % 10) * 12.0f, static_cast<float>(widget / 10) * 12.0f);
+    list.Add(static_cast<float>(widget % 10) * 12.0f + 2.0f, static_cast<float>(widget / 10) * 12.0f + 2.0f);
+    commands.push_back(swgtk::UIDrawCommand{.clip = screen, .indexOffset = first, .elementCount = 12u});
+  }
+
+  swgtk::UIDrawData data;
+  swgtk::Timer timer;
+
+  for (auto frame = 0; frame < frames; ++frame) {
+    data.Clear();
+
+    for (auto window = 0; window < windows; ++window) {
+      // A clip rect per window stops windows merging with each other.
+      commands.front().clip.x2 = 800.0f - static_cast<float>(window);
+      data.AddList(list.vertices, list.indices, commands);
+    }
+  }
+
+  std::puts(std::format("{} commands into {} batches: {:.3f} ms per frame", data.GetCommandCount(), data.Batches().size(),
+                        timer.GetElapsedMilliseconds() / frames).c_str());
+
+  REQUIRE(data.GetCommandCount() == static_cast<size_t>(windows * widgets));
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)
@@ -0,0 +1,121 @@
+#include <VisualHarness.hpp>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <swgtk/SDLHW2D.hpp>
+#include <swgtk/ShapeBatch.hpp>
+
+// NOLINTBEGIN(readability-magic-numbers, *-avoid-magic-numbers)
+
+namespace {
+  using namespace swgtk::test;
+
+  // Outlines, fills and thick lines, turning a little each frame.
+  void ShapesScene(swgtk::SDLHW2D& renderer, const int frame) {
+    swgtk::ShapeBatch shapes;
+    const auto angle = static_cast<float>(frame) * 0.05f;
+
+    renderer.BufferClear(SDL_FColor{.r = 0.1f, .g = 0.1f, .b = 0.15f, .a = 1.0f});
+
+    shapes.AddFilledRect(SDL_FRect{.x = 16.0f, .y = 16.0f, .w = 64.0f, .h = 40.0f}, SDL_FColor{.r = 0.9f, .g = 0.3f, .b = 0.2f, .a = 1.0f});
+    shapes.AddRect(SDL_FRect{.x = 96.0f, .y = 16.0f, .w = 64.0f, .h = 40.0f}, 3.0f, SDL_FColor{.r = 0.2f, .g = 0.8f, .b = 0.3f, .a = 1.0f});
+    shapes.AddFilledCircle(SDL_FPoint{.x = 208.0f, .y = 40.0f}, 24.0f, SDL_FColor{.r = 0.2f, .g = 0.4f, .b = 0.9f, .a = 0.75f});
+    shapes.AddCircle(SDL_FPoint{.x = 64.0f, .y = 128.0f}, 36.0f, 4.0f);
+
+    std::array<SDL_FPoint, 5> star{};
+
+    for (auto i = 0uz; i < star.size(); ++i) {
+      const auto a = angle + static_cast<float>(i * 2uz) * 2.0f * 3.14159265f / 5.0f;
+      star[i] = SDL_FPoint{.x = 176.0f + 40.0f * std::cos(a), .y = 128.0f + 40.0f * std::sin(a)};
+    }
+
+    shapes.AddPolygon(star, 2.0f, SDL_FColor{.r = 1.0f, .g = 0.85f, .b = 0.2f, .a = 1.0f});
+
+    for (auto i = 0; i < 8; ++i) {
+      const auto y = 172.0f + static_cast<float>(i % 2) * 8.0f;
+      shapes.AddLine(SDL_FPoint{.x = 16.0f + static_cast<float>(i) * 28.0f, .y = y}, SDL_FPoint{.x = 40.0f + static_cast<float>(i) * 28.0f, .y = 360.0f - y},
+                     1.0f + static_cast<float>(i) * 0.5f);
+    }
+
+    renderer.DrawShapes(shapes);
+  }
+
+  // An offscreen pass into a pooled target, drawn back several times scaled.
+  void TargetScene(swgtk::SDLHW2D& renderer, const int frame) {
+    const auto target = renderer.AcquireTarget(32, 32);
+    swgtk::ShapeBatch shapes;
+
+    renderer.SetDrawTarget(target);
+    renderer.BufferClear(SDL_FColor{.r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 0.0f});
+    shapes.AddFilledCircle(SDL_FPoint{.x = 16.0f, .y = 16.0f}, 14.0f, SDL_FColor{.r = 0.3f, .g = 0.9f, .b = 0.9f, .a = 1.0f});
+    shapes.AddFilledRect(SDL_FRect{.x = static_cast<float>(frame % 24), .y = 12.0f, .w = 8.0f, .h = 8.0f}, SDL_FColor{.r = 0.9f, .g = 0.1f, .b = 0.6f, .a = 1.0f});
+    renderer.DrawShapes(shapes);
+
+    renderer.SetDrawTarget(swgtk::Texture{});
+    renderer.BufferClear(SDL_FColor{.r = 0.05f, .g = 0.05f, .b = 0.05f, .a = 1.0f});
+
+    for (auto i = 0; i < 6; ++i) {
+      const auto size = 24.0f + static_cast<float>(i) * 12.0f;
+      renderer.DrawTexture(target, std::nullopt, SDL_FRect{.x = 8.0f + static_cast<float>(i) * 36.0f, .y = 96.0f - size * 0.5f, .w = size, .h = size});
+    }
+  }
+
+  // A box sliding across a static backdrop. Only the box's old and new places are marked with dirty rendering.
+  void DirtyScene(swgtk::SDLHW2D& renderer, const int frame) {
+    const auto box = [](const int f) { return SDL_Rect{.x = 8 + (f * 3) % 200, .y = 80, .w = 32, .h = 32}; };
+
+    renderer.MarkDirty(box(frame));
+
+    if (frame > 0) {
+      renderer.MarkDirty(box(frame - 1));
+    }
+
+    if (!renderer.BeginRedraw(SDL_FColor{.r = 0.2f, .g = 0.2f, .b = 0.2f, .a = 1.0f})) {
+      return;
+    }
+
+    swgtk::ShapeBatch shapes;
+
+    for (auto i = 0; i < 8; ++i) {
+      shapes.AddFilledRect(SDL_FRect{.x = static_cast<float>(i) * 32.0f, .y = 0.0f, .w = 16.0f, .h = static_cast<float>(sceneHeight)},
+                           SDL_FColor{.r = 0.3f, .g = 0.3f, .b = 0.35f, .a = 1.0f});
+    }
+
+    const auto moving = box(frame);
+    shapes.AddFilledRect(SDL_FRect{.x = static_cast<float>(moving.x), .y = static_cast<float>(moving.y), .w = static_cast<float>(moving.w),
+                                   .h = static_cast<float>(moving.h)},
+                         SDL_FColor{.r = 1.0f, .g = 0.6f, .b = 0.1f, .a = 1.0f});
+
+    renderer.DrawShapes(shapes);
+  }
+} // namespace
+
+TEST_CASE("Visual Regression Tests") {
+  SECTION("Test shapes") {
+    const auto result = RunScene(ShapesScene);
+    CheckAgainstGolden("shapes", result.image.get(), ImageTolerance{.channel = 2, .mismatched = 0.002});
+    CheckAgainstBaseline("shapes", result.times);
+  }
+
+  SECTION("Test an offscreen target pass") {
+    const auto result = RunScene(TargetScene);
+    CheckAgainstGolden("render_target", result.image.get());
+    CheckAgainstBaseline("render_target", result.times);
+  }
+
+  SECTION("Test dirty rendering matches redrawing everything") {
+    const auto full = RunScene(DirtyScene);
+    const auto dirty = RunScene(DirtyScene, sceneFrames, true);
+
+    REQUIRE(full.image != nullptr);
+    REQUIRE(dirty.image != nullptr);
+
+    const SurfacePtr diff{SDL_CreateSurface(sceneWidth, sceneHeight, SDL_PIXELFORMAT_RGBA32)};
+    CHECK(CountMismatched(dirty.image.get(), full.image.get(), 1, diff.get()) == 0uz);
+
+    CheckAgainstGolden("dirty", dirty.image.get());
+    CheckAgainstBaseline("dirty", dirty.times);
+  }
+}
+
+// NOLINTEND(readability-magic-numbers, *-avoid-magic-numbers)